@@ -0,0 +1,54 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ProjectionStatus.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief the result of attempting to project a quadric into an image
+ */
+
+#pragma once
+
+namespace gtsam_quadrics {
+
+/**
+ * Returned by the non-throwing projection methods
+ * (QuadricCamera::tryProject, DualConic::trySmartBounds) in place of a
+ * QuadricProjectionException
+ */
+enum class ProjectionStatus {
+  SUCCESS,        ///< the projection and bounds are valid
+  BEHIND_CAMERA,  ///< the quadric is behind the camera
+  CAMERA_INSIDE,  ///< the camera is inside the quadric
+  NON_ELLIPSE,    ///< the projected conic is not an ellipse
+  NOT_VISIBLE     ///< no part of the conic lies inside the image
+};
+
+/** Returns a human readable description of the projection status */
+inline const char* toString(const ProjectionStatus& status) {
+  switch (status) {
+    case ProjectionStatus::SUCCESS:
+      return "Projection succeeded";
+    case ProjectionStatus::BEHIND_CAMERA:
+      return "Quadric is behind camera";
+    case ProjectionStatus::CAMERA_INSIDE:
+      return "Camera is inside quadric";
+    case ProjectionStatus::NON_ELLIPSE:
+      return "Projected Conic is non-ellipse";
+    case ProjectionStatus::NOT_VISIBLE:
+      return "no valid conic points inside image dimensions, implies quadric "
+             "not visible";
+  }
+  return "Unknown projection status";
+}
+
+}  // namespace gtsam_quadrics
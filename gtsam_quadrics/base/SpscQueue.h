@@ -0,0 +1,123 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file SpscQueue.h
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief bounded lock-free queue between one producer and one consumer
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class SpscQueue
+ * A bounded ring buffer passing values from exactly one producer thread to
+ * exactly one consumer thread without locks. Neither side ever waits:
+ * tryPush fails when the queue is full and tryPop when it is empty. The
+ * indices are 64 bytes apart so the two threads do not share a cache line.
+ * NOTE: values stay in their slot until overwritten, use cheap to move
+ * types such as shared pointers.
+ */
+template <class T>
+class SpscQueue {
+ protected:
+  std::vector<T> slots_;           ///< one more slot than the capacity
+  std::atomic<size_t> head_;       ///< next slot to pop, owned by the consumer
+  char padding_[64 - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> tail_;       ///< next slot to push, owned by the producer
+
+  /** Returns the slot after i */
+  size_t next(size_t i) const { return i + 1 == slots_.size() ? 0 : i + 1; }
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Constructor from the largest number of queued values */
+  explicit SpscQueue(size_t capacity)
+      : slots_(capacity + 1), head_(0), tail_(0) {
+    if (capacity == 0) {
+      throw std::invalid_argument("SpscQueue requires a capacity of at least 1");
+    }
+  }
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the largest number of queued values */
+  size_t capacity() const { return slots_.size() - 1; }
+
+  /** Returns the number of queued values, exact only on an idle queue */
+  size_t size() const {
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    return tail >= head ? tail - head : tail + slots_.size() - head;
+  }
+
+  /** Checks if nothing is queued, exact only on an idle queue */
+  bool empty() const { return this->size() == 0; }
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /**
+   * Queues a value, called by the producer only
+   * @return false if the queue is full, leaving value unchanged
+   */
+  bool tryPush(T&& value) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t after = this->next(tail);
+    if (after == head_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    slots_[tail] = std::move(value);
+    tail_.store(after, std::memory_order_release);
+    return true;
+  }
+
+  /** Queues a copy of a value, see tryPush */
+  bool tryPush(const T& value) {
+    T copy(value);
+    return this->tryPush(std::move(copy));
+  }
+
+  /**
+   * Takes the oldest value, called by the consumer only
+   * @return false if the queue is empty, leaving value unchanged
+   */
+  bool tryPop(T& value) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    value = std::move(slots_[head]);
+    head_.store(this->next(head), std::memory_order_release);
+    return true;
+  }
+
+  /// @}
+};
+
+}  // namespace gtsam_quadrics
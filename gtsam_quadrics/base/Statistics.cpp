@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file Statistics.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief counters and timings of the factor evaluation hot path
+ */
+
+#include <gtsam_quadrics/base/Statistics.h>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+std::atomic<size_t> Statistics::counters_[Statistics::NR_COUNTERS];
+
+/* ************************************************************************* */
+bool Statistics::enabled() {
+#ifdef GTSAM_QUADRICS_ENABLE_STATISTICS
+  return true;
+#else
+  return false;
+#endif
+}
+
+/* ************************************************************************* */
+size_t Statistics::count(const std::string& name) {
+  for (int counter = 0; counter < NR_COUNTERS; counter++) {
+    if (Statistics::name(Counter(counter)) == name) {
+      return count(Counter(counter));
+    }
+  }
+  throw std::invalid_argument("The counter \"" + name +
+                              "\" is not a valid Statistics counter");
+}
+
+/* ************************************************************************* */
+std::string Statistics::name(const Counter& counter) {
+  switch (counter) {
+    case EVALUATIONS:
+      return "EVALUATIONS";
+    case BEHIND_CAMERA:
+      return "BEHIND_CAMERA";
+    case CAMERA_INSIDE:
+      return "CAMERA_INSIDE";
+    case NON_ELLIPSE:
+      return "NON_ELLIPSE";
+    case SMART_BOUNDS_FAILED:
+      return "SMART_BOUNDS_FAILED";
+    case NON_FINITE:
+      return "NON_FINITE";
+    case SMART_BOUNDS_STANDARD:
+      return "SMART_BOUNDS_STANDARD";
+    case SMART_BOUNDS_TRUNCATED:
+      return "SMART_BOUNDS_TRUNCATED";
+    case INACTIVE:
+      return "INACTIVE";
+    case NR_COUNTERS:
+      break;
+  }
+  throw std::invalid_argument("Not a valid Statistics counter");
+}
+
+/* ************************************************************************* */
+void Statistics::reset() {
+  for (std::atomic<size_t>& counter : counters_) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+#ifdef GTSAM_QUADRICS_ENABLE_TIMING
+  tictoc_reset_();
+#endif
+}
+
+/* ************************************************************************* */
+void Statistics::print(const std::string& s) {
+  cout << s << (enabled() ? "" : " (statistics disabled)") << endl;
+  for (int counter = 0; counter < NR_COUNTERS; counter++) {
+    cout << "  " << name(Counter(counter)) << ": " << count(Counter(counter))
+         << endl;
+  }
+#ifdef GTSAM_QUADRICS_ENABLE_TIMING
+  tictoc_print_();
+#endif
+}
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,96 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file Statistics.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief counters and timings of the factor evaluation hot path
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#ifdef GTSAM_QUADRICS_ENABLE_TIMING
+#include <gtsam/base/timing.h>
+/** Times the rest of the enclosing scope with gtsam's gttic */
+#define GTSAM_QUADRICS_TIC(label) gttic_(label)
+#else
+#define GTSAM_QUADRICS_TIC(label) ((void)0)
+#endif
+
+namespace gtsam_quadrics {
+
+/**
+ * @class Statistics
+ * Process-wide counters of why factor evaluations fail and which bounds
+ * are computed, to diagnose slow or stuck optimizations.
+ * Counting is compiled in with the CMake option
+ * GTSAM_QUADRICS_ENABLE_STATISTICS and is otherwise free. Counters are
+ * relaxed atomics, so they are safe to update from many threads, but a
+ * snapshot taken during a solve may mix evaluations. Scoped timings use
+ * gtsam's timing tree, compiled in with GTSAM_QUADRICS_ENABLE_TIMING,
+ * which is not thread-safe.
+ */
+class Statistics {
+ public:
+  /// the events that are counted
+  enum Counter {
+    EVALUATIONS,             ///< BoundingBoxFactor::evaluateView calls
+    BEHIND_CAMERA,           ///< evaluations with the quadric behind
+    CAMERA_INSIDE,           ///< evaluations with the camera inside
+    NON_ELLIPSE,             ///< evaluations projecting to a non-ellipse
+    SMART_BOUNDS_FAILED,     ///< TRUNCATED evaluations without smartBounds
+    NON_FINITE,              ///< evaluations with a nan or inf error
+    SMART_BOUNDS_STANDARD,   ///< smartBounds of fully visible conics
+    SMART_BOUNDS_TRUNCATED,  ///< smartBounds truncated by the image
+    INACTIVE,                ///< gated factors that skipped a hidden quadric
+    NR_COUNTERS
+  };
+
+ protected:
+  static std::atomic<size_t> counters_[NR_COUNTERS];
+
+ public:
+  /** Returns true if counting was compiled in */
+  static bool enabled();
+
+  /** Counts one event, does nothing unless enabled */
+  static void increment(const Counter& counter) {
+#ifdef GTSAM_QUADRICS_ENABLE_STATISTICS
+    counters_[counter].fetch_add(1, std::memory_order_relaxed);
+#else
+    (void)counter;
+#endif
+  }
+
+  /** Returns the number of events counted since the last reset */
+  static size_t count(const Counter& counter) {
+    return counters_[counter].load(std::memory_order_relaxed);
+  }
+
+  /** Returns a counter by name, as "BEHIND_CAMERA" */
+  static size_t count(const std::string& name);
+
+  /** Returns the name of a counter */
+  static std::string name(const Counter& counter);
+
+  /** Resets the counters, and the timings if compiled in */
+  static void reset();
+
+  /** Prints the counters, and the timings if compiled in */
+  static void print(const std::string& s = "");
+};
+
+}  // namespace gtsam_quadrics
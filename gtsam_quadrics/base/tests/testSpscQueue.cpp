@@ -0,0 +1,85 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testSpscQueue.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for SpscQueue
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/base/SpscQueue.h>
+
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+using namespace gtsam_quadrics;
+
+TEST(SpscQueue, PushPop) {
+  SpscQueue<int> queue(3);
+  LONGS_EQUAL(3, queue.capacity());
+  EXPECT(queue.empty());
+
+  int value = -1;
+  EXPECT(!queue.tryPop(value));
+  LONGS_EQUAL(-1, value);
+
+  // wraps around the ring several times, full at the capacity
+  int next = 0, expected = 0;
+  for (int round = 0; round < 5; round++) {
+    while (queue.tryPush(next)) {
+      next++;
+    }
+    LONGS_EQUAL(3, queue.size());
+    EXPECT(queue.tryPop(value));
+    LONGS_EQUAL(expected++, value);
+    EXPECT(queue.tryPop(value));
+    LONGS_EQUAL(expected++, value);
+    LONGS_EQUAL(1, queue.size());
+  }
+
+  CHECK_EXCEPTION(SpscQueue<int> empty(0), std::invalid_argument);
+}
+
+TEST(SpscQueue, Threads) {
+  // every value arrives once and in order
+  SpscQueue<size_t> queue(16);
+  const size_t n = 10000;
+  std::thread producer([&]() {
+    for (size_t i = 0; i < n; i++) {
+      while (!queue.tryPush(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  size_t received = 0, value, errors = 0;
+  while (received < n) {
+    if (queue.tryPop(value)) {
+      errors += value != received;
+      received++;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  LONGS_EQUAL(0, errors);
+  EXPECT(queue.empty());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,97 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testStatistics.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for Statistics
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/base/Statistics.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot3.h>
+
+#include <limits>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+TEST(Statistics, Names) {
+  for (int counter = 0; counter < Statistics::NR_COUNTERS; counter++) {
+    string name = Statistics::name(Statistics::Counter(counter));
+    EXPECT_LONGS_EQUAL(Statistics::count(Statistics::Counter(counter)),
+                       Statistics::count(name));
+  }
+  CHECK_EXCEPTION(Statistics::count("FAILURES"), std::invalid_argument);
+}
+
+TEST(Statistics, FailureReasons) {
+  boost::shared_ptr<Cal3_S2> calibration(
+      new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+  ConstrainedDualQuadric quadric(Rot3(), Point3(0.0, 0.0, 0.0),
+                                 Vector3(0.3, 0.4, 0.5));
+  ConstrainedDualQuadric truncated(Rot3(), Point3(3.0, 0.0, 0.0),
+                                   Vector3(0.3, 0.4, 0.5));
+  AlignedBox2 measured(200.0, 150.0, 400.0, 300.0);
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 1.0);
+  BoundingBoxFactor standard(measured, calibration, Symbol('x', 0),
+                             Symbol('q', 0), model);
+  BoundingBoxFactor smart(measured, calibration, Symbol('x', 0),
+                          Symbol('q', 0), model,
+                          BoundingBoxFactor::TRUNCATED);
+
+  Statistics::reset();
+  standard.evaluateError(Pose3(Rot3(), Point3(0.0, 0.0, -5.0)), quadric);
+  standard.evaluateError(Pose3(Rot3(), Point3(0.0, 0.0, 5.0)), quadric);
+  standard.evaluateError(Pose3(Rot3(), Point3(0.0, 0.0, -0.1)), quadric);
+  smart.evaluateError(Pose3(Rot3(), Point3(0.0, 0.0, -5.0)), quadric);
+  smart.evaluateError(Pose3(Rot3(), Point3(0.0, 0.0, -5.0)), truncated);
+
+  // a nan measurement fails as a projection failure instead of throwing
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  BoundingBoxFactor invalid(AlignedBox2(nan, nan, nan, nan), calibration,
+                            Symbol('x', 0), Symbol('q', 0), model);
+  Matrix H1, H2;
+  Vector error = invalid.evaluateError(Pose3(Rot3(), Point3(0.0, 0.0, -5.0)),
+                                       quadric, H1, H2);
+  EXPECT(assert_equal(Vector(Vector4::Constant(1000.0)), error));
+  EXPECT(assert_equal(Matrix(Matrix::Zero(4, 9)), H2));
+
+  // counted only when compiled in, and reset clears every counter
+  size_t enabled = Statistics::enabled() ? 1 : 0;
+  EXPECT_LONGS_EQUAL(6 * enabled, Statistics::count(Statistics::EVALUATIONS));
+  EXPECT_LONGS_EQUAL(enabled, Statistics::count(Statistics::BEHIND_CAMERA));
+  EXPECT_LONGS_EQUAL(enabled, Statistics::count(Statistics::CAMERA_INSIDE));
+  EXPECT_LONGS_EQUAL(enabled, Statistics::count(Statistics::NON_FINITE));
+  EXPECT_LONGS_EQUAL(0, Statistics::count(Statistics::SMART_BOUNDS_FAILED));
+  EXPECT_LONGS_EQUAL(enabled,
+                     Statistics::count(Statistics::SMART_BOUNDS_STANDARD));
+  EXPECT_LONGS_EQUAL(enabled,
+                     Statistics::count(Statistics::SMART_BOUNDS_TRUNCATED));
+
+  Statistics::reset();
+  for (int counter = 0; counter < Statistics::NR_COUNTERS; counter++) {
+    EXPECT_LONGS_EQUAL(0, Statistics::count(Statistics::Counter(counter)));
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
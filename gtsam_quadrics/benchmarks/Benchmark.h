@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file Benchmark.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief minimal timing harness shared by the benchmark executables
+ */
+
+/**
+ * Every result is printed to stdout as one JSON object per line, so runs
+ * can be stored and diffed by CI without a benchmarking dependency.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace gtsam_quadrics {
+namespace benchmark {
+
+/// sink for results the compiler would otherwise optimize away
+static volatile double sink = 0.0;
+
+/** Seconds elapsed since start */
+inline double elapsed(const std::chrono::steady_clock::time_point& start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+/**
+ * Command line options of the form --name=value or --name value
+ * Unknown options are kept, so each executable reads the ones it uses.
+ */
+class Options {
+ protected:
+  std::map<std::string, std::string> values_;
+
+ public:
+  Options(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+      std::string arg(argv[i]);
+      if (arg.compare(0, 2, "--") != 0) continue;
+      size_t equals = arg.find('=');
+      if (equals != std::string::npos) {
+        values_[arg.substr(2, equals - 2)] = arg.substr(equals + 1);
+      } else if (i + 1 < argc && argv[i + 1][0] != '-') {
+        values_[arg.substr(2)] = argv[++i];
+      } else {
+        values_[arg.substr(2)] = "1";
+      }
+    }
+  }
+
+  /** Returns the option as a number, or the default if not given */
+  double get(const std::string& name, double defaultValue) const {
+    auto it = values_.find(name);
+    return it == values_.end() ? defaultValue
+                               : std::strtod(it->second.c_str(), nullptr);
+  }
+
+  /** Returns the option as a string, or the default if not given */
+  std::string get(const std::string& name,
+                  const std::string& defaultValue) const {
+    auto it = values_.find(name);
+    return it == values_.end() ? defaultValue : it->second;
+  }
+};
+
+/** A single line of JSON output, fields are printed in insertion order */
+class Record {
+ protected:
+  std::ostringstream stream_;
+  bool empty_ = true;
+
+  void key(const std::string& name) {
+    stream_ << (empty_ ? "{" : ", ") << "\"" << name << "\": ";
+    empty_ = false;
+  }
+
+ public:
+  explicit Record(const std::string& benchmark) {
+    stream_.precision(9);
+    add("benchmark", benchmark);
+  }
+
+  Record& add(const std::string& name, const std::string& value) {
+    key(name);
+    stream_ << "\"" << value << "\"";
+    return *this;
+  }
+
+  Record& add(const std::string& name, const char* value) {
+    return add(name, std::string(value));
+  }
+
+  Record& add(const std::string& name, double value) {
+    key(name);
+    stream_ << value;
+    return *this;
+  }
+
+  Record& add(const std::string& name, size_t value) {
+    key(name);
+    stream_ << value;
+    return *this;
+  }
+
+  /** Prints the record to stdout */
+  void print() const { std::cout << stream_.str() << "}" << std::endl; }
+};
+
+/// the time per call of a benchmarked function
+struct Timing {
+  size_t iterations;   ///< calls per repetition
+  size_t repetitions;  ///< timed repetitions
+  double median;       ///< median nanoseconds per call
+  double min;          ///< best nanoseconds per call
+};
+
+/**
+ * Times a function, choosing the number of calls per repetition so each
+ * repetition takes at least minSeconds
+ * @param function called once per iteration
+ * @param minSeconds the smallest duration of a repetition
+ * @param repetitions the number of timed repetitions
+ */
+template <typename Function>
+Timing measure(Function function, double minSeconds, size_t repetitions) {
+  // grow the iteration count until one repetition is long enough
+  size_t iterations = 1;
+  while (true) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) function();
+    double seconds = elapsed(start);
+    if (seconds >= minSeconds || iterations >= (size_t(1) << 30)) break;
+    iterations = seconds > 0.0
+                     ? std::max(iterations + 1,
+                                size_t(1.2 * iterations * minSeconds /
+                                       seconds))
+                     : iterations * 10;
+  }
+
+  std::vector<double> times;
+  for (size_t r = 0; r < std::max(repetitions, size_t(1)); r++) {
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) function();
+    times.push_back(1e9 * elapsed(start) / iterations);
+  }
+  std::sort(times.begin(), times.end());
+  return Timing{iterations, times.size(), times[times.size() / 2],
+                times.front()};
+}
+
+/** Times a function as measure, and prints the median and best time */
+template <typename Function>
+void run(const std::string& name, Function function, double minSeconds,
+         size_t repetitions) {
+  Timing timing = measure(function, minSeconds, repetitions);
+  Record(name)
+      .add("iterations", timing.iterations)
+      .add("repetitions", timing.repetitions)
+      .add("ns_median", timing.median)
+      .add("ns_min", timing.min)
+      .print();
+}
+
+}  // namespace benchmark
+}  // namespace gtsam_quadrics
@@ -0,0 +1,113 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file benchmarkFrames.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief measures the cost of adding the bounding box factors of frames
+ */
+
+/**
+ * Usage: benchmarkFrames [--frames 100] [--detections 50] [--cameras 4]
+ *   [--min-time 0.5] [--repetitions 3]
+ *
+ * Adds the detections of every camera of a rig for a number of frames,
+ * constructing one BoundingBoxFactor at a time as the python examples do,
+ * and with FrameFactorBuilder. Prints one JSON line per method, see
+ * Benchmark.h.
+ */
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam_quadrics/benchmarks/Benchmark.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/FrameFactorBuilder.h>
+
+#include <boost/make_shared.hpp>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+int main(int argc, char** argv) {
+  benchmark::Options options(argc, argv);
+  const size_t nrFrames = options.get("frames", 100.0);
+  const size_t nrDetections = options.get("detections", 50.0);
+  const size_t nrCameras = options.get("cameras", 4.0);
+  const double minTime = options.get("min-time", 0.5);
+  const size_t repetitions = options.get("repetitions", 3.0);
+
+  Matrix boxes(nrDetections, 4);
+  KeyVector keys;
+  for (size_t d = 0; d < nrDetections; d++) {
+    boxes.row(d) << 10.0 + d, 20.0, 60.0 + d, 90.0;
+    keys.push_back(Symbol('q', d));
+  }
+  FrameFactorBuilder builder;
+  for (size_t c = 0; c < nrCameras; c++) {
+    builder.addCamera(
+        boost::make_shared<Cal3_S2>(525.0, 525.0, 0.0, 320.0, 240.0),
+        noiseModel::Isotropic::Sigma(4, 2.0), BoundingBoxFactor::TRUNCATED);
+  }
+  const size_t nrFactors = nrFrames * nrCameras * nrDetections;
+
+  // each factor with its own calibration and noise model, as from python
+  benchmark::Timing single = benchmark::measure(
+      [&] {
+        NonlinearFactorGraph graph;
+        for (size_t i = 0; i < nrFrames; i++) {
+          for (size_t c = 0; c < nrCameras; c++) {
+            for (size_t d = 0; d < nrDetections; d++) {
+              graph.add(BoundingBoxFactor(
+                  AlignedBox2(boxes(d, 0), boxes(d, 1), boxes(d, 2),
+                              boxes(d, 3)),
+                  boost::make_shared<Cal3_S2>(525.0, 525.0, 0.0, 320.0,
+                                              240.0),
+                  Symbol('x', i * nrCameras + c), keys[d],
+                  noiseModel::Isotropic::Sigma(4, 2.0), "TRUNCATED"));
+            }
+          }
+        }
+        benchmark::sink = graph.size();
+      },
+      minTime, repetitions);
+  benchmark::Record("BoundingBoxFactor frames")
+      .add("factors", nrFactors)
+      .add("ns_median", single.median)
+      .add("ns_per_factor", single.median / nrFactors)
+      .print();
+
+  benchmark::Timing built = benchmark::measure(
+      [&] {
+        NonlinearFactorGraph graph;
+        for (size_t i = 0; i < nrFrames; i++) {
+          for (size_t c = 0; c < nrCameras; c++) {
+            builder.add(graph, Symbol('x', i * nrCameras + c), c, boxes,
+                        keys);
+          }
+        }
+        benchmark::sink = graph.size();
+      },
+      minTime, repetitions);
+  benchmark::Record("FrameFactorBuilder frames")
+      .add("factors", nrFactors)
+      .add("cameras", nrCameras)
+      .add("ns_median", built.median)
+      .add("ns_per_factor", built.median / nrFactors)
+      .add("speedup", single.median / built.median)
+      .print();
+
+  return 0;
+}
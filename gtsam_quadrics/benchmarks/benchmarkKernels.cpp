@@ -0,0 +1,214 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file benchmarkKernels.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief microbenchmarks of the geometry kernels and factor evaluation
+ */
+
+/**
+ * Usage: benchmarkKernels [--min-time 0.1] [--repetitions 5] [--filter name]
+ * Prints one JSON line per benchmark, see Benchmark.h.
+ */
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam_quadrics/benchmarks/Benchmark.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/DualConic.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricKernels.h>
+#include <gtsam_quadrics/geometry/QuadricStore.h>
+
+#include <boost/make_shared.hpp>
+#include <string>
+#include <unsupported/Eigen/AutoDiff>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+using benchmark::sink;
+
+/// runs the benchmarks whose name contains the filter
+struct Runner {
+  double minTime;
+  size_t repetitions;
+  string filter;
+
+  template <typename Function>
+  void operator()(const string& name, Function function) const {
+    if (name.find(filter) != string::npos) {
+      benchmark::run(name, function, minTime, repetitions);
+    }
+  }
+};
+
+int main(int argc, char** argv) {
+  benchmark::Options options(argc, argv);
+  const Runner run = {options.get("min-time", 0.1),
+                      size_t(options.get("repetitions", 5.0)),
+                      options.get("filter", string())};
+
+  // a quadric in front of the camera, and one cut off by the image border
+  boost::shared_ptr<Cal3_S2> K =
+      boost::make_shared<Cal3_S2>(525.0, 525.0, 0.0, 320.0, 240.0);
+  Pose3 pose(Rot3::Rodrigues(0.1, -0.2, 0.05), Point3(0.3, -0.1, -5.0));
+  ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.4, 0.1, -0.3),
+                                 Point3(0.2, 0.1, 0.3),
+                                 Vector3(0.5, 0.8, 1.1));
+  ConstrainedDualQuadric truncated(Rot3::Rodrigues(0.4, 0.1, -0.3),
+                                   Point3(-3.0, 0.1, 0.3),
+                                   Vector3(0.5, 0.8, 1.1));
+  ImageBoundary imageBoundary;
+  DualConic conic = QuadricCamera::project(quadric, pose, K);
+  DualConic truncatedConic = QuadricCamera::project(truncated, pose, K);
+
+  Matrix4 Q;
+  Eigen::Matrix<double, 16, 9> dQ_dq;
+  Eigen::Matrix<double, 9, 9> dC_dq;
+  Eigen::Matrix<double, 9, 6> dC_dx;
+  Eigen::Matrix<double, 4, 9> db_dC;
+
+  run("ConstrainedDualQuadric::matrix", [&] {
+    Q = quadric.matrix();
+    sink = Q(0, 0);
+  });
+  run("ConstrainedDualQuadric::matrix(H)", [&] {
+    Q = quadric.matrix(dQ_dq);
+    sink = Q(0, 0) + dQ_dq(0, 0);
+  });
+  run("QuadricCamera::project", [&] {
+    sink = QuadricCamera::project(quadric, pose, K).matrix()(0, 0);
+  });
+  run("QuadricCamera::project(H)", [&] {
+    sink = QuadricCamera::project(quadric, pose, K, dC_dq, dC_dx)
+               .matrix()(0, 0) +
+           dC_dq(0, 0);
+  });
+  run("DualConic::bounds", [&] { sink = conic.bounds().xmin(); });
+  run("DualConic::bounds(H)", [&] {
+    sink = conic.bounds(db_dC).xmin() + db_dC(0, 0);
+  });
+  run("DualConic::smartBounds", [&] {
+    sink = conic.smartBounds(imageBoundary).xmin();
+  });
+  run("DualConic::smartBounds(H)", [&] {
+    sink = conic.smartBounds(imageBoundary, db_dC).xmin() + db_dC(0, 0);
+  });
+  run("DualConic::smartBounds truncated", [&] {
+    sink = truncatedConic.smartBounds(imageBoundary).xmin();
+  });
+  run("DualConic::smartBounds(H) truncated", [&] {
+    sink = truncatedConic.smartBounds(imageBoundary, db_dC).xmin() +
+           db_dC(0, 0);
+  });
+
+  // many quadrics into one camera, in double and single precision
+  std::vector<ConstrainedDualQuadric> quadrics;
+  for (int i = 0; i < 1000; i++) {
+    quadrics.push_back(ConstrainedDualQuadric(
+        Rot3::Rodrigues(0.01 * i, -0.02 * i, 0.2),
+        Point3(0.3 * (i % 10) - 1.5, 0.2 * (i % 7) - 0.6, 0.05 * (i % 20)),
+        Vector3(0.3, 0.5, 0.4)));
+  }
+  BatchProjection projections;
+  BatchProjectionf projectionsf;
+  run("QuadricCamera::projectBatch 1000", [&] {
+    QuadricCamera::projectBatch(quadrics.data(), quadrics.size(), pose, K,
+                                projections);
+    sink = projections.xmin[0];
+  });
+  run("QuadricCamera::projectBatch float 1000", [&] {
+    QuadricCamera::projectBatch(quadrics.data(), quadrics.size(), pose, K,
+                                projectionsf);
+    sink = projectionsf.xmin[0];
+  });
+
+  // the same quadrics from compact stores
+  QuadricStore store;
+  QuadricStoref storef;
+  for (size_t i = 0; i < quadrics.size(); i++) {
+    store.insert(Symbol('q', i), quadrics[i]);
+    storef.insert(Symbol('q', i), quadrics[i]);
+  }
+  run("QuadricCamera::projectBatch QuadricStore 1000", [&] {
+    QuadricCamera::projectBatch(store, pose, K, projections);
+    sink = projections.xmin[0];
+  });
+  run("QuadricCamera::projectBatch QuadricStoref 1000", [&] {
+    QuadricCamera::projectBatch(storef, pose, K, projectionsf);
+    sink = projectionsf.xmin[0];
+  });
+
+  // the STANDARD error and jacobians as one forward autodiff pass
+  typedef Eigen::AutoDiffScalar<Eigen::Matrix<double, 15, 1> > Jet;
+  run("kernels::boundingBoxError autodiff", [&] {
+    kernels::Vector3T<Jet> wx, vx, wq, vq, dr;
+    for (int i = 0; i < 3; i++) {
+      wx(i) = Jet(0.0, 15, i);
+      vx(i) = Jet(0.0, 15, 3 + i);
+      wq(i) = Jet(0.0, 15, 6 + i);
+      vq(i) = Jet(0.0, 15, 9 + i);
+      dr(i) = Jet(0.0, 15, 12 + i);
+    }
+    kernels::Matrix3T<Jet> Rx, Rq;
+    kernels::Vector3T<Jet> tx, tq;
+    kernels::retractFirstOrder<Jet>(pose.rotation().matrix().cast<Jet>(),
+                                    pose.translation().cast<Jet>(), wx, vx,
+                                    Rx, tx);
+    kernels::retractFirstOrder<Jet>(
+        quadric.pose().rotation().matrix().cast<Jet>(),
+        quadric.pose().translation().cast<Jet>(), wq, vq, Rq, tq);
+    kernels::Vector4T<Jet> error = kernels::boundingBoxError<Jet>(
+        Rx, tx, Rq, tq, quadric.radii().cast<Jet>() + dr, K->K().cast<Jet>(),
+        kernels::Vector4T<Jet>::Zero());
+    sink = error(0).value() + error(0).derivatives()(0);
+  });
+
+  // factors measuring the projected bounds with an offset
+  Key poseKey = Symbol('x', 0), quadricKey = Symbol('q', 0);
+  Values values;
+  values.insert(poseKey, pose);
+  values.insert(quadricKey, quadric);
+  boost::shared_ptr<ImageBoundary> image =
+      boost::make_shared<ImageBoundary>();
+  AlignedBox2 measured(conic.bounds().vector() +
+                       Vector4(2.0, -3.0, 1.0, 4.0));
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 3.0);
+
+  const BoundingBoxFactor::MeasurementModel models[] = {
+      BoundingBoxFactor::STANDARD, BoundingBoxFactor::TRUNCATED};
+  const string names[] = {"STANDARD", "TRUNCATED"};
+  for (int m = 0; m < 2; m++) {
+    BoundingBoxFactor factor(measured, K, image, poseKey, quadricKey, model,
+                             models[m]);
+    Matrix H1, H2;
+    run("BoundingBoxFactor::evaluateError " + names[m], [&] {
+      sink = factor.evaluateError(pose, quadric)[0];
+    });
+    run("BoundingBoxFactor::evaluateError(H) " + names[m], [&] {
+      sink = factor.evaluateError(pose, quadric, H1, H2)[0] + H1(0, 0);
+    });
+    run("BoundingBoxFactor::linearize " + names[m], [&] {
+      sink = factor.linearize(values).use_count();
+    });
+  }
+
+  return 0;
+}
@@ -0,0 +1,215 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file benchmarkLinearize.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief scaling of BoundingBoxFactor graph linearization across threads
+ */
+
+/**
+ * Usage: benchmarkLinearize [--factors 20000] [--threads N] [--min-time 0.5]
+ *   [--repetitions 3] [--model STANDARD|TRUNCATED]
+ *
+ * Linearizes a graph of BoundingBoxFactors that share one calibration,
+ * image and noise model, splitting the factors over 1, 2, 4 .. N threads,
+ * and with NonlinearFactorGraph::linearize, which is parallel when gtsam is
+ * built with TBB. The same measurements as ExpressionFactors built from
+ * QuadricExpressions are linearized on one thread for comparison. Prints one
+ * JSON line per configuration, see Benchmark.h.
+ *
+ * The same detections are also split over the same threads as
+ * MultiViewBoundingBoxFactors, sharing one QuadricContextCache per
+ * landmark, and as RigBoundingBoxFactors of a two camera rig, which compute
+ * their camera view per detection. Their ns_per_factor against
+ * BoundingBoxFactor is the saving of the cache and the cost of the view.
+ */
+
+#include <gtsam/config.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam_quadrics/benchmarks/Benchmark.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/CameraRig.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/MultiViewBoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricExpressions.h>
+#include <gtsam_quadrics/geometry/RigBoundingBoxFactor.h>
+
+#include <algorithm>
+#include <boost/make_shared.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+int main(int argc, char** argv) {
+  benchmark::Options options(argc, argv);
+  const size_t nrFactors = options.get("factors", 20000.0);
+  const size_t maxThreads = options.get(
+      "threads", double(std::max(std::thread::hardware_concurrency(), 1u)));
+  const double minTime = options.get("min-time", 0.5);
+  const size_t repetitions = options.get("repetitions", 3.0);
+  const bool truncated =
+      options.get("model", string("STANDARD")) == "TRUNCATED";
+
+  // a ring of 100 landmarks seen from 10 poses per 1000 factors
+  const size_t nrLandmarks = 100;
+  const size_t nrPoses = std::max(nrFactors / nrLandmarks, size_t(1));
+  boost::shared_ptr<Cal3_S2> K =
+      boost::make_shared<Cal3_S2>(525.0, 525.0, 0.0, 320.0, 240.0);
+  boost::shared_ptr<ImageBoundary> image =
+      boost::make_shared<ImageBoundary>();
+  SharedNoiseModel noise = noiseModel::Isotropic::Sigma(4, 2.0);
+
+  Values values;
+  for (size_t i = 0; i < nrPoses; i++) {
+    values.insert(Symbol('x', i),
+                  Pose3(Rot3::Rodrigues(0.0, 0.01 * (i % 20), 0.0),
+                        Point3(0.02 * (i % 50), 0.0, -8.0)));
+  }
+  for (size_t j = 0; j < nrLandmarks; j++) {
+    values.insert(Symbol('q', j),
+                  ConstrainedDualQuadric(
+                      Rot3::Rodrigues(0.1 * j, 0.0, 0.0),
+                      Point3(0.5 * (j % 10) - 2.25, 0.4 * (j / 10) - 1.8, 0.0),
+                      Vector3(0.2, 0.15, 0.25)));
+  }
+
+  const BoundingBoxFactor::MeasurementModel model =
+      truncated ? BoundingBoxFactor::TRUNCATED : BoundingBoxFactor::STANDARD;
+  NonlinearFactorGraph graph, expressionGraph;
+  for (size_t f = 0; f < nrFactors; f++) {
+    size_t i = f / nrLandmarks % nrPoses, j = f % nrLandmarks;
+    AlignedBox2 measured(300.0, 220.0, 340.0 + j % 7, 260.0);
+    graph.add(BoundingBoxFactor(measured, K, image, Symbol('x', i),
+                                Symbol('q', j), noise, model));
+    expressionGraph.add(ExpressionFactor<Vector4>(
+        noise, measured.vector(),
+        predictedBounds(Pose3_(Symbol('x', i)),
+                        ConstrainedDualQuadric_(Symbol('q', j)), K, image,
+                        model)));
+  }
+
+  // the same detections from a two camera rig, each body pose seen by both
+  // cameras, as one RigBoundingBoxFactor per detection
+  boost::shared_ptr<CameraRig> rig = boost::make_shared<CameraRig>();
+  rig->add(Pose3(Rot3(), Point3(0.1, 0.0, 0.0)), K, image);
+  rig->add(Pose3(Rot3::Ry(-0.05), Point3(-0.1, 0.0, 0.0)), K, image);
+  NonlinearFactorGraph rigGraph;
+  for (size_t f = 0; f < nrFactors; f++) {
+    size_t i = f / nrLandmarks % nrPoses, j = f % nrLandmarks;
+    AlignedBox2 measured(300.0, 220.0, 340.0 + j % 7, 260.0);
+    rigGraph.add(RigBoundingBoxFactor(measured, rig, f % 2, Symbol('x', i),
+                                      Symbol('q', j), noise, model));
+  }
+
+  // the same detections sharing the quadric terms of each landmark
+  std::vector<boost::shared_ptr<QuadricContextCache> > caches;
+  for (size_t j = 0; j < nrLandmarks; j++) {
+    caches.push_back(boost::make_shared<QuadricContextCache>());
+  }
+  NonlinearFactorGraph multiViewGraph;
+  for (size_t f = 0; f < nrFactors; f++) {
+    size_t i = f / nrLandmarks % nrPoses, j = f % nrLandmarks;
+    AlignedBox2 measured(300.0, 220.0, 340.0 + j % 7, 260.0);
+    multiViewGraph.add(MultiViewBoundingBoxFactor(
+        measured, K, image, Symbol('x', i), Symbol('q', j), noise, caches[j],
+        model));
+  }
+
+  // contiguous ranges of factors per thread, as a parallel_for would
+  std::vector<GaussianFactor::shared_ptr> linear(graph.size());
+  auto scaling = [&](const string& name, const NonlinearFactorGraph& factors) {
+    auto linearize = [&](size_t begin, size_t end) {
+      for (size_t f = begin; f < end; f++) {
+        linear[f] = factors.at(f)->linearize(values);
+      }
+    };
+
+    double single = 0.0;
+    for (size_t nrThreads = 1; nrThreads <= maxThreads;
+         nrThreads = nrThreads < maxThreads
+                         ? std::min(2 * nrThreads, maxThreads)
+                         : maxThreads + 1) {
+      benchmark::Timing timing = benchmark::measure(
+          [&] {
+            std::vector<std::thread> threads;
+            for (size_t t = 1; t < nrThreads; t++) {
+              threads.push_back(std::thread(linearize,
+                                            t * factors.size() / nrThreads,
+                                            (t + 1) * factors.size() /
+                                                nrThreads));
+            }
+            linearize(0, factors.size() / nrThreads);
+            for (std::thread& thread : threads) thread.join();
+          },
+          minTime, repetitions);
+      if (nrThreads == 1) single = timing.median;
+
+      benchmark::Record(name + "::linearize threads")
+          .add("factors", factors.size())
+          .add("threads", nrThreads)
+          .add("ns_median", timing.median)
+          .add("ns_per_factor", timing.median / factors.size())
+          .add("speedup", single / timing.median)
+          .print();
+    }
+    return single;
+  };
+
+  const double serial = scaling("BoundingBoxFactor", graph);
+  scaling("MultiViewBoundingBoxFactor", multiViewGraph);
+  scaling("RigBoundingBoxFactor", rigGraph);
+
+  benchmark::Timing timing = benchmark::measure(
+      [&] {
+        for (size_t f = 0; f < expressionGraph.size(); f++) {
+          linear[f] = expressionGraph.at(f)->linearize(values);
+        }
+      },
+      minTime, repetitions);
+  benchmark::Record("ExpressionFactor::linearize")
+      .add("factors", expressionGraph.size())
+      .add("ns_median", timing.median)
+      .add("ns_per_factor", timing.median / expressionGraph.size())
+      .add("speedup", serial / timing.median)
+      .print();
+
+  timing = benchmark::measure(
+      [&] { benchmark::sink = graph.linearize(values)->size(); }, minTime,
+      repetitions);
+#ifdef GTSAM_USE_TBB
+  const string tbb = "ON";
+#else
+  const string tbb = "OFF";
+#endif
+  benchmark::Record("NonlinearFactorGraph::linearize")
+      .add("factors", graph.size())
+      .add("tbb", tbb)
+      .add("ns_median", timing.median)
+      .add("ns_per_factor", timing.median / graph.size())
+      .add("speedup", serial / timing.median)
+      .print();
+
+  return 0;
+}
@@ -0,0 +1,431 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file benchmarkSolvers.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief batch and incremental solves of synthetic quadric scenes
+ */
+
+/**
+ * Usage: benchmarkSolvers [--landmarks 50] [--poses 100] [--detections 20]
+ *   [--min-views 5] [--seed 0] [--pixel-noise 2] [--max-iterations 20]
+ *   [--model STANDARD|TRUNCATED] [--solver all|lm|isam2|window]
+ *   [--init perturbed|boxes] [--lag 10] [--window-iterations 5]
+ *
+ * The camera circles the landmarks looking at the centre of the scene,
+ * detecting at most the nearest `detections` visible landmarks per pose.
+ * Landmarks seen fewer than `min-views` times are left out. Landmarks are
+ * initialized as the perturbed ground truth, or from their detected boxes
+ * with QuadricInitializer, falling back to the perturbed ground truth where
+ * that fails. The window solver optimizes the last `lag` poses with
+ * QuadricWindow. Prints one JSON line per solver, see Benchmark.h.
+ */
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/LevenbergMarquardtOptimizer.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam/slam/BetweenFactor.h>
+#include <gtsam_quadrics/benchmarks/Benchmark.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricInitializer.h>
+#include <gtsam_quadrics/geometry/QuadricWindow.h>
+
+#include <algorithm>
+#include <boost/make_shared.hpp>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+using symbol_shorthand::Q;
+using symbol_shorthand::X;
+
+/// a detection of landmark j
+struct Detection {
+  size_t landmark;
+  AlignedBox2 box;
+};
+typedef std::vector<Detection, Eigen::aligned_allocator<Detection> >
+    Detections;
+
+/// a synthetic graph, in the order an incremental solver receives it
+struct Scene {
+  std::vector<Pose3> poses;
+  std::vector<ConstrainedDualQuadric> quadrics;
+  std::vector<Detections> detections;  ///< per pose
+  std::vector<size_t> views;           ///< per landmark
+
+  NonlinearFactorGraph graph;
+  Values initial;
+  size_t nrDetections = 0;
+};
+
+/** Builds the scene, its factor graph and a perturbed initial estimate */
+Scene makeScene(const benchmark::Options& options) {
+  const size_t nrLandmarks = options.get("landmarks", 50.0);
+  const size_t nrPoses = std::max(options.get("poses", 100.0), 1.0);
+  const size_t maxDetections = options.get("detections", 20.0);
+  const size_t minViews = options.get("min-views", 5.0);
+  const double pixelNoise = options.get("pixel-noise", 2.0);
+  const bool truncated = options.get("model", string("STANDARD")) ==
+                         "TRUNCATED";
+
+  std::mt19937 generator(unsigned(options.get("seed", 0.0)));
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  auto noise = [&](int n, double sigma) {
+    Vector v(n);
+    for (int i = 0; i < n; i++) v[i] = sigma * normal(generator);
+    return v;
+  };
+
+  // landmarks spread over a square that grows with their number
+  Scene scene;
+  const double extent = std::max(1.0, 0.5 * std::sqrt(double(nrLandmarks)));
+  for (size_t j = 0; j < nrLandmarks; j++) {
+    Rot3 R = Rot3::Rodrigues(0.0, 0.0, M_PI * uniform(generator));
+    Point3 t(extent * uniform(generator), extent * uniform(generator),
+             0.25 * (1.0 + uniform(generator)));
+    Vector3 radii(0.35 + 0.15 * uniform(generator),
+                  0.35 + 0.15 * uniform(generator),
+                  0.35 + 0.15 * uniform(generator));
+    scene.quadrics.push_back(ConstrainedDualQuadric(R, t, radii));
+  }
+
+  // the camera circles the square looking at its centre
+  boost::shared_ptr<Cal3_S2> K =
+      boost::make_shared<Cal3_S2>(525.0, 525.0, 0.0, 320.0, 240.0);
+  const double radius = 2.0 * extent + 4.0;
+  for (size_t i = 0; i < nrPoses; i++) {
+    double angle = 2.0 * M_PI * i / nrPoses;
+    Point3 eye(radius * std::cos(angle), radius * std::sin(angle), 1.5);
+    scene.poses.push_back(PinholeCamera<Cal3_S2>::Lookat(
+                              eye, Point3(0.0, 0.0, 0.25),
+                              Point3(0.0, 0.0, 1.0), *K)
+                              .pose());
+  }
+
+  // the nearest landmarks that project into the image
+  ImageBoundary image;
+  scene.views.assign(nrLandmarks, 0);
+  scene.detections.resize(nrPoses);
+  for (size_t i = 0; i < nrPoses; i++) {
+    std::vector<std::pair<double, Detection>,
+                Eigen::aligned_allocator<std::pair<double, Detection> > >
+        candidates;
+    for (size_t j = 0; j < nrLandmarks; j++) {
+      DualConic conic;
+      AlignedBox2 box;
+      if (QuadricCamera::tryProject(scene.quadrics[j], scene.poses[i], K,
+                                    conic) != ProjectionStatus::SUCCESS) {
+        continue;
+      }
+      if (image.bounds().contains(conic.bounds())) {
+        box = conic.bounds();
+      } else if (!truncated || conic.trySmartBounds(image, box) !=
+                                   ProjectionStatus::SUCCESS) {
+        continue;
+      }
+      double distance =
+          (scene.poses[i].translation() - scene.quadrics[j].centroid())
+              .norm();
+      candidates.push_back(make_pair(distance, Detection{j, box}));
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const std::pair<double, Detection>& a,
+                 const std::pair<double, Detection>& b) {
+                return a.first < b.first;
+              });
+    for (size_t k = 0; k < std::min(maxDetections, candidates.size()); k++) {
+      Detection detection = candidates[k].second;
+      detection.box =
+          AlignedBox2(detection.box.vector() + noise(4, pixelNoise));
+      scene.detections[i].push_back(detection);
+      scene.views[detection.landmark]++;
+    }
+  }
+
+  // odometry, detections of landmarks seen often enough, and a prior
+  boost::shared_ptr<ImageBoundary> imageBoundary =
+      boost::make_shared<ImageBoundary>(image);
+  SharedNoiseModel boxNoise =
+      noiseModel::Isotropic::Sigma(4, std::max(pixelNoise, 1.0));
+  SharedNoiseModel odometryNoise = noiseModel::Diagonal::Sigmas(
+      (Vector(6) << 0.01, 0.01, 0.01, 0.05, 0.05, 0.05).finished());
+  scene.graph.add(PriorFactor<Pose3>(
+      X(0), scene.poses[0],
+      noiseModel::Isotropic::Sigma(6, 1e-3)));
+  for (size_t i = 0; i < nrPoses; i++) {
+    if (i > 0) {
+      Pose3 odometry = scene.poses[i - 1].between(scene.poses[i]);
+      scene.graph.add(BetweenFactor<Pose3>(
+          X(i - 1), X(i), odometry.retract(noise(6, 0.01)), odometryNoise));
+    }
+    scene.initial.insert(X(i), scene.poses[i].retract(noise(6, 0.02)));
+    for (const Detection& detection : scene.detections[i]) {
+      if (scene.views[detection.landmark] < minViews) continue;
+      scene.graph.add(BoundingBoxFactor(
+          detection.box, K, imageBoundary, X(i), Q(detection.landmark),
+          boxNoise,
+          truncated ? BoundingBoxFactor::TRUNCATED
+                    : BoundingBoxFactor::STANDARD));
+      scene.nrDetections++;
+    }
+  }
+  std::vector<ConstrainedDualQuadric> initialized;
+  std::vector<QuadricInitializer::Status> status(
+      nrLandmarks, QuadricInitializer::TOO_FEW_PLANES);
+  if (options.get("init", string("perturbed")) == "boxes") {
+    // from the noisy detections and initial poses, as a frontend would
+    std::vector<Pose3> initialPoses;
+    std::vector<QuadricInitializer::Track> tracks(nrLandmarks);
+    for (size_t i = 0; i < nrPoses; i++) {
+      initialPoses.push_back(scene.initial.at<Pose3>(X(i)));
+      for (const Detection& detection : scene.detections[i]) {
+        tracks[detection.landmark].poses.push_back(i);
+        tracks[detection.landmark].boxes.push_back(detection.box);
+      }
+    }
+    auto start = std::chrono::steady_clock::now();
+    status = QuadricInitializer::initializeBatch(initialPoses, tracks, K,
+                                                 initialized);
+    double seconds = benchmark::elapsed(start);
+    size_t nrInitialized = std::count(status.begin(), status.end(),
+                                      QuadricInitializer::SUCCESS);
+    benchmark::Record("QuadricInitializer::initializeBatch")
+        .add("landmarks", nrLandmarks)
+        .add("initialized", nrInitialized)
+        .add("seconds", seconds)
+        .print();
+  }
+  for (size_t j = 0; j < nrLandmarks; j++) {
+    if (scene.views[j] < minViews) continue;
+    if (status[j] == QuadricInitializer::SUCCESS) {
+      scene.initial.insert(Q(j), initialized[j]);
+    } else {
+      scene.initial.insert(Q(j), scene.quadrics[j].retract(noise(9, 0.05)));
+    }
+  }
+  return scene;
+}
+
+/** Starts a record describing the scene */
+benchmark::Record sceneRecord(const string& name, const Scene& scene) {
+  size_t nrLandmarks = scene.initial.size() - scene.poses.size();
+  benchmark::Record record(name);
+  record.add("landmarks", nrLandmarks)
+      .add("poses", scene.poses.size())
+      .add("detections", scene.nrDetections)
+      .add("factors", scene.graph.size());
+  return record;
+}
+
+/** Batch Levenberg-Marquardt over the whole scene */
+void benchmarkLevenbergMarquardt(const Scene& scene,
+                                 const benchmark::Options& options) {
+  LevenbergMarquardtParams params;
+  params.setMaxIterations(options.get("max-iterations", 20.0));
+
+  auto start = std::chrono::steady_clock::now();
+  LevenbergMarquardtOptimizer optimizer(scene.graph, scene.initial, params);
+  Values result = optimizer.optimize();
+  double seconds = benchmark::elapsed(start);
+
+  sceneRecord("LevenbergMarquardt", scene)
+      .add("iterations", size_t(optimizer.iterations()))
+      .add("seconds", seconds)
+      .add("initial_error", scene.graph.error(scene.initial))
+      .add("final_error", scene.graph.error(result))
+      .print();
+}
+
+/**
+ * Returns the factors and values of pose i, in the order an incremental
+ * solver receives them. A landmark and its buffered detections are added
+ * once it has been seen min-views times, so that every landmark in the
+ * solver is constrained.
+ */
+std::pair<NonlinearFactorGraph, Values> nextPose(
+    const Scene& scene, size_t i, size_t minViews,
+    std::vector<NonlinearFactorGraph>& pending, std::vector<size_t>& seen,
+    size_t& next) {
+  NonlinearFactorGraph newFactors;
+  Values newValues;
+  newValues.insert(X(i), scene.initial.at<Pose3>(X(i)));
+
+  // the prior or odometry factor comes first, then its detections
+  newFactors.push_back(scene.graph.at(next++));
+  while (next < scene.graph.size()) {
+    auto factor =
+        boost::dynamic_pointer_cast<BoundingBoxFactor>(scene.graph.at(next));
+    if (!factor || factor->poseKey() != X(i)) break;
+    size_t j = Symbol(factor->objectKey()).index();
+    next++;
+
+    if (seen[j] >= minViews) {
+      newFactors.push_back(factor);
+    } else {
+      pending[j].push_back(factor);
+      if (++seen[j] == minViews) {
+        newValues.insert(Q(j),
+                         scene.initial.at<ConstrainedDualQuadric>(Q(j)));
+        newFactors.push_back(pending[j]);
+        pending[j] = NonlinearFactorGraph();
+      }
+    }
+  }
+  return make_pair(newFactors, newValues);
+}
+
+/**
+ * ISAM2 receiving one pose at a time. A landmark and its buffered
+ * detections are added once it has been seen min-views times, so that
+ * every landmark in the solver is constrained.
+ */
+void benchmarkISAM2(const Scene& scene, const benchmark::Options& options) {
+  const size_t minViews = options.get("min-views", 5.0);
+  ISAM2Params params;
+  params.relinearizeThreshold = 0.01;
+  params.relinearizeSkip = 1;
+  ISAM2 isam(params);
+
+  // detection factors of each landmark, in the order they were added
+  std::vector<NonlinearFactorGraph> pending(scene.quadrics.size());
+  std::vector<size_t> seen(scene.quadrics.size(), 0);
+  size_t next = 0;
+
+  double updateSeconds = 0.0, maxUpdateSeconds = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < scene.poses.size(); i++) {
+    std::pair<NonlinearFactorGraph, Values> newPose =
+        nextPose(scene, i, minViews, pending, seen, next);
+
+    auto update = std::chrono::steady_clock::now();
+    isam.update(newPose.first, newPose.second);
+    double elapsed = benchmark::elapsed(update);
+    updateSeconds += elapsed;
+    maxUpdateSeconds = std::max(maxUpdateSeconds, elapsed);
+  }
+  Values result = isam.calculateEstimate();
+  double seconds = benchmark::elapsed(start);
+
+  sceneRecord("ISAM2", scene)
+      .add("seconds", seconds)
+      .add("update_seconds_mean", updateSeconds / scene.poses.size())
+      .add("update_seconds_max", maxUpdateSeconds)
+      .add("initial_error", scene.graph.error(scene.initial))
+      .add("final_error", scene.graph.error(result))
+      .print();
+}
+
+/**
+ * Levenberg-Marquardt over a QuadricWindow of the last `lag` poses, one
+ * pose per second. The update cost is bounded by the window, reported as
+ * the mean of the first and last tenth of the updates.
+ */
+void benchmarkWindow(const Scene& scene, const benchmark::Options& options) {
+  const size_t minViews = options.get("min-views", 5.0);
+  QuadricWindow window(
+      QuadricWindowParams(options.get("lag", 10.0), minViews));
+  LevenbergMarquardtParams params;
+  params.setMaxIterations(options.get("window-iterations", 5.0));
+
+  std::vector<NonlinearFactorGraph> pending(scene.quadrics.size());
+  std::vector<size_t> seen(scene.quadrics.size(), 0);
+  size_t next = 0;
+
+  // the last estimate of every variable, including those that have left
+  Values result;
+  auto keep = [&result](const Values& values, const KeyVector& keys) {
+    for (const Key& key : keys) {
+      if (result.exists(key)) {
+        result.update(key, values.at(key));
+      } else {
+        result.insert(key, values.at(key));
+      }
+    }
+  };
+
+  std::vector<double> updateSeconds;
+  size_t maxFactors = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < scene.poses.size(); i++) {
+    std::pair<NonlinearFactorGraph, Values> newPose =
+        nextPose(scene, i, minViews, pending, seen, next);
+
+    auto update = std::chrono::steady_clock::now();
+    window.update(newPose.first, newPose.second, double(i));
+    LevenbergMarquardtOptimizer optimizer(window.graph(), window.values(),
+                                          params);
+    window.setEstimate(optimizer.optimize());
+    maxFactors = std::max(maxFactors, window.graph().size());
+    Values estimate = window.values();
+    keep(estimate, window.marginalize(double(i)));
+    updateSeconds.push_back(benchmark::elapsed(update));
+  }
+  keep(window.values(), window.values().keys());
+  double seconds = benchmark::elapsed(start);
+
+  const size_t tenth = std::max<size_t>(updateSeconds.size() / 10, 1);
+  auto mean = [&](size_t begin) {
+    double sum = 0.0;
+    for (size_t k = begin; k < begin + tenth; k++) sum += updateSeconds[k];
+    return sum / tenth;
+  };
+  sceneRecord("QuadricWindow", scene)
+      .add("seconds", seconds)
+      .add("window_factors_max", maxFactors)
+      .add("update_seconds_first", mean(0))
+      .add("update_seconds_last", mean(updateSeconds.size() - tenth))
+      .add("initial_error", scene.graph.error(scene.initial))
+      .add("final_error", scene.graph.error(result))
+      .print();
+}
+
+int main(int argc, char** argv) {
+  benchmark::Options options(argc, argv);
+  const string solver = options.get("solver", string("all"));
+
+  auto start = std::chrono::steady_clock::now();
+  Scene scene = makeScene(options);
+  sceneRecord("makeScene", scene)
+      .add("seconds", benchmark::elapsed(start))
+      .print();
+
+  if (solver == "all" || solver == "lm") {
+    benchmarkLevenbergMarquardt(scene, options);
+  }
+  if (solver == "all" || solver == "isam2") {
+    benchmarkISAM2(scene, options);
+  }
+  if (solver == "all" || solver == "window") {
+    benchmarkWindow(scene, options);
+  }
+  return 0;
+}
@@ -21,6 +21,7 @@
 #include <gtsam/base/Testable.h>
 #include <gtsam/geometry/Pose3.h>
 
+#include <boost/serialization/nvp.hpp>
 #include <vector>
 
 namespace gtsam_quadrics {
@@ -131,12 +132,29 @@ class AlignedBox2 {
   /** Compares two boxes */
   bool equals(const AlignedBox2& other, double tol = 1e-9) const;
 
+  /// @}
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& BOOST_SERIALIZATION_NVP(tlbr_);
+  }
+
   /// @}
 };
 
 // Add vector<> typedef for python wrapper
 typedef std::vector<gtsam::Vector3> Vector3Vector;
 
+// Add vector<> typedef for boxes, aligned as boxes hold a fixed-size vector
+typedef std::vector<AlignedBox2, Eigen::aligned_allocator<AlignedBox2>>
+    AlignedBox2Vector;
+
 }  // namespace gtsam_quadrics
 
 /** \cond PRIVATE */
@@ -20,6 +20,7 @@
 
 #include <gtsam/geometry/Pose3.h>
 
+#include <boost/serialization/nvp.hpp>
 #include <vector>
 
 namespace gtsam_quadrics {
@@ -105,6 +106,19 @@ class AlignedBox3 {
   /** Compares two boxes */
   bool equals(const AlignedBox3& other, double tol = 1e-9) const;
 
+  /// @}
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& BOOST_SERIALIZATION_NVP(xxyyzz_);
+  }
+
   /// @}
 };
 
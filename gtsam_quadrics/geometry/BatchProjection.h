@@ -0,0 +1,84 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BatchProjection.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief structure-of-arrays output of QuadricCamera::projectBatch
+ */
+
+#pragma once
+
+#include <gtsam_quadrics/base/ProjectionStatus.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/DualConic.h>
+
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class BatchProjectionT
+ * Many quadrics projected into one camera, stored as one contiguous array
+ * per field so the per-quadric passes vectorize.
+ * The unique entries of each symmetric dual conic are stored, together with
+ * its simple bounds and projection status. The float instantiation halves
+ * the memory traffic and doubles the SIMD width of the passes, at the cost
+ * of precision near degenerate conics.
+ * NOTE: conics and bounds are only meaningful where status is SUCCESS
+ */
+template <typename Scalar>
+class BatchProjectionT {
+ public:
+  /// dual conic entries (row, col) of the upper triangle
+  std::vector<Scalar> c00, c01, c02, c11, c12, c22;
+
+  /// simple bounds of each dual conic, see DualConic::bounds
+  std::vector<Scalar> xmin, ymin, xmax, ymax;
+
+  /// validity of each projection, see QuadricCamera::tryProject
+  std::vector<ProjectionStatus> status;
+
+  /// @name Class methods
+  /// @{
+
+  /** Returns the number of projected quadrics */
+  size_t size() const { return status.size(); }
+
+  /** Resizes every array, keeping their capacity to avoid reallocation */
+  void resize(size_t n) {
+    for (std::vector<Scalar>* v :
+         {&c00, &c01, &c02, &c11, &c12, &c22, &xmin, &ymin, &xmax, &ymax}) {
+      v->resize(n);
+    }
+    status.resize(n);
+  }
+
+  /** Returns the dual conic of quadric i */
+  DualConic conic(size_t i) const {
+    return DualConic((gtsam::Matrix33() << c00[i], c01[i], c02[i], c01[i],
+                      c11[i], c12[i], c02[i], c12[i], c22[i])
+                         .finished());
+  }
+
+  /** Returns the simple bounds of quadric i */
+  AlignedBox2 bounds(size_t i) const {
+    return AlignedBox2(xmin[i], ymin[i], xmax[i], ymax[i]);
+  }
+
+  /// @}
+};
+
+typedef BatchProjectionT<double> BatchProjection;
+typedef BatchProjectionT<float> BatchProjectionf;
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,216 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BoundingBoxBatch.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief evaluates every bounding box factor of a graph in one pass
+ */
+
+#include <gtsam/base/VerticalBlockMatrix.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam_quadrics/geometry/BoundingBoxBatch.h>
+#include <gtsam_quadrics/geometry/BoundingBoxKernel.h>
+
+#include <boost/make_shared.hpp>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+BoundingBoxBatch::BoundingBoxBatch(const gtsam::NonlinearFactorGraph& graph,
+                                   const Backend& backend)
+    : graph_(graph), batched_(graph.size(), -1), backend_(backend) {
+  if (backend_ == CUDA && !BoundingBoxBatch::cudaEnabled()) {
+    throw std::invalid_argument(
+        "BoundingBoxBatch requires GTSAM_QUADRICS_ENABLE_CUDA and a CUDA "
+        "device for the CUDA backend");
+  }
+#ifdef GTSAM_QUADRICS_ENABLE_CUDA
+  if (backend_ == CUDA) {
+    device_.reset(cuda::createBuffers(), [](void* buffers) {
+      cuda::releaseBuffers(static_cast<cuda::Buffers*>(buffers));
+    });
+  }
+#endif
+
+  // the factors whose linearization is exactly the batched one
+  for (size_t g = 0; g < graph_.size(); g++) {
+    const BoundingBoxFactor* factor =
+        dynamic_cast<const BoundingBoxFactor*>(graph_[g].get());
+    if (!factor || factor->measurementModel() != BoundingBoxFactor::STANDARD) {
+      continue;
+    }
+    const gtsam::noiseModel::Gaussian* gaussian =
+        dynamic_cast<const gtsam::noiseModel::Gaussian*>(
+            factor->noiseModel().get());
+    if (!gaussian || gaussian->isConstrained()) {
+      continue;
+    }
+    batched_[g] = factors_.size();
+    factors_.push_back(g);
+  }
+}
+
+/* ************************************************************************* */
+static BoundingBoxBatch::Backend parseBackend(const std::string& backendString) {
+  if (backendString == "HOST") {
+    return BoundingBoxBatch::HOST;
+  } else if (backendString == "CUDA") {
+    return BoundingBoxBatch::CUDA;
+  }
+  throw std::logic_error("The backend \"" + backendString +
+                         "\" is not a valid option for initializing a "
+                         "BoundingBoxBatch");
+}
+
+/* ************************************************************************* */
+BoundingBoxBatch::BoundingBoxBatch(const gtsam::NonlinearFactorGraph& graph,
+                                   const std::string& backendString)
+    : BoundingBoxBatch(graph, parseBackend(backendString)) {}
+
+/* ************************************************************************* */
+bool BoundingBoxBatch::cudaEnabled() {
+#ifdef GTSAM_QUADRICS_ENABLE_CUDA
+  static const bool available = cuda::available();
+  return available;
+#else
+  return false;
+#endif
+}
+
+/* ************************************************************************* */
+BoundingBoxBatch::Backend BoundingBoxBatch::defaultBackend() {
+  return BoundingBoxBatch::cudaEnabled() ? CUDA : HOST;
+}
+
+/* ************************************************************************* */
+const BoundingBoxFactor& BoundingBoxBatch::factor(size_t i) const {
+  return static_cast<const BoundingBoxFactor&>(*graph_[factors_[i]]);
+}
+
+/* ************************************************************************* */
+void BoundingBoxBatch::evaluate(const gtsam::Values& values,
+                                bool computeJacobians) {
+  typedef Eigen::Matrix<double, 3, 3, Eigen::RowMajor> RowMajor33;
+  const size_t n = factors_.size();
+
+  // pack the inputs of every factor
+  inputs_.resize(n * kernels::INPUT_SIZE);
+  for (size_t i = 0; i < n; i++) {
+    const BoundingBoxFactor& factor = this->factor(i);
+    const gtsam::Pose3& pose = values.at<gtsam::Pose3>(factor.poseKey());
+    const ConstrainedDualQuadric& quadric =
+        values.at<ConstrainedDualQuadric>(factor.objectKey());
+    const gtsam::Cal3_S2& K = *factor.calibration();
+
+    double* in = inputs_.data() + i * kernels::INPUT_SIZE;
+    Eigen::Map<RowMajor33>(in + kernels::CAMERA_R) = pose.rotation().matrix();
+    Eigen::Map<gtsam::Vector3>(in + kernels::CAMERA_T) = pose.translation();
+    Eigen::Map<RowMajor33>(in + kernels::QUADRIC_R) =
+        quadric.pose().rotation().matrix();
+    Eigen::Map<gtsam::Vector3>(in + kernels::QUADRIC_T) =
+        quadric.pose().translation();
+    Eigen::Map<gtsam::Vector3>(in + kernels::QUADRIC_RADII) = quadric.radii();
+    in[kernels::CALIBRATION] = K.fx();
+    in[kernels::CALIBRATION + 1] = K.fy();
+    in[kernels::CALIBRATION + 2] = K.skew();
+    in[kernels::CALIBRATION + 3] = K.px();
+    in[kernels::CALIBRATION + 4] = K.py();
+    Eigen::Map<gtsam::Vector4>(in + kernels::MEASURED) =
+        factor.measurement().vector();
+  }
+
+  errors_.resize(n, 4);
+  jacobians_.resize(computeJacobians ? n : 0, kernels::JACOBIAN_SIZE);
+  status_.resize(n);
+  double* jacobians = computeJacobians ? jacobians_.data() : nullptr;
+
+#ifdef GTSAM_QUADRICS_ENABLE_CUDA
+  if (backend_ == CUDA) {
+    cuda::evaluateBoundingBoxes(*static_cast<cuda::Buffers*>(device_.get()),
+                                inputs_.data(), n, errors_.data(), jacobians,
+                                status_.data());
+    return;
+  }
+#endif
+  for (size_t i = 0; i < n; i++) {
+    status_[i] = static_cast<int>(kernels::evaluateBoundingBox(
+        inputs_.data() + i * kernels::INPUT_SIZE, errors_.data() + 4 * i,
+        jacobians ? jacobians + i * kernels::JACOBIAN_SIZE : nullptr));
+  }
+}
+
+/* ************************************************************************* */
+double BoundingBoxBatch::error(const gtsam::Values& values) {
+  this->evaluate(values, false);
+  double total = 0.0;
+  for (size_t g = 0; g < graph_.size(); g++) {
+    if (!graph_[g]) {
+      continue;
+    }
+    if (batched_[g] < 0) {
+      total += graph_[g]->error(values);
+      continue;
+    }
+    const size_t i = batched_[g];
+    const gtsam::SharedNoiseModel& model = this->factor(i).noiseModel();
+    const gtsam::Vector error = errors_.row(i).transpose();
+    total += model->loss(model->squaredMahalanobisDistance(error));
+  }
+  return total;
+}
+
+/* ************************************************************************* */
+gtsam::GaussianFactorGraph::shared_ptr BoundingBoxBatch::linearize(
+    const gtsam::Values& values) {
+  this->evaluate(values, true);
+  gtsam::GaussianFactorGraph::shared_ptr linear =
+      boost::make_shared<gtsam::GaussianFactorGraph>();
+  linear->reserve(graph_.size());
+
+  static const size_t dimensions[] = {6, 9};
+  for (size_t g = 0; g < graph_.size(); g++) {
+    if (!graph_[g]) {
+      linear->push_back(gtsam::GaussianFactor::shared_ptr());
+      continue;
+    }
+    if (batched_[g] < 0) {
+      linear->push_back(graph_[g]->linearize(values));
+      continue;
+    }
+    const size_t i = batched_[g];
+    const BoundingBoxFactor& factor = this->factor(i);
+    const gtsam::noiseModel::Gaussian& gaussian =
+        static_cast<const gtsam::noiseModel::Gaussian&>(*factor.noiseModel());
+    if (status_[i] != static_cast<int>(ProjectionStatus::SUCCESS)) {
+      linear->push_back(factor.linearizeHidden(gaussian));
+      continue;
+    }
+
+    // the blocks [pose, quadric, b] of BoundingBoxFactor::linearize
+    Eigen::Map<const Eigen::Matrix<double, 4, 15, Eigen::RowMajor> > H(
+        jacobians_.data() + i * kernels::JACOBIAN_SIZE);
+    gtsam::VerticalBlockMatrix Ab(dimensions, dimensions + 2, 4, true);
+    Ab(0) = H.leftCols<6>();
+    Ab(1) = H.rightCols<9>();
+    Ab(2) = -errors_.row(i).transpose();
+    gaussian.WhitenInPlace(Ab.full());
+    linear->push_back(
+        boost::make_shared<gtsam::JacobianFactor>(factor.keys(), Ab));
+  }
+  return linear;
+}
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,136 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BoundingBoxBatch.cu
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief the CUDA backend of BoundingBoxBatch
+ */
+
+#include <gtsam_quadrics/geometry/BoundingBoxKernel.h>
+
+#include <cuda_runtime.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace gtsam_quadrics {
+namespace cuda {
+
+/// factors evaluated per launch, bounding the device memory to ~800MB
+static const size_t chunkSize = size_t(1) << 20;
+
+/// threads per block
+static const int blockSize = 128;
+
+/** Throws std::runtime_error if a CUDA call failed */
+static void check(cudaError_t error, const char* call) {
+  if (error != cudaSuccess) {
+    throw std::runtime_error(std::string("BoundingBoxBatch: ") + call +
+                             " failed: " + cudaGetErrorString(error));
+  }
+}
+
+/** Evaluates factor i of the chunk, see kernels::evaluateBoundingBox */
+__global__ void evaluateKernel(const double* inputs, size_t n, double* errors,
+                               double* jacobians, int* status) {
+  const size_t i = size_t(blockIdx.x) * blockDim.x + threadIdx.x;
+  if (i >= n) {
+    return;
+  }
+  status[i] = static_cast<int>(kernels::evaluateBoundingBox(
+      inputs + i * kernels::INPUT_SIZE, errors + 4 * i,
+      jacobians ? jacobians + i * kernels::JACOBIAN_SIZE : nullptr));
+}
+
+struct Buffers {
+  size_t capacity = 0;  ///< factors the buffers hold
+  double* inputs = nullptr;
+  double* errors = nullptr;
+  double* jacobians = nullptr;
+  int* status = nullptr;
+
+  void release() {
+    cudaFree(inputs);
+    cudaFree(errors);
+    cudaFree(jacobians);
+    cudaFree(status);
+    *this = Buffers();
+  }
+
+  void reserve(size_t n) {
+    if (n <= capacity) {
+      return;
+    }
+    this->release();
+    check(cudaMalloc(&inputs, n * kernels::INPUT_SIZE * sizeof(double)),
+          "cudaMalloc");
+    check(cudaMalloc(&errors, n * 4 * sizeof(double)), "cudaMalloc");
+    check(cudaMalloc(&jacobians, n * kernels::JACOBIAN_SIZE * sizeof(double)),
+          "cudaMalloc");
+    check(cudaMalloc(&status, n * sizeof(int)), "cudaMalloc");
+    capacity = n;
+  }
+};
+
+/* ************************************************************************* */
+bool available() {
+  int count = 0;
+  return cudaGetDeviceCount(&count) == cudaSuccess && count > 0;
+}
+
+/* ************************************************************************* */
+Buffers* createBuffers() { return new Buffers(); }
+
+/* ************************************************************************* */
+void releaseBuffers(Buffers* buffers) {
+  buffers->release();
+  delete buffers;
+}
+
+/* ************************************************************************* */
+void evaluateBoundingBoxes(Buffers& buffers, const double* inputs, size_t n,
+                           double* errors, double* jacobians, int* status) {
+  buffers.reserve(std::min(n, chunkSize));
+  for (size_t begin = 0; begin < n; begin += chunkSize) {
+    const size_t m = std::min(chunkSize, n - begin);
+    check(cudaMemcpy(buffers.inputs, inputs + begin * kernels::INPUT_SIZE,
+                     m * kernels::INPUT_SIZE * sizeof(double),
+                     cudaMemcpyHostToDevice),
+          "cudaMemcpy");
+
+    const unsigned int blocks = (m + blockSize - 1) / blockSize;
+    evaluateKernel<<<blocks, blockSize>>>(buffers.inputs, m, buffers.errors,
+                                          jacobians ? buffers.jacobians
+                                                    : nullptr,
+                                          buffers.status);
+    check(cudaGetLastError(), "evaluateKernel");
+
+    check(cudaMemcpy(errors + 4 * begin, buffers.errors,
+                     m * 4 * sizeof(double), cudaMemcpyDeviceToHost),
+          "cudaMemcpy");
+    check(cudaMemcpy(status + begin, buffers.status, m * sizeof(int),
+                     cudaMemcpyDeviceToHost),
+          "cudaMemcpy");
+    if (jacobians) {
+      check(cudaMemcpy(jacobians + begin * kernels::JACOBIAN_SIZE,
+                       buffers.jacobians,
+                       m * kernels::JACOBIAN_SIZE * sizeof(double),
+                       cudaMemcpyDeviceToHost),
+            "cudaMemcpy");
+    }
+  }
+}
+
+}  // namespace cuda
+}  // namespace gtsam_quadrics
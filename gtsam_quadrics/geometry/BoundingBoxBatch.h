@@ -0,0 +1,159 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BoundingBoxBatch.h
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief evaluates every bounding box factor of a graph in one pass
+ */
+
+#pragma once
+
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam_quadrics/base/ProjectionStatus.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class BoundingBoxBatch
+ * Evaluates and linearizes every BoundingBoxFactor of a fixed graph in one
+ * pass, on the host or, when built with the CMake option
+ * GTSAM_QUADRICS_ENABLE_CUDA, in one launch on a CUDA device. For
+ * reprocessing recorded datasets where the same graph is linearized for
+ * every iteration of an optimizer.
+ *
+ * The poses, quadrics, calibrations and boxes of the batched factors are
+ * packed into one array, evaluated by kernels::evaluateBoundingBox with one
+ * thread per factor, and the errors and 4x15 jacobians come back as
+ * row-major arrays in the layout of BoundingBoxFactor::evaluateBatch.
+ * linearize() whitens them into the JacobianFactors
+ * BoundingBoxFactor::linearize would build, and linearizes the other
+ * factors of the graph as usual. Only STANDARD factors with Gaussian noise
+ * are batched: TRUNCATED factors, whose smart bounds branch per factor,
+ * and robust or constrained noise models are linearized by the factor.
+ * NOTE: the device evaluates in double precision, which is much slower
+ * than single precision on most consumer GPUs.
+ */
+class BoundingBoxBatch {
+ public:
+  /// where the batched factors are evaluated
+  enum Backend {
+    HOST,  ///< a loop on the calling thread
+    CUDA   ///< one launch on the first CUDA device
+  };
+
+  typedef BoundingBoxFactor::BatchBoxes BatchBoxes;
+  typedef BoundingBoxFactor::BatchJacobians BatchJacobians;
+
+ protected:
+  gtsam::NonlinearFactorGraph graph_;
+  std::vector<size_t> factors_;  ///< graph index of each batched factor
+  std::vector<int> batched_;     ///< batch index of each graph factor, or -1
+  Backend backend_;
+  std::vector<double> inputs_;  ///< see kernels::BoundingBoxInput
+  BatchBoxes errors_;
+  BatchJacobians jacobians_;
+  std::vector<int> status_;        ///< ProjectionStatus of each factor
+  boost::shared_ptr<void> device_;  ///< cuda::Buffers of the CUDA backend
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /**
+   * Constructor from the graph to evaluate, keeping its factors
+   * @throws std::invalid_argument if the backend is unavailable
+   */
+  explicit BoundingBoxBatch(const gtsam::NonlinearFactorGraph& graph,
+                            const Backend& backend = defaultBackend());
+
+  /** Constructor with the backend "HOST" or "CUDA" */
+  BoundingBoxBatch(const gtsam::NonlinearFactorGraph& graph,
+                   const std::string& backendString);
+
+  BoundingBoxBatch(const BoundingBoxBatch&) = delete;
+  BoundingBoxBatch& operator=(const BoundingBoxBatch&) = delete;
+
+  /// @}
+  /// @name Static methods
+  /// @{
+
+  /** Returns true if built with CUDA and a device is present */
+  static bool cudaEnabled();
+
+  /** Returns CUDA where enabled, otherwise HOST */
+  static Backend defaultBackend();
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the graph */
+  const gtsam::NonlinearFactorGraph& graph() const { return graph_; }
+
+  /** Returns the backend */
+  const Backend& backend() const { return backend_; }
+
+  /** Returns the number of batched factors */
+  size_t size() const { return factors_.size(); }
+
+  /** Returns the graph index of batched factor i */
+  size_t graphIndex(size_t i) const { return factors_.at(i); }
+
+  /** Returns the Nx4 errors of the last evaluation */
+  const BatchBoxes& errors() const { return errors_; }
+
+  /**
+   * Returns the Nx60 jacobians of the last evaluation, each row the 4x15
+   * [H1 H2] in row-major order, or no rows if they were skipped
+   */
+  const BatchJacobians& jacobians() const { return jacobians_; }
+
+  /** Returns the projection status of batched factor i */
+  ProjectionStatus status(size_t i) const {
+    return static_cast<ProjectionStatus>(status_.at(i));
+  }
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /**
+   * Evaluates the unwhitened errors, and optionally jacobians, of every
+   * batched factor as BoundingBoxFactor::evaluateView
+   */
+  void evaluate(const gtsam::Values& values, bool computeJacobians = true);
+
+  /** Returns the error of the graph, as gtsam::NonlinearFactorGraph::error */
+  double error(const gtsam::Values& values);
+
+  /**
+   * Linearizes the graph, as gtsam::NonlinearFactorGraph::linearize
+   * @return one factor per graph factor
+   */
+  gtsam::GaussianFactorGraph::shared_ptr linearize(const gtsam::Values& values);
+
+  /// @}
+
+ protected:
+  /** Returns batched factor i */
+  const BoundingBoxFactor& factor(size_t i) const;
+};
+
+}  // namespace gtsam_quadrics
@@ -16,123 +16,320 @@
  * @brief factor between Pose3 and ConstrainedDualQuadric
  */
 
+#include <gtsam/base/VerticalBlockMatrix.h>
 #include <gtsam/base/numericalDerivative.h>
-#include <gtsam_quadrics/base/QuadricProjectionException.h>
+#include <gtsam/base/serialization.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam_quadrics/base/Statistics.h>
 #include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
 #include <gtsam_quadrics/geometry/QuadricCamera.h>
 
 #include <boost/bind/bind.hpp>
+#include <stdexcept>
 
 #define NUMERICAL_DERIVATIVE false
 
+BOOST_CLASS_EXPORT(gtsam_quadrics::BoundingBoxFactor)
+
 using namespace std;
 
 namespace gtsam_quadrics {
 
+constexpr double BoundingBoxFactor::HIDDEN_ERROR;
+
 /* ************************************************************************* */
 gtsam::Vector BoundingBoxFactor::evaluateError(
     const gtsam::Pose3& pose, const ConstrainedDualQuadric& quadric,
     boost::optional<gtsam::Matrix&> H1,
     boost::optional<gtsam::Matrix&> H2) const {
-  try {
-    // check pose-quadric pair
-    if (quadric.isBehind(pose)) {
-      throw QuadricProjectionException("Quadric is behind camera");
+  if (NUMERICAL_DERIVATIVE) {
+    gtsam::Vector4 error = BoundingBoxFactor::evaluateView(
+        QuadricContext(quadric), pose, measured_, calibration_,
+        *imageBoundary_, measurementModel_);
+    std::function<gtsam::Vector(const gtsam::Pose3&,
+                                const ConstrainedDualQuadric&)>
+        funPtr(boost::bind(&BoundingBoxFactor::evaluateError, this,
+                           boost::placeholders::_1, boost::placeholders::_2,
+                           boost::none, boost::none));
+    if (H1) {
+      Eigen::Matrix<double, 4, 6> db_dx_ =
+          gtsam::numericalDerivative21(funPtr, pose, quadric, 1e-6);
+      *H1 = db_dx_;
     }
-    if (quadric.contains(pose)) {
-      throw QuadricProjectionException("Camera is inside quadric");
+    if (H2) {
+      Eigen::Matrix<double, 4, 9> db_dq_ =
+          gtsam::numericalDerivative22(funPtr, pose, quadric, 1e-6);
+      *H2 = db_dq_;
     }
+    return error;
+  }
 
-    // project quadric taking into account partial derivatives
-    Eigen::Matrix<double, 9, 6> dC_dx;
-    Eigen::Matrix<double, 9, 9> dC_dq;
-    DualConic dualConic;
-    if (!NUMERICAL_DERIVATIVE) {
-      dualConic = QuadricCamera::project(quadric, pose, calibration_,
-                                         H2 ? &dC_dq : 0, H1 ? &dC_dx : 0);
-    } else {
-      dualConic = QuadricCamera::project(quadric, pose, calibration_);
-    }
+  if (!this->inView(pose, quadric)) {
+    return this->evaluateHidden(H1, H2);
+  }
+  return this->evaluateContext(QuadricContext(quadric, bool(H2)), pose, H1,
+                               H2);
+}
 
-    // check dual conic is valid for error function
-    if (!dualConic.isEllipse()) {
-      throw QuadricProjectionException("Projected Conic is non-ellipse");
-    }
+/* ************************************************************************* */
+gtsam::Vector BoundingBoxFactor::evaluateContext(
+    const QuadricContext& context, const gtsam::Pose3& pose,
+    boost::optional<gtsam::Matrix&> H1,
+    boost::optional<gtsam::Matrix&> H2) const {
+  Eigen::Matrix<double, 4, 6> db_dx;
+  Eigen::Matrix<double, 4, 9> db_dq;
+  gtsam::Vector4 error = BoundingBoxFactor::evaluateView(
+      context, pose, measured_, calibration_, *imageBoundary_,
+      measurementModel_, H1 ? &db_dx : 0, H2 ? &db_dq : 0);
+  if (H1) {
+    *H1 = db_dx;
+  }
+  if (H2) {
+    *H2 = db_dq;
+  }
+  return error;
+}
 
-    // calculate conic bounds with derivatives
-    bool computeJacobians = bool(H1 || H2) && !NUMERICAL_DERIVATIVE;
-    Eigen::Matrix<double, 4, 9> db_dC;
-    AlignedBox2 predictedBounds;
-    if (measurementModel_ == STANDARD) {
-      predictedBounds = dualConic.bounds(computeJacobians ? &db_dC : 0);
-    } else if (measurementModel_ == TRUNCATED) {
-      try {
-        predictedBounds =
-            dualConic.smartBounds(calibration_, computeJacobians ? &db_dC : 0);
-      } catch (std::runtime_error& e) {
-        throw QuadricProjectionException("smartbounds failed");
-      }
-    }
+/* ************************************************************************* */
+gtsam::Vector4 BoundingBoxFactor::evaluateView(
+    const QuadricContext& context, const gtsam::Pose3& pose,
+    const AlignedBox2& measured,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const ImageBoundary& imageBoundary,
+    const MeasurementModel& measurementModel, gtsam::OptionalJacobian<4, 6> H1,
+    gtsam::OptionalJacobian<4, 9> H2) {
+  return BoundingBoxFactor::evaluateView(
+      context, CameraView(pose, *calibration), measured, imageBoundary,
+      measurementModel, H1, H2);
+}
 
-    // evaluate error
-    gtsam::Vector4 error = predictedBounds.vector() - measured_.vector();
-
-    if (NUMERICAL_DERIVATIVE) {
-      std::function<gtsam::Vector(const gtsam::Pose3&,
-                                  const ConstrainedDualQuadric&)>
-          funPtr(boost::bind(&BoundingBoxFactor::evaluateError, this,
-                             boost::placeholders::_1, boost::placeholders::_2,
-                             boost::none, boost::none));
-      if (H1) {
-        Eigen::Matrix<double, 4, 6> db_dx_ =
-            gtsam::numericalDerivative21(funPtr, pose, quadric, 1e-6);
-        *H1 = db_dx_;
-      }
-      if (H2) {
-        Eigen::Matrix<double, 4, 9> db_dq_ =
-            gtsam::numericalDerivative22(funPtr, pose, quadric, 1e-6);
-        *H2 = db_dq_;
-      }
-    } else {
-      // calculate derivative of error wrt pose
-      if (H1) {
-        // combine partial derivatives
-        *H1 = db_dC * dC_dx;
-      }
+/* ************************************************************************* */
+gtsam::Vector4 BoundingBoxFactor::evaluateView(
+    const QuadricContext& context, const CameraView& view,
+    const AlignedBox2& measured, const ImageBoundary& imageBoundary,
+    const MeasurementModel& measurementModel, gtsam::OptionalJacobian<4, 6> H1,
+    gtsam::OptionalJacobian<4, 9> H2) {
+  GTSAM_QUADRICS_TIC(BoundingBoxFactor_evaluateView);
+  Statistics::increment(Statistics::EVALUATIONS);
+
+  // project quadric taking into account partial derivatives
+  Eigen::Matrix<double, 9, 6> dC_dx;
+  Eigen::Matrix<double, 9, 9> dC_dq;
+  DualConic dualConic;
+  ProjectionStatus status =
+      QuadricCamera::tryProject(context, view, dualConic, H2 ? &dC_dq : 0,
+                                H1 ? &dC_dx : 0);
 
-      // calculate derivative of error wrt quadric
-      if (H2) {
-        // combine partial derivatives
-        *H2 = db_dC * dC_dq;
+  // calculate conic bounds with derivatives
+  bool computeJacobians = bool(H1 || H2);
+  Eigen::Matrix<double, 4, 9> db_dC;
+  AlignedBox2 predictedBounds;
+  if (status == ProjectionStatus::SUCCESS) {
+    if (measurementModel == STANDARD) {
+      predictedBounds = dualConic.bounds(computeJacobians ? &db_dC : 0);
+    } else if (measurementModel == TRUNCATED) {
+      status = dualConic.trySmartBounds(imageBoundary, predictedBounds,
+                                        computeJacobians ? &db_dC : 0);
+      if (status != ProjectionStatus::SUCCESS) {
+        Statistics::increment(Statistics::SMART_BOUNDS_FAILED);
       }
     }
+  } else if (status == ProjectionStatus::BEHIND_CAMERA) {
+    Statistics::increment(Statistics::BEHIND_CAMERA);
+  } else if (status == ProjectionStatus::CAMERA_INSIDE) {
+    Statistics::increment(Statistics::CAMERA_INSIDE);
+  } else if (status == ProjectionStatus::NON_ELLIPSE) {
+    Statistics::increment(Statistics::NON_ELLIPSE);
+  }
 
-    return error;
+  // evaluate error
+  gtsam::Vector4 error = predictedBounds.vector() - measured.vector();
 
-    // check for nans
-    if (error.array().isInf().any() || error.array().isNaN().any() ||
-        (H1 && (H1->array().isInf().any() || H1->array().isNaN().any())) ||
-        (H2 && (H2->array().isInf().any() || H2->array().isNaN().any()))) {
-      throw std::runtime_error("nan/inf error in bbf");
-    }
+  // calculate derivative of error wrt pose
+  if (status == ProjectionStatus::SUCCESS && H1) {
+    // combine partial derivatives
+    *H1 = db_dC * dC_dx;
+  }
 
-    // handle projection failures
-  } catch (QuadricProjectionException& e) {
-    // std::cout << "  Landmark " << symbolIndex(this->objectKey()) << "
-    // received: " << e.what() << std::endl;
+  // calculate derivative of error wrt quadric
+  if (status == ProjectionStatus::SUCCESS && H2) {
+    // combine partial derivatives
+    *H2 = db_dC * dC_dq;
+  }
+
+  // check for nans, which are handled as a failed projection
+  if (status == ProjectionStatus::SUCCESS &&
+      (!error.allFinite() || (H1 && !H1->allFinite()) ||
+       (H2 && !H2->allFinite()))) {
+    Statistics::increment(Statistics::NON_FINITE);
+    status = ProjectionStatus::NON_ELLIPSE;
+  }
 
+  // handle projection failures
+  if (status != ProjectionStatus::SUCCESS) {
     // if error cannot be calculated
     // set error vector and jacobians to zero
-    gtsam::Vector4 error = gtsam::Vector4::Ones() * 1000.0;
     if (H1) {
-      *H1 = gtsam::Matrix::Zero(4, 6);
+      H1->setZero();
     }
     if (H2) {
-      *H2 = gtsam::Matrix::Zero(4, 9);
+      H2->setZero();
     }
+    return gtsam::Vector4::Constant(HIDDEN_ERROR);
+  }
 
-    return error;
+  return error;
+}
+
+/* ************************************************************************* */
+void BoundingBoxFactor::evaluateBatch(
+    const Eigen::Ref<const BatchPoses>& poses,
+    const Eigen::Ref<const BatchQuadrics>& quadrics,
+    const Eigen::Ref<const BatchBoxes>& measured,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const ImageBoundary& imageBoundary,
+    const MeasurementModel& measurementModel, Eigen::Ref<BatchBoxes> errors,
+    Eigen::Ref<BatchJacobians> jacobians) {
+  const Eigen::Index n = poses.rows();
+  const bool computeJacobians = jacobians.rows() > 0;
+  if (quadrics.rows() != n || measured.rows() != n || errors.rows() != n ||
+      (computeJacobians && jacobians.rows() != n)) {
+    throw std::invalid_argument(
+        "BoundingBoxFactor::evaluateBatch requires one row per factor");
+  }
+
+  Eigen::Matrix<double, 4, 6> db_dx;
+  Eigen::Matrix<double, 4, 9> db_dq;
+  for (Eigen::Index i = 0; i < n; i++) {
+    const Eigen::Map<const Eigen::Matrix<double, 3, 4, Eigen::RowMajor>> T(
+        poses.row(i).data());
+    const gtsam::Pose3 pose(gtsam::Rot3(gtsam::Matrix3(T.leftCols<3>())),
+                            gtsam::Point3(T.col(3)));
+    const ConstrainedDualQuadric quadric = ConstrainedDualQuadric::Retract(
+        gtsam::Vector9(quadrics.row(i).transpose()));
+    const AlignedBox2 box(gtsam::Vector4(measured.row(i).transpose()));
+
+    gtsam::Vector4 error = BoundingBoxFactor::evaluateView(
+        QuadricContext(quadric, computeJacobians), pose, box, calibration,
+        imageBoundary, measurementModel, computeJacobians ? &db_dx : 0,
+        computeJacobians ? &db_dq : 0);
+    errors.row(i) = error.transpose();
+    if (computeJacobians) {
+      Eigen::Map<Eigen::Matrix<double, 4, 15, Eigen::RowMajor>> H(
+          jacobians.row(i).data());
+      H << db_dx, db_dq;
+    }
+  }
+}
+
+/* ************************************************************************* */
+bool BoundingBoxFactor::inView(const gtsam::Pose3& pose,
+                               const ConstrainedDualQuadric& quadric) const {
+  if (!gated_) {
+    return true;
+  }
+  // undecided views are projected by evaluateView, which handles failures
+  QuadricCamera::Visibility visibility = QuadricCamera::checkVisible(
+      quadric, pose, calibration_,
+      measurementModel_ == TRUNCATED ? imageBoundary_.get() : 0);
+  if (visibility == QuadricCamera::HIDDEN) {
+    Statistics::increment(Statistics::INACTIVE);
+    return false;
+  }
+  return true;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<gtsam::GaussianFactor> BoundingBoxFactor::linearize(
+    const gtsam::Values& values) const {
+  GTSAM_QUADRICS_TIC(BoundingBoxFactor_linearize);
+  // cast the raw pointer, copying the shared noise model would contend on
+  // its reference count when linearizing in parallel
+  const gtsam::noiseModel::Gaussian* gaussian =
+      dynamic_cast<const gtsam::noiseModel::Gaussian*>(noiseModel().get());
+  if (NUMERICAL_DERIVATIVE || !gaussian || gaussian->isConstrained()) {
+    return Base::linearize(values);
   }
+
+  const gtsam::Pose3& pose = values.at<gtsam::Pose3>(this->poseKey());
+  const ConstrainedDualQuadric& quadric =
+      values.at<ConstrainedDualQuadric>(this->objectKey());
+  if (!this->inView(pose, quadric)) {
+    return this->linearizeHidden(*gaussian);
+  }
+  return this->linearizeContext(QuadricContext(quadric, true), pose,
+                                *gaussian);
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<gtsam::GaussianFactor> BoundingBoxFactor::linearizeContext(
+    const QuadricContext& context, const gtsam::Pose3& pose,
+    const gtsam::noiseModel::Gaussian& gaussian) const {
+  // evaluate directly into fixed-size blocks [pose, quadric, b]
+  Eigen::Matrix<double, 4, 6> db_dx;
+  Eigen::Matrix<double, 4, 9> db_dq;
+  gtsam::Vector4 error = BoundingBoxFactor::evaluateView(
+      context, pose, measured_, calibration_, *imageBoundary_,
+      measurementModel_, db_dx, db_dq);
+
+  // a failed projection only carries its constant error
+  if (db_dx.isZero(0.0) && db_dq.isZero(0.0)) {
+    return this->linearizeHidden(gaussian);
+  }
+
+  static const size_t dimensions[] = {6, 9};
+  gtsam::VerticalBlockMatrix Ab(dimensions, dimensions + 2, 4, true);
+  Ab(0) = db_dx;
+  Ab(1) = db_dq;
+  Ab(2) = -error;
+  gaussian.WhitenInPlace(Ab.full());
+
+  return boost::make_shared<gtsam::JacobianFactor>(this->keys(), Ab);
+}
+
+/* ************************************************************************* */
+gtsam::Vector BoundingBoxFactor::evaluateHidden(
+    boost::optional<gtsam::Matrix&> H1,
+    boost::optional<gtsam::Matrix&> H2) const {
+  if (H1) {
+    *H1 = gtsam::Matrix::Zero(4, 6);
+  }
+  if (H2) {
+    *H2 = gtsam::Matrix::Zero(4, 9);
+  }
+  return gtsam::Vector4::Constant(HIDDEN_ERROR);
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<gtsam::GaussianFactor> BoundingBoxFactor::linearizeHidden(
+    const gtsam::noiseModel::Gaussian& gaussian) const {
+  // the jacobians are zero, so the constant error is carried by the quadric
+  // alone and elimination never couples the pose to it
+  static const size_t dimensions[] = {9};
+  gtsam::VerticalBlockMatrix Ab(dimensions, dimensions + 1, 4, true);
+  Ab.full().setZero();
+  Ab(1).setConstant(-HIDDEN_ERROR);
+  gaussian.WhitenInPlace(Ab.full());
+
+  return boost::make_shared<gtsam::JacobianFactor>(
+      gtsam::KeyVector{this->objectKey()}, Ab);
+}
+
+/* ************************************************************************* */
+std::pair<gtsam::Matrix, gtsam::Matrix> BoundingBoxFactor::evaluateH1H2(
+    const gtsam::Pose3& pose, const ConstrainedDualQuadric& quadric) const {
+  gtsam::Matrix H1, H2;
+  this->evaluateError(pose, quadric, H1, H2);
+  return std::make_pair(H1, H2);
+}
+
+/* ************************************************************************* */
+std::pair<gtsam::Matrix, gtsam::Matrix> BoundingBoxFactor::evaluateH1H2(
+    const gtsam::Values& x) const {
+  const gtsam::Pose3 pose = x.at<gtsam::Pose3>(this->poseKey());
+  const ConstrainedDualQuadric quadric =
+      x.at<ConstrainedDualQuadric>(this->objectKey());
+  return this->evaluateH1H2(pose, quadric);
 }
 
 /* ************************************************************************* */
@@ -173,6 +370,7 @@ void BoundingBoxFactor::print(const std::string& s,
   cout << s << "BoundingBoxFactor(" << keyFormatter(key1()) << ","
        << keyFormatter(key2()) << ")" << endl;
   measured_.print("    Measured: ");
+  imageBoundary_->print("    ImageBoundary: ");
   cout << "    NoiseModel: ";
   noiseModel()->print();
   cout << endl;
@@ -183,8 +381,10 @@ bool BoundingBoxFactor::equals(const BoundingBoxFactor& other,
                                double tol) const {
   bool equal = measured_.equals(other.measured_, tol) &&
                calibration_->equals(*other.calibration_, tol) &&
+               imageBoundary_->equals(*other.imageBoundary_, tol) &&
                noiseModel()->equals(*other.noiseModel(), tol) &&
-               key1() == other.key1() && key2() == other.key2();
+               key1() == other.key1() && key2() == other.key2() &&
+               gated_ == other.gated_;
   return equal;
 }
 
@@ -25,6 +25,13 @@
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 #include <gtsam_quadrics/geometry/AlignedBox2.h>
 #include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricContext.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+#include <utility>
 
 namespace gtsam_quadrics {
 
@@ -34,6 +41,13 @@ namespace gtsam_quadrics {
  * Projects the quadric at the current pose estimates,
  * Calculates the bounds of the dual conic,
  * and compares this to the measured bounding box.
+ * Evaluating and linearizing are thread-safe and share no mutable state,
+ * the calibration, image boundary and noise model are only read through
+ * references, so factors sharing them can be linearized in parallel.
+ * Where the quadric cannot be projected the error is constant and the
+ * jacobians are zero, and the factor linearizes on the quadric key only.
+ * Gated factors detect this with a cheap visibility test first, see
+ * setGated, and skip projecting the quadric there.
  */
 class BoundingBoxFactor
     : public gtsam::NoiseModelFactor2<gtsam::Pose3, ConstrainedDualQuadric> {
@@ -43,12 +57,26 @@ class BoundingBoxFactor
     TRUNCATED
   };  ///< enum to declare which error function to use
 
+  /// row-major batch storage, one row per factor, matches NumPy C order
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 12, Eigen::RowMajor>
+      BatchPoses;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 9, Eigen::RowMajor>
+      BatchQuadrics;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 4, Eigen::RowMajor> BatchBoxes;
+  typedef Eigen::Matrix<double, Eigen::Dynamic, 60, Eigen::RowMajor>
+      BatchJacobians;
+
+  /// the error of each side where the quadric cannot be projected
+  static constexpr double HIDDEN_ERROR = 1000.0;
+
  protected:
-  AlignedBox2 measured_;                           ///< measured bounding box
-  boost::shared_ptr<gtsam::Cal3_S2> calibration_;  ///< camera calibration
+  AlignedBox2 measured_;                            ///< measured bounding box
+  boost::shared_ptr<gtsam::Cal3_S2> calibration_;   ///< camera calibration
+  boost::shared_ptr<ImageBoundary> imageBoundary_;  ///< image area
   typedef NoiseModelFactor2<gtsam::Pose3, ConstrainedDualQuadric>
       Base;  ///< base class has keys and noisemodel as private members
   MeasurementModel measurementModel_;
+  bool gated_ = false;  ///< skips hidden quadrics, see setGated
 
  public:
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -58,30 +86,62 @@ class BoundingBoxFactor
 
   /** Default constructor */
   BoundingBoxFactor()
-      : measured_(0., 0., 0., 0.), measurementModel_(STANDARD){};
+      : measured_(0., 0., 0., 0.),
+        imageBoundary_(new ImageBoundary()),
+        measurementModel_(STANDARD){};
+
+  /** Constructor from measured box, calbration, dimensions and posekey,
+   * quadrickey, noisemodel. Assumes a 640x480 image. */
+  BoundingBoxFactor(const AlignedBox2& measured,
+                    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                    const gtsam::Key& poseKey, const gtsam::Key& quadricKey,
+                    const gtsam::SharedNoiseModel& model,
+                    const MeasurementModel& errorType = STANDARD)
+      : BoundingBoxFactor(measured, calibration,
+                          boost::make_shared<ImageBoundary>(), poseKey,
+                          quadricKey, model, errorType){};
 
   /** Constructor from measured box, calbration, dimensions and posekey,
-   * quadrickey, noisemodel */
+   * quadrickey, noisemodel. Assumes a 640x480 image. */
+  BoundingBoxFactor(const AlignedBox2& measured,
+                    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                    const gtsam::Key& poseKey, const gtsam::Key& quadricKey,
+                    const gtsam::SharedNoiseModel& model,
+                    const std::string& errorString)
+      : BoundingBoxFactor(measured, calibration,
+                          boost::make_shared<ImageBoundary>(), poseKey,
+                          quadricKey, model, errorString){};
+
+  /**
+   * Constructor from measured box, calibration, image area and posekey,
+   * quadrickey, noisemodel
+   * @param imageBoundary the image area used by TRUNCATED, share one
+   * instance between all factors of the same camera
+   */
   BoundingBoxFactor(const AlignedBox2& measured,
                     const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                    const boost::shared_ptr<ImageBoundary>& imageBoundary,
                     const gtsam::Key& poseKey, const gtsam::Key& quadricKey,
                     const gtsam::SharedNoiseModel& model,
                     const MeasurementModel& errorType = STANDARD)
       : Base(model, poseKey, quadricKey),
         measured_(measured),
         calibration_(calibration),
+        imageBoundary_(imageBoundary),
         measurementModel_(errorType){};
 
-  /** Constructor from measured box, calbration, dimensions and posekey,
-   * quadrickey, noisemodel */
+  /** Constructor from measured box, calibration, image area and posekey,
+   * quadrickey, noisemodel, with error type "STANDARD"/"TRUNCATED" */
   BoundingBoxFactor(const AlignedBox2& measured,
                     const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                    const boost::shared_ptr<ImageBoundary>& imageBoundary,
                     const gtsam::Key& poseKey, const gtsam::Key& quadricKey,
                     const gtsam::SharedNoiseModel& model,
                     const std::string& errorString)
       : Base(model, poseKey, quadricKey),
         measured_(measured),
-        calibration_(calibration) {
+        calibration_(calibration),
+        imageBoundary_(imageBoundary) {
     if (errorString == "STANDARD") {
       measurementModel_ = STANDARD;
     } else if (errorString == "TRUNCATED") {
@@ -106,6 +166,30 @@ class BoundingBoxFactor
   /** Returns the object/landmark key */
   gtsam::Key objectKey() const { return key2(); }
 
+  /** Returns the camera calibration */
+  const boost::shared_ptr<gtsam::Cal3_S2>& calibration() const {
+    return calibration_;
+  }
+
+  /** Returns the error function */
+  MeasurementModel measurementModel() const { return measurementModel_; }
+
+  /** Returns the image area used to truncate the bounds */
+  const boost::shared_ptr<ImageBoundary>& imageBoundary() const {
+    return imageBoundary_;
+  }
+
+  /** Returns true if the factor tests visibility before projecting */
+  bool gated() const { return gated_; }
+
+  /**
+   * Tests visibility before projecting the quadric, see inView. Where the
+   * quadric is hidden the factor keeps the constant error of a failed
+   * projection, so moving a landmark out of view never lowers the cost,
+   * but skips projecting it and computing the zero jacobians.
+   */
+  void setGated(bool gated) { gated_ = gated; }
+
   /// @}
   /// @name Class methods
   /// @{
@@ -122,6 +206,109 @@ class BoundingBoxFactor
       boost::optional<gtsam::Matrix&> H1 = boost::none,
       boost::optional<gtsam::Matrix&> H2 = boost::none) const;
 
+  /**
+   * Evaluate the error of a single view with fixed-size jacobians,
+   * taking the quadric terms from a shared context.
+   * If the quadric cannot be projected into the view the error is set to
+   * HIDDEN_ERROR and the jacobians to zero.
+   * @param context the memoized quadric (with jacobian if H2 is requested)
+   * @param pose the 6DOF camera position
+   * @param measured the measured bounding box
+   * @param calibration the camera calibration
+   * @param imageBoundary the image area used by TRUNCATED
+   * @param measurementModel the error function to use
+   * @param H1 the derivative of the error wrt camera pose (4x6)
+   * @param H2 the derivative of the error wrt quadric (4x9)
+   */
+  static gtsam::Vector4 evaluateView(
+      const QuadricContext& context, const gtsam::Pose3& pose,
+      const AlignedBox2& measured,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      const ImageBoundary& imageBoundary,
+      const MeasurementModel& measurementModel,
+      gtsam::OptionalJacobian<4, 6> H1 = boost::none,
+      gtsam::OptionalJacobian<4, 9> H2 = boost::none);
+
+  /**
+   * Evaluate the error of a single view as above, from a camera view that
+   * is computed once and shared, e.g. by every detection of one camera
+   * @param H1 the derivative of the error wrt the camera pose (4x6)
+   */
+  static gtsam::Vector4 evaluateView(
+      const QuadricContext& context, const CameraView& view,
+      const AlignedBox2& measured, const ImageBoundary& imageBoundary,
+      const MeasurementModel& measurementModel,
+      gtsam::OptionalJacobian<4, 6> H1 = boost::none,
+      gtsam::OptionalJacobian<4, 9> H2 = boost::none);
+
+  /**
+   * Evaluates many pose, quadric and measurement triplets in one call, as
+   * evaluateView. Arrays hold one row per triplet and can map NumPy buffers
+   * without copying.
+   * @param poses the top 3x4 rows [R t] of N pose matrices, each row-major
+   * in one row; an outer stride of 16 maps Nx4x4 matrices without copying
+   * @param quadrics Nx9 quadric tangent vectors, see
+   * ConstrainedDualQuadric::Retract
+   * @param measured Nx4 measured boxes (xmin,ymin,xmax,ymax)
+   * @param errors Nx4 output errors
+   * @param jacobians Nx60 output, each row the 4x15 [H1 H2] in row-major
+   * order, or no rows to skip the jacobians
+   */
+  static void evaluateBatch(
+      const Eigen::Ref<const BatchPoses>& poses,
+      const Eigen::Ref<const BatchQuadrics>& quadrics,
+      const Eigen::Ref<const BatchBoxes>& measured,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      const ImageBoundary& imageBoundary,
+      const MeasurementModel& measurementModel, Eigen::Ref<BatchBoxes> errors,
+      Eigen::Ref<BatchJacobians> jacobians);
+
+  /** Returns a deep copy of the factor, as used by rekey */
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new BoundingBoxFactor(*this)));
+  }
+
+  /**
+   * Returns false for a gated factor where the cheap, conservative
+   * QuadricCamera::checkVisible shows the quadric cannot be projected, or
+   * for TRUNCATED lies outside the image, so the error is the constant of a
+   * failed projection. Always true if the factor is not gated, or when the
+   * test is undecided, which is resolved by projecting once in evaluateView.
+   */
+  bool inView(const gtsam::Pose3& pose,
+              const ConstrainedDualQuadric& quadric) const;
+
+  /**
+   * Linearizes the factor into a JacobianFactor with fixed-size blocks.
+   * Gaussian noise models are whitened in place in a single pass,
+   * robust and constrained noise models fall back to NoiseModelFactor.
+   * Where the quadric is hidden or cannot be projected, see
+   * linearizeHidden.
+   */
+  boost::shared_ptr<gtsam::GaussianFactor> linearize(
+      const gtsam::Values& values) const override;
+
+  /**
+   * Linearizes the constant error of a hidden quadric or failed projection
+   * with a gaussian noise model, as a JacobianFactor on the quadric key
+   * only with a zero 4x9 block, so the pose is not coupled to the quadric
+   */
+  boost::shared_ptr<gtsam::GaussianFactor> linearizeHidden(
+      const gtsam::noiseModel::Gaussian& gaussian) const;
+
+  /**
+   * Evaluates the derivatives of the error wrt pose and quadric
+   * from a single projection
+   * @return the pair [H1, H2] (4x6, 4x9)
+   */
+  std::pair<gtsam::Matrix, gtsam::Matrix> evaluateH1H2(
+      const gtsam::Pose3& pose, const ConstrainedDualQuadric& quadric) const;
+
+  /** Evaluates the derivatives of the error wrt pose and quadric */
+  std::pair<gtsam::Matrix, gtsam::Matrix> evaluateH1H2(
+      const gtsam::Values& x) const;
+
   /** Evaluates the derivative of the error wrt pose */
   gtsam::Matrix evaluateH1(const gtsam::Pose3& pose,
                            const ConstrainedDualQuadric& quadric) const;
@@ -145,12 +332,58 @@ class BoundingBoxFactor
              const gtsam::KeyFormatter& keyFormatter =
                  gtsam::DefaultKeyFormatter) const override;
 
-  /** Returns true if equal keys, measurement, noisemodel and calibration */
+  /**
+   * Returns true if equal keys, measurement, noisemodel, calibration
+   * and image area
+   */
   bool equals(const BoundingBoxFactor& other, double tol = 1e-9) const;
+
+  /// @}
+
+ protected:
+  /** Evaluates the error from the quadric terms of a context, see
+   * evaluateError */
+  gtsam::Vector evaluateContext(const QuadricContext& context,
+                                const gtsam::Pose3& pose,
+                                boost::optional<gtsam::Matrix&> H1,
+                                boost::optional<gtsam::Matrix&> H2) const;
+
+  /** Linearizes from the quadric terms of a context with a gaussian noise
+   * model, see linearize */
+  boost::shared_ptr<gtsam::GaussianFactor> linearizeContext(
+      const QuadricContext& context, const gtsam::Pose3& pose,
+      const gtsam::noiseModel::Gaussian& gaussian) const;
+
+  /** Returns the constant error and zero jacobians of a hidden quadric */
+  gtsam::Vector evaluateHidden(boost::optional<gtsam::Matrix&> H1,
+                               boost::optional<gtsam::Matrix&> H2) const;
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int version) {
+    ar& boost::serialization::make_nvp(
+        "NoiseModelFactor2", boost::serialization::base_object<Base>(*this));
+    ar& BOOST_SERIALIZATION_NVP(measured_);
+    ar& BOOST_SERIALIZATION_NVP(calibration_);
+    ar& BOOST_SERIALIZATION_NVP(imageBoundary_);
+    ar& BOOST_SERIALIZATION_NVP(measurementModel_);
+    if (version > 0) {
+      ar& BOOST_SERIALIZATION_NVP(gated_);
+    }
+  }
+
+  /// @}
 };
 
 }  // namespace gtsam_quadrics
 
+BOOST_CLASS_VERSION(gtsam_quadrics::BoundingBoxFactor, 1)
+
 /** \cond PRIVATE */
 // Add to testable group
 template <>
@@ -0,0 +1,156 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BoundingBoxKernel.h
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief the STANDARD bounding box error and jacobians on packed arrays
+ */
+
+/**
+ * BoundingBoxFactor::evaluateView for STANDARD factors on packed arrays of
+ * doubles, so the same code compiles for the host and for CUDA devices. It
+ * is what BoundingBoxBatch runs on either backend. Every step is one of the
+ * QuadricKernels.h templates the classes compute with, so the errors and
+ * jacobians are those of BoundingBoxFactor.
+ */
+
+#pragma once
+
+#include <gtsam_quadrics/base/ProjectionStatus.h>
+#include <gtsam_quadrics/geometry/QuadricKernels.h>
+
+#include <Eigen/Core>
+
+#include <cstddef>
+
+namespace gtsam_quadrics {
+namespace kernels {
+
+/// offsets into the packed input of one factor, matrices are row-major
+enum BoundingBoxInput {
+  CAMERA_R = 0,      ///< camera rotation, world_R_camera
+  CAMERA_T = 9,      ///< camera translation
+  QUADRIC_R = 12,    ///< quadric rotation
+  QUADRIC_T = 21,    ///< quadric translation
+  QUADRIC_RADII = 24,  ///< quadric radii
+  CALIBRATION = 27,  ///< fx, fy, s, u0, v0
+  MEASURED = 32,     ///< xmin, ymin, xmax, ymax
+  INPUT_SIZE = 36
+};
+
+/// the size of the 4x15 row-major jacobian [H1 H2] of one factor
+const size_t JACOBIAN_SIZE = 60;
+
+/// the error of a failed projection, see BoundingBoxFactor::HIDDEN_ERROR
+const double HIDDEN_ERROR = 1000.0;
+
+/**
+ * Evaluates one STANDARD bounding box factor, see
+ * BoundingBoxFactor::evaluateView
+ * @param in the packed input, see BoundingBoxInput
+ * @param error the 4 unwhitened errors, HIDDEN_ERROR where the projection
+ * fails
+ * @param H the 4x15 row-major jacobian [d/dpose d/dquadric], zero where
+ * the projection fails, or null to skip the jacobians
+ * @return the projection status, see QuadricCamera::tryProject
+ */
+EIGEN_DEVICE_FUNC inline ProjectionStatus evaluateBoundingBox(
+    const double* in, double* error, double* H) {
+  typedef Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor> >
+      RotationMap;
+  typedef Eigen::Map<const Eigen::Vector3d> Vector3Map;
+  const Matrix3T<double> Rx = RotationMap(in + CAMERA_R);
+  const Vector3T<double> tx = Vector3Map(in + CAMERA_T);
+  const Matrix3T<double> Rq = RotationMap(in + QUADRIC_R);
+  const Vector3T<double> tq = Vector3Map(in + QUADRIC_T);
+  const Vector3T<double> radii = Vector3Map(in + QUADRIC_RADII);
+  const double* k = in + CALIBRATION;
+  const Matrix3T<double> K = calibrationMatrix<double>(k[0], k[1], k[2],
+                                                       k[3], k[4]);
+
+  // check the pose-quadric pair, see QuadricCamera::tryProject
+  ProjectionStatus status = ProjectionStatus::SUCCESS;
+  if (isBehind<double>(Rx, tx, tq)) {
+    status = ProjectionStatus::BEHIND_CAMERA;
+  } else if (contains<double>(Rq, tq, radii, tx)) {
+    status = ProjectionStatus::CAMERA_INSIDE;
+  }
+
+  const Matrix4T<double> Xi = inversePose<double>(Rx, tx);
+  const Matrix34T<double> P = K * Xi.topRows<3>();
+  const Matrix4T<double> Q = quadricMatrix<double>(Rq, tq, radii);
+  const Matrix3T<double> C = projectQuadric<double>(P, Q);
+  if (status == ProjectionStatus::SUCCESS && !isEllipse<double>(C)) {
+    status = ProjectionStatus::NON_ELLIPSE;
+  }
+
+  Eigen::Map<Eigen::Vector4d> e(error);
+  e = conicBounds<double>(C) -
+      Eigen::Map<const Eigen::Vector4d>(in + MEASURED);
+
+  // nans are handled as a failed projection
+  if (!e.allFinite()) {
+    status = ProjectionStatus::NON_ELLIPSE;
+  }
+  if (H && status == ProjectionStatus::SUCCESS) {
+    Eigen::Map<Eigen::Matrix<double, 4, 15, Eigen::RowMajor> > J(H);
+    const Eigen::Matrix<double, 4, 9> db_dC = conicBoundsJacobian<double>(C);
+    J.leftCols<6>() = db_dC * projectPoseJacobian<double>(K, Xi, Q, P);
+    J.rightCols<9>() =
+        db_dC * projectQuadricJacobian<double>(
+                    P, quadricJacobian<double>(Rq, tq, radii));
+    if (!J.allFinite()) {
+      status = ProjectionStatus::NON_ELLIPSE;
+    }
+  }
+
+  if (status != ProjectionStatus::SUCCESS) {
+    e.setConstant(HIDDEN_ERROR);
+    for (size_t i = 0; H && i < JACOBIAN_SIZE; i++) {
+      H[i] = 0.0;
+    }
+  }
+  return status;
+}
+
+}  // namespace kernels
+
+#ifdef GTSAM_QUADRICS_ENABLE_CUDA
+/// the CUDA backend of BoundingBoxBatch, see BoundingBoxBatch.cu
+namespace cuda {
+
+/** Returns true if a CUDA device is present */
+bool available();
+
+/** Device buffers reused between evaluations, grown as needed */
+struct Buffers;
+
+/** Allocates empty device buffers, freed with releaseBuffers */
+Buffers* createBuffers();
+
+/** Frees device buffers */
+void releaseBuffers(Buffers* buffers);
+
+/**
+ * Evaluates n packed factors with evaluateBoundingBox, one device thread
+ * per factor, in chunks that bound the device memory
+ * @param jacobians n x 60 output, or null to skip the jacobians
+ * @throws std::runtime_error on a CUDA error
+ */
+void evaluateBoundingBoxes(Buffers& buffers, const double* inputs, size_t n,
+                           double* errors, double* jacobians, int* status);
+
+}  // namespace cuda
+#endif
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,270 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BoxAssociation.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief associates measured boxes with projected landmark bounds
+ */
+
+#include <gtsam_quadrics/geometry/BoxAssociation.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+namespace {
+
+/// a candidate pair for the greedy solver
+struct Candidate {
+  double iou;
+  int measurement;
+  int landmark;
+  bool operator<(const Candidate& other) const {
+    if (iou != other.iou) return iou > other.iou;
+    if (measurement != other.measurement) {
+      return measurement < other.measurement;
+    }
+    return landmark < other.landmark;
+  }
+};
+
+/**
+ * Minimum cost assignment of a square cost matrix, returns the column
+ * assigned to each row. The O(n^3) Hungarian method with potentials.
+ */
+std::vector<int> hungarian(const gtsam::Matrix& cost) {
+  const int n = cost.rows();
+  const double inf = std::numeric_limits<double>::infinity();
+
+  // 1-indexed potentials, column 0 holds the row being inserted
+  std::vector<double> u(n + 1, 0.0), v(n + 1, 0.0), minv(n + 1);
+  std::vector<int> p(n + 1, 0), way(n + 1, 0);
+  std::vector<char> used(n + 1);
+  for (int i = 1; i <= n; i++) {
+    p[0] = i;
+    int j0 = 0;
+    std::fill(minv.begin(), minv.end(), inf);
+    std::fill(used.begin(), used.end(), false);
+    do {
+      used[j0] = true;
+      int i0 = p[j0], j1 = 0;
+      double delta = inf;
+      for (int j = 1; j <= n; j++) {
+        if (!used[j]) {
+          double cur = cost(i0 - 1, j - 1) - u[i0] - v[j];
+          if (cur < minv[j]) {
+            minv[j] = cur;
+            way[j] = j0;
+          }
+          if (minv[j] < delta) {
+            delta = minv[j];
+            j1 = j;
+          }
+        }
+      }
+      for (int j = 0; j <= n; j++) {
+        if (used[j]) {
+          u[p[j]] += delta;
+          v[j] -= delta;
+        } else {
+          minv[j] -= delta;
+        }
+      }
+      j0 = j1;
+    } while (p[j0] != 0);
+
+    // augment along the alternating path
+    do {
+      int j1 = way[j0];
+      p[j0] = p[j1];
+      j0 = j1;
+    } while (j0);
+  }
+
+  std::vector<int> assignment(n);
+  for (int j = 1; j <= n; j++) {
+    assignment[p[j] - 1] = j - 1;
+  }
+  return assignment;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+BoxAssociation BoxAssociation::associate(const BatchProjection& projections,
+                                         const AlignedBox2Vector& measured,
+                                         const double& minIoU,
+                                         const Solver& solver) {
+  return solve(iouMatrix(projections, measured), minIoU, solver);
+}
+
+/* ************************************************************************* */
+BoxAssociation BoxAssociation::associate(const gtsam::Matrix& predicted,
+                                         const gtsam::Matrix& measured,
+                                         const double& minIoU,
+                                         const Solver& solver) {
+  return solve(iouMatrix(predicted, measured), minIoU, solver);
+}
+
+/* ************************************************************************* */
+BoxAssociation BoxAssociation::associate(const gtsam::Matrix& predicted,
+                                         const gtsam::Matrix& measured,
+                                         const double& minIoU,
+                                         const std::string& solver) {
+  if (solver == "HUNGARIAN") {
+    return associate(predicted, measured, minIoU, HUNGARIAN);
+  } else if (solver == "GREEDY") {
+    return associate(predicted, measured, minIoU, GREEDY);
+  }
+  throw std::logic_error("The solver \"" + solver +
+                         "\" is not a valid option for BoxAssociation");
+}
+
+/* ************************************************************************* */
+BoxAssociation BoxAssociation::solve(const gtsam::Matrix& iou,
+                                     const double& minIoU,
+                                     const Solver& solver) {
+  const int M = iou.rows();
+  const int N = iou.cols();
+  BoxAssociation association;
+  association.landmarks_.assign(M, -1);
+  association.ious_.assign(M, 0.0);
+
+  // overlapping pairs above the threshold are candidates
+  auto gated = [&](int i, int j) {
+    return iou(i, j) > 0.0 && iou(i, j) >= minIoU;
+  };
+
+  if (solver == GREEDY) {
+    std::vector<Candidate> candidates;
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++) {
+        if (gated(i, j)) {
+          candidates.push_back(Candidate{iou(i, j), i, j});
+        }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    std::vector<char> taken(N, false);
+    for (const Candidate& candidate : candidates) {
+      if (association.landmarks_[candidate.measurement] < 0 &&
+          !taken[candidate.landmark]) {
+        association.landmarks_[candidate.measurement] = candidate.landmark;
+        association.ious_[candidate.measurement] = candidate.iou;
+        taken[candidate.landmark] = true;
+      }
+    }
+    return association;
+  }
+
+  // pad to square, any gated pair is cheaper than leaving both unmatched
+  // so minimizing cost maximizes the total IoU of the gated pairs
+  const int n = std::max(M, N);
+  if (n == 0) {
+    return association;
+  }
+  gtsam::Matrix cost = gtsam::Matrix::Ones(n, n);
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < N; j++) {
+      if (gated(i, j)) {
+        cost(i, j) = 1.0 - iou(i, j);
+      }
+    }
+  }
+
+  std::vector<int> assignment = hungarian(cost);
+  for (int i = 0; i < M; i++) {
+    int j = assignment[i];
+    if (j < N && gated(i, j)) {
+      association.landmarks_[i] = j;
+      association.ious_[i] = iou(i, j);
+    }
+  }
+  return association;
+}
+
+/* ************************************************************************* */
+gtsam::Matrix BoxAssociation::iouMatrix(const BatchProjection& projections,
+                                        const AlignedBox2Vector& measured) {
+  const size_t N = projections.size();
+  gtsam::Matrix predicted(N, 4);
+  predicted.col(0) = gtsam::Vector::Map(projections.xmin.data(), N);
+  predicted.col(1) = gtsam::Vector::Map(projections.ymin.data(), N);
+  predicted.col(2) = gtsam::Vector::Map(projections.xmax.data(), N);
+  predicted.col(3) = gtsam::Vector::Map(projections.ymax.data(), N);
+
+  gtsam::Matrix boxes(measured.size(), 4);
+  for (size_t i = 0; i < measured.size(); i++) {
+    boxes.row(i) = measured[i].vector().transpose();
+  }
+
+  // failed projections have meaningless bounds
+  gtsam::Matrix iou = iouMatrix(predicted, boxes);
+  for (size_t j = 0; j < N; j++) {
+    if (projections.status[j] != ProjectionStatus::SUCCESS) {
+      iou.col(j).setZero();
+    }
+  }
+  return iou;
+}
+
+/* ************************************************************************* */
+gtsam::Matrix BoxAssociation::iouMatrix(const gtsam::Matrix& predicted,
+                                        const gtsam::Matrix& measured) {
+  if ((predicted.rows() && predicted.cols() != 4) ||
+      (measured.rows() && measured.cols() != 4)) {
+    throw std::invalid_argument(
+        "BoxAssociation requires boxes as rows of (xmin,ymin,xmax,ymax)");
+  }
+  if (predicted.rows() == 0 || measured.rows() == 0) {
+    return gtsam::Matrix::Zero(measured.rows(), predicted.rows());
+  }
+
+  const Eigen::ArrayXd xmin = predicted.col(0).array();
+  const Eigen::ArrayXd ymin = predicted.col(1).array();
+  const Eigen::ArrayXd xmax = predicted.col(2).array();
+  const Eigen::ArrayXd ymax = predicted.col(3).array();
+  const Eigen::ArrayXd area = (xmax - xmin) * (ymax - ymin);
+
+  // one measurement against every prediction at a time, as AlignedBox2::iou
+  gtsam::Matrix iou(measured.rows(), predicted.rows());
+  for (int i = 0; i < measured.rows(); i++) {
+    const double mxmin = measured(i, 0), mymin = measured(i, 1);
+    const double mxmax = measured(i, 2), mymax = measured(i, 3);
+    const double marea = (mxmax - mxmin) * (mymax - mymin);
+
+    const Eigen::ArrayXd width = (xmax.min(mxmax) - xmin.max(mxmin));
+    const Eigen::ArrayXd height = (ymax.min(mymax) - ymin.max(mymin));
+    const Eigen::ArrayXd inter = width.max(0.0) * height.max(0.0);
+
+    // zero unless the boxes intersect or one contains the other
+    iou.row(i) = ((width > 0.0) && (height > 0.0))
+                     .select(inter / (area + marea - inter), 0.0)
+                     .matrix()
+                     .transpose();
+  }
+  return iou;
+}
+
+/* ************************************************************************* */
+size_t BoxAssociation::nrMatches() const {
+  return std::count_if(landmarks_.begin(), landmarks_.end(),
+                       [](int landmark) { return landmark >= 0; });
+}
+
+}  // namespace gtsam_quadrics
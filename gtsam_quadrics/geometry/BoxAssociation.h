@@ -0,0 +1,135 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BoxAssociation.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief associates measured boxes with projected landmark bounds
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/BatchProjection.h>
+
+#include <string>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class BoxAssociation
+ * A one-to-one assignment of measured boxes to predicted landmark bounds,
+ * maximizing the total intersection over union of the matched pairs.
+ * Pairs are gated as with AlignedBox2::intersects and AlignedBox2::contains:
+ * boxes that do not overlap, predictions whose projection failed, and
+ * pairs below the minimum IoU are never matched.
+ */
+class BoxAssociation {
+ public:
+  /// how the assignment is solved
+  enum Solver {
+    HUNGARIAN,  ///< optimal assignment, O(n^3)
+    GREEDY      ///< repeatedly match the remaining pair with the largest IoU
+  };
+
+ protected:
+  std::vector<int> landmarks_;  ///< matched prediction of each measurement
+  std::vector<double> ious_;    ///< IoU of each measurement with its match
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Default constructor: no measurements */
+  BoxAssociation() {}
+
+  /**
+   * Associates measured boxes with batch projected landmarks
+   * Bounds are the simple bounds of each projection, see BatchProjection.
+   * @param projections the predicted landmarks
+   * @param measured the measured boxes
+   * @param minIoU the smallest IoU of a matched pair
+   * @param solver how the assignment is solved
+   */
+  static BoxAssociation associate(const BatchProjection& projections,
+                                  const AlignedBox2Vector& measured,
+                                  const double& minIoU = 0.3,
+                                  const Solver& solver = HUNGARIAN);
+
+  /**
+   * Associates measured boxes with predicted boxes
+   * @param predicted Nx4 predicted boxes (xmin,ymin,xmax,ymax)
+   * @param measured Mx4 measured boxes (xmin,ymin,xmax,ymax)
+   */
+  static BoxAssociation associate(const gtsam::Matrix& predicted,
+                                  const gtsam::Matrix& measured,
+                                  const double& minIoU = 0.3,
+                                  const Solver& solver = HUNGARIAN);
+
+  /** Associates using a solver name for the python wrapper */
+  static BoxAssociation associate(const gtsam::Matrix& predicted,
+                                  const gtsam::Matrix& measured,
+                                  const double& minIoU,
+                                  const std::string& solver);
+
+  /**
+   * Solves the assignment given the IoU of every pair
+   * @param iou MxN IoU of each measurement with each prediction
+   */
+  static BoxAssociation solve(const gtsam::Matrix& iou,
+                              const double& minIoU = 0.3,
+                              const Solver& solver = HUNGARIAN);
+
+  /// @}
+  /// @name Static methods
+  /// @{
+
+  /**
+   * Computes the IoU of every measurement and projected landmark
+   * Pairs that do not overlap, or whose projection failed, are zero.
+   * @return MxN IoU, rows are measurements
+   */
+  static gtsam::Matrix iouMatrix(const BatchProjection& projections,
+                                 const AlignedBox2Vector& measured);
+
+  /** Computes the IoU of every pair of Mx4 measured and Nx4 predicted boxes */
+  static gtsam::Matrix iouMatrix(const gtsam::Matrix& predicted,
+                                 const gtsam::Matrix& measured);
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the number of measurements */
+  size_t size() const { return landmarks_.size(); }
+
+  /** Returns the number of matched measurements */
+  size_t nrMatches() const;
+
+  /** Returns the prediction matched to measurement i, or -1 */
+  int landmark(size_t i) const { return landmarks_.at(i); }
+
+  /** Returns the IoU of measurement i with its match, or 0 */
+  double iou(size_t i) const { return ious_.at(i); }
+
+  /** Checks if measurement i was matched */
+  bool isMatched(size_t i) const { return landmarks_.at(i) >= 0; }
+
+  /** Returns the matched prediction of every measurement, -1 if unmatched */
+  const std::vector<int>& landmarks() const { return landmarks_; }
+
+  /// @}
+};
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,75 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file CameraRig.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief cameras rigidly mounted on one body
+ */
+
+#include <gtsam_quadrics/geometry/CameraRig.h>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+size_t CameraRig::add(const gtsam::Pose3& extrinsic,
+                      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                      const boost::shared_ptr<ImageBoundary>& imageBoundary) {
+  if (!calibration || !imageBoundary) {
+    throw std::invalid_argument(
+        "CameraRig requires a calibration and image area per camera");
+  }
+  extrinsics_.push_back(extrinsic);
+  calibrations_.push_back(calibration);
+  imageBoundaries_.push_back(imageBoundary);
+
+  // perturbing the body by exp(v) moves the camera by exp(Ad(inv(E)) * v)
+  adjoints_.push_back(extrinsic.inverse().AdjointMap());
+  return extrinsics_.size() - 1;
+}
+
+/* ************************************************************************* */
+gtsam::Pose3 CameraRig::cameraPose(const gtsam::Pose3& bodyPose, size_t i,
+                                   gtsam::OptionalJacobian<6, 6> H) const {
+  if (H) {
+    *H = adjoints_.at(i);
+  }
+  return bodyPose * extrinsics_.at(i);
+}
+
+/* ************************************************************************* */
+void CameraRig::print(const std::string& s) const {
+  cout << s << "CameraRig with " << this->size() << " cameras" << endl;
+  for (size_t i = 0; i < this->size(); i++) {
+    extrinsics_[i].print("    Extrinsic: ");
+    calibrations_[i]->print("    Calibration: ");
+    imageBoundaries_[i]->print("    ImageBoundary: ");
+  }
+}
+
+/* ************************************************************************* */
+bool CameraRig::equals(const CameraRig& other, double tol) const {
+  bool equal = this->size() == other.size();
+  for (size_t i = 0; equal && i < this->size(); i++) {
+    equal = extrinsics_[i].equals(other.extrinsics_[i], tol) &&
+            calibrations_[i]->equals(*other.calibrations_[i], tol) &&
+            imageBoundaries_[i]->equals(*other.imageBoundaries_[i], tol);
+  }
+  return equal;
+}
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,165 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file CameraRig.h
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief cameras rigidly mounted on one body
+ */
+
+#pragma once
+
+#include <gtsam/base/Testable.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/split_member.hpp>
+#include <boost/serialization/vector.hpp>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class CameraRig
+ * Cameras with fixed extrinsics on one body, e.g. a multi-camera rig whose
+ * body pose is the only variable per timestamp. Camera i is at
+ * bodyPose * extrinsic(i). The derivative of each camera pose wrt the body
+ * pose is constant and precomputed. Share one instance between every
+ * factor of the rig, cameras can be added but not changed.
+ */
+class CameraRig {
+ protected:
+  std::vector<gtsam::Pose3> extrinsics_;  ///< body_P_camera of each camera
+  std::vector<boost::shared_ptr<gtsam::Cal3_S2> >
+      calibrations_;  ///< calibration of each camera
+  std::vector<boost::shared_ptr<ImageBoundary> >
+      imageBoundaries_;  ///< image area of each camera
+  std::vector<gtsam::Matrix6, Eigen::aligned_allocator<gtsam::Matrix6> >
+      adjoints_;  ///< derivative of each camera pose wrt the body pose
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Default constructor, a rig without cameras */
+  CameraRig() {}
+
+  /**
+   * Adds a camera to the rig
+   * @param extrinsic the camera pose in the body frame
+   * @param calibration the camera calibration
+   * @param imageBoundary the image area used by TRUNCATED factors
+   * @return the index of the camera
+   */
+  size_t add(const gtsam::Pose3& extrinsic,
+             const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+             const boost::shared_ptr<ImageBoundary>& imageBoundary);
+
+  /** Adds a camera with a 640x480 image, see add */
+  size_t add(const gtsam::Pose3& extrinsic,
+             const boost::shared_ptr<gtsam::Cal3_S2>& calibration) {
+    return this->add(extrinsic, calibration,
+                     boost::make_shared<ImageBoundary>());
+  }
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the number of cameras */
+  size_t size() const { return extrinsics_.size(); }
+
+  /** Returns the pose of camera i in the body frame */
+  const gtsam::Pose3& extrinsic(size_t i) const { return extrinsics_.at(i); }
+
+  /** Returns the calibration of camera i */
+  const boost::shared_ptr<gtsam::Cal3_S2>& calibration(size_t i) const {
+    return calibrations_.at(i);
+  }
+
+  /** Returns the image area of camera i */
+  const boost::shared_ptr<ImageBoundary>& imageBoundary(size_t i) const {
+    return imageBoundaries_.at(i);
+  }
+
+  /** Returns the derivative of the pose of camera i wrt the body pose */
+  const gtsam::Matrix6& adjoint(size_t i) const { return adjoints_.at(i); }
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /**
+   * Returns the world pose of camera i
+   * @param H the derivative wrt the body pose (6x6)
+   */
+  gtsam::Pose3 cameraPose(const gtsam::Pose3& bodyPose, size_t i,
+                          gtsam::OptionalJacobian<6, 6> H = boost::none) const;
+
+  /// @}
+  /// @name Testable group traits
+  /// @{
+
+  /** Prints the rig with optional string */
+  void print(const std::string& s = "") const;
+
+  /** Returns true if equal extrinsics, calibrations and image areas */
+  bool equals(const CameraRig& other, double tol = 1e-9) const;
+
+  /// @}
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+
+  /** Saves the cameras, the adjoints are derived from them */
+  template <class ARCHIVE>
+  void save(ARCHIVE& ar, const unsigned int /*version*/) const {
+    ar << BOOST_SERIALIZATION_NVP(extrinsics_);
+    ar << BOOST_SERIALIZATION_NVP(calibrations_);
+    ar << BOOST_SERIALIZATION_NVP(imageBoundaries_);
+  }
+
+  /** Loads the cameras and recomputes the adjoints */
+  template <class ARCHIVE>
+  void load(ARCHIVE& ar, const unsigned int /*version*/) {
+    std::vector<gtsam::Pose3> extrinsics;
+    std::vector<boost::shared_ptr<gtsam::Cal3_S2> > calibrations;
+    std::vector<boost::shared_ptr<ImageBoundary> > imageBoundaries;
+    ar >> boost::serialization::make_nvp("extrinsics_", extrinsics);
+    ar >> boost::serialization::make_nvp("calibrations_", calibrations);
+    ar >> boost::serialization::make_nvp("imageBoundaries_", imageBoundaries);
+    *this = CameraRig();
+    for (size_t i = 0; i < extrinsics.size(); i++) {
+      this->add(extrinsics[i], calibrations[i], imageBoundaries[i]);
+    }
+  }
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+  /// @}
+};
+
+}  // namespace gtsam_quadrics
+
+/** \cond PRIVATE */
+// Add CameraRig to Testable group
+template <>
+struct gtsam::traits<gtsam_quadrics::CameraRig>
+    : public gtsam::Testable<gtsam_quadrics::CameraRig> {};
+/** \endcond */
@@ -16,14 +16,18 @@
  * @brief a constrained dual quadric
  */
 
+#include <gtsam/base/serialization.h>
 #include <gtsam_quadrics/base/Utilities.h>
 #include <gtsam_quadrics/geometry/AlignedBox2.h>
 #include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
 #include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricKernels.h>
 
 #include <Eigen/Eigenvalues>
 #include <iostream>
 
+GTSAM_VALUE_EXPORT(gtsam_quadrics::ConstrainedDualQuadric)
+
 using namespace std;
 
 namespace gtsam_quadrics {
@@ -42,38 +46,26 @@ ConstrainedDualQuadric::ConstrainedDualQuadric(const gtsam::Matrix44& dQ) {
 /* ************************************************************************* */
 ConstrainedDualQuadric ConstrainedDualQuadric::constrain(
     const gtsam::Matrix4& dual_quadric) {
-  // normalize if required
-  gtsam::Matrix4 normalized_dual_quadric(dual_quadric);
-  if (dual_quadric(3, 3) != 1.0) {
-    normalized_dual_quadric = dual_quadric / dual_quadric(3, 3);
-  }
+  // normalize so the constrained form [R*S*R' - t*t', -t; -t', -1], with
+  // S = diag(r^2), becomes [t*t' - R*S*R', t; t', 1]
+  gtsam::Matrix4 normalized_dual_quadric = dual_quadric / dual_quadric(3, 3);
 
   // extract translation
-  gtsam::Point3 translation(normalized_dual_quadric.block(0, 3, 3, 1));
-
-  // calculate the point quadric matrix
-  gtsam::Matrix4 point_quadric = normalized_dual_quadric.inverse();
-  gtsam::Matrix4 normalized_point_quadric = point_quadric;
-  if (point_quadric(3, 3) != 1.0) {
-    normalized_point_quadric = point_quadric / point_quadric(3, 3);
-  }
-
-  // extract shape
-  auto lambdaa = normalized_point_quadric.block(0, 0, 3, 3).eigenvalues();
-  gtsam::Vector3 shape =
-      Eigen::sqrt(-1.0 * normalized_point_quadric.determinant() /
-                  normalized_point_quadric.block(0, 0, 3, 3).determinant() *
-                  1.0 / lambdaa.array())
-          .abs();
-
-  // extract rotation
-  Eigen::EigenSolver<Eigen::Matrix<double, 3, 3>> s(
-      normalized_point_quadric.block(0, 0, 3, 3));
-  gtsam::Matrix3 rotation_matrix = s.eigenvectors().real();
-
-  // ensure rotation is right-handed
-  if (!(fabs(1.0 - rotation_matrix.determinant()) < 1e-8)) {
-    rotation_matrix *= -1.0 * gtsam::Matrix3::Identity();
+  gtsam::Point3 translation(normalized_dual_quadric.block<3, 1>(0, 3));
+
+  // R*S*R' is symmetric, so its eigenvectors are the orthonormal rotation
+  // and its eigenvalues the squared radii, taken as absolute values to
+  // constrain a surface that is not an ellipsoid
+  gtsam::Matrix3 A = normalized_dual_quadric.topLeftCorner<3, 3>();
+  gtsam::Matrix3 shape_matrix =
+      translation * translation.transpose() - 0.5 * (A + A.transpose());
+  Eigen::SelfAdjointEigenSolver<gtsam::Matrix3> s(shape_matrix);
+  gtsam::Vector3 shape = s.eigenvalues().cwiseAbs().cwiseSqrt();
+
+  // extract rotation, ensuring it is right-handed
+  gtsam::Matrix3 rotation_matrix = s.eigenvectors();
+  if (rotation_matrix.determinant() < 0.0) {
+    rotation_matrix.col(2) *= -1.0;
   }
   gtsam::Rot3 rotation(rotation_matrix);
 
@@ -83,28 +75,12 @@ ConstrainedDualQuadric ConstrainedDualQuadric::constrain(
 /* ************************************************************************* */
 gtsam::Matrix44 ConstrainedDualQuadric::matrix(
     gtsam::OptionalJacobian<16, 9> dQ_dq) const {
-  gtsam::Matrix44 Z = pose_.matrix();
-  gtsam::Matrix44 Qc = (gtsam::Vector4() << (radii_).array().pow(2), -1.0)
-                           .finished()
-                           .asDiagonal();
-  gtsam::Matrix44 Q = Z * Qc * Z.transpose();
+  gtsam::Matrix44 Q = kernels::quadricMatrix<double>(
+      pose_.rotation().matrix(), pose_.translation(), radii_);
 
   if (dQ_dq) {
-    Eigen::Matrix<double, 16, 6> dZ_dx;
-    utils::matrix(pose_, dZ_dx);  // NOTE: this will recalculate pose.matrix
-    Eigen::Matrix<double, 16, 9> dZ_dq = gtsam::Matrix::Zero(16, 9);
-    dZ_dq.block(0, 0, 16, 6) = dZ_dx;
-
-    Eigen::Matrix<double, 16, 9> dQc_dq = gtsam::Matrix::Zero(16, 9);
-    dQc_dq(0, 6) = 2.0 * radii_(0);
-    dQc_dq(5, 7) = 2.0 * radii_(1);
-    dQc_dq(10, 8) = 2.0 * radii_(2);
-
-    using utils::kron;
-    static gtsam::Matrix4 I44 = gtsam::Matrix::Identity(4, 4);
-    static Eigen::Matrix<double, 16, 16> T44 = utils::TVEC(4, 4);
-    *dQ_dq = kron(I44, Z * Qc) * T44 * dZ_dq +
-             kron(Z, I44) * (kron(I44, Z) * dQc_dq + kron(Qc, I44) * dZ_dq);
+    *dQ_dq = kernels::quadricJacobian<double>(pose_.rotation().matrix(),
+                                              pose_.translation(), radii_);
   }
   return Q;
 }
@@ -116,32 +92,14 @@ gtsam::Matrix44 ConstrainedDualQuadric::normalizedMatrix(void) const {
 }
 
 /* ************************************************************************* */
-// TODO: vectorize
 AlignedBox3 ConstrainedDualQuadric::bounds() const {
-  gtsam::Matrix44 dE = this->matrix();
-  double x_min =
-      (dE(0, 3) + std::sqrt(dE(0, 3) * dE(0, 3) - (dE(0, 0) * dE(3, 3)))) /
-      dE(3, 3);
-  double y_min =
-      (dE(1, 3) + std::sqrt(dE(1, 3) * dE(1, 3) - (dE(1, 1) * dE(3, 3)))) /
-      dE(3, 3);
-  double z_min =
-      (dE(2, 3) + std::sqrt(dE(2, 3) * dE(2, 3) - (dE(2, 2) * dE(3, 3)))) /
-      dE(3, 3);
-  double x_max =
-      (dE(0, 3) - std::sqrt(dE(0, 3) * dE(0, 3) - (dE(0, 0) * dE(3, 3)))) /
-      dE(3, 3);
-  double y_max =
-      (dE(1, 3) - std::sqrt(dE(1, 3) * dE(1, 3) - (dE(1, 1) * dE(3, 3)))) /
-      dE(3, 3);
-  double z_max =
-      (dE(2, 3) - std::sqrt(dE(2, 3) * dE(2, 3) - (dE(2, 2) * dE(3, 3)))) /
-      dE(3, 3);
-  return AlignedBox3((gtsam::Vector6() << std::min(x_min, x_max),
-                      std::max(x_min, x_max), std::min(y_min, y_max),
-                      std::max(y_min, y_max), std::min(z_min, z_max),
-                      std::max(z_min, z_max))
-                         .finished());
+  // closed form from the pose and radii, equal to the roots of the quadric
+  // matrix along each axis
+  const gtsam::Point3& t = pose_.translation();
+  const gtsam::Vector3 h =
+      kernels::halfExtents<double>(pose_.rotation().matrix(), radii_);
+  return AlignedBox3(t.x() - h.x(), t.x() + h.x(), t.y() - h.y(),
+                     t.y() + h.y(), t.z() - h.z(), t.z() + h.z());
 }
 
 /* ************************************************************************* */
@@ -23,6 +23,7 @@
 #include <gtsam/nonlinear/Values.h>
 #include <gtsam_quadrics/geometry/AlignedBox3.h>
 
+#include <boost/serialization/nvp.hpp>
 #include <random>
 
 namespace gtsam_quadrics {
@@ -167,6 +168,20 @@ class ConstrainedDualQuadric {
   /// TODO: account for scaling by normalizing quadric
   bool equals(const ConstrainedDualQuadric& other, double tol = 1e-9) const;
 
+  /// @}
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& BOOST_SERIALIZATION_NVP(pose_);
+    ar& BOOST_SERIALIZATION_NVP(radii_);
+  }
+
   /// @}
 };
 
@@ -0,0 +1,173 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file DistortedCamera.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief bounding box factors for cameras with lens distortion
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class DistortedCamera
+ * Builds BoundingBoxFactors for boxes detected by a camera with lens
+ * distortion, e.g. DistortedCamera<gtsam::Cal3DS2> or Cal3Fisheye.
+ * Each box is mapped to the ideal image once, see QuadricCamera::undistort,
+ * and measured through the pinhole part of the calibration, so the factors
+ * cost the same to optimize as pinhole factors.
+ * This approximates templating the projection on the calibration, the
+ * error of each side is bounded by QuadricCamera::undistortError.
+ * The image area is mapped the same way and shared by every factor of the
+ * camera, so TRUNCATED factors ignore the sides cut by the distorted image
+ * border. The noise model is given in distorted pixels and each sigma is
+ * scaled by the local undistortion of its side.
+ * DistortedCamera<gtsam::Cal3_S2> measures the boxes unchanged.
+ */
+template <class CALIBRATION>
+class DistortedCamera {
+ protected:
+  CALIBRATION calibration_;  ///< calibration including the distortion
+  boost::shared_ptr<gtsam::Cal3_S2> pinhole_;       ///< undistorted part
+  boost::shared_ptr<ImageBoundary> imageBoundary_;  ///< ideal image area
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Constructor from calibration and the distorted image area */
+  DistortedCamera(const CALIBRATION& calibration,
+                  const AlignedBox2& imageBounds)
+      : calibration_(calibration),
+        pinhole_(QuadricCamera::pinhole(calibration)),
+        imageBoundary_(boost::make_shared<ImageBoundary>(
+            QuadricCamera::undistort(imageBounds, calibration))) {}
+
+  /** Constructor from calibration and distorted image size */
+  DistortedCamera(const CALIBRATION& calibration, const double& width,
+                  const double& height)
+      : DistortedCamera(calibration, AlignedBox2(0.0, 0.0, width, height)) {}
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the calibration including the distortion */
+  const CALIBRATION& calibration() const { return calibration_; }
+
+  /** Returns the pinhole calibration used by the factors */
+  const boost::shared_ptr<gtsam::Cal3_S2>& pinhole() const { return pinhole_; }
+
+  /** Returns the image area in the ideal image */
+  const boost::shared_ptr<ImageBoundary>& imageBoundary() const {
+    return imageBoundary_;
+  }
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /** Maps a detected box to the ideal image */
+  AlignedBox2 undistort(const AlignedBox2& box) const {
+    return QuadricCamera::undistort(box, calibration_);
+  }
+
+  /**
+   * Maps the noise model of a detected box to the ideal image, scaling the
+   * sigma of each side by the derivative of its undistortion
+   * @throws std::invalid_argument unless the model is gaussian or robust
+   */
+  gtsam::SharedNoiseModel undistort(
+      const AlignedBox2& box, const gtsam::SharedNoiseModel& model) const {
+    const gtsam::Vector4 scale =
+        QuadricCamera::undistortJacobian(box, calibration_);
+    if (scale == gtsam::Vector4::Ones()) {
+      return model;
+    }
+    return scaleSigmas(model, scale);
+  }
+
+  /** Maps a box in the ideal image, e.g. a predicted quadric, to the image */
+  AlignedBox2 distort(const AlignedBox2& box) const {
+    return QuadricCamera::distort(box, calibration_);
+  }
+
+  /** Returns the factor of a box detected in the distorted image */
+  BoundingBoxFactor factor(const AlignedBox2& measured,
+                           const gtsam::Key& poseKey,
+                           const gtsam::Key& quadricKey,
+                           const gtsam::SharedNoiseModel& model,
+                           const BoundingBoxFactor::MeasurementModel&
+                               errorType = BoundingBoxFactor::STANDARD) const {
+    return BoundingBoxFactor(undistort(measured), pinhole_, imageBoundary_,
+                             poseKey, quadricKey, undistort(measured, model),
+                             errorType);
+  }
+
+  /** Returns the factor of a box, errorString is "STANDARD" or "TRUNCATED" */
+  BoundingBoxFactor factor(const AlignedBox2& measured,
+                           const gtsam::Key& poseKey,
+                           const gtsam::Key& quadricKey,
+                           const gtsam::SharedNoiseModel& model,
+                           const std::string& errorString) const {
+    return BoundingBoxFactor(undistort(measured), pinhole_, imageBoundary_,
+                             poseKey, quadricKey, undistort(measured, model),
+                             errorString);
+  }
+
+  /// @}
+
+ protected:
+  /** Returns the model with each sigma multiplied by scale */
+  static gtsam::SharedNoiseModel scaleSigmas(
+      const gtsam::SharedNoiseModel& model, const gtsam::Vector4& scale) {
+    namespace noiseModel = gtsam::noiseModel;
+    if (boost::shared_ptr<noiseModel::Robust> robust =
+            boost::dynamic_pointer_cast<noiseModel::Robust>(model)) {
+      return noiseModel::Robust::Create(robust->robust(),
+                                        scaleSigmas(robust->noise(), scale));
+    }
+    if (boost::shared_ptr<noiseModel::Constrained> constrained =
+            boost::dynamic_pointer_cast<noiseModel::Constrained>(model)) {
+      return noiseModel::Constrained::MixedSigmas(
+          constrained->mu(), constrained->sigmas().cwiseProduct(scale));
+    }
+    if (boost::shared_ptr<noiseModel::Diagonal> diagonal =
+            boost::dynamic_pointer_cast<noiseModel::Diagonal>(model)) {
+      return noiseModel::Diagonal::Sigmas(
+          diagonal->sigmas().cwiseProduct(scale));
+    }
+    if (boost::shared_ptr<noiseModel::Gaussian> gaussian =
+            boost::dynamic_pointer_cast<noiseModel::Gaussian>(model)) {
+      return noiseModel::Gaussian::SqrtInformation(
+          gaussian->R() * scale.cwiseInverse().asDiagonal());
+    }
+    throw std::invalid_argument(
+        "DistortedCamera requires a gaussian or robust noise model");
+  }
+};
+
+}  // namespace gtsam_quadrics
@@ -16,11 +16,11 @@
  * @brief a dual conic
  */
 
-#include <gtsam/base/numericalDerivative.h>
 #include <gtsam_quadrics/base/QuadricProjectionException.h>
-#include <gtsam_quadrics/base/Utilities.h>
+#include <gtsam_quadrics/base/Statistics.h>
 #include <gtsam_quadrics/geometry/DualConic.h>
 #include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricKernels.h>
 
 #include <cmath>
 #include <iomanip>
@@ -56,65 +56,209 @@ DualConic DualConic::normalize(void) const {
 /// assert bounds are real-valued
 /// normalize conic
 AlignedBox2 DualConic::bounds(gtsam::OptionalJacobian<4, 9> H) const {
-  double xmin =
-      (dC_(0, 2) + sqrt(dC_(0, 2) * dC_(0, 2) - dC_(2, 2) * dC_(0, 0))) /
-      dC_(2, 2);
-  double xmax =
-      (dC_(0, 2) - sqrt(dC_(0, 2) * dC_(0, 2) - dC_(2, 2) * dC_(0, 0))) /
-      dC_(2, 2);
-  double ymin =
-      (dC_(1, 2) + sqrt(dC_(1, 2) * dC_(1, 2) - dC_(2, 2) * dC_(1, 1))) /
-      dC_(2, 2);
-  double ymax =
-      (dC_(1, 2) - sqrt(dC_(1, 2) * dC_(1, 2) - dC_(2, 2) * dC_(1, 1))) /
-      dC_(2, 2);
+  const gtsam::Vector4 bounds = kernels::conicBounds<double>(dC_);
 
   if (H) {
-    Eigen::Matrix<double, 4, 9> db_dC = gtsam::Matrix::Zero(4, 9);
-    double f = sqrt(dC_(0, 2) * dC_(0, 2) - dC_(0, 0) * dC_(2, 2));
-    double g = sqrt(dC_(1, 2) * dC_(1, 2) - dC_(1, 1) * dC_(2, 2));
-    db_dC(0, 0) = 1.0 / f * (-1.0 / 2.0);
-    db_dC(0, 6) = (dC_(0, 2) * 1.0 / f + 1.0) / dC_(2, 2);
-    db_dC(0, 8) = -1.0 / (dC_(2, 2) * dC_(2, 2)) * (dC_(0, 2) + f) -
-                  (dC_(0, 0) * 1.0 / f * (1.0 / 2.0)) / dC_(2, 2);
-    db_dC(1, 4) = 1.0 / g * (-1.0 / 2.0);
-    db_dC(1, 7) = (dC_(1, 2) * 1.0 / g + 1.0) / dC_(2, 2);
-    db_dC(1, 8) = -1.0 / (dC_(2, 2) * dC_(2, 2)) * (dC_(1, 2) + g) -
-                  (dC_(1, 1) * 1.0 / g * (1.0 / 2.0)) / dC_(2, 2);
-    db_dC(2, 0) = 1.0 / f * (1.0 / 2.0);
-    db_dC(2, 6) = -(dC_(0, 2) * 1.0 / f - 1.0) / dC_(2, 2);
-    db_dC(2, 8) = -1.0 / (dC_(2, 2) * dC_(2, 2)) * (dC_(0, 2) - f) +
-                  (dC_(0, 0) * 1.0 / f * (1.0 / 2.0)) / dC_(2, 2);
-    db_dC(3, 4) = 1.0 / g * (1.0 / 2.0);
-    db_dC(3, 7) = -(dC_(1, 2) * 1.0 / g - 1.0) / dC_(2, 2);
-    db_dC(3, 8) = -1.0 / (dC_(2, 2) * dC_(2, 2)) * (dC_(1, 2) - g) +
-                  (dC_(1, 1) * 1.0 / g * (1.0 / 2.0)) / dC_(2, 2);
-    *H = db_dC;
+    *H = kernels::conicBoundsJacobian<double>(dC_);
   }
 
-  return AlignedBox2(xmin, ymin, xmax, ymax);
+  return AlignedBox2(bounds);
+}
+
+/* ************************************************************************* */
+namespace {
+
+typedef Eigen::Matrix<double, 1, 9> Gradient;  ///< gradient wrt vec(C)
+
+/// discriminants within this fraction of their terms are treated as zero
+const double DISCRIMINANT_TOLERANCE = 1e-9;
+
+/// the 640x480 image assumed without an ImageBoundary, constructed at load
+/// time so the bounds avoid a function-local static guard
+const ImageBoundary DEFAULT_IMAGE_BOUNDARY;
+
+/** Returns the discriminant of a*x^2 + b*x + c, zero within tolerance */
+double discriminant(double a, double b, double c) {
+  double disc = b * b - 4.0 * a * c;
+  double tol = DISCRIMINANT_TOLERANCE * (b * b + std::fabs(4.0 * a * c));
+  return (std::fabs(disc) <= tol) ? 0.0 : disc;
+}
+
+/**
+ * Solves a*x^2 + b*x + c = 0 without cancellation, ordered as
+ * utils::solvePolynomial: root1 = (-b + sqrt(disc)) / 2a and
+ * root2 = (-b - sqrt(disc)) / 2a. Complex roots are clamped to the real part.
+ * @return false if the roots are complex
+ */
+bool solveQuadratic(double a, double b, double c, double& root1,
+                    double& root2) {
+  double disc = discriminant(a, b, c);
+  bool real = disc >= 0.0;
+  double sqrtDisc = real ? std::sqrt(disc) : 0.0;
+
+  // q has the sign of -b so the larger root never subtracts
+  double q = (b >= 0.0) ? -0.5 * (b + sqrtDisc) : -0.5 * (b - sqrtDisc);
+  if (q == 0.0) {
+    root1 = root2 = -b / (2.0 * a);
+  } else if (b >= 0.0) {
+    root1 = c / q;
+    root2 = q / a;
+  } else {
+    root1 = q / a;
+    root2 = c / q;
+  }
+  return real;
+}
+
+/**
+ * Derivative of a root of a*x^2 + b*x + c = 0 given the coefficient
+ * gradients, matching the root selected by solveQuadratic
+ * (sign = +1 for the first root, -1 for the second)
+ */
+Gradient rootGradient(double a, double b, double c, double sign,
+                      const Gradient& da, const Gradient& db,
+                      const Gradient& dc) {
+  double disc = discriminant(a, b, c);
+  double root = (disc <= 0.0) ? -b / (2.0 * a)
+                              : (-b + sign * std::sqrt(disc)) / (2.0 * a);
+  Gradient dsqrt = Gradient::Zero();
+  if (disc > 0.0) {
+    dsqrt = (2.0 * b * db - 4.0 * (a * dc + c * da)) / (2.0 * std::sqrt(disc));
+  }
+  return (-db + sign * dsqrt) / (2.0 * a) - root / a * da;
+}
+
+/**
+ * A candidate point of the smartBounds calculation,
+ * remembering which conic feature it was generated from
+ */
+struct ConicPoint {
+  enum Source {
+    X_EXTREMA,  ///< tangent point where dC/dy = 0
+    Y_EXTREMA,  ///< tangent point where dC/dx = 0
+    BORDER_X,   ///< intersection with a vertical image border
+    BORDER_Y,   ///< intersection with a horizontal image border
+    CORNER      ///< image corner contained inside the conic
+  };
+
+  gtsam::Point2 point;
+  Source source;
+  double sign;  ///< which polynomial root generated the point
+
+  ConicPoint() : source(CORNER), sign(0.0) {}
+
+  ConicPoint(const gtsam::Point2& p, Source s, double r)
+      : point(p), source(s), sign(r) {}
+
+  /** Derivative of the point wrt vec(C) of the normalized point conic */
+  Eigen::Matrix<double, 2, 9> jacobian(const gtsam::Matrix33& C) const {
+    auto e = [](int i, int j) -> Gradient { return Gradient::Unit(i + 3 * j); };
+    Eigen::Matrix<double, 2, 9> J = Eigen::Matrix<double, 2, 9>::Zero();
+
+    if (source == Y_EXTREMA) {
+      // y solves a*y^2 + b*y + c = 0, x = -(C10*y + C20)/C00
+      double a = C(1, 1) - C(1, 0) * C(1, 0) / C(0, 0);
+      double b = 2.0 * C(2, 1) - 2.0 * C(1, 0) * C(2, 0) / C(0, 0);
+      double c = C(2, 2) - C(2, 0) * C(2, 0) / C(0, 0);
+      Gradient da = e(1, 1) - 2.0 * C(1, 0) / C(0, 0) * e(1, 0) +
+                    C(1, 0) * C(1, 0) / (C(0, 0) * C(0, 0)) * e(0, 0);
+      Gradient db = 2.0 * e(2, 1) - 2.0 * C(2, 0) / C(0, 0) * e(1, 0) -
+                    2.0 * C(1, 0) / C(0, 0) * e(2, 0) +
+                    2.0 * C(1, 0) * C(2, 0) / (C(0, 0) * C(0, 0)) * e(0, 0);
+      Gradient dc = e(2, 2) - 2.0 * C(2, 0) / C(0, 0) * e(2, 0) +
+                    C(2, 0) * C(2, 0) / (C(0, 0) * C(0, 0)) * e(0, 0);
+      double y = point.y();
+      Gradient dy = rootGradient(a, b, c, sign, da, db, dc);
+      J.row(0) = -(y * e(1, 0) + C(1, 0) * dy + e(2, 0)) / C(0, 0) +
+                 (C(1, 0) * y + C(2, 0)) / (C(0, 0) * C(0, 0)) * e(0, 0);
+      J.row(1) = dy;
+    } else if (source == X_EXTREMA) {
+      // x solves a*x^2 + b*x + c = 0, y = -(C10*x + C21)/C11
+      double a = C(0, 0) - C(1, 0) * C(1, 0) / C(1, 1);
+      double b = 2.0 * C(2, 0) - 2.0 * C(1, 0) * C(2, 1) / C(1, 1);
+      double c = C(2, 2) - C(2, 1) * C(2, 1) / C(1, 1);
+      Gradient da = e(0, 0) - 2.0 * C(1, 0) / C(1, 1) * e(1, 0) +
+                    C(1, 0) * C(1, 0) / (C(1, 1) * C(1, 1)) * e(1, 1);
+      Gradient db = 2.0 * e(2, 0) - 2.0 * C(2, 1) / C(1, 1) * e(1, 0) -
+                    2.0 * C(1, 0) / C(1, 1) * e(2, 1) +
+                    2.0 * C(1, 0) * C(2, 1) / (C(1, 1) * C(1, 1)) * e(1, 1);
+      Gradient dc = e(2, 2) - 2.0 * C(2, 1) / C(1, 1) * e(2, 1) +
+                    C(2, 1) * C(2, 1) / (C(1, 1) * C(1, 1)) * e(1, 1);
+      double x = point.x();
+      Gradient dx = rootGradient(a, b, c, sign, da, db, dc);
+      J.row(0) = dx;
+      J.row(1) = -(x * e(1, 0) + C(1, 0) * dx + e(2, 1)) / C(1, 1) +
+                 (C(1, 0) * x + C(2, 1)) / (C(1, 1) * C(1, 1)) * e(1, 1);
+    } else if (source == BORDER_X) {
+      // y solves C11*y^2 + 2*(C01*x + C12)*y + C00*x^2 + 2*C02*x + C22
+      double x = point.x();
+      double a = C(1, 1);
+      double b = 2 * C(0, 1) * x + 2 * C(1, 2);
+      double c = C(0, 0) * x * x + 2 * C(0, 2) * x + C(2, 2);
+      J.row(1) = rootGradient(a, b, c, sign, e(1, 1),
+                              2 * x * e(0, 1) + 2 * e(1, 2),
+                              x * x * e(0, 0) + 2 * x * e(0, 2) + e(2, 2));
+    } else if (source == BORDER_Y) {
+      // x solves C00*x^2 + 2*(C01*y + C02)*x + C11*y^2 + 2*C12*y + C22
+      double y = point.y();
+      double a = C(0, 0);
+      double b = 2 * C(0, 1) * y + 2 * C(0, 2);
+      double c = C(1, 1) * y * y + 2 * C(1, 2) * y + C(2, 2);
+      J.row(0) = rootGradient(a, b, c, sign, e(0, 0),
+                              2 * y * e(0, 1) + 2 * e(0, 2),
+                              y * y * e(1, 1) + 2 * y * e(1, 2) + e(2, 2));
+    }
+    // image corners do not move with the conic
+    return J;
+  }
+};
+
+}  // namespace
+
+/* ************************************************************************* */
+AlignedBox2 DualConic::smartBounds(const ImageBoundary& imageBoundary,
+                                   gtsam::OptionalJacobian<4, 9> H) const {
+  AlignedBox2 smartBounds;
+  ProjectionStatus status =
+      this->trySmartBounds(imageBoundary, smartBounds, H);
+  if (status != ProjectionStatus::SUCCESS) {
+    throw std::runtime_error(toString(status));
+  }
+  return smartBounds;
 }
 
 /* ************************************************************************* */
 AlignedBox2 DualConic::smartBounds(
-    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const boost::shared_ptr<gtsam::Cal3_S2>& /* calibration */,
     gtsam::OptionalJacobian<4, 9> H) const {
-  // calculate image dimensions from calibration
-  // double imageWidth = calibration->px() * 2.0;
-  // double imageHeight = calibration->py() * 2.0;
-  double imageWidth = 640.0;
-  double imageHeight = 480.0;
-  AlignedBox2 imageBounds(0.0, 0.0, imageWidth, imageHeight);
+  return this->smartBounds(DEFAULT_IMAGE_BOUNDARY, H);
+}
+
+/* ************************************************************************* */
+ProjectionStatus DualConic::trySmartBounds(
+    const boost::shared_ptr<gtsam::Cal3_S2>& /* calibration */,
+    AlignedBox2& smartBounds, gtsam::OptionalJacobian<4, 9> H) const {
+  return this->trySmartBounds(DEFAULT_IMAGE_BOUNDARY, smartBounds, H);
+}
+
+/* ************************************************************************* */
+ProjectionStatus DualConic::trySmartBounds(
+    const ImageBoundary& imageBoundary, AlignedBox2& smartBounds,
+    gtsam::OptionalJacobian<4, 9> H) const {
+  const AlignedBox2& imageBounds = imageBoundary.bounds();
 
   // if quadric is fully visible, use the faster simple bounds
   Eigen::Matrix<double, 4, 9> simpleJacobian;
   AlignedBox2 simpleBounds = this->bounds(H ? &simpleJacobian : 0);
   if (imageBounds.contains(simpleBounds)) {
+    Statistics::increment(Statistics::SMART_BOUNDS_STANDARD);
     if (H) {
       *H = simpleJacobian;
     }
-    return simpleBounds;
+    smartBounds = simpleBounds;
+    return ProjectionStatus::SUCCESS;
   }
+  Statistics::increment(Statistics::SMART_BOUNDS_TRUNCATED);
 
   // ensure quadric is at least partially visible
   // NOTE: this will not work because bounds can be inside whilst conic is
@@ -124,171 +268,141 @@ AlignedBox2 DualConic::smartBounds(
   //   implies quadric not visible");
   // }
 
-  // cast dual conic to long double before inverting
-  /// NOTE: this helps keep polynomials from having -ve desc
-  Eigen::Matrix<long double, 3, 3> dualConic = dC_.cast<long double>();
-  dualConic = dualConic / dualConic(2, 2);
-
-  // calculate point conic
-  Eigen::Matrix<long double, 3, 3> C = dualConic.inverse();
-
-  // normalize conic so polynomials behave
-  C = C / C(2, 2);
-
-  std::vector<gtsam::Point2> points;
-
-  try {
-    // solve intersection of dC/dx and conic C (solving y values first)
-    gtsam::Vector2 ys = utils::solvePolynomial(
-        C(1, 1) - pow(C(1, 0) * 2, 2) / (4 * C(0, 0)),
-        C(2, 1) * 2 - (C(1, 0) * 2 * C(2, 0) * 2) / (2 * C(0, 0)),
-        C(2, 2) - pow(C(2, 0) * 2, 2) / (4 * C(0, 0)));
-    gtsam::Point2 p1((-C(1, 0) * 2 * ys[0] - C(2, 0) * 2) / (2 * C(0, 0)),
-                     ys[0]);
-    gtsam::Point2 p3((-C(1, 0) * 2 * ys[1] - C(2, 0) * 2) / (2 * C(0, 0)),
-                     ys[1]);
-
-    // solve intersection of dC/dx and conic C (solving x values first)
-    // Vector2 xs = gtsam::utils::solvePolynomial(
-    //   4*pow(C(0,0),2)*C(1,1)/pow(C(1,0)*2,2) - C(0,0),
-    //   4*C(0,0)*C(1,1)*C(2,0)*2/pow(C(1,0)*2,2) - 2*C(0,0)*C(2,1)*2/C(1,0)*2,
-    //   C(1,1)*pow(C(2,0)*2,2)/pow(C(1,0)*2,2) - C(2,0)*2*C(2,1)*2/C(1,0)*2 +
-    //   C(2,2)
-    // );
-
-    // solve intersection of dC/dy and conic C (solving y values first)
-    // Vector2 ys = gtsam::utils::solvePolynomial(
-    //   4*C(0,0)*pow(C(1,1),2)/pow(C(1,0)*2,2) - C(1,1),
-    //   4*C(0,0)*C(1,1)*C(2,1)*2/pow(C(1,0)*2,2) -
-    //   (2*C(1,1)*C(2,0)*2/C(1,0)*2), C(0,0)*pow(C(2,1)*2,2)/pow(C(1,0)*2,2) -
-    //   (C(2,0)*2*C(2,1)*2/C(1,0)*2) + C(2,2)
-    // );
-
-    // solve intersection of dC/dy and conic C (solving x values first)
-    gtsam::Vector2 xs = utils::solvePolynomial(
-        C(0, 0) - pow(C(1, 0) * 2, 2) / (4 * C(1, 1)),
-        C(2, 0) * 2 - (C(1, 0) * 2 * C(2, 1) * 2) / (2 * C(1, 1)),
-        C(2, 2) - pow(C(2, 1) * 2, 2) / (4 * C(1, 1)));
-    gtsam::Point2 p0(xs[0],
-                     (-C(1, 0) * 2 * xs[0] - C(2, 1) * 2) / (2 * C(1, 1)));
-    gtsam::Point2 p2(xs[1],
-                     (-C(1, 0) * 2 * xs[1] - C(2, 1) * 2) / (2 * C(1, 1)));
-
-    // append extrema to set of points
-    points.push_back(p0);
-    points.push_back(p1);
-    points.push_back(p2);
-    points.push_back(p3);
-  } catch (std::runtime_error& e) {
-    throw e;
-  }
-
-  // intersection of conic and line at X = 0
-  try {
-    gtsam::Vector2 ys = utils::getConicPointsAtX(C, 0.0);
-    points.push_back(gtsam::Point2(0.0, ys[0]));
-    points.push_back(gtsam::Point2(0.0, ys[1]));
-  } catch (std::runtime_error& e) {
+  // the point conic is the adjugate of the dual conic up to scale,
+  // inv(dC) = adj(dC) / det(dC), so no inverse is needed
+  const gtsam::Matrix33& D = dC_;
+  gtsam::Matrix33 C;
+  C(0, 0) = D(1, 1) * D(2, 2) - D(1, 2) * D(2, 1);
+  C(0, 1) = D(0, 2) * D(2, 1) - D(0, 1) * D(2, 2);
+  C(0, 2) = D(0, 1) * D(1, 2) - D(0, 2) * D(1, 1);
+  C(1, 0) = D(1, 2) * D(2, 0) - D(1, 0) * D(2, 2);
+  C(1, 1) = D(0, 0) * D(2, 2) - D(0, 2) * D(2, 0);
+  C(1, 2) = D(0, 2) * D(1, 0) - D(0, 0) * D(1, 2);
+  C(2, 0) = D(1, 0) * D(2, 1) - D(1, 1) * D(2, 0);
+  C(2, 1) = D(0, 1) * D(2, 0) - D(0, 0) * D(2, 1);
+  C(2, 2) = D(0, 0) * D(1, 1) - D(0, 1) * D(1, 0);
+  const double det = D(0, 0) * C(0, 0) + D(0, 1) * C(1, 0) + D(0, 2) * C(2, 0);
+  if (det == 0.0 || C(2, 2) == 0.0 || !std::isfinite(det)) {
+    return ProjectionStatus::NON_ELLIPSE;
   }
 
-  // intersection of conic and line at X = width
-  try {
-    gtsam::Vector2 ys = utils::getConicPointsAtX(C, imageWidth);
-    points.push_back(gtsam::Point2(imageWidth, ys[0]));
-    points.push_back(gtsam::Point2(imageWidth, ys[1]));
-  } catch (std::runtime_error& e) {
-  }
-
-  // intersection of conic and line at Y = 0
-  try {
-    gtsam::Vector2 xs = utils::getConicPointsAtY(C, 0.0);
-    points.push_back(gtsam::Point2(xs[0], 0.0));
-    points.push_back(gtsam::Point2(xs[1], 0.0));
-  } catch (std::runtime_error& e) {
+  // normalize conic so polynomials behave
+  /// NOTE: the scale is kept to map jacobians back onto the dual conic,
+  /// inv(dC) = C * inverseScale
+  const double inverseScale = C(2, 2) / det;
+  C /= C(2, 2);
+
+  // candidate points: 4 extrema, 8 border intersections and 4 corners
+  ConicPoint points[16];
+  int nrPoints = 0;
+
+  // solve intersection of dC/dx and conic C (solving y values first)
+  // and of dC/dy and conic C (solving x values first)
+  /// NOTE: the extrema of an ellipse are always real, complex roots only
+  /// arise from rounding at tangency and are clamped
+  double y0, y1, x0, x1;
+  solveQuadratic(C(1, 1) - C(1, 0) * C(1, 0) / C(0, 0),
+                 2.0 * C(2, 1) - 2.0 * C(1, 0) * C(2, 0) / C(0, 0),
+                 C(2, 2) - C(2, 0) * C(2, 0) / C(0, 0), y0, y1);
+  solveQuadratic(C(0, 0) - C(1, 0) * C(1, 0) / C(1, 1),
+                 2.0 * C(2, 0) - 2.0 * C(1, 0) * C(2, 1) / C(1, 1),
+                 C(2, 2) - C(2, 1) * C(2, 1) / C(1, 1), x0, x1);
+  points[nrPoints++] = ConicPoint(
+      gtsam::Point2(x0, (-C(1, 0) * x0 - C(2, 1)) / C(1, 1)),
+      ConicPoint::X_EXTREMA, +1.0);
+  points[nrPoints++] = ConicPoint(
+      gtsam::Point2((-C(1, 0) * y0 - C(2, 0)) / C(0, 0), y0),
+      ConicPoint::Y_EXTREMA, +1.0);
+  points[nrPoints++] = ConicPoint(
+      gtsam::Point2(x1, (-C(1, 0) * x1 - C(2, 1)) / C(1, 1)),
+      ConicPoint::X_EXTREMA, -1.0);
+  points[nrPoints++] = ConicPoint(
+      gtsam::Point2((-C(1, 0) * y1 - C(2, 0)) / C(0, 0), y1),
+      ConicPoint::Y_EXTREMA, -1.0);
+
+  // intersection of conic and the vertical borders X = xmin, X = xmax
+  for (double x : {imageBounds.xmin(), imageBounds.xmax()}) {
+    double r1, r2;
+    if (solveQuadratic(C(1, 1), 2.0 * C(0, 1) * x + 2.0 * C(1, 2),
+                       C(0, 0) * x * x + 2.0 * C(0, 2) * x + C(2, 2), r1,
+                       r2)) {
+      points[nrPoints++] =
+          ConicPoint(gtsam::Point2(x, r1), ConicPoint::BORDER_X, +1.0);
+      points[nrPoints++] =
+          ConicPoint(gtsam::Point2(x, r2), ConicPoint::BORDER_X, -1.0);
+    }
   }
 
-  // intersection of conic and line at Y = height
-  try {
-    gtsam::Vector2 xs = utils::getConicPointsAtY(C, imageHeight);
-    points.push_back(gtsam::Point2(xs[0], imageHeight));
-    points.push_back(gtsam::Point2(xs[1], imageHeight));
-  } catch (std::runtime_error& e) {
+  // intersection of conic and the horizontal borders Y = ymin, Y = ymax
+  for (double y : {imageBounds.ymin(), imageBounds.ymax()}) {
+    double r1, r2;
+    if (solveQuadratic(C(0, 0), 2.0 * C(0, 1) * y + 2.0 * C(0, 2),
+                       C(1, 1) * y * y + 2.0 * C(1, 2) * y + C(2, 2), r1,
+                       r2)) {
+      points[nrPoints++] =
+          ConicPoint(gtsam::Point2(r1, y), ConicPoint::BORDER_Y, +1.0);
+      points[nrPoints++] =
+          ConicPoint(gtsam::Point2(r2, y), ConicPoint::BORDER_Y, -1.0);
+    }
   }
 
-  // push back any captured image boundaries
-  gtsam::Point2 i1(0.0, 0.0);
-  gtsam::Point2 i2(0.0, imageHeight);
-  gtsam::Point2 i3(imageWidth, 0.0);
-  gtsam::Point2 i4(imageWidth, imageHeight);
-  if (this->contains(i1)) {
-    points.push_back(i1);
-  }
-  if (this->contains(i2)) {
-    points.push_back(i2);
-  }
-  if (this->contains(i3)) {
-    points.push_back(i3);
-  }
-  if (this->contains(i4)) {
-    points.push_back(i4);
+  // push back any captured image corners, reusing the point conic rather
+  // than calling contains, which would invert the dual conic again
+  for (const gtsam::Point2& corner : imageBoundary.corners()) {
+    gtsam::Vector3 x(corner.x(), corner.y(), 1.0);
+    double pointError = inverseScale * x.dot(C * x);
+    if (pointError <= 1e-10) {  // same threshold as contains
+      points[nrPoints++] = ConicPoint(corner, ConicPoint::CORNER, 0.0);
+    }
   }
 
-  // only accept non-imaginary points within image boundaries
+  // take the max/min of the non-imaginary points within image boundaries
   /// NOTE: it's important that contains includes points on the boundary
   /// ^ such that the fov intersect points count as valid
-  std::vector<gtsam::Point2> validPoints;
-  for (auto point : points) {
-    if (imageBounds.contains(point)) {
-      validPoints.push_back(point);
+  /// NOTE: ties keep the first minimum and last maximum, as minmax_element
+  const ConicPoint* xmin = 0;
+  const ConicPoint* ymin = 0;
+  const ConicPoint* xmax = 0;
+  const ConicPoint* ymax = 0;
+  for (int i = 0; i < nrPoints; i++) {
+    const ConicPoint& p = points[i];
+    if (!imageBounds.contains(p.point)) {
+      continue;
+    }
+    if (!xmin) {
+      xmin = ymin = xmax = ymax = &p;
+      continue;
     }
+    if (p.point.x() < xmin->point.x()) xmin = &p;
+    if (p.point.y() < ymin->point.y()) ymin = &p;
+    if (p.point.x() >= xmax->point.x()) xmax = &p;
+    if (p.point.y() >= ymax->point.y()) ymax = &p;
   }
-
-  if (validPoints.size() < 1) {
-    throw std::runtime_error(
-        "no valid conic points inside image dimensions, implies quadric not "
-        "visible");
-    // simpleBounds.print("Failed SimpleBounds:");
-    // throw QuadricProjectionException("No valid conic points inside image
-    // dimensions, implies quadric not visible");
+  if (!xmin) {
+    return ProjectionStatus::NOT_VISIBLE;
   }
-  auto minMaxX = std::minmax_element(
-      validPoints.begin(), validPoints.end(),
-      [](const gtsam::Point2& lhs, const gtsam::Point2& rhs) {
-        return lhs.x() < rhs.x();
-      });
-  auto minMaxY = std::minmax_element(
-      validPoints.begin(), validPoints.end(),
-      [](const gtsam::Point2& lhs, const gtsam::Point2& rhs) {
-        return lhs.y() < rhs.y();
-      });
-
-  // take the max/min of remaining points
-  AlignedBox2 smartBounds(minMaxX.first->x(), minMaxY.first->y(),
-                          minMaxX.second->x(), minMaxY.second->y());
+  smartBounds = AlignedBox2(xmin->point.x(), ymin->point.y(),
+                            xmax->point.x(), ymax->point.y());
 
   // calculate jacobians
   if (H) {
-    // we want to derive wrt vector output and matrix input
-    auto bounds_funptr =
-        [&](const gtsam::Matrix33& conic_matrix) -> gtsam::Vector {
-      return DualConic(conic_matrix)
-          .smartBounds(calibration, boost::none)
-          .vector();
-    };
-
-    // cast to boost::function for numericalDerivative
-    auto boost_funptr(
-        static_cast<std::function<gtsam::Vector(const gtsam::Matrix33&)>>(
-            bounds_funptr));
-
-    // calculate derivative of conic_matrix wrt quadric vector
-    Eigen::Matrix<double, 4, 9> db_dC =
-        gtsam::numericalDerivative11(boost_funptr, this->matrix(), 1e-6);
-
-    // set jacobian to numerical derivative
-    *H = db_dC;
+    // each bound has the derivative of the conic point that generated it
+    Eigen::Matrix<double, 4, 9> db_dCn;
+    db_dCn.row(0) = xmin->jacobian(C).row(0);
+    db_dCn.row(1) = ymin->jacobian(C).row(1);
+    db_dCn.row(2) = xmax->jacobian(C).row(0);
+    db_dCn.row(3) = ymax->jacobian(C).row(1);
+
+    // the points are invariant to the scale of the point conic, so we only
+    // need to chain through the inverse: dC = -C * dD * C
+    for (int i = 0; i < 4; i++) {
+      Eigen::Matrix<double, 1, 9> g = db_dCn.row(i);
+      Eigen::Map<const gtsam::Matrix33> G(g.data());
+      gtsam::Matrix33 db_dD = -inverseScale * C.transpose() * G * C.transpose();
+      H->row(i) = Eigen::Map<const gtsam::Vector9>(db_dD.data()).transpose();
+    }
   }
-  return smartBounds;
+  return ProjectionStatus::SUCCESS;
 }
 
 /* ************************************************************************* */
@@ -21,7 +21,11 @@
 #include <gtsam/base/Testable.h>
 #include <gtsam/geometry/Cal3_S2.h>
 #include <gtsam/geometry/Pose2.h>
+#include <gtsam_quadrics/base/ProjectionStatus.h>
 #include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+
+#include <boost/serialization/nvp.hpp>
 
 namespace gtsam_quadrics {
 
@@ -70,9 +74,32 @@ class DualConic {
    * NOTE: assumes conic is elliptical and non-degenerate (will throw
    * std::runtimeerror) FAILS: if quadric is not visible
    */
+  AlignedBox2 smartBounds(const ImageBoundary& imageBoundary,
+                          gtsam::OptionalJacobian<4, 9> H = boost::none) const;
+
+  /**
+   * Returns the smartBounds for a 640x480 image
+   * NOTE: the calibration is unused; kept for compatibility,
+   * pass an ImageBoundary for other image sizes
+   */
   AlignedBox2 smartBounds(const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
                           gtsam::OptionalJacobian<4, 9> H = boost::none) const;
 
+  /**
+   * Calculates the smartBounds without throwing
+   * @param imageBoundary the image area to truncate the bounds to
+   * @param bounds set to the truncated bounds when successful
+   * @return SUCCESS, or NOT_VISIBLE if no part of the conic is in the image
+   */
+  ProjectionStatus trySmartBounds(
+      const ImageBoundary& imageBoundary, AlignedBox2& bounds,
+      gtsam::OptionalJacobian<4, 9> H = boost::none) const;
+
+  /** Calculates the smartBounds for a 640x480 image without throwing */
+  ProjectionStatus trySmartBounds(
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      AlignedBox2& bounds, gtsam::OptionalJacobian<4, 9> H = boost::none) const;
+
   /**
    * Returns true if conic section is degenerate
    * Using det(C) as opposed to sign(eigenvalues)
@@ -101,6 +128,19 @@ class DualConic {
   /** Compares two dual conics accounting for normalization */
   bool equals(const DualConic& other, double tol = 1e-9) const;
 
+  /// @}
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& BOOST_SERIALIZATION_NVP(dC_);
+  }
+
   /// @}
 };
 
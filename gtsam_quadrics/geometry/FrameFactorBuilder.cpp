@@ -0,0 +1,277 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FrameFactorBuilder.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief builds the bounding box factors of whole frames from a pool
+ */
+
+#include <gtsam_quadrics/geometry/FrameFactorBuilder.h>
+
+#include <boost/make_shared.hpp>
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+namespace {
+
+/// chunk alignment, enough for Eigen's fixed size members
+const size_t kAlignment =
+    std::max<size_t>(EIGEN_MAX_ALIGN_BYTES, alignof(std::max_align_t));
+
+/// calibrations and noise models closer than this are interned together
+const double kTolerance = 1e-12;
+
+/// returns the measurement model named by an error string
+BoundingBoxFactor::MeasurementModel measurementModel(
+    const std::string& errorString) {
+  if (errorString == "STANDARD") {
+    return BoundingBoxFactor::STANDARD;
+  } else if (errorString == "TRUNCATED") {
+    return BoundingBoxFactor::TRUNCATED;
+  }
+  throw std::logic_error(
+      "The error type \"" + errorString +
+      "\" is not a valid option for initializing a BoundingBoxFactor");
+}
+
+/// returns the stored object equal to value, storing value if there is none
+template <class T, class EQUAL>
+boost::shared_ptr<T> internIn(std::vector<boost::shared_ptr<T> >& interned,
+                              const boost::shared_ptr<T>& value,
+                              EQUAL equal) {
+  for (const boost::shared_ptr<T>& existing : interned) {
+    if (existing == value || equal(*existing, *value)) {
+      return existing;
+    }
+  }
+  interned.push_back(value);
+  return value;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+FactorPool::FactorPool(size_t chunksPerBlock)
+    : chunksPerBlock_(std::max<size_t>(chunksPerBlock, 1)),
+      chunkSize_(0),
+      free_(nullptr),
+      allocated_(0) {}
+
+/* ************************************************************************* */
+FactorPool::~FactorPool() {
+  for (char* block : blocks_) {
+    ::operator delete(block);
+  }
+}
+
+/* ************************************************************************* */
+size_t FactorPool::allocated() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return allocated_;
+}
+
+/* ************************************************************************* */
+size_t FactorPool::capacity() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return blocks_.size() * chunksPerBlock_;
+}
+
+/* ************************************************************************* */
+void* FactorPool::allocate(size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (chunkSize_ == 0) {
+    chunkSize_ = (std::max(bytes, sizeof(void*)) + kAlignment - 1) /
+                 kAlignment * kAlignment;
+  }
+  if (bytes > chunkSize_) {
+    return ::operator new(bytes);
+  }
+
+  if (!free_) {
+    // the block is over allocated to align its first chunk
+    char* block = static_cast<char*>(
+        ::operator new(chunksPerBlock_ * chunkSize_ + kAlignment));
+    blocks_.push_back(block);
+    const size_t offset =
+        (kAlignment - reinterpret_cast<uintptr_t>(block) % kAlignment) %
+        kAlignment;
+    for (size_t i = chunksPerBlock_; i > 0; i--) {
+      void* chunk = block + offset + (i - 1) * chunkSize_;
+      *static_cast<void**>(chunk) = free_;
+      free_ = chunk;
+    }
+  }
+  void* chunk = free_;
+  free_ = *static_cast<void**>(chunk);
+  allocated_++;
+  return chunk;
+}
+
+/* ************************************************************************* */
+void FactorPool::deallocate(void* p, size_t bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (bytes > chunkSize_) {
+    ::operator delete(p);
+    return;
+  }
+  *static_cast<void**>(p) = free_;
+  free_ = p;
+  allocated_--;
+}
+
+/* ************************************************************************* */
+FrameFactorBuilder::FrameFactorBuilder(size_t blockSize)
+    : pool_(boost::make_shared<FactorPool>(blockSize)), gated_(false) {}
+
+/* ************************************************************************* */
+const FrameFactorBuilder::Camera& FrameFactorBuilder::camera(
+    uint32_t cameraId) const {
+  if (cameraId >= cameras_.size()) {
+    throw std::out_of_range("FrameFactorBuilder camera is not registered");
+  }
+  return cameras_[cameraId];
+}
+
+/* ************************************************************************* */
+uint32_t FrameFactorBuilder::addCamera(
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const gtsam::SharedNoiseModel& model,
+    const BoundingBoxFactor::MeasurementModel& errorType) {
+  return addCamera(calibration, boost::make_shared<ImageBoundary>(), model,
+                   errorType);
+}
+
+/* ************************************************************************* */
+uint32_t FrameFactorBuilder::addCamera(
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const gtsam::SharedNoiseModel& model, const std::string& errorString) {
+  return addCamera(calibration, model, measurementModel(errorString));
+}
+
+/* ************************************************************************* */
+uint32_t FrameFactorBuilder::addCamera(
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const boost::shared_ptr<ImageBoundary>& imageBoundary,
+    const gtsam::SharedNoiseModel& model, const std::string& errorString) {
+  return addCamera(calibration, imageBoundary, model,
+                   measurementModel(errorString));
+}
+
+/* ************************************************************************* */
+uint32_t FrameFactorBuilder::addCamera(
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const boost::shared_ptr<ImageBoundary>& imageBoundary,
+    const gtsam::SharedNoiseModel& model,
+    const BoundingBoxFactor::MeasurementModel& errorType) {
+  if (!calibration || !imageBoundary || !model) {
+    throw std::invalid_argument(
+        "FrameFactorBuilder camera needs a calibration, image area and "
+        "noise model");
+  }
+  Camera camera;
+  camera.calibration = internIn(
+      calibrations_, calibration,
+      [](const gtsam::Cal3_S2& a, const gtsam::Cal3_S2& b) {
+        return a.equals(b, kTolerance);
+      });
+  camera.imageBoundary =
+      internIn(imageBoundaries_, imageBoundary,
+               [](const ImageBoundary& a, const ImageBoundary& b) {
+                 return a.equals(b, kTolerance);
+               });
+  camera.model = intern(model);
+  camera.measurementModel = errorType;
+  cameras_.push_back(camera);
+  return uint32_t(cameras_.size() - 1);
+}
+
+/* ************************************************************************* */
+gtsam::SharedNoiseModel FrameFactorBuilder::intern(
+    const gtsam::SharedNoiseModel& model) {
+  return internIn(models_, model,
+                  [](const gtsam::noiseModel::Base& a,
+                     const gtsam::noiseModel::Base& b) {
+                    return a.equals(b, kTolerance);
+                  });
+}
+
+/* ************************************************************************* */
+void FrameFactorBuilder::add(gtsam::NonlinearFactorGraph& graph,
+                             const gtsam::Key& poseKey, uint32_t cameraId,
+                             const AlignedBox2Vector& boxes,
+                             const gtsam::KeyVector& quadricKeys) const {
+  if (boxes.size() != quadricKeys.size()) {
+    throw std::invalid_argument(
+        "FrameFactorBuilder needs one quadric key per box");
+  }
+  const Camera& frameCamera = camera(cameraId);
+  graph.reserve(graph.size() + boxes.size());
+  for (size_t i = 0; i < boxes.size(); i++) {
+    graph.push_back(factor(boxes[i], poseKey, quadricKeys[i], frameCamera));
+  }
+}
+
+/* ************************************************************************* */
+void FrameFactorBuilder::add(gtsam::NonlinearFactorGraph& graph,
+                             const gtsam::Key& poseKey, uint32_t cameraId,
+                             const gtsam::Matrix& boxes,
+                             const gtsam::KeyVector& quadricKeys) const {
+  if (boxes.cols() != 4 || size_t(boxes.rows()) != quadricKeys.size()) {
+    throw std::invalid_argument(
+        "FrameFactorBuilder needs boxes as rows of 4 and one quadric key per "
+        "box");
+  }
+  const Camera& frameCamera = camera(cameraId);
+  graph.reserve(graph.size() + quadricKeys.size());
+  for (size_t i = 0; i < quadricKeys.size(); i++) {
+    AlignedBox2 box(boxes(i, 0), boxes(i, 1), boxes(i, 2), boxes(i, 3));
+    graph.push_back(factor(box, poseKey, quadricKeys[i], frameCamera));
+  }
+}
+
+/* ************************************************************************* */
+gtsam::NonlinearFactorGraph FrameFactorBuilder::build(
+    const gtsam::Key& poseKey, uint32_t cameraId, const gtsam::Matrix& boxes,
+    const gtsam::KeyVector& quadricKeys) const {
+  gtsam::NonlinearFactorGraph graph;
+  add(graph, poseKey, cameraId, boxes, quadricKeys);
+  return graph;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<BoundingBoxFactor> FrameFactorBuilder::factor(
+    const AlignedBox2& measured, const gtsam::Key& poseKey,
+    const gtsam::Key& quadricKey, uint32_t cameraId) const {
+  return factor(measured, poseKey, quadricKey, camera(cameraId));
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<BoundingBoxFactor> FrameFactorBuilder::factor(
+    const AlignedBox2& measured, const gtsam::Key& poseKey,
+    const gtsam::Key& quadricKey, const Camera& camera) const {
+  boost::shared_ptr<BoundingBoxFactor> factor =
+      boost::allocate_shared<BoundingBoxFactor>(
+          FactorPoolAllocator<BoundingBoxFactor>(pool_), measured,
+          camera.calibration, camera.imageBoundary, poseKey, quadricKey,
+          camera.model, camera.measurementModel);
+  factor->setGated(gated_);
+  return factor;
+}
+
+}  // namespace gtsam_quadrics
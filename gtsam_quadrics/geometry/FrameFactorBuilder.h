@@ -0,0 +1,265 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file FrameFactorBuilder.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief builds the bounding box factors of whole frames from a pool
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+
+#include <boost/shared_ptr.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class FactorPool
+ * Fixed size chunks of memory carved from large blocks, with a free list.
+ * The chunk size is set by the first allocation, larger requests fall back
+ * to the heap. Chunks are aligned for Eigen's fixed size members.
+ * Allocating and freeing are thread-safe, so factors from the pool can be
+ * destroyed anywhere.
+ */
+class FactorPool {
+ protected:
+  size_t chunksPerBlock_;       ///< chunks allocated at once
+  size_t chunkSize_;            ///< bytes per chunk, 0 until first used
+  std::vector<char*> blocks_;   ///< memory owned by the pool
+  void* free_;                  ///< singly linked list of free chunks
+  size_t allocated_;            ///< chunks in use
+  std::mutex mutex_;
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Constructor from the number of chunks allocated at once */
+  explicit FactorPool(size_t chunksPerBlock = 1024);
+
+  /** Frees every block, the chunks must no longer be in use */
+  ~FactorPool();
+
+  FactorPool(const FactorPool&) = delete;
+  FactorPool& operator=(const FactorPool&) = delete;
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the number of chunks in use */
+  size_t allocated();
+
+  /** Returns the number of chunks the blocks can hold */
+  size_t capacity();
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /** Returns memory for the given number of bytes */
+  void* allocate(size_t bytes);
+
+  /** Returns memory from allocate to the pool */
+  void deallocate(void* p, size_t bytes);
+
+  /// @}
+};
+
+/**
+ * @class FactorPoolAllocator
+ * Standard allocator over a shared FactorPool, for boost::allocate_shared.
+ * The factor and its reference count are one chunk, and every factor
+ * keeps the pool alive until it is destroyed.
+ */
+template <class T>
+struct FactorPoolAllocator {
+  typedef T value_type;
+  template <class U>
+  struct rebind {
+    typedef FactorPoolAllocator<U> other;
+  };
+
+  boost::shared_ptr<FactorPool> pool;
+
+  explicit FactorPoolAllocator(const boost::shared_ptr<FactorPool>& pool)
+      : pool(pool) {}
+
+  template <class U>
+  FactorPoolAllocator(const FactorPoolAllocator<U>& other)
+      : pool(other.pool) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(pool->allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) { pool->deallocate(p, n * sizeof(T)); }
+
+  template <class U>
+  bool operator==(const FactorPoolAllocator<U>& other) const {
+    return pool == other.pool;
+  }
+
+  template <class U>
+  bool operator!=(const FactorPoolAllocator<U>& other) const {
+    return pool != other.pool;
+  }
+};
+
+/**
+ * @class FrameFactorBuilder
+ * Builds the BoundingBoxFactors of a frame in one call. Each camera is
+ * registered once with its calibration, image area and noise model, and
+ * every factor of the camera shares them: equal calibrations and noise
+ * models of different cameras are interned to one object, so building a
+ * factor copies no calibration or model and allocates one chunk from a
+ * FactorPool instead of the factor, its reference count and an image area.
+ * The factors are ordinary BoundingBoxFactors and can be optimized,
+ * serialized and removed like any other.
+ * Boxes of distorted cameras have to be undistorted first, register
+ * DistortedCamera::pinhole and imageBoundary as the camera.
+ * NOTE: building is not thread-safe, use one builder per thread
+ */
+class FrameFactorBuilder {
+ public:
+  /// the shared parameters of the factors of one camera
+  struct Camera {
+    boost::shared_ptr<gtsam::Cal3_S2> calibration;
+    boost::shared_ptr<ImageBoundary> imageBoundary;
+    gtsam::SharedNoiseModel model;
+    BoundingBoxFactor::MeasurementModel measurementModel;
+  };
+
+ protected:
+  std::vector<Camera> cameras_;  ///< cameras by id
+  std::vector<boost::shared_ptr<gtsam::Cal3_S2> > calibrations_;
+  std::vector<boost::shared_ptr<ImageBoundary> > imageBoundaries_;
+  std::vector<gtsam::SharedNoiseModel> models_;  ///< interned noise models
+  boost::shared_ptr<FactorPool> pool_;
+  bool gated_;  ///< built factors are gated, see BoundingBoxFactor::setGated
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Constructor from the number of factors allocated at once */
+  explicit FrameFactorBuilder(size_t blockSize = 1024);
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the number of registered cameras */
+  size_t nrCameras() const { return cameras_.size(); }
+
+  /** Returns a registered camera, throws std::out_of_range if missing */
+  const Camera& camera(uint32_t cameraId) const;
+
+  /** Returns the number of distinct noise models */
+  size_t nrNoiseModels() const { return models_.size(); }
+
+  /** Returns the pool the factors are allocated from */
+  const boost::shared_ptr<FactorPool>& pool() const { return pool_; }
+
+  /** Returns true if the built factors are gated */
+  bool gated() const { return gated_; }
+
+  /** Gates the factors built from now on, see BoundingBoxFactor::setGated */
+  void setGated(bool gated) { gated_ = gated; }
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /**
+   * Registers a camera, with a default image area for TRUNCATED factors
+   * @return the id of the camera, consecutive from 0
+   */
+  uint32_t addCamera(const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                     const gtsam::SharedNoiseModel& model,
+                     const BoundingBoxFactor::MeasurementModel& errorType =
+                         BoundingBoxFactor::STANDARD);
+
+  /** Registers a camera, see BoundingBoxFactor for the error strings */
+  uint32_t addCamera(const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                     const gtsam::SharedNoiseModel& model,
+                     const std::string& errorString);
+
+  /** Registers a camera with its image area */
+  uint32_t addCamera(const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                     const boost::shared_ptr<ImageBoundary>& imageBoundary,
+                     const gtsam::SharedNoiseModel& model,
+                     const BoundingBoxFactor::MeasurementModel& errorType =
+                         BoundingBoxFactor::STANDARD);
+
+  /** Registers a camera with its image area and an error string */
+  uint32_t addCamera(const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                     const boost::shared_ptr<ImageBoundary>& imageBoundary,
+                     const gtsam::SharedNoiseModel& model,
+                     const std::string& errorString);
+
+  /**
+   * Returns the interned noise model equal to the given one, adding it if
+   * there is none, so factors built with equal models share one object
+   */
+  gtsam::SharedNoiseModel intern(const gtsam::SharedNoiseModel& model);
+
+  /**
+   * Adds one factor per box to the graph, box i observing quadricKeys[i]
+   * from the pose. Throws std::invalid_argument if the sizes differ and
+   * std::out_of_range if the camera is missing.
+   */
+  void add(gtsam::NonlinearFactorGraph& graph, const gtsam::Key& poseKey,
+           uint32_t cameraId, const AlignedBox2Vector& boxes,
+           const gtsam::KeyVector& quadricKeys) const;
+
+  /** Adds one factor per row of boxes, as (xmin, ymin, xmax, ymax) */
+  void add(gtsam::NonlinearFactorGraph& graph, const gtsam::Key& poseKey,
+           uint32_t cameraId, const gtsam::Matrix& boxes,
+           const gtsam::KeyVector& quadricKeys) const;
+
+  /** Returns the factors of a frame as a new graph */
+  gtsam::NonlinearFactorGraph build(const gtsam::Key& poseKey,
+                                    uint32_t cameraId,
+                                    const gtsam::Matrix& boxes,
+                                    const gtsam::KeyVector& quadricKeys) const;
+
+  /** Returns one factor from the pool */
+  boost::shared_ptr<BoundingBoxFactor> factor(const AlignedBox2& measured,
+                                              const gtsam::Key& poseKey,
+                                              const gtsam::Key& quadricKey,
+                                              uint32_t cameraId) const;
+
+  /// @}
+
+ protected:
+  /** Returns one factor from the pool for a registered camera */
+  boost::shared_ptr<BoundingBoxFactor> factor(
+      const AlignedBox2& measured, const gtsam::Key& poseKey,
+      const gtsam::Key& quadricKey, const Camera& camera) const;
+};
+
+}  // namespace gtsam_quadrics
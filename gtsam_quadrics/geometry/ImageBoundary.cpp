@@ -0,0 +1,47 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ImageBoundary.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief the image area of a camera, used to truncate projected bounds
+ */
+
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+
+#include <iostream>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+ImageBoundary::ImageBoundary(const AlignedBox2& bounds)
+    : bounds_(bounds), lines_(bounds.lines()) {
+  corners_.reserve(4);
+  corners_.push_back(gtsam::Point2(bounds_.xmin(), bounds_.ymin()));
+  corners_.push_back(gtsam::Point2(bounds_.xmin(), bounds_.ymax()));
+  corners_.push_back(gtsam::Point2(bounds_.xmax(), bounds_.ymin()));
+  corners_.push_back(gtsam::Point2(bounds_.xmax(), bounds_.ymax()));
+}
+
+/* ************************************************************************* */
+void ImageBoundary::print(const std::string& s) const {
+  bounds_.print(s);
+}
+
+/* ************************************************************************* */
+bool ImageBoundary::equals(const ImageBoundary& other, double tol) const {
+  return bounds_.equals(other.bounds_, tol);
+}
+
+}  // namespace gtsam_quadrics
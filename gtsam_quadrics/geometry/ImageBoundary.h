@@ -0,0 +1,122 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file ImageBoundary.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief the image area of a camera, used to truncate projected bounds
+ */
+
+#pragma once
+
+#include <gtsam/base/Testable.h>
+#include <gtsam/geometry/Point2.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/split_member.hpp>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class ImageBoundary
+ * The image area of a camera (xmin,ymin,xmax,ymax), with the border lines
+ * and corners precomputed once so smartBounds does not rebuild them on
+ * every call. Immutable, share one instance between every factor using
+ * the same camera.
+ */
+class ImageBoundary {
+ protected:
+  AlignedBox2 bounds_;           ///< image area
+  gtsam::Point2Vector corners_;  ///< corners, xmin/xmax major, ymin first
+  Vector3Vector lines_;          ///< border lines, see AlignedBox2::lines
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Default constructor: a 640x480 image */
+  ImageBoundary() : ImageBoundary(640.0, 480.0) {}
+
+  /** Constructor from image dimensions in pixels */
+  ImageBoundary(const double& width, const double& height)
+      : ImageBoundary(AlignedBox2(0.0, 0.0, width, height)) {}
+
+  /** Constructor from the image area */
+  explicit ImageBoundary(const AlignedBox2& bounds);
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the image area */
+  const AlignedBox2& bounds() const { return bounds_; }
+
+  /** Returns the image width */
+  double width() const { return bounds_.width(); }
+
+  /** Returns the image height */
+  double height() const { return bounds_.height(); }
+
+  /** Returns the four image corners */
+  const gtsam::Point2Vector& corners() const { return corners_; }
+
+  /** Returns the four border lines */
+  const Vector3Vector& lines() const { return lines_; }
+
+  /// @}
+  /// @name Testable group traits
+  /// @{
+
+  /** Prints the image area with optional string */
+  void print(const std::string& s = "") const;
+
+  /** Compares two image boundaries */
+  bool equals(const ImageBoundary& other, double tol = 1e-9) const;
+
+  /// @}
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+
+  /** Saves the image area, the corners and lines are derived from it */
+  template <class ARCHIVE>
+  void save(ARCHIVE& ar, const unsigned int /*version*/) const {
+    ar << BOOST_SERIALIZATION_NVP(bounds_);
+  }
+
+  /** Loads the image area and recomputes the corners and lines */
+  template <class ARCHIVE>
+  void load(ARCHIVE& ar, const unsigned int /*version*/) {
+    AlignedBox2 bounds;
+    ar >> boost::serialization::make_nvp("bounds_", bounds);
+    *this = ImageBoundary(bounds);
+  }
+  BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+  /// @}
+};
+
+}  // namespace gtsam_quadrics
+
+/** \cond PRIVATE */
+// Add ImageBoundary to Testable group
+template <>
+struct gtsam::traits<gtsam_quadrics::ImageBoundary>
+    : public gtsam::Testable<gtsam_quadrics::ImageBoundary> {};
+/** \endcond */
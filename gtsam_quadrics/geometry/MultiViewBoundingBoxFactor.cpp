@@ -0,0 +1,133 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file MultiViewBoundingBoxFactor.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief bounding box factors sharing the quadric terms of one landmark
+ */
+
+#include <gtsam/base/serialization.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam_quadrics/geometry/MultiViewBoundingBoxFactor.h>
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+BOOST_CLASS_EXPORT(gtsam_quadrics::MultiViewBoundingBoxFactor)
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+MultiViewBoundingBoxFactor::MultiViewBoundingBoxFactor(
+    const AlignedBox2& measured,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const boost::shared_ptr<ImageBoundary>& imageBoundary,
+    const gtsam::Key& poseKey, const gtsam::Key& quadricKey,
+    const gtsam::SharedNoiseModel& model,
+    const boost::shared_ptr<QuadricContextCache>& cache,
+    const MeasurementModel& errorType)
+    : Base(measured, calibration, imageBoundary, poseKey, quadricKey, model,
+           errorType),
+      cache_(cache) {
+  if (!cache_) {
+    throw std::invalid_argument(
+        "MultiViewBoundingBoxFactor requires a quadric context cache");
+  }
+}
+
+/* ************************************************************************* */
+MultiViewBoundingBoxFactor::MultiViewBoundingBoxFactor(
+    const AlignedBox2& measured,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const boost::shared_ptr<ImageBoundary>& imageBoundary,
+    const gtsam::Key& poseKey, const gtsam::Key& quadricKey,
+    const gtsam::SharedNoiseModel& model,
+    const boost::shared_ptr<QuadricContextCache>& cache,
+    const std::string& errorString)
+    : Base(measured, calibration, imageBoundary, poseKey, quadricKey, model,
+           errorString),
+      cache_(cache) {
+  if (!cache_) {
+    throw std::invalid_argument(
+        "MultiViewBoundingBoxFactor requires a quadric context cache");
+  }
+}
+
+/* ************************************************************************* */
+gtsam::NonlinearFactorGraph MultiViewBoundingBoxFactor::create(
+    const AlignedBox2Vector& measured,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const boost::shared_ptr<ImageBoundary>& imageBoundary,
+    const gtsam::KeyVector& poseKeys, const gtsam::Key& quadricKey,
+    const gtsam::SharedNoiseModel& model, const MeasurementModel& errorType) {
+  if (measured.size() != poseKeys.size()) {
+    throw std::invalid_argument(
+        "MultiViewBoundingBoxFactor requires one pose key per measurement");
+  }
+  gtsam::KeyVector sorted = poseKeys;
+  std::sort(sorted.begin(), sorted.end());
+  if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+    throw std::invalid_argument(
+        "MultiViewBoundingBoxFactor requires each pose key to be unique");
+  }
+
+  boost::shared_ptr<QuadricContextCache> cache(new QuadricContextCache());
+  gtsam::NonlinearFactorGraph graph;
+  graph.reserve(measured.size());
+  for (size_t i = 0; i < measured.size(); i++) {
+    graph.emplace_shared<MultiViewBoundingBoxFactor>(
+        measured[i], calibration, imageBoundary, poseKeys[i], quadricKey,
+        model, cache, errorType);
+  }
+  return graph;
+}
+
+/* ************************************************************************* */
+gtsam::Vector MultiViewBoundingBoxFactor::evaluateError(
+    const gtsam::Pose3& pose, const ConstrainedDualQuadric& quadric,
+    boost::optional<gtsam::Matrix&> H1,
+    boost::optional<gtsam::Matrix&> H2) const {
+  if (!this->inView(pose, quadric)) {
+    return this->evaluateHidden(H1, H2);
+  }
+  return this->evaluateContext(cache_->context(quadric), pose, H1, H2);
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<gtsam::GaussianFactor> MultiViewBoundingBoxFactor::linearize(
+    const gtsam::Values& values) const {
+  const gtsam::noiseModel::Gaussian* gaussian =
+      dynamic_cast<const gtsam::noiseModel::Gaussian*>(noiseModel().get());
+  if (!gaussian || gaussian->isConstrained()) {
+    return Base::linearize(values);
+  }
+
+  const gtsam::Pose3& pose = values.at<gtsam::Pose3>(this->poseKey());
+  const ConstrainedDualQuadric& quadric =
+      values.at<ConstrainedDualQuadric>(this->objectKey());
+  if (!this->inView(pose, quadric)) {
+    return this->linearizeHidden(*gaussian);
+  }
+  return this->linearizeContext(cache_->context(quadric), pose, *gaussian);
+}
+
+/* ************************************************************************* */
+void MultiViewBoundingBoxFactor::print(
+    const std::string& s, const gtsam::KeyFormatter& keyFormatter) const {
+  Base::print(s + "MultiView", keyFormatter);
+}
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,169 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file MultiViewBoundingBoxFactor.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief bounding box factors sharing the quadric terms of one landmark
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/QuadricContext.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+#include <string>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class MultiViewBoundingBoxFactor
+ * A BoundingBoxFactor for one detection of a landmark that shares the
+ * quadric matrix and its jacobian with the other detections of the landmark
+ * through a QuadricContextCache, so they are computed once per quadric value
+ * and thread rather than once per detection, without any shared state on
+ * the evaluation path. Each detection stays a separate factor
+ * between its pose and the quadric and linearizes to its own 4x15
+ * JacobianFactor, see create() for building all detections of a landmark.
+ */
+class MultiViewBoundingBoxFactor : public BoundingBoxFactor {
+ protected:
+  boost::shared_ptr<QuadricContextCache> cache_;  ///< shared quadric terms
+  typedef BoundingBoxFactor Base;
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Default constructor */
+  MultiViewBoundingBoxFactor() : cache_(new QuadricContextCache()) {}
+
+  /**
+   * Constructor from a detection and the cache of its landmark
+   * @param cache the quadric terms shared by every detection of the landmark
+   * @throws std::invalid_argument if the cache is null
+   */
+  MultiViewBoundingBoxFactor(
+      const AlignedBox2& measured,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      const boost::shared_ptr<ImageBoundary>& imageBoundary,
+      const gtsam::Key& poseKey, const gtsam::Key& quadricKey,
+      const gtsam::SharedNoiseModel& model,
+      const boost::shared_ptr<QuadricContextCache>& cache,
+      const MeasurementModel& errorType = STANDARD);
+
+  /** Constructor with error type "STANDARD"/"TRUNCATED" */
+  MultiViewBoundingBoxFactor(
+      const AlignedBox2& measured,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      const boost::shared_ptr<ImageBoundary>& imageBoundary,
+      const gtsam::Key& poseKey, const gtsam::Key& quadricKey,
+      const gtsam::SharedNoiseModel& model,
+      const boost::shared_ptr<QuadricContextCache>& cache,
+      const std::string& errorString);
+
+  /**
+   * Builds one factor per detection of a landmark, all sharing one cache
+   * @param measured the measured boxes, one per pose key
+   * @param poseKeys the pose each box was detected from
+   * @param model the 4-dimensional noise model of each box
+   * @throws std::invalid_argument unless there is one unique pose key per box
+   */
+  static gtsam::NonlinearFactorGraph create(
+      const AlignedBox2Vector& measured,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      const boost::shared_ptr<ImageBoundary>& imageBoundary,
+      const gtsam::KeyVector& poseKeys, const gtsam::Key& quadricKey,
+      const gtsam::SharedNoiseModel& model,
+      const MeasurementModel& errorType = STANDARD);
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the quadric terms shared with the other detections */
+  const boost::shared_ptr<QuadricContextCache>& cache() const {
+    return cache_;
+  }
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /** Evaluates the error as BoundingBoxFactor, with the shared quadric */
+  gtsam::Vector evaluateError(
+      const gtsam::Pose3& pose, const ConstrainedDualQuadric& quadric,
+      boost::optional<gtsam::Matrix&> H1 = boost::none,
+      boost::optional<gtsam::Matrix&> H2 = boost::none) const override;
+
+  /** Linearizes as BoundingBoxFactor, with the shared quadric */
+  boost::shared_ptr<gtsam::GaussianFactor> linearize(
+      const gtsam::Values& values) const override;
+
+  /** Returns a deep copy of the factor sharing the same cache */
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(
+            new MultiViewBoundingBoxFactor(*this)));
+  }
+
+  /// @}
+  /// @name Testable group traits
+  /// @{
+
+  /** Prints the factor with optional string */
+  void print(const std::string& s = "",
+             const gtsam::KeyFormatter& keyFormatter =
+                 gtsam::DefaultKeyFormatter) const override;
+
+  /** Returns true if equal as BoundingBoxFactor, the cache is not compared */
+  bool equals(const MultiViewBoundingBoxFactor& other,
+              double tol = 1e-9) const {
+    return Base::equals(other, tol);
+  }
+
+  /// @}
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function, factors of one archive keep sharing a cache */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& boost::serialization::make_nvp(
+        "BoundingBoxFactor", boost::serialization::base_object<Base>(*this));
+    ar& BOOST_SERIALIZATION_NVP(cache_);
+  }
+
+  /// @}
+};
+
+}  // namespace gtsam_quadrics
+
+/** \cond PRIVATE */
+// Add to testable group
+template <>
+struct gtsam::traits<gtsam_quadrics::MultiViewBoundingBoxFactor>
+    : public gtsam::Testable<gtsam_quadrics::MultiViewBoundingBoxFactor> {};
+/** \endcond */
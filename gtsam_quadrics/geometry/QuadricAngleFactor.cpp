@@ -17,12 +17,15 @@
  */
 
 #include <gtsam/base/numericalDerivative.h>
+#include <gtsam/base/serialization.h>
 #include <gtsam_quadrics/geometry/QuadricAngleFactor.h>
 
 #include <boost/bind/bind.hpp>
 
 #define NUMERICAL_DERIVATIVE false
 
+BOOST_CLASS_EXPORT(gtsam_quadrics::QuadricAngleFactor)
+
 using namespace std;
 
 namespace gtsam_quadrics {
@@ -33,16 +36,29 @@ gtsam::Vector QuadricAngleFactor::evaluateError(
     boost::optional<gtsam::Matrix&> H) const {
   // evaluate error
   gtsam::Rot3 QRot = quadric.pose().rotation();
-  gtsam::Vector3 error = measured_.localCoordinates(QRot);
-  // Rot3::LocalCoordinates(quadric.pose().rotation());
 
-  std::function<gtsam::Vector(const ConstrainedDualQuadric&)> funPtr(
-      boost::bind(&QuadricAngleFactor::evaluateError, this,
-                  boost::placeholders::_1, boost::none));
+  if (NUMERICAL_DERIVATIVE) {
+    gtsam::Vector3 error = measured_.localCoordinates(QRot);
+    if (H) {
+      std::function<gtsam::Vector(const ConstrainedDualQuadric&)> funPtr(
+          boost::bind(&QuadricAngleFactor::evaluateError, this,
+                      boost::placeholders::_1, boost::none));
+      Eigen::Matrix<double, 3, 9> de_dr =
+          gtsam::numericalDerivative11(funPtr, quadric, 1e-6);
+      *H = de_dr;
+    }
+    return error;
+  }
+
+  // the error only depends on the quadric rotation, which is retracted
+  // directly by the first 3 elements of the quadric tangent vector
+  gtsam::Matrix33 de_dR;
+  gtsam::Vector3 error =
+      measured_.localCoordinates(QRot, boost::none, H ? &de_dR : 0);
   if (H) {
-    Eigen::Matrix<double, 3, 9> de_dr =
-        gtsam::numericalDerivative11(funPtr, quadric, 1e-6);
-    *H = de_dr;
+    Eigen::Matrix<double, 3, 9> de_dq = Eigen::Matrix<double, 3, 9>::Zero();
+    de_dq.leftCols<3>() = de_dR;
+    *H = de_dq;
   }
   return error;
 }
@@ -48,6 +48,9 @@ class QuadricAngleFactor
   /// @name Constructors and named constructors
   /// @{
 
+  /** Default constructor */
+  QuadricAngleFactor() {}
+
   /** Constructor from measured box, calbration, dimensions and posekey,
    * quadrickey, noisemodel */
   QuadricAngleFactor(const gtsam::Key& quadricKey, const gtsam::Rot3 measured,
@@ -58,12 +61,16 @@ class QuadricAngleFactor
   /// @name Class methods
   /// @{
 
+  /** Returns a deep copy of the factor, as used by rekey */
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new QuadricAngleFactor(*this)));
+  }
+
   /**
-   * Evaluate the error between a quadric and 3D pose
-   * @param pose the 6DOF camera position
+   * Evaluate the error between the quadric orientation and the measurement
    * @param quadric the constrained dual quadric
-   * @param H1 the derivative of the error wrt camera pose (4x6)
-   * @param H2 the derivative of the error wrt quadric (4x9)
+   * @param H the derivative of the error wrt quadric (3x9)
    */
   gtsam::Vector evaluateError(
       const ConstrainedDualQuadric& quadric,
@@ -80,6 +87,23 @@ class QuadricAngleFactor
 
   /** Returns true if equal keys, measurement, noisemodel and calibration */
   bool equals(const QuadricAngleFactor& other, double tol = 1e-9) const;
+
+  /// @}
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& boost::serialization::make_nvp(
+        "NoiseModelFactor1", boost::serialization::base_object<Base>(*this));
+    ar& BOOST_SERIALIZATION_NVP(measured_);
+  }
+
+  /// @}
 };
 
 }  // namespace gtsam_quadrics
@@ -19,6 +19,12 @@
 #include <gtsam/base/numericalDerivative.h>
 #include <gtsam_quadrics/base/Utilities.h>
 #include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricKernels.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 
 namespace gtsam_quadrics {
 
@@ -41,38 +47,365 @@ DualConic QuadricCamera::project(
     const ConstrainedDualQuadric& quadric, const gtsam::Pose3& pose,
     const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
     gtsam::OptionalJacobian<9, 9> dC_dq, gtsam::OptionalJacobian<9, 6> dC_dx) {
+  return QuadricCamera::project(QuadricContext(quadric, bool(dC_dq)), pose,
+                                calibration, dC_dq, dC_dx);
+}
+
+/* ************************************************************************* */
+DualConic QuadricCamera::project(
+    const QuadricContext& context, const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    gtsam::OptionalJacobian<9, 9> dC_dq, gtsam::OptionalJacobian<9, 6> dC_dx) {
+  return QuadricCamera::project(context, CameraView(pose, *calibration), dC_dq,
+                                dC_dx);
+}
+
+/* ************************************************************************* */
+DualConic QuadricCamera::project(const QuadricContext& context,
+                                 const CameraView& view,
+                                 gtsam::OptionalJacobian<9, 9> dC_dq,
+                                 gtsam::OptionalJacobian<9, 6> dC_dx) {
   // first retract quadric and pose to compute dX:/dx and dQ:/dq
-  gtsam::Matrix3 K = calibration->K();
-  gtsam::Matrix4 Xi = pose.inverse().matrix();
-  static gtsam::Matrix34 I34 = gtsam::Matrix::Identity(3, 4);
-  gtsam::Matrix34 P = K * I34 * Xi;
-  gtsam::Matrix4 Q = quadric.matrix();
-  gtsam::Matrix3 C = P * Q * P.transpose();
+  const gtsam::Matrix3& K = view.K;
+  const gtsam::Matrix4& Xi = view.Xi;
+  const gtsam::Matrix34& P = view.P;
+  const gtsam::Matrix4& Q = context.Q();
+  gtsam::Matrix3 C = kernels::projectQuadric<double>(P, Q);
   DualConic dualConic(C);
 
   if (dC_dq) {
-    Eigen::Matrix<double, 9, 16> dC_dQ = utils::kron(P, P);
-    Eigen::Matrix<double, 16, 9> dQ_dq;
-    quadric.matrix(dQ_dq);  // NOTE: this recalculates quadric.matrix
-    *dC_dq = dC_dQ * dQ_dq;
+    *dC_dq = kernels::projectQuadricJacobian<double>(P, context.dQ_dq());
   }
-
   if (dC_dx) {
-    using utils::kron;
-    static gtsam::Matrix33 I33 = gtsam::Matrix::Identity(3, 3);
-    static gtsam::Matrix44 I44 = gtsam::Matrix::Identity(4, 4);
-    Eigen::Matrix<double, 9, 12> dC_dP =
-        kron(I33, P * Q) * utils::TVEC(3, 4) + kron(P * Q.transpose(), I33);
-    Eigen::Matrix<double, 12, 16> dP_dXi = kron(I44, K * I34);
-    Eigen::Matrix<double, 16, 16> dXi_dX = -kron(Xi.transpose(), Xi);
-    Eigen::Matrix<double, 16, 6> dX_dx;
-    utils::matrix(pose, dX_dx);
-    *dC_dx = dC_dP * dP_dXi * dXi_dX * dX_dx;
+    *dC_dx = kernels::projectPoseJacobian<double>(K, Xi, Q, P);
   }
 
   return dualConic;
 }
 
+/* ************************************************************************* */
+ProjectionStatus QuadricCamera::tryProject(
+    const ConstrainedDualQuadric& quadric, const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    DualConic& dualConic, gtsam::OptionalJacobian<9, 9> dC_dq,
+    gtsam::OptionalJacobian<9, 6> dC_dx) {
+  return QuadricCamera::tryProject(QuadricContext(quadric, bool(dC_dq)), pose,
+                                   calibration, dualConic, dC_dq, dC_dx);
+}
+
+/* ************************************************************************* */
+ProjectionStatus QuadricCamera::tryProject(
+    const QuadricContext& context, const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    DualConic& dualConic, gtsam::OptionalJacobian<9, 9> dC_dq,
+    gtsam::OptionalJacobian<9, 6> dC_dx) {
+  return QuadricCamera::tryProject(context, CameraView(pose, *calibration),
+                                   dualConic, dC_dq, dC_dx);
+}
+
+/* ************************************************************************* */
+ProjectionStatus QuadricCamera::tryProject(
+    const QuadricContext& context, const CameraView& view,
+    DualConic& dualConic, gtsam::OptionalJacobian<9, 9> dC_dq,
+    gtsam::OptionalJacobian<9, 6> dC_dx) {
+  // check pose-quadric pair
+  if (context.isBehind(view.pose)) {
+    return ProjectionStatus::BEHIND_CAMERA;
+  }
+  if (context.contains(view.pose)) {
+    return ProjectionStatus::CAMERA_INSIDE;
+  }
+
+  // project quadric taking into account partial derivatives
+  dualConic = QuadricCamera::project(context, view, dC_dq, dC_dx);
+
+  // check dual conic is valid for error function
+  if (!dualConic.isEllipse()) {
+    return ProjectionStatus::NON_ELLIPSE;
+  }
+  return ProjectionStatus::SUCCESS;
+}
+
+/* ************************************************************************* */
+QuadricCamera::Visibility QuadricCamera::checkVisible(
+    const ConstrainedDualQuadric& quadric, const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const ImageBoundary* imageBoundary) {
+  // the centre and half extents of the quadric in the camera frame
+  const gtsam::Matrix3 cameraR = pose.rotation().matrix().transpose();
+  const gtsam::Pose3 quadricPose = quadric.pose();
+  const gtsam::Vector3 center =
+      cameraR * (quadricPose.translation() - pose.translation());
+  if (center.z() < 0.0) {
+    return HIDDEN;
+  }
+  const gtsam::Vector3 h = kernels::halfExtents<double>(
+      cameraR * quadricPose.rotation().matrix(), quadric.radii());
+  if (center.z() - h.z() <= 0.0) {
+    return UNDECIDED;
+  }
+  if (!imageBoundary) {
+    return VISIBLE;
+  }
+
+  // the projected corners of the bounds contain the conic
+  double xmin = std::numeric_limits<double>::infinity(), xmax = -xmin;
+  double ymin = xmin, ymax = -xmin;
+  for (int i = 0; i < 8; i++) {
+    const gtsam::Vector3 corner =
+        center + gtsam::Vector3(i & 1 ? h.x() : -h.x(),
+                                i & 2 ? h.y() : -h.y(),
+                                i & 4 ? h.z() : -h.z());
+    const gtsam::Point2 p = calibration->uncalibrate(
+        gtsam::Point2(corner.x() / corner.z(), corner.y() / corner.z()));
+    xmin = std::min(xmin, p.x());
+    xmax = std::max(xmax, p.x());
+    ymin = std::min(ymin, p.y());
+    ymax = std::max(ymax, p.y());
+  }
+  const AlignedBox2 bounds(xmin, ymin, xmax, ymax);
+  if (imageBoundary->bounds().contains(bounds)) {
+    return VISIBLE;
+  }
+  return imageBoundary->bounds().intersects(bounds) ? UNDECIDED : HIDDEN;
+}
+
+/* ************************************************************************* */
+ProjectionStatus QuadricCamera::tryProjectUncertain(
+    const ConstrainedDualQuadric& quadric, const gtsam::Matrix& covariance,
+    const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    AlignedBox2& bounds, gtsam::Matrix& boundsCovariance,
+    const gtsam::Matrix& poseCovariance) {
+  const bool uncertainPose = poseCovariance.size() > 0;
+  if (covariance.rows() != 9 || covariance.cols() != 9 ||
+      (uncertainPose &&
+       (poseCovariance.rows() != 6 || poseCovariance.cols() != 6))) {
+    throw std::invalid_argument(
+        "QuadricCamera::tryProjectUncertain requires a 9x9 quadric and an "
+        "empty or 6x6 pose covariance");
+  }
+
+  DualConic dualConic;
+  Eigen::Matrix<double, 9, 9> dC_dq;
+  Eigen::Matrix<double, 9, 6> dC_dx;
+  ProjectionStatus status = QuadricCamera::tryProject(
+      quadric, pose, calibration, dualConic, dC_dq,
+      uncertainPose ? &dC_dx : 0);
+  if (status != ProjectionStatus::SUCCESS) {
+    return status;
+  }
+
+  Eigen::Matrix<double, 4, 9> db_dC;
+  bounds = dualConic.bounds(db_dC);
+  const Eigen::Matrix<double, 4, 9> db_dq = db_dC * dC_dq;
+  boundsCovariance = db_dq * covariance * db_dq.transpose();
+  if (uncertainPose) {
+    const Eigen::Matrix<double, 4, 6> db_dx = db_dC * dC_dx;
+    boundsCovariance += db_dx * poseCovariance * db_dx.transpose();
+  }
+  return ProjectionStatus::SUCCESS;
+}
+
+/* ************************************************************************* */
+AlignedBox2 QuadricCamera::inflate(const AlignedBox2& bounds,
+                                   const gtsam::Matrix& boundsCovariance,
+                                   double sigmas) {
+  const gtsam::Vector4 margin =
+      sigmas * boundsCovariance.diagonal().cwiseMax(0.0).cwiseSqrt();
+  return AlignedBox2(bounds.xmin() - margin(0), bounds.ymin() - margin(1),
+                     bounds.xmax() + margin(2), bounds.ymax() + margin(3));
+}
+
+/* ************************************************************************* */
+std::vector<ProjectionStatus> QuadricCamera::projectUncertainBatch(
+    const std::vector<ConstrainedDualQuadric>& quadrics,
+    const std::vector<gtsam::Matrix>& covariances, const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration, double sigmas,
+    AlignedBox2Vector& bounds) {
+  if (quadrics.size() != covariances.size()) {
+    throw std::invalid_argument(
+        "QuadricCamera::projectUncertainBatch requires one covariance per "
+        "quadric");
+  }
+  std::vector<ProjectionStatus> status(quadrics.size());
+  bounds.resize(quadrics.size());
+  gtsam::Matrix boundsCovariance;
+  for (size_t i = 0; i < quadrics.size(); i++) {
+    status[i] = QuadricCamera::tryProjectUncertain(
+        quadrics[i], covariances[i], pose, calibration, bounds[i],
+        boundsCovariance);
+    if (status[i] == ProjectionStatus::SUCCESS) {
+      bounds[i] = QuadricCamera::inflate(bounds[i], boundsCovariance, sigmas);
+    }
+  }
+  return status;
+}
+
+/* ************************************************************************* */
+namespace {
+
+/**
+ * QuadricCamera::projectBatch in the precision of the output
+ * @param gather sets the rotation, translation and squared radii of quadric i
+ */
+template <typename Scalar, typename Gather>
+void projectBatchImpl(size_t n, const Gather& gather, const gtsam::Pose3& pose,
+                      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                      BatchProjectionT<Scalar>& projections) {
+  typedef kernels::Matrix3T<Scalar> Matrix3;
+  typedef kernels::Vector3T<Scalar> Vector3;
+  projections.resize(n);
+  const kernels::Matrix34T<Scalar> P =
+      QuadricCamera::transformToImage(pose, calibration).cast<Scalar>();
+  const Matrix3 cameraR = pose.rotation().matrix().cast<Scalar>();
+  const Vector3 cameraT = pose.translation().cast<Scalar>();
+
+  // gather each quadric into conic entries and check the pose-quadric pair
+  Matrix3 R;
+  Vector3 t, s;
+  for (size_t i = 0; i < n; i++) {
+    gather(i, R, t, s);
+
+    // C = P * Z * Qc * Z' * P' = sum_j s_j * m_j * m_j' - m_3 * m_3'
+    // where m_j are the columns of M = P * Z
+    kernels::Matrix34T<Scalar> M;
+    M.template leftCols<3>() = P.template leftCols<3>() * R;
+    M.col(3) = P.template leftCols<3>() * t + P.col(3);
+    Matrix3 C = M.template leftCols<3>() * s.asDiagonal() *
+                    M.template leftCols<3>().transpose() -
+                M.col(3) * M.col(3).transpose();
+    projections.c00[i] = C(0, 0);
+    projections.c01[i] = C(0, 1);
+    projections.c02[i] = C(0, 2);
+    projections.c11[i] = C(1, 1);
+    projections.c12[i] = C(1, 2);
+    projections.c22[i] = C(2, 2);
+
+    // closed forms of isBehind and contains
+    Scalar depth = cameraR.col(2).dot(t - cameraT);
+    Vector3 p = R.transpose() * (cameraT - t);
+    Scalar pointError = (p.array().square() / s.array()).sum() - Scalar(1);
+    if (depth < Scalar(0)) {
+      projections.status[i] = ProjectionStatus::BEHIND_CAMERA;
+    } else if (pointError <= Scalar(0)) {
+      projections.status[i] = ProjectionStatus::CAMERA_INSIDE;
+    } else {
+      projections.status[i] = ProjectionStatus::SUCCESS;
+    }
+  }
+
+  // bounds and ellipse check over the contiguous conic entries
+  const Scalar* c00 = projections.c00.data();
+  const Scalar* c01 = projections.c01.data();
+  const Scalar* c02 = projections.c02.data();
+  const Scalar* c11 = projections.c11.data();
+  const Scalar* c12 = projections.c12.data();
+  const Scalar* c22 = projections.c22.data();
+  Scalar* xmin = projections.xmin.data();
+  Scalar* ymin = projections.ymin.data();
+  Scalar* xmax = projections.xmax.data();
+  Scalar* ymax = projections.ymax.data();
+  ProjectionStatus* status = projections.status.data();
+  for (size_t i = 0; i < n; i++) {
+    // see kernels::conicBounds and kernels::isEllipse, unrolled over the
+    // unique entries so the loop vectorizes
+    Scalar f = std::sqrt(c02[i] * c02[i] - c22[i] * c00[i]);
+    Scalar g = std::sqrt(c12[i] * c12[i] - c22[i] * c11[i]);
+    xmin[i] = (c02[i] + f) / c22[i];
+    xmax[i] = (c02[i] - f) / c22[i];
+    ymin[i] = (c12[i] + g) / c22[i];
+    ymax[i] = (c12[i] - g) / c22[i];
+
+    Scalar minor = c00[i] * c11[i] - c01[i] * c01[i];
+    Scalar det = c00[i] * (c11[i] * c22[i] - c12[i] * c12[i]) -
+                 c01[i] * (c01[i] * c22[i] - c12[i] * c02[i]) +
+                 c02[i] * (c01[i] * c12[i] - c11[i] * c02[i]);
+    bool isEllipse = det * c22[i] > Scalar(0) && minor != Scalar(0);
+    if (status[i] == ProjectionStatus::SUCCESS && !isEllipse) {
+      status[i] = ProjectionStatus::NON_ELLIPSE;
+    }
+  }
+}
+
+/// QuadricCamera::projectBatch of an array of quadrics
+template <typename Scalar>
+void projectQuadrics(const ConstrainedDualQuadric* quadrics, size_t n,
+                     const gtsam::Pose3& pose,
+                     const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                     BatchProjectionT<Scalar>& projections) {
+  auto gather = [quadrics](size_t i, kernels::Matrix3T<Scalar>& R,
+                           kernels::Vector3T<Scalar>& t,
+                           kernels::Vector3T<Scalar>& s) {
+    const gtsam::Pose3 quadricPose = quadrics[i].pose();
+    R = quadricPose.rotation().matrix().cast<Scalar>();
+    t = quadricPose.translation().cast<Scalar>();
+    s = quadrics[i].radii().array().square().cast<Scalar>();
+  };
+  projectBatchImpl<Scalar>(n, gather, pose, calibration, projections);
+}
+
+/// QuadricCamera::projectBatch of a store, in the precision of the store
+template <typename Scalar>
+void projectStore(const QuadricStoreT<Scalar>& store, const gtsam::Pose3& pose,
+                  const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                  BatchProjectionT<Scalar>& projections) {
+  auto gather = [&store](size_t i, kernels::Matrix3T<Scalar>& R,
+                         kernels::Vector3T<Scalar>& t,
+                         kernels::Vector3T<Scalar>& s) {
+    R = store.rotation(i);
+    t = store.translation(i);
+    s = store.radii(i).array().square();
+  };
+  projectBatchImpl<Scalar>(store.size(), gather, pose, calibration,
+                           projections);
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+void QuadricCamera::projectBatch(
+    const ConstrainedDualQuadric* quadrics, size_t n, const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    BatchProjection& projections) {
+  projectQuadrics(quadrics, n, pose, calibration, projections);
+}
+
+/* ************************************************************************* */
+void QuadricCamera::projectBatch(
+    const ConstrainedDualQuadric* quadrics, size_t n, const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    BatchProjectionf& projections) {
+  projectQuadrics(quadrics, n, pose, calibration, projections);
+}
+
+/* ************************************************************************* */
+void QuadricCamera::projectBatch(
+    const QuadricStore& store, const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    BatchProjection& projections) {
+  projectStore(store, pose, calibration, projections);
+}
+
+/* ************************************************************************* */
+void QuadricCamera::projectBatch(
+    const QuadricStoref& store, const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    BatchProjectionf& projections) {
+  projectStore(store, pose, calibration, projections);
+}
+
+/* ************************************************************************* */
+BatchProjection QuadricCamera::projectBatch(
+    const std::vector<ConstrainedDualQuadric>& quadrics,
+    const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration) {
+  BatchProjection projections;
+  QuadricCamera::projectBatch(quadrics.data(), quadrics.size(), pose,
+                              calibration, projections);
+  return projections;
+}
+
 /* ************************************************************************* */
 std::vector<gtsam::Vector4> QuadricCamera::project(
     const AlignedBox2& box, const gtsam::Pose3& pose,
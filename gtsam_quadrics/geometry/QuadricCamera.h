@@ -22,17 +22,53 @@
 #include <gtsam/base/types.h>
 #include <gtsam/geometry/Cal3_S2.h>
 #include <gtsam/geometry/PinholePose.h>
+#include <gtsam_quadrics/base/ProjectionStatus.h>
+#include <gtsam_quadrics/geometry/BatchProjection.h>
 #include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
 #include <gtsam_quadrics/geometry/DualConic.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/QuadricContext.h>
+#include <gtsam_quadrics/geometry/QuadricStore.h>
+
+#include <boost/make_shared.hpp>
+#include <vector>
 
 namespace gtsam_quadrics {
 
+/**
+ * @class CameraView
+ * The matrices of a camera pose and calibration used by every projection
+ * into that camera, computed once, e.g. per camera of a rig at one
+ * timestamp. The quadric counterpart is QuadricContext.
+ */
+struct CameraView {
+  gtsam::Pose3 pose;     ///< camera pose in the world frame
+  gtsam::Matrix3 K;      ///< calibration matrix
+  gtsam::Matrix4 Xi;     ///< inverse of the camera pose
+  gtsam::Matrix34 P;     ///< projection matrix K * I34 * Xi
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /** Constructor from camera pose and calibration */
+  CameraView(const gtsam::Pose3& pose, const gtsam::Cal3_S2& calibration)
+      : pose(pose), K(calibration.K()), Xi(pose.inverse().matrix()) {
+    P = K * Xi.topRows<3>();
+  }
+};
+
 /**
  * @class QuadricCamera
  * A camera that projects quadrics
  */
 class QuadricCamera {
  public:
+  /// the result of checkVisible
+  enum Visibility {
+    VISIBLE,   ///< the quadric projects to a valid ellipse and bounds
+    HIDDEN,    ///< the projection or its bounds cannot be evaluated
+    UNDECIDED  ///< only the projection itself can tell
+  };
+
   /** Static projection matrix */
   static gtsam::Matrix34 transformToImage(
       const gtsam::Pose3& pose,
@@ -49,10 +85,311 @@ class QuadricCamera {
                            gtsam::OptionalJacobian<9, 9> dC_dq = boost::none,
                            gtsam::OptionalJacobian<9, 6> dC_dx = boost::none);
 
+  /**
+   * Project a memoized quadric, reusing its matrix and jacobian
+   * @param context the 3D quadric surface to be projected
+   * @return the projected dual conic
+   */
+  static DualConic project(const QuadricContext& context,
+                           const gtsam::Pose3& pose,
+                           const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                           gtsam::OptionalJacobian<9, 9> dC_dq = boost::none,
+                           gtsam::OptionalJacobian<9, 6> dC_dx = boost::none);
+
+  /** Project a memoized quadric into a precomputed camera view */
+  static DualConic project(const QuadricContext& context,
+                           const CameraView& view,
+                           gtsam::OptionalJacobian<9, 9> dC_dq = boost::none,
+                           gtsam::OptionalJacobian<9, 6> dC_dx = boost::none);
+
+  /**
+   * Project a quadric without throwing, first checking that the pose-quadric
+   * pair can be projected to an ellipse
+   * @param quadric the 3D quadric surface to be projected
+   * @param dualConic set to the projected dual conic
+   * @return SUCCESS, or the reason the projection is invalid
+   */
+  static ProjectionStatus tryProject(
+      const ConstrainedDualQuadric& quadric, const gtsam::Pose3& pose,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      DualConic& dualConic, gtsam::OptionalJacobian<9, 9> dC_dq = boost::none,
+      gtsam::OptionalJacobian<9, 6> dC_dx = boost::none);
+
+  /** Project a memoized quadric without throwing, see tryProject */
+  static ProjectionStatus tryProject(
+      const QuadricContext& context, const gtsam::Pose3& pose,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      DualConic& dualConic, gtsam::OptionalJacobian<9, 9> dC_dq = boost::none,
+      gtsam::OptionalJacobian<9, 6> dC_dx = boost::none);
+
+  /** Project a memoized quadric into a camera view without throwing */
+  static ProjectionStatus tryProject(
+      const QuadricContext& context, const CameraView& view,
+      DualConic& dualConic, gtsam::OptionalJacobian<9, 9> dC_dq = boost::none,
+      gtsam::OptionalJacobian<9, 6> dC_dx = boost::none);
+
+  /**
+   * Cheap conservative test of whether tryProject would succeed, from the
+   * axis aligned bounds of the quadric in the camera frame and without
+   * building the quadric matrix. A quadric with its centre behind the
+   * camera is HIDDEN as in tryProject, and one entirely in front of the
+   * camera always projects to an ellipse and is VISIBLE. With an image
+   * boundary, as used by TRUNCATED bounds, the projected corners of the
+   * bounds must also lie inside the image to be VISIBLE, and a quadric whose
+   * corners project outside the image is HIDDEN.
+   * @param imageBoundary the image area, or null to ignore the image
+   */
+  static Visibility checkVisible(
+      const ConstrainedDualQuadric& quadric, const gtsam::Pose3& pose,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      const ImageBoundary* imageBoundary = 0);
+
+  /**
+   * Projects the simple bounds of an uncertain quadric without throwing.
+   * The covariance of the quadric, and of the pose if given, is propagated
+   * through the jacobians of project and DualConic::bounds to first order,
+   * assuming the quadric and pose are independent.
+   * @param covariance the 9x9 covariance of the quadric in its tangent
+   * space, e.g. from QuadricMarginals
+   * @param bounds set to the simple bounds
+   * @param boundsCovariance set to the 4x4 covariance of the bounds
+   * @param poseCovariance the 6x6 covariance of the pose, or empty if the
+   * pose is known
+   * @return SUCCESS, or the reason the projection is invalid
+   * @throws std::invalid_argument if a covariance has the wrong size
+   */
+  static ProjectionStatus tryProjectUncertain(
+      const ConstrainedDualQuadric& quadric, const gtsam::Matrix& covariance,
+      const gtsam::Pose3& pose,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      AlignedBox2& bounds, gtsam::Matrix& boundsCovariance,
+      const gtsam::Matrix& poseCovariance = gtsam::Matrix());
+
+  /**
+   * Grows each side of the bounds outwards by a number of its standard
+   * deviations, e.g. to gate the association of measured boxes
+   */
+  static AlignedBox2 inflate(const AlignedBox2& bounds,
+                             const gtsam::Matrix& boundsCovariance,
+                             double sigmas);
+
+  /**
+   * Projects the inflated bounds of many uncertain quadrics into one
+   * camera, see tryProjectUncertain and inflate
+   * @param covariances the 9x9 covariance of each quadric
+   * @param bounds resized and set to the inflated bounds, only meaningful
+   * where the status is SUCCESS
+   * @return the projection status of each quadric
+   */
+  static std::vector<ProjectionStatus> projectUncertainBatch(
+      const std::vector<ConstrainedDualQuadric>& quadrics,
+      const std::vector<gtsam::Matrix>& covariances, const gtsam::Pose3& pose,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration, double sigmas,
+      AlignedBox2Vector& bounds);
+
+  /**
+   * Project many quadrics into one camera in a single pass.
+   * The projection matrix is computed once, then the dual conic, simple
+   * bounds and status (as tryProject) of every quadric are written to
+   * structure-of-arrays output.
+   * @param quadrics pointer to the first of n quadrics
+   * @param n the number of quadrics
+   * @param projections resized to n and overwritten, reuse between frames
+   * to avoid reallocation
+   */
+  static void projectBatch(const ConstrainedDualQuadric* quadrics, size_t n,
+                           const gtsam::Pose3& pose,
+                           const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                           BatchProjection& projections);
+
+  /**
+   * Project many quadrics into one camera in single precision, see
+   * projectBatch. The projection matrix and quadric poses are computed in
+   * double and the per-quadric passes in float.
+   */
+  static void projectBatch(const ConstrainedDualQuadric* quadrics, size_t n,
+                           const gtsam::Pose3& pose,
+                           const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                           BatchProjectionf& projections);
+
+  /**
+   * Project every landmark of a store into one camera, see projectBatch.
+   * Projection i is of landmark i of the store.
+   */
+  static void projectBatch(const QuadricStore& store, const gtsam::Pose3& pose,
+                           const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                           BatchProjection& projections);
+
+  /** Project every landmark of a single precision store, see projectBatch */
+  static void projectBatch(const QuadricStoref& store,
+                           const gtsam::Pose3& pose,
+                           const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+                           BatchProjectionf& projections);
+
+  /** Project a vector of quadrics into one camera, see projectBatch */
+  static BatchProjection projectBatch(
+      const std::vector<ConstrainedDualQuadric>& quadrics,
+      const gtsam::Pose3& pose,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration);
+
   /** Project box to planes */
   static std::vector<gtsam::Vector4> project(
       const AlignedBox2& box, const gtsam::Pose3& pose,
       const boost::shared_ptr<gtsam::Cal3_S2>& calibration);
+
+  /**
+   * @name Distorted cameras
+   * A camera with lens distortion is its pinhole part followed by the
+   * distortion of the ideal image. Quadrics project to conics in the ideal
+   * image, so boxes detected in the distorted image are mapped to the ideal
+   * image once instead of undistorting every image, see DistortedCamera.
+   * CALIBRATION is any gtsam calibration with calibrate and uncalibrate,
+   * e.g. Cal3DS2 or Cal3Fisheye. The Cal3_S2 overloads are the identity.
+   */
+  /// @{
+
+  /** Returns the pinhole part of a calibration */
+  template <class CALIBRATION>
+  static boost::shared_ptr<gtsam::Cal3_S2> pinhole(
+      const CALIBRATION& calibration) {
+    return boost::make_shared<gtsam::Cal3_S2>(
+        calibration.fx(), calibration.fy(), calibration.skew(),
+        calibration.px(), calibration.py());
+  }
+
+  /**
+   * Maps a box detected in the distorted image to the ideal image.
+   * This approximates the exact model, where the conic would be distorted
+   * before taking its bounds: each side is moved by the undistortion of its
+   * midpoint, which is exact when the distortion is locally affine. In
+   * general a straight side undistorts to a curve, and the conic touches it
+   * somewhere along the side, so the error of each side is bounded by the
+   * spread of that curve, see undistortError. The error grows with the size
+   * of the box and the curvature of the distortion, e.g. 2 pixels for a
+   * 250 pixel box near the corner of a 640x480 image with k1 = -0.28.
+   */
+  template <class CALIBRATION>
+  static AlignedBox2 undistort(const AlignedBox2& box,
+                               const CALIBRATION& calibration) {
+    const gtsam::Cal3_S2 K = *pinhole(calibration);
+    return mapSides(box, [&](const gtsam::Point2& p) {
+      return K.uncalibrate(calibration.calibrate(p));
+    });
+  }
+
+  /** Maps a box in the ideal image to the distorted image, see undistort */
+  template <class CALIBRATION>
+  static AlignedBox2 distort(const AlignedBox2& box,
+                             const CALIBRATION& calibration) {
+    const gtsam::Cal3_S2 K = *pinhole(calibration);
+    return mapSides(box, [&](const gtsam::Point2& p) {
+      return calibration.uncalibrate(K.calibrate(p));
+    });
+  }
+
+  /**
+   * Returns the bound on the error of each side of undistort, as
+   * (xmin, ymin, xmax, ymax) in ideal pixels: the spread of the undistorted
+   * side, sampled along its length. It holds when the distortion is
+   * monotone across the box, e.g. radial distortion within the image.
+   */
+  template <class CALIBRATION>
+  static gtsam::Vector4 undistortError(const AlignedBox2& box,
+                                       const CALIBRATION& calibration) {
+    const gtsam::Cal3_S2 K = *pinhole(calibration);
+    return sideSpread(box, [&](const gtsam::Point2& p) {
+      return K.uncalibrate(calibration.calibrate(p));
+    });
+  }
+
+  /**
+   * Returns the derivative of each side of undistort by the detected side,
+   * as (xmin, ymin, xmax, ymax), to map the noise of a detection to the
+   * ideal image, see DistortedCamera::undistort.
+   */
+  template <class CALIBRATION>
+  static gtsam::Vector4 undistortJacobian(const AlignedBox2& box,
+                                          const CALIBRATION& calibration) {
+    const gtsam::Cal3_S2 K = *pinhole(calibration);
+    return sideDerivatives(box, [&](const gtsam::Point2& p) {
+      return K.uncalibrate(calibration.calibrate(p));
+    });
+  }
+
+  /** A pinhole camera has no distortion */
+  static AlignedBox2 undistort(const AlignedBox2& box,
+                               const gtsam::Cal3_S2& /*calibration*/) {
+    return box;
+  }
+
+  /** A pinhole camera has no distortion */
+  static gtsam::Vector4 undistortError(const AlignedBox2& /*box*/,
+                                       const gtsam::Cal3_S2& /*calibration*/) {
+    return gtsam::Vector4::Zero();
+  }
+
+  /** A pinhole camera has no distortion */
+  static gtsam::Vector4 undistortJacobian(
+      const AlignedBox2& /*box*/, const gtsam::Cal3_S2& /*calibration*/) {
+    return gtsam::Vector4::Ones();
+  }
+
+  /** A pinhole camera has no distortion */
+  static AlignedBox2 distort(const AlignedBox2& box,
+                             const gtsam::Cal3_S2& /*calibration*/) {
+    return box;
+  }
+
+  /// @}
+
+ protected:
+  /** Moves each side of the box by the map of its midpoint */
+  template <class FUNCTION>
+  static AlignedBox2 mapSides(const AlignedBox2& box, const FUNCTION& f) {
+    const gtsam::Point2 center = box.center();
+    const gtsam::Point2 left = f(gtsam::Point2(box.xmin(), center.y()));
+    const gtsam::Point2 top = f(gtsam::Point2(center.x(), box.ymin()));
+    const gtsam::Point2 right = f(gtsam::Point2(box.xmax(), center.y()));
+    const gtsam::Point2 bottom = f(gtsam::Point2(center.x(), box.ymax()));
+    return AlignedBox2(left.x(), top.y(), right.x(), bottom.y());
+  }
+
+  /** Returns the derivative of each mapped side by the side, at its midpoint */
+  template <class FUNCTION>
+  static gtsam::Vector4 sideDerivatives(const AlignedBox2& box,
+                                        const FUNCTION& f) {
+    const double h = 0.5;  // central differences over one pixel
+    const gtsam::Point2 center = box.center();
+    const gtsam::Point2 dx(h, 0.0), dy(0.0, h);
+    const gtsam::Point2 left(box.xmin(), center.y());
+    const gtsam::Point2 top(center.x(), box.ymin());
+    const gtsam::Point2 right(box.xmax(), center.y());
+    const gtsam::Point2 bottom(center.x(), box.ymax());
+    return gtsam::Vector4(f(left + dx).x() - f(left - dx).x(),
+                          f(top + dy).y() - f(top - dy).y(),
+                          f(right + dx).x() - f(right - dx).x(),
+                          f(bottom + dy).y() - f(bottom - dy).y()) /
+           (2.0 * h);
+  }
+
+  /** Returns the spread of each mapped side, sampled along the side */
+  template <class FUNCTION>
+  static gtsam::Vector4 sideSpread(const AlignedBox2& box, const FUNCTION& f) {
+    const int nrSamples = 16;
+    gtsam::Vector4 lower, upper;
+    for (int i = 0; i <= nrSamples; i++) {
+      const double t = double(i) / nrSamples;
+      const double x = box.xmin() + t * (box.xmax() - box.xmin());
+      const double y = box.ymin() + t * (box.ymax() - box.ymin());
+      const gtsam::Vector4 sides(f(gtsam::Point2(box.xmin(), y)).x(),
+                                 f(gtsam::Point2(x, box.ymin())).y(),
+                                 f(gtsam::Point2(box.xmax(), y)).x(),
+                                 f(gtsam::Point2(x, box.ymax())).y());
+      lower = i ? lower.cwiseMin(sides) : sides;
+      upper = i ? upper.cwiseMax(sides) : sides;
+    }
+    return upper - lower;
+  }
 };
 
 }  // namespace gtsam_quadrics
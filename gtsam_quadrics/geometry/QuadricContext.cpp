@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricContext.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief the matrices of a quadric, computed once and reused for projection
+ */
+
+#include <gtsam_quadrics/geometry/QuadricContext.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+QuadricContext::QuadricContext(const ConstrainedDualQuadric& quadric,
+                               bool computeJacobian)
+    : quadric_(quadric), hasInverse_(false), hasJacobian_(computeJacobian) {
+  if (computeJacobian) {
+    Q_ = quadric_.matrix(dQ_dq_);
+  } else {
+    Q_ = quadric_.matrix();
+  }
+}
+
+/* ************************************************************************* */
+const gtsam::Matrix44& QuadricContext::Qinv() const {
+  if (!hasInverse_) {
+    // Q = Z * Qc * Z' so inv(Q) = inv(Z)' * inv(Qc) * inv(Z)
+    gtsam::Matrix44 Zi = quadric_.pose().inverse().matrix();
+    gtsam::Vector4 qc =
+        (gtsam::Vector4() << quadric_.radii().array().square().inverse(), -1.0)
+            .finished();
+    Qinv_ = Zi.transpose() * qc.asDiagonal() * Zi;
+    hasInverse_ = true;
+  }
+  return Qinv_;
+}
+
+/* ************************************************************************* */
+const Eigen::Matrix<double, 16, 9>& QuadricContext::dQ_dq() const {
+  if (!hasJacobian_) {
+    quadric_.matrix(dQ_dq_);
+    hasJacobian_ = true;
+  }
+  return dQ_dq_;
+}
+
+/* ************************************************************************* */
+bool QuadricContext::isBehind(const gtsam::Pose3& cameraPose) const {
+  return quadric_.isBehind(cameraPose);
+}
+
+/* ************************************************************************* */
+bool QuadricContext::contains(const gtsam::Pose3& cameraPose) const {
+  gtsam::Vector4 cameraPoint =
+      (gtsam::Vector4() << cameraPose.translation(), 1.0).finished();
+  double pointError = cameraPoint.transpose() * this->Qinv() * cameraPoint;
+  return pointError <= 0.0;
+}
+
+/* ************************************************************************* */
+constexpr size_t QuadricContextCache::SLOTS;
+
+/* ************************************************************************* */
+const QuadricContext& QuadricContextCache::context(
+    const ConstrainedDualQuadric& quadric) const {
+  // the slot of each cache is private to the calling thread, and a context
+  // only depends on the quadric so a slot of another cache is never wrong
+  thread_local std::array<std::unique_ptr<QuadricContext>, SLOTS> slots;
+  const uint64_t hash =
+      uint64_t(reinterpret_cast<std::uintptr_t>(this)) * 0x9E3779B97F4A7C15ull;
+  std::unique_ptr<QuadricContext>& slot = slots[(hash >> 56) % SLOTS];
+
+  if (!slot) {
+    slot.reset(new QuadricContext(quadric, true));
+    return *slot;
+  }
+  const ConstrainedDualQuadric& cached = slot->quadric();
+  if (cached.pose().matrix() != quadric.pose().matrix() ||
+      cached.radii() != quadric.radii()) {
+    *slot = QuadricContext(quadric, true);
+  }
+  return *slot;
+}
+
+}  // namespace gtsam_quadrics
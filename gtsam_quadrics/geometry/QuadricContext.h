@@ -0,0 +1,129 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricContext.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief the matrices of a quadric, computed once and reused for projection
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+
+#include <boost/serialization/nvp.hpp>
+#include <boost/shared_ptr.hpp>
+#include <cstddef>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class QuadricContext
+ * Memoizes the dual quadric matrix, its inverse and its jacobian so the
+ * validity checks, projection and jacobians of one evaluation (or one
+ * quadric seen from many views) share a single computation.
+ * NOTE: the inverse and jacobian are computed lazily on first use,
+ * a context should not be shared between threads
+ */
+class QuadricContext {
+ protected:
+  ConstrainedDualQuadric quadric_;                    ///< the quadric
+  gtsam::Matrix44 Q_;                                 ///< dual quadric
+  mutable gtsam::Matrix44 Qinv_;                      ///< point quadric
+  mutable Eigen::Matrix<double, 16, 9> dQ_dq_;        ///< d(vec(Q))/dq
+  mutable bool hasInverse_;                           ///< Qinv_ is valid
+  mutable bool hasJacobian_;                          ///< dQ_dq_ is valid
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /// @name Constructors and named constructors
+  /// @{
+
+  /**
+   * Constructor from quadric
+   * @param quadric the quadric to memoize
+   * @param computeJacobian compute dQ_dq alongside Q
+   */
+  explicit QuadricContext(const ConstrainedDualQuadric& quadric,
+                          bool computeJacobian = false);
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the memoized quadric */
+  const ConstrainedDualQuadric& quadric() const { return quadric_; }
+
+  /** Returns the 4x4 dual quadric matrix */
+  const gtsam::Matrix44& Q() const { return Q_; }
+
+  /**
+   * Returns the 4x4 point quadric matrix
+   * in closed form from the pose and radii rather than inverting Q
+   */
+  const gtsam::Matrix44& Qinv() const;
+
+  /** Returns the derivative of vec(Q) wrt the quadric */
+  const Eigen::Matrix<double, 16, 9>& dQ_dq() const;
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /** Returns true if quadric centroid has negative depth */
+  bool isBehind(const gtsam::Pose3& cameraPose) const;
+
+  /** Returns true if camera is inside quadric, using the cached inverse */
+  bool contains(const gtsam::Pose3& cameraPose) const;
+
+  /// @}
+};
+
+/**
+ * @class QuadricContextCache
+ * The QuadricContext of one landmark shared by all of its factors, see
+ * MultiViewBoundingBoxFactor. Each thread keeps its own context per cache in
+ * a small direct-mapped table, rebuilt when the quadric changes, so factors
+ * sharing a cache are evaluated in parallel without locks, atomics or
+ * reference counts. A thread computes the context once per quadric value as
+ * long as the landmarks it is evaluating fit in the table, and a slot shared
+ * by two landmarks only costs a recomputation.
+ */
+class QuadricContextCache {
+ public:
+  /// number of contexts each thread keeps, allocated on first use
+  static constexpr size_t SLOTS = 256;
+
+  /** Default constructor */
+  QuadricContextCache() {}
+
+  QuadricContextCache(const QuadricContextCache&) = delete;
+  QuadricContextCache& operator=(const QuadricContextCache&) = delete;
+
+  /**
+   * Returns the context of the quadric with its jacobian, reusing the
+   * context of the calling thread if the quadric is unchanged
+   * NOTE: the context belongs to the calling thread and is valid until its
+   * next call to context() on any cache
+   */
+  const QuadricContext& context(const ConstrainedDualQuadric& quadric) const;
+
+ private:
+  /** Serialization function, the cache is not saved */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& /*ar*/, const unsigned int /*version*/) {}
+};
+
+}  // namespace gtsam_quadrics
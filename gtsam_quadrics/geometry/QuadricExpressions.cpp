@@ -0,0 +1,78 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricExpressions.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief gtsam expressions for quadric projection and bounds
+ */
+
+#include <gtsam_quadrics/geometry/DualConic.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricExpressions.h>
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+Matrix44_ quadricMatrix(const ConstrainedDualQuadric_& quadric) {
+  return Matrix44_(quadric, &ConstrainedDualQuadric::matrix);
+}
+
+/* ************************************************************************* */
+Matrix33_ project(const ConstrainedDualQuadric_& quadric,
+                  const gtsam::Pose3_& pose,
+                  const boost::shared_ptr<gtsam::Cal3_S2>& calibration) {
+  return Matrix33_(
+      [calibration](const ConstrainedDualQuadric& q, const gtsam::Pose3& x,
+                    gtsam::OptionalJacobian<9, 9> dC_dq,
+                    gtsam::OptionalJacobian<9, 6> dC_dx) {
+        return QuadricCamera::project(q, x, calibration, dC_dq, dC_dx)
+            .matrix();
+      },
+      quadric, pose);
+}
+
+/* ************************************************************************* */
+gtsam::Vector4_ bounds(const Matrix33_& dualConic) {
+  return gtsam::Vector4_(
+      [](const gtsam::Matrix33& dC, gtsam::OptionalJacobian<4, 9> db_dC) {
+        return DualConic(dC).bounds(db_dC).vector();
+      },
+      dualConic);
+}
+
+/* ************************************************************************* */
+gtsam::Vector4_ smartBounds(
+    const Matrix33_& dualConic,
+    const boost::shared_ptr<ImageBoundary>& imageBoundary) {
+  return gtsam::Vector4_(
+      [imageBoundary](const gtsam::Matrix33& dC,
+                      gtsam::OptionalJacobian<4, 9> db_dC) {
+        return DualConic(dC).smartBounds(*imageBoundary, db_dC).vector();
+      },
+      dualConic);
+}
+
+/* ************************************************************************* */
+gtsam::Vector4_ predictedBounds(
+    const gtsam::Pose3_& pose, const ConstrainedDualQuadric_& quadric,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const boost::shared_ptr<ImageBoundary>& imageBoundary,
+    const BoundingBoxFactor::MeasurementModel& measurementModel) {
+  Matrix33_ dualConic = project(quadric, pose, calibration);
+  if (measurementModel == BoundingBoxFactor::TRUNCATED) {
+    return smartBounds(dualConic, imageBoundary);
+  }
+  return bounds(dualConic);
+}
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,89 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricExpressions.h
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief gtsam expressions for quadric projection and bounds
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/nonlinear/expressions.h>
+#include <gtsam/slam/expressions.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+
+namespace gtsam_quadrics {
+
+/**
+ * @name Expressions
+ * Building blocks for custom factors with gtsam::ExpressionFactor, which
+ * chains the fixed-size jacobians of each block in reverse mode. Dual
+ * quadrics and conics are their 4x4 and 3x3 matrices, whose tangent space
+ * is the column-major vectorization used by ConstrainedDualQuadric::matrix
+ * and DualConic::bounds. Bounds are (xmin, ymin, xmax, ymax).
+ *
+ * Like QuadricCamera::project and DualConic::smartBounds, the blocks throw
+ * where the quadric cannot be projected or bounded. Factors that need a
+ * constant error there instead should use BoundingBoxFactor, which also
+ * remains the faster choice for a plain pose and quadric measurement.
+ */
+/// @{
+
+typedef gtsam::Expression<ConstrainedDualQuadric> ConstrainedDualQuadric_;
+typedef gtsam::Expression<gtsam::Matrix44> Matrix44_;
+typedef gtsam::Expression<gtsam::Matrix33> Matrix33_;
+
+/** The 4x4 dual quadric matrix, see ConstrainedDualQuadric::matrix */
+Matrix44_ quadricMatrix(const ConstrainedDualQuadric_& quadric);
+
+/**
+ * The 3x3 dual conic of a quadric seen from a camera pose, see
+ * QuadricCamera::project. The projection and both jacobians come from one
+ * call, so the pose is inverted once per evaluation.
+ * @throws QuadricProjectionException if the quadric cannot be projected
+ */
+Matrix33_ project(const ConstrainedDualQuadric_& quadric,
+                  const gtsam::Pose3_& pose,
+                  const boost::shared_ptr<gtsam::Cal3_S2>& calibration);
+
+/** The simple bounds of a dual conic, see DualConic::bounds */
+gtsam::Vector4_ bounds(const Matrix33_& dualConic);
+
+/**
+ * The bounds of a dual conic truncated to the image, see
+ * DualConic::smartBounds
+ * @throws std::runtime_error if the conic cannot be bounded in the image
+ */
+gtsam::Vector4_ smartBounds(
+    const Matrix33_& dualConic,
+    const boost::shared_ptr<ImageBoundary>& imageBoundary);
+
+/**
+ * The bounds a BoundingBoxFactor predicts for a quadric seen from a camera
+ * pose, e.g. to build
+ *   ExpressionFactor<Vector4>(model, measured.vector(), predictedBounds(..))
+ * whose error and jacobians match the factor where the projection is valid
+ */
+gtsam::Vector4_ predictedBounds(
+    const gtsam::Pose3_& pose, const ConstrainedDualQuadric_& quadric,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const boost::shared_ptr<ImageBoundary>& imageBoundary,
+    const BoundingBoxFactor::MeasurementModel& measurementModel =
+        BoundingBoxFactor::STANDARD);
+
+/// @}
+
+}  // namespace gtsam_quadrics
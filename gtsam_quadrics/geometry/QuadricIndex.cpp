@@ -0,0 +1,387 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricIndex.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief a uniform grid over quadric landmarks for spatial queries
+ */
+
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+namespace {
+
+/// cell coordinates are packed into 21 bits each
+const int CELL_OFFSET = 1 << 20;
+const uint64_t CELL_MASK = (uint64_t(1) << 21) - 1;
+
+uint64_t packCell(const Eigen::Vector3i& cell) {
+  return (uint64_t(cell.x() + CELL_OFFSET) << 42) |
+         (uint64_t(cell.y() + CELL_OFFSET) << 21) |
+         uint64_t(cell.z() + CELL_OFFSET);
+}
+
+Eigen::Vector3i unpackCell(const uint64_t& packed) {
+  return Eigen::Vector3i(int((packed >> 42) & CELL_MASK) - CELL_OFFSET,
+                         int((packed >> 21) & CELL_MASK) - CELL_OFFSET,
+                         int(packed & CELL_MASK) - CELL_OFFSET);
+}
+
+int toCell(const double& x, const double& cellSize) {
+  double cell = std::floor(x / cellSize);
+  if (std::isnan(cell)) {
+    return 0;
+  }
+  cell = std::max(cell, double(-CELL_OFFSET));
+  cell = std::min(cell, double(CELL_OFFSET - 1));
+  return int(cell);
+}
+
+bool overlaps(const AlignedBox3& a, const AlignedBox3& b) {
+  return a.xmin() <= b.xmax() && a.xmax() >= b.xmin() &&
+         a.ymin() <= b.ymax() && a.ymax() >= b.ymin() &&
+         a.zmin() <= b.zmax() && a.zmax() >= b.zmin();
+}
+
+/// false if the box is entirely on the negative side of the plane
+bool inFront(const gtsam::Vector4& plane, const AlignedBox3& box) {
+  double x = plane[0] >= 0.0 ? box.xmax() : box.xmin();
+  double y = plane[1] >= 0.0 ? box.ymax() : box.ymin();
+  double z = plane[2] >= 0.0 ? box.zmax() : box.zmin();
+  return plane[0] * x + plane[1] * y + plane[2] * z + plane[3] >= 0.0;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+QuadricIndex::QuadricIndex(const double& cellSize, size_t maxCells)
+    : cellSize_(cellSize), maxCells_(maxCells) {
+  if (!(cellSize > 0.0)) {
+    throw std::invalid_argument("QuadricIndex cellSize must be positive");
+  }
+  if (maxCells == 0) {
+    throw std::invalid_argument("QuadricIndex maxCells must be positive");
+  }
+}
+
+/* ************************************************************************* */
+const AlignedBox3& QuadricIndex::bounds(const gtsam::Key& key) const {
+  EntryMap::const_iterator it = entries_.find(key);
+  if (it == entries_.end()) {
+    throw std::out_of_range("QuadricIndex::bounds key is not indexed");
+  }
+  return it->second.bounds;
+}
+
+/* ************************************************************************* */
+void QuadricIndex::update(const gtsam::Key& key, const AlignedBox3& bounds) {
+  Eigen::Vector3i minCell, maxCell;
+  cellRange(bounds, minCell, maxCell);
+  const bool large = isLarge(bounds, minCell, maxCell);
+
+  EntryMap::iterator it = entries_.find(key);
+  if (it != entries_.end()) {
+    // landmarks usually move less than a cell per optimization step
+    Entry& entry = it->second;
+    if (entry.large == large &&
+        (large || (entry.minCell == minCell && entry.maxCell == maxCell))) {
+      entry.bounds = bounds;
+      entry.minCell = minCell;
+      entry.maxCell = maxCell;
+      return;
+    }
+    remove(key);
+  }
+
+  Entry& entry = entries_[key];
+  entry.bounds = bounds;
+  entry.minCell = minCell;
+  entry.maxCell = maxCell;
+  entry.large = large;
+  if (large) {
+    large_.push_back(key);
+    return;
+  }
+  for (int x = minCell.x(); x <= maxCell.x(); x++) {
+    for (int y = minCell.y(); y <= maxCell.y(); y++) {
+      for (int z = minCell.z(); z <= maxCell.z(); z++) {
+        cells_[packCell(Eigen::Vector3i(x, y, z))].push_back(key);
+      }
+    }
+  }
+}
+
+/* ************************************************************************* */
+void QuadricIndex::update(const gtsam::Values& values) {
+  gtsam::KeyVector keys;
+  keys.reserve(entries_.size());
+  for (const EntryMap::value_type& entry : entries_) {
+    keys.push_back(entry.first);
+  }
+  for (const gtsam::Key& key : keys) {
+    if (values.exists(key)) {
+      update(key, values.at<ConstrainedDualQuadric>(key));
+    }
+  }
+}
+
+/* ************************************************************************* */
+bool QuadricIndex::remove(const gtsam::Key& key) {
+  EntryMap::iterator it = entries_.find(key);
+  if (it == entries_.end()) {
+    return false;
+  }
+  if (it->second.large) {
+    *std::find(large_.begin(), large_.end(), key) = large_.back();
+    large_.pop_back();
+    entries_.erase(it);
+    return true;
+  }
+
+  const Eigen::Vector3i minCell = it->second.minCell;
+  const Eigen::Vector3i maxCell = it->second.maxCell;
+  for (int x = minCell.x(); x <= maxCell.x(); x++) {
+    for (int y = minCell.y(); y <= maxCell.y(); y++) {
+      for (int z = minCell.z(); z <= maxCell.z(); z++) {
+        CellMap::iterator cell =
+            cells_.find(packCell(Eigen::Vector3i(x, y, z)));
+        gtsam::KeyVector& keys = cell->second;
+        *std::find(keys.begin(), keys.end(), key) = keys.back();
+        keys.pop_back();
+        if (keys.empty()) {
+          cells_.erase(cell);
+        }
+      }
+    }
+  }
+  entries_.erase(it);
+  return true;
+}
+
+/* ************************************************************************* */
+void QuadricIndex::clear() {
+  entries_.clear();
+  cells_.clear();
+  large_.clear();
+}
+
+/* ************************************************************************* */
+gtsam::KeyVector QuadricIndex::intersecting(const AlignedBox3& box) const {
+  Eigen::Vector3i minCell, maxCell;
+  cellRange(box, minCell, maxCell);
+
+  gtsam::KeyVector keys;
+  forEach(minCell, maxCell,
+          [&](const gtsam::Key& key, const AlignedBox3& bounds) {
+            if (overlaps(box, bounds)) {
+              keys.push_back(key);
+            }
+          });
+  return keys;
+}
+
+/* ************************************************************************* */
+std::vector<std::pair<gtsam::Key, gtsam::Key> > QuadricIndex::overlapping(
+    const double& minIou, size_t nrThreads) const {
+  typedef std::vector<std::pair<gtsam::Key, gtsam::Key> > Pairs;
+  std::vector<const EntryMap::value_type*> entries;
+  entries.reserve(entries_.size());
+  for (const EntryMap::value_type& entry : entries_) {
+    entries.push_back(&entry);
+  }
+
+  // each pair is found from its smaller key only, so the threads only read
+  // the index and write their own results
+  nrThreads = std::max<size_t>(std::min(nrThreads, entries.size()), 1);
+  std::vector<Pairs> found(nrThreads);
+  auto search = [&](size_t thread) {
+    for (size_t i = thread; i < entries.size(); i += nrThreads) {
+      const gtsam::Key& key = entries[i]->first;
+      const Entry& entry = entries[i]->second;
+      forEach(entry.minCell, entry.maxCell,
+              [&](const gtsam::Key& other, const AlignedBox3& bounds) {
+                if (key < other && overlaps(entry.bounds, bounds) &&
+                    entry.bounds.iou(bounds) >= minIou) {
+                  found[thread].push_back(std::make_pair(key, other));
+                }
+              });
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t thread = 1; thread < nrThreads; thread++) {
+    threads.push_back(std::thread(search, thread));
+  }
+  search(0);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  Pairs pairs;
+  for (const Pairs& threadPairs : found) {
+    pairs.insert(pairs.end(), threadPairs.begin(), threadPairs.end());
+  }
+  std::sort(pairs.begin(), pairs.end());
+  return pairs;
+}
+
+/* ************************************************************************* */
+gtsam::KeyVector QuadricIndex::near(const gtsam::Point3& point,
+                                    const double& radius) const {
+  AlignedBox3 box(point.x() - radius, point.x() + radius, point.y() - radius,
+                  point.y() + radius, point.z() - radius, point.z() + radius);
+  Eigen::Vector3i minCell, maxCell;
+  cellRange(box, minCell, maxCell);
+
+  gtsam::KeyVector keys;
+  forEach(minCell, maxCell,
+          [&](const gtsam::Key& key, const AlignedBox3& bounds) {
+            // distance from the point to the closest point of the bounds
+            gtsam::Vector3 lower(bounds.xmin(), bounds.ymin(), bounds.zmin());
+            gtsam::Vector3 upper(bounds.xmax(), bounds.ymax(), bounds.zmax());
+            gtsam::Vector3 closest =
+                gtsam::Vector3(point).cwiseMax(lower).cwiseMin(upper);
+            if ((closest - point).squaredNorm() <= radius * radius) {
+              keys.push_back(key);
+            }
+          });
+  return keys;
+}
+
+/* ************************************************************************* */
+gtsam::KeyVector QuadricIndex::visible(
+    const gtsam::Pose3& pose,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const ImageBoundary& imageBoundary, const double& maxDepth) const {
+  const gtsam::Matrix34 P = QuadricCamera::transformToImage(pose, calibration);
+  const AlignedBox2& image = imageBoundary.bounds();
+
+  // border lines oriented positive inside the image, backprojected to
+  // planes through the camera center, and the image and far planes
+  const Eigen::Matrix<double, 4, 3> Pt = P.transpose();
+  Eigen::Matrix<double, 4, 6> planes;
+  planes.col(0) = Pt * gtsam::Vector3(1.0, 0.0, -image.xmin());
+  planes.col(1) = Pt * gtsam::Vector3(0.0, 1.0, -image.ymin());
+  planes.col(2) = Pt * gtsam::Vector3(-1.0, 0.0, image.xmax());
+  planes.col(3) = Pt * gtsam::Vector3(0.0, -1.0, image.ymax());
+  planes.col(4) = Pt.col(2);
+  planes.col(5) = -Pt.col(2) + gtsam::Vector4(0.0, 0.0, 0.0, maxDepth);
+
+  // the frustum is contained by the camera center and far corners
+  const gtsam::Matrix3 Kinv = calibration->K().inverse();
+  gtsam::Vector3 lower = pose.translation();
+  gtsam::Vector3 upper = pose.translation();
+  for (const gtsam::Point2& corner : imageBoundary.corners()) {
+    gtsam::Vector3 ray = Kinv * gtsam::Vector3(corner.x(), corner.y(), 1.0);
+    gtsam::Vector3 far = pose.transformFrom(gtsam::Point3(ray * maxDepth));
+    lower = lower.cwiseMin(far);
+    upper = upper.cwiseMax(far);
+  }
+  AlignedBox3 frustumBounds(lower.x(), upper.x(), lower.y(), upper.y(),
+                            lower.z(), upper.z());
+  Eigen::Vector3i minCell, maxCell;
+  cellRange(frustumBounds, minCell, maxCell);
+
+  gtsam::KeyVector keys;
+  forEach(minCell, maxCell,
+          [&](const gtsam::Key& key, const AlignedBox3& bounds) {
+            for (int i = 0; i < planes.cols(); i++) {
+              if (!inFront(planes.col(i), bounds)) {
+                return;
+              }
+            }
+            keys.push_back(key);
+          });
+  return keys;
+}
+
+/* ************************************************************************* */
+void QuadricIndex::cellRange(const AlignedBox3& box, Eigen::Vector3i& minCell,
+                             Eigen::Vector3i& maxCell) const {
+  minCell = Eigen::Vector3i(toCell(box.xmin(), cellSize_),
+                            toCell(box.ymin(), cellSize_),
+                            toCell(box.zmin(), cellSize_));
+  maxCell = Eigen::Vector3i(toCell(box.xmax(), cellSize_),
+                            toCell(box.ymax(), cellSize_),
+                            toCell(box.zmax(), cellSize_));
+}
+
+/* ************************************************************************* */
+bool QuadricIndex::isLarge(const AlignedBox3& bounds,
+                           const Eigen::Vector3i& minCell,
+                           const Eigen::Vector3i& maxCell) const {
+  if (!bounds.vector().allFinite()) {
+    return true;
+  }
+  gtsam::Vector3 extent = (maxCell - minCell).cast<double>().array() + 1.0;
+  return extent.prod() > double(maxCells_);
+}
+
+/* ************************************************************************* */
+void QuadricIndex::forEach(
+    const Eigen::Vector3i& minCell, const Eigen::Vector3i& maxCell,
+    const std::function<void(const gtsam::Key&, const AlignedBox3&)>& f)
+    const {
+  // a landmark spanning several cells is only reported from the first cell
+  // it shares with the range, so results need no deduplication
+  auto visit = [&](const Eigen::Vector3i& cell, const gtsam::KeyVector& keys) {
+    for (const gtsam::Key& key : keys) {
+      const Entry& entry = entries_.find(key)->second;
+      if (entry.minCell.cwiseMax(minCell) == cell) {
+        f(key, entry.bounds);
+      }
+    }
+  };
+
+  gtsam::Vector3 extent = (maxCell - minCell).cast<double>().array() + 1.0;
+  if (extent.prod() <= double(cells_.size())) {
+    for (int x = minCell.x(); x <= maxCell.x(); x++) {
+      for (int y = minCell.y(); y <= maxCell.y(); y++) {
+        for (int z = minCell.z(); z <= maxCell.z(); z++) {
+          Eigen::Vector3i cell(x, y, z);
+          CellMap::const_iterator it = cells_.find(packCell(cell));
+          if (it != cells_.end()) {
+            visit(cell, it->second);
+          }
+        }
+      }
+    }
+  } else {
+    // sparse maps have fewer occupied cells than cells in the range
+    for (const CellMap::value_type& occupied : cells_) {
+      Eigen::Vector3i cell = unpackCell(occupied.first);
+      if ((cell.array() >= minCell.array()).all() &&
+          (cell.array() <= maxCell.array()).all()) {
+        visit(cell, occupied.second);
+      }
+    }
+  }
+
+  for (const gtsam::Key& key : large_) {
+    const Entry& entry = entries_.find(key)->second;
+    if ((entry.maxCell.array() >= minCell.array()).all() &&
+        (entry.minCell.array() <= maxCell.array()).all()) {
+      f(key, entry.bounds);
+    }
+  }
+}
+
+}  // namespace gtsam_quadrics
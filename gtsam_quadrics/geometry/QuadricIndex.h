@@ -0,0 +1,203 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricIndex.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief a uniform grid over quadric landmarks for spatial queries
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Point3.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam_quadrics/geometry/AlignedBox3.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/QuadricStore.h>
+
+#include <Eigen/StdVector>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class QuadricIndex
+ * A uniform grid over the 3D bounds of quadric landmarks, so finding the
+ * landmarks visible from a camera or near a point scales with the number of
+ * results rather than with the size of the map.
+ * Each landmark is registered in every cell its bounds overlap, and queries
+ * are conservative: they return every landmark whose bounds may intersect
+ * the query region. Update landmarks after each optimization step to keep
+ * the index consistent with the estimate.
+ * Landmarks overlapping more than maxCells cells, e.g. diverged or
+ * degenerate quadrics, are kept in a separate list that every query checks,
+ * so they cost one bounds test per query rather than one entry per cell.
+ */
+class QuadricIndex {
+ protected:
+  /// a landmark's bounds and the range of cells they overlap
+  struct Entry {
+    AlignedBox3 bounds;
+    Eigen::Vector3i minCell;
+    Eigen::Vector3i maxCell;
+    bool large;  ///< kept in large_ rather than in its cells
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  typedef std::unordered_map<
+      gtsam::Key, Entry, std::hash<gtsam::Key>, std::equal_to<gtsam::Key>,
+      Eigen::aligned_allocator<std::pair<const gtsam::Key, Entry> > >
+      EntryMap;
+  typedef std::unordered_map<uint64_t, gtsam::KeyVector> CellMap;
+
+  double cellSize_;  ///< side length of each cubic cell
+  size_t maxCells_;  ///< most cells a landmark is registered in
+  EntryMap entries_; ///< bounds of each landmark
+  CellMap cells_;    ///< landmarks overlapping each occupied cell
+  gtsam::KeyVector large_; ///< landmarks overlapping too many cells
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /**
+   * Constructor from the grid resolution
+   * @param cellSize side length of each cell, of the order of the landmarks
+   * @param maxCells landmarks overlapping more cells are not registered in
+   * the grid but checked by every query
+   */
+  explicit QuadricIndex(const double& cellSize = 1.0, size_t maxCells = 512);
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the side length of each cell */
+  double cellSize() const { return cellSize_; }
+
+  /** Returns the number of indexed landmarks */
+  size_t size() const { return entries_.size(); }
+
+  /** Returns the most cells a landmark is registered in */
+  size_t maxCells() const { return maxCells_; }
+
+  /** Returns the number of occupied cells */
+  size_t nrCells() const { return cells_.size(); }
+
+  /** Returns the number of landmarks too large to register in the grid */
+  size_t nrLarge() const { return large_.size(); }
+
+  /** Checks if a landmark is indexed */
+  bool exists(const gtsam::Key& key) const { return entries_.count(key) > 0; }
+
+  /** Returns the indexed bounds of a landmark, throws if not indexed */
+  const AlignedBox3& bounds(const gtsam::Key& key) const;
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /** Inserts or moves a landmark to the bounds of the quadric */
+  void update(const gtsam::Key& key, const ConstrainedDualQuadric& quadric) {
+    update(key, quadric.bounds());
+  }
+
+  /** Inserts or moves a landmark to the given bounds */
+  void update(const gtsam::Key& key, const AlignedBox3& bounds);
+
+  /**
+   * Moves every indexed landmark to its estimate in values
+   * Landmarks without an estimate are left unchanged.
+   */
+  void update(const gtsam::Values& values);
+
+  /** Inserts or moves every landmark of a store to its bounds */
+  template <typename Scalar>
+  void update(const QuadricStoreT<Scalar>& store) {
+    typename QuadricStoreT<Scalar>::BatchBounds bounds;
+    store.bounds(bounds);
+    for (size_t i = 0; i < store.size(); i++) {
+      const gtsam::Vector6 xxyyzz =
+          bounds.row(i).transpose().template cast<double>();
+      update(store.key(i), AlignedBox3(xxyyzz));
+    }
+  }
+
+  /** Removes a landmark, returns false if it was not indexed */
+  bool remove(const gtsam::Key& key);
+
+  /** Removes every landmark */
+  void clear();
+
+  /** Returns the landmarks whose bounds intersect the box */
+  gtsam::KeyVector intersecting(const AlignedBox3& box) const;
+
+  /** Returns the landmarks whose bounds are within radius of the point */
+  gtsam::KeyVector near(const gtsam::Point3& point,
+                        const double& radius) const;
+
+  /**
+   * Returns every pair of landmarks whose bounds overlap by at least minIou,
+   * as (smaller key, larger key) in ascending order, e.g. to find landmarks
+   * initialized twice from different views
+   * @param minIou the minimum intersection over union of the 3D bounds
+   * @param nrThreads the landmarks are split between this many threads
+   */
+  std::vector<std::pair<gtsam::Key, gtsam::Key> > overlapping(
+      const double& minIou, size_t nrThreads = 1) const;
+
+  /**
+   * Returns the landmarks whose bounds may intersect the view frustum
+   * The frustum is bounded by the image borders, the image plane and the
+   * far plane at maxDepth. Landmarks straddling a frustum edge are kept,
+   * project them to test their visibility exactly.
+   * @param pose the camera pose
+   * @param calibration the camera intrinsics
+   * @param imageBoundary the image area
+   * @param maxDepth the far plane distance along the optical axis
+   */
+  gtsam::KeyVector visible(
+      const gtsam::Pose3& pose,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      const ImageBoundary& imageBoundary, const double& maxDepth) const;
+
+  /// @}
+
+ protected:
+  /** Returns the cell containing each corner of the box */
+  void cellRange(const AlignedBox3& box, Eigen::Vector3i& minCell,
+                 Eigen::Vector3i& maxCell) const;
+
+  /** Checks if the bounds overlap more than maxCells cells or are not finite */
+  bool isLarge(const AlignedBox3& bounds, const Eigen::Vector3i& minCell,
+               const Eigen::Vector3i& maxCell) const;
+
+  /**
+   * Calls f(key, bounds) once for each landmark overlapping the cell range
+   * Iterates the range or the occupied cells, whichever is smaller, and then
+   * the large landmarks.
+   */
+  void forEach(
+      const Eigen::Vector3i& minCell, const Eigen::Vector3i& maxCell,
+      const std::function<void(const gtsam::Key&, const AlignedBox3&)>& f)
+      const;
+};
+
+}  // namespace gtsam_quadrics
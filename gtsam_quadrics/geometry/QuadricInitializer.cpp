@@ -0,0 +1,218 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricInitializer.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief initializes quadric landmarks from multi-view bounding boxes
+ */
+
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricInitializer.h>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+namespace {
+
+typedef Eigen::Matrix<double, 10, 10> NormalMatrix;
+typedef Eigen::Matrix<double, 10, 1> Constraint;
+typedef std::vector<gtsam::Matrix34, Eigen::aligned_allocator<gtsam::Matrix34>>
+    ProjectionMatrices;
+
+/// the least number of planes that determine a dual quadric up to scale
+const size_t MIN_PLANES = 9;
+
+/**
+ * Adds the constraint pi' * Q * pi = 0 on the upper triangle of Q,
+ * normalizing the plane so each constraint has the same weight
+ */
+void addPlane(const gtsam::Vector4& plane, NormalMatrix& normal) {
+  const gtsam::Vector4 p = plane.normalized();
+  Constraint a;
+  a << p(0) * p(0), 2.0 * p(0) * p(1), 2.0 * p(0) * p(2), 2.0 * p(0) * p(3),
+      p(1) * p(1), 2.0 * p(1) * p(2), 2.0 * p(1) * p(3), p(2) * p(2),
+      2.0 * p(2) * p(3), p(3) * p(3);
+  normal.selfadjointView<Eigen::Lower>().rankUpdate(a);
+}
+
+/**
+ * Adds the four planes through the sides of a box seen with projection P,
+ * expressed in a frame translated to the origin so the constraints are
+ * conditioned independently of where the landmark is in the world
+ */
+void addBox(const gtsam::Matrix34& P, const AlignedBox2& box,
+            const gtsam::Vector3& origin, NormalMatrix& normal) {
+  // the lines (1, 0, -x) and (0, 1, -y) back-project to P' * l
+  const double sides[4] = {box.xmin(), box.ymin(), box.xmax(), box.ymax()};
+  for (int i = 0; i < 4; i++) {
+    gtsam::Vector4 plane =
+        P.row(i % 2).transpose() - sides[i] * P.row(2).transpose();
+    plane(3) += plane.head<3>().dot(origin);
+    addPlane(plane, normal);
+  }
+}
+
+/// returns the dual quadric of the smallest eigenvector of the constraints
+gtsam::Matrix4 solveNormal(const NormalMatrix& normal) {
+  Eigen::SelfAdjointEigenSolver<NormalMatrix> solver(normal);
+  const Constraint q = solver.eigenvectors().col(0);
+  return (gtsam::Matrix4() << q(0), q(1), q(2), q(3), q(1), q(4), q(5), q(6),
+          q(2), q(5), q(7), q(8), q(3), q(6), q(8), q(9))
+      .finished();
+}
+
+/// initializes one track given the projection matrix of every pose
+QuadricInitializer::Status initializeTrack(
+    const std::vector<gtsam::Pose3>& poses, const ProjectionMatrices& P,
+    const QuadricInitializer::Track& track, ConstrainedDualQuadric& quadric) {
+  if (track.poses.size() != track.boxes.size()) {
+    throw std::invalid_argument(
+        "QuadricInitializer requires one pose per box");
+  }
+  if (4 * track.boxes.size() < MIN_PLANES) {
+    return QuadricInitializer::TOO_FEW_PLANES;
+  }
+
+  // solve about the mean camera position, then translate back
+  gtsam::Vector3 origin = gtsam::Vector3::Zero();
+  for (size_t i = 0; i < track.poses.size(); i++) {
+    origin += poses.at(track.poses[i]).translation();
+  }
+  origin /= double(track.poses.size());
+  NormalMatrix normal = NormalMatrix::Zero();
+  for (size_t i = 0; i < track.boxes.size(); i++) {
+    addBox(P.at(track.poses[i]), track.boxes[i], origin, normal);
+  }
+  gtsam::Matrix4 T = gtsam::Matrix4::Identity();
+  T.block<3, 1>(0, 3) = origin;
+  gtsam::Matrix4 dualQuadric = T * solveNormal(normal) * T.transpose();
+
+  // an ellipsoid normalizes to [t*t' - R*S*R', t; t', 1] with R*S*R'
+  // positive definite, see ConstrainedDualQuadric::constrain
+  gtsam::Matrix4 normalized = dualQuadric / dualQuadric(3, 3);
+  gtsam::Vector3 t = normalized.block<3, 1>(0, 3);
+  gtsam::Matrix3 shape =
+      t * t.transpose() - normalized.topLeftCorner<3, 3>();
+  if (!normalized.allFinite() ||
+      Eigen::LLT<gtsam::Matrix3>(shape).info() != Eigen::Success) {
+    return QuadricInitializer::NON_ELLIPSOID;
+  }
+
+  ConstrainedDualQuadric result = ConstrainedDualQuadric::constrain(normalized);
+  for (size_t i = 0; i < track.poses.size(); i++) {
+    const gtsam::Pose3& pose = poses.at(track.poses[i]);
+    if (result.isBehind(pose)) {
+      return QuadricInitializer::BEHIND_CAMERA;
+    }
+    if (result.contains(pose)) {
+      return QuadricInitializer::CAMERA_INSIDE;
+    }
+  }
+  quadric = result;
+  return QuadricInitializer::SUCCESS;
+}
+
+/// returns the projection matrix of every pose
+ProjectionMatrices projectionMatrices(
+    const std::vector<gtsam::Pose3>& poses,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration) {
+  ProjectionMatrices P;
+  P.reserve(poses.size());
+  for (const gtsam::Pose3& pose : poses) {
+    P.push_back(QuadricCamera::transformToImage(pose, calibration));
+  }
+  return P;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+QuadricInitializer::Status QuadricInitializer::tryInitialize(
+    const std::vector<gtsam::Pose3>& poses, const AlignedBox2Vector& boxes,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    ConstrainedDualQuadric& quadric) {
+  Track track;
+  track.boxes = boxes;
+  for (size_t i = 0; i < poses.size(); i++) {
+    track.poses.push_back(i);
+  }
+  return initializeTrack(poses, projectionMatrices(poses, calibration), track,
+                         quadric);
+}
+
+/* ************************************************************************* */
+ConstrainedDualQuadric QuadricInitializer::initialize(
+    const std::vector<gtsam::Pose3>& poses, const AlignedBox2Vector& boxes,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration) {
+  ConstrainedDualQuadric quadric;
+  Status status = tryInitialize(poses, boxes, calibration, quadric);
+  if (status != SUCCESS) {
+    throw std::runtime_error(string("QuadricInitializer failed: ") +
+                             toString(status));
+  }
+  return quadric;
+}
+
+/* ************************************************************************* */
+std::vector<QuadricInitializer::Status> QuadricInitializer::initializeBatch(
+    const std::vector<gtsam::Pose3>& poses, const std::vector<Track>& tracks,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    std::vector<ConstrainedDualQuadric>& quadrics) {
+  const ProjectionMatrices P = projectionMatrices(poses, calibration);
+  quadrics.resize(tracks.size());
+  std::vector<Status> status(tracks.size());
+  for (size_t j = 0; j < tracks.size(); j++) {
+    status[j] = initializeTrack(poses, P, tracks[j], quadrics[j]);
+  }
+  return status;
+}
+
+/* ************************************************************************* */
+gtsam::Matrix4 QuadricInitializer::solve(
+    const std::vector<gtsam::Vector4>& planes) {
+  if (planes.size() < MIN_PLANES) {
+    throw std::invalid_argument(
+        "QuadricInitializer::solve requires at least 9 planes");
+  }
+  NormalMatrix normal = NormalMatrix::Zero();
+  for (const gtsam::Vector4& plane : planes) {
+    addPlane(plane, normal);
+  }
+  gtsam::Matrix4 dualQuadric = solveNormal(normal);
+  return dualQuadric / dualQuadric.norm();
+}
+
+/* ************************************************************************* */
+const char* QuadricInitializer::toString(const Status& status) {
+  switch (status) {
+    case SUCCESS:
+      return "Initialization succeeded";
+    case TOO_FEW_PLANES:
+      return "Fewer than 3 boxes";
+    case NON_ELLIPSOID:
+      return "Least squares quadric is not an ellipsoid";
+    case BEHIND_CAMERA:
+      return "Quadric is behind camera";
+    case CAMERA_INSIDE:
+      return "Camera is inside quadric";
+  }
+  return "Unknown initialization status";
+}
+
+}  // namespace gtsam_quadrics
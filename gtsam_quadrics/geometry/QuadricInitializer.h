@@ -0,0 +1,108 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricInitializer.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief initializes quadric landmarks from multi-view bounding boxes
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class QuadricInitializer
+ * Initializes a quadric from the bounding boxes it was detected in.
+ * Each box side back-projects to a plane pi = P' * l tangent to the
+ * quadric, so pi' * Q * pi = 0 is one linear constraint on the 10 unique
+ * entries of the dual quadric Q. The least squares Q is the eigenvector of
+ * the smallest eigenvalue of the 10x10 normal matrix of the constraints,
+ * which is then constrained to an ellipsoid, see
+ * ConstrainedDualQuadric::constrain. Sides truncated by the image border
+ * are not tangent planes, so such boxes bias the initialization.
+ */
+class QuadricInitializer {
+ public:
+  /// the result of initializing a quadric
+  enum Status {
+    SUCCESS,         ///< the quadric is valid in every view
+    TOO_FEW_PLANES,  ///< fewer than 9 planes, at least 3 boxes are needed
+    NON_ELLIPSOID,   ///< the least squares quadric is not an ellipsoid
+    BEHIND_CAMERA,   ///< the quadric is behind one of the views
+    CAMERA_INSIDE    ///< one of the views is inside the quadric
+  };
+
+  /// the boxes of one landmark and the index of the pose each was seen from
+  struct Track {
+    std::vector<size_t> poses;  ///< index into the batch poses of each box
+    AlignedBox2Vector boxes;    ///< the measured boxes
+  };
+
+  /// @name Static methods
+  /// @{
+
+  /**
+   * Initializes a quadric from the boxes of one landmark
+   * @param poses the camera pose of each box
+   * @param boxes the measured boxes
+   * @param calibration the camera calibration shared by every view
+   * @param quadric set to the initialized quadric where SUCCESS
+   */
+  static Status tryInitialize(
+      const std::vector<gtsam::Pose3>& poses, const AlignedBox2Vector& boxes,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      ConstrainedDualQuadric& quadric);
+
+  /**
+   * Initializes a quadric as tryInitialize
+   * @throws std::runtime_error if the initialization fails
+   */
+  static ConstrainedDualQuadric initialize(
+      const std::vector<gtsam::Pose3>& poses, const AlignedBox2Vector& boxes,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration);
+
+  /**
+   * Initializes many landmarks seen from a shared set of poses, computing
+   * the projection matrix of each pose once
+   * @param poses the camera poses indexed by the tracks
+   * @param tracks the boxes of each landmark
+   * @param quadrics resized to the number of tracks, each is set where its
+   * status is SUCCESS
+   * @return the status of each track
+   */
+  static std::vector<Status> initializeBatch(
+      const std::vector<gtsam::Pose3>& poses, const std::vector<Track>& tracks,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      std::vector<ConstrainedDualQuadric>& quadrics);
+
+  /**
+   * Returns the least squares dual quadric tangent to the planes, normalized
+   * to unit Frobenius norm and not constrained to an ellipsoid
+   * @param planes at least 9 planes (a, b, c, d) with ax + by + cz + d = 0
+   */
+  static gtsam::Matrix4 solve(const std::vector<gtsam::Vector4>& planes);
+
+  /** Returns a human readable description of the status */
+  static const char* toString(const Status& status);
+
+  /// @}
+};
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,342 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricKernels.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief quadric geometry templated on the scalar type
+ */
+
+/**
+ * The classes in geometry/ are gtsam manifold types and stay double. These
+ * kernels are the same maths on plain Eigen matrices of any scalar, so they
+ * can be instantiated with float for wider batched passes, or with an
+ * automatic differentiation scalar such as Eigen::AutoDiffScalar or
+ * ceres::Jet. The double instantiation is what the classes compute,
+ * including their closed form jacobians. Every kernel is an
+ * EIGEN_DEVICE_FUNC, so BoundingBoxKernel.h also runs them on CUDA devices.
+ * Poses are given as a rotation R and translation t, world_T_local.
+ */
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include <cmath>
+
+namespace gtsam_quadrics {
+namespace kernels {
+
+template <typename T>
+using Matrix3T = Eigen::Matrix<T, 3, 3>;
+template <typename T>
+using Matrix4T = Eigen::Matrix<T, 4, 4>;
+template <typename T>
+using Matrix34T = Eigen::Matrix<T, 3, 4>;
+template <typename T>
+using Vector3T = Eigen::Matrix<T, 3, 1>;
+template <typename T>
+using Vector4T = Eigen::Matrix<T, 4, 1>;
+
+/** Returns the skew symmetric matrix of w */
+template <typename T>
+EIGEN_DEVICE_FUNC Matrix3T<T> skew(const Vector3T<T>& w) {
+  Matrix3T<T> W;
+  W << T(0), -w(2), w(1), w(2), T(0), -w(0), -w(1), w(0), T(0);
+  return W;
+}
+
+/** Returns a * b' + b * a' */
+template <typename T>
+EIGEN_DEVICE_FUNC Matrix4T<T> symmetricOuter(const Vector4T<T>& a,
+                                             const Vector4T<T>& b) {
+  return a * b.transpose() + b * a.transpose();
+}
+
+/** Returns the rotation matrix of the unit quaternion (w, x, y, z) */
+template <typename T>
+EIGEN_DEVICE_FUNC Matrix3T<T> quaternionMatrix(const T& w, const T& x,
+                                               const T& y, const T& z) {
+  const T xx = x * x, yy = y * y, zz = z * z;
+  const T xy = x * y, xz = x * z, yz = y * z;
+  const T wx = w * x, wy = w * y, wz = w * z;
+  Matrix3T<T> R;
+  R << T(1) - T(2) * (yy + zz), T(2) * (xy - wz), T(2) * (xz + wy),
+      T(2) * (xy + wz), T(1) - T(2) * (xx + zz), T(2) * (yz - wx),
+      T(2) * (xz - wy), T(2) * (yz + wx), T(1) - T(2) * (xx + yy);
+  return R;
+}
+
+/**
+ * Returns the half extents of the axis aligned bounds of an ellipsoid with
+ * rotation R and radii r, sqrt(sum_j R_ij^2 * r_j^2) along each axis i
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC Vector3T<T> halfExtents(const Matrix3T<T>& R,
+                                          const Vector3T<T>& radii) {
+  return (R.array().square().matrix() * radii.array().square().matrix())
+      .cwiseSqrt();
+}
+
+/**
+ * Retracts a pose by the tangent vector [w, v] to first order, as
+ * R * (I + [w]x) and t + R * v. This matches Pose3::retract and its
+ * derivative at zero, which is all an automatic differentiation pass
+ * seeded at zero needs, but the rotation is not orthonormal elsewhere.
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC void retractFirstOrder(const Matrix3T<T>& R,
+                                         const Vector3T<T>& t,
+                                         const Vector3T<T>& w,
+                                         const Vector3T<T>& v,
+                                         Matrix3T<T>& retractedR,
+                                         Vector3T<T>& retractedT) {
+  retractedR = R + R * skew<T>(w);
+  retractedT = t + R * v;
+}
+
+/**
+ * Returns the dual quadric matrix Z * diag(r^2, -1) * Z', where Z is the
+ * quadric pose, in the closed form
+ * [R * diag(r^2) * R' - t*t', -t; -t', -1]
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC Matrix4T<T> quadricMatrix(const Matrix3T<T>& R,
+                                            const Vector3T<T>& t,
+                                            const Vector3T<T>& radii) {
+  Matrix4T<T> Q;
+  Q.template topLeftCorner<3, 3>() =
+      R * radii.array().square().matrix().asDiagonal() * R.transpose() -
+      t * t.transpose();
+  Q.template topRightCorner<3, 1>() = -t;
+  Q.template bottomLeftCorner<1, 3>() = -t.transpose();
+  Q(3, 3) = T(-1);
+  return Q;
+}
+
+/**
+ * Returns the derivative of vec(quadricMatrix) wrt the quadric tangent
+ * vector, see ConstrainedDualQuadric::matrix. This is the closed form of
+ * the kronecker chain
+ *   kron(I44, Z*Qc) * T44 * dZ_dq +
+ *   kron(Z, I44) * (kron(I44, Z) * dQc_dq + kron(Qc, I44) * dZ_dq)
+ * perturbing the pose by the se(3) generator G gives dZ = Z*G, so each
+ * column is vec(Z * (G*Qc + Qc*G') * Z'), which only couples two columns
+ * of Z. Perturbing radius i gives vec(2*r_i * z_i*z_i').
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC Eigen::Matrix<T, 16, 9> quadricJacobian(
+    const Matrix3T<T>& R, const Vector3T<T>& t, const Vector3T<T>& radii) {
+  typedef Eigen::Map<Matrix4T<T> > Column;
+  Vector4T<T> z0, z1, z2, z3;
+  z0 << R.col(0), T(0);
+  z1 << R.col(1), T(0);
+  z2 << R.col(2), T(0);
+  z3 << t, T(1);
+  const Vector3T<T> s = radii.array().square();
+
+  Eigen::Matrix<T, 16, 9> dQ_dq;
+  Column(dQ_dq.col(0).data()) = symmetricOuter<T>(z1, z2) * (s(1) - s(2));
+  Column(dQ_dq.col(1).data()) = symmetricOuter<T>(z0, z2) * (s(2) - s(0));
+  Column(dQ_dq.col(2).data()) = symmetricOuter<T>(z0, z1) * (s(0) - s(1));
+  Column(dQ_dq.col(3).data()) = -symmetricOuter<T>(z0, z3);
+  Column(dQ_dq.col(4).data()) = -symmetricOuter<T>(z1, z3);
+  Column(dQ_dq.col(5).data()) = -symmetricOuter<T>(z2, z3);
+  Column(dQ_dq.col(6).data()) = symmetricOuter<T>(z0, z0) * radii(0);
+  Column(dQ_dq.col(7).data()) = symmetricOuter<T>(z1, z1) * radii(1);
+  Column(dQ_dq.col(8).data()) = symmetricOuter<T>(z2, z2) * radii(2);
+  return dQ_dq;
+}
+
+/** Returns the camera calibration matrix K */
+template <typename T>
+EIGEN_DEVICE_FUNC Matrix3T<T> calibrationMatrix(const T& fx, const T& fy,
+                                                const T& s, const T& u0,
+                                                const T& v0) {
+  Matrix3T<T> K;
+  K << fx, s, u0, T(0), fy, v0, T(0), T(0), T(1);
+  return K;
+}
+
+/** Returns the inverse camera_T_world of a camera at pose (R, t) */
+template <typename T>
+EIGEN_DEVICE_FUNC Matrix4T<T> inversePose(const Matrix3T<T>& R,
+                                          const Vector3T<T>& t) {
+  Matrix4T<T> Xi = Matrix4T<T>::Identity();
+  Xi.template topLeftCorner<3, 3>() = R.transpose();
+  Xi.template topRightCorner<3, 1>() = -R.transpose() * t;
+  return Xi;
+}
+
+/**
+ * Returns the projection matrix K * [R' | -R' * t] of a camera at pose
+ * (R, t), see QuadricCamera::transformToImage
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC Matrix34T<T> projectionMatrix(const Matrix3T<T>& K,
+                                                const Matrix3T<T>& R,
+                                                const Vector3T<T>& t) {
+  Matrix34T<T> P;
+  P.template leftCols<3>() = K * R.transpose();
+  P.col(3) = -P.template leftCols<3>() * t;
+  return P;
+}
+
+/** Returns the dual conic P * Q * P' of a dual quadric */
+template <typename T>
+EIGEN_DEVICE_FUNC Matrix3T<T> projectQuadric(const Matrix34T<T>& P,
+                                             const Matrix4T<T>& Q) {
+  return P * Q * P.transpose();
+}
+
+/**
+ * Returns the derivative of vec(projectQuadric) wrt the quadric tangent
+ * vector, kron(P, P) * dQ_dq applied one column at a time as
+ * vec(P * dQ * P') to avoid forming the 9x16 kronecker product
+ * @param dQ_dq the derivative of the quadric, see quadricJacobian
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC Eigen::Matrix<T, 9, 9> projectQuadricJacobian(
+    const Matrix34T<T>& P, const Eigen::Matrix<T, 16, 9>& dQ_dq) {
+  Eigen::Matrix<T, 9, 9> dC_dq;
+  for (int j = 0; j < 9; j++) {
+    Eigen::Map<const Matrix4T<T> > dQ(dQ_dq.col(j).data());
+    Eigen::Map<Matrix3T<T> >(dC_dq.col(j).data()) = P * dQ * P.transpose();
+  }
+  return dC_dq;
+}
+
+/**
+ * Returns the derivative of vec(projectQuadric) wrt the camera pose tangent
+ * vector, the closed form of dC_dP * dP_dXi * dXi_dX * dX_dx: perturbing
+ * the pose by the se(3) generator G gives dXi = -G * Xi,
+ * dP = -K * I34 * G * Xi and dC = B + B' where B = dP * Q * P'
+ * @param Xi the inverse camera pose, see inversePose
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC Eigen::Matrix<T, 9, 6> projectPoseJacobian(
+    const Matrix3T<T>& K, const Matrix4T<T>& Xi, const Matrix4T<T>& Q,
+    const Matrix34T<T>& P) {
+  const Eigen::Matrix<T, 4, 3> W = Xi * Q * P.transpose();
+  Eigen::Matrix<T, 9, 6> dC_dx;
+  for (int j = 0; j < 3; j++) {
+    // rotation generators only act on the top 3 rows of W
+    const Matrix3T<T> Br =
+        -K * skew<T>(Vector3T<T>::Unit(j)) * W.template topRows<3>();
+    Eigen::Map<Matrix3T<T> >(dC_dx.col(j).data()) = Br + Br.transpose();
+
+    // translation generators move the last row of W into row j
+    const Matrix3T<T> Bt = -K.col(j) * W.row(3);
+    Eigen::Map<Matrix3T<T> >(dC_dx.col(j + 3).data()) = Bt + Bt.transpose();
+  }
+  return dC_dx;
+}
+
+/**
+ * Returns true if the centre tq of a quadric is behind a camera at pose
+ * (Rx, tx), see ConstrainedDualQuadric::isBehind
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC bool isBehind(const Matrix3T<T>& Rx, const Vector3T<T>& tx,
+                                const Vector3T<T>& tq) {
+  return Rx.col(2).dot(tq - tx) < T(0);
+}
+
+/**
+ * Returns true if the camera centre tx is inside the ellipsoid (Rq, tq,
+ * radii), see QuadricContext::contains
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC bool contains(const Matrix3T<T>& Rq, const Vector3T<T>& tq,
+                                const Vector3T<T>& radii,
+                                const Vector3T<T>& tx) {
+  return (Rq.transpose() * (tx - tq)).cwiseQuotient(radii).squaredNorm() <=
+         T(1);
+}
+
+/**
+ * Returns the simple bounds (xmin, ymin, xmax, ymax) of a dual conic, see
+ * DualConic::bounds. Bounds are nan when the conic is not an ellipse.
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC Vector4T<T> conicBounds(const Matrix3T<T>& C) {
+  using std::sqrt;
+  const T f = sqrt(C(0, 2) * C(0, 2) - C(2, 2) * C(0, 0));
+  const T g = sqrt(C(1, 2) * C(1, 2) - C(2, 2) * C(1, 1));
+  Vector4T<T> bounds;
+  bounds << (C(0, 2) + f) / C(2, 2), (C(1, 2) + g) / C(2, 2),
+      (C(0, 2) - f) / C(2, 2), (C(1, 2) - g) / C(2, 2);
+  return bounds;
+}
+
+/**
+ * Returns the derivative of conicBounds wrt vec(C), see DualConic::bounds.
+ * Only C00, C11, C22, C02 and C12 have nonzero columns.
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC Eigen::Matrix<T, 4, 9> conicBoundsJacobian(
+    const Matrix3T<T>& C) {
+  using std::sqrt;
+  const T f = sqrt(C(0, 2) * C(0, 2) - C(0, 0) * C(2, 2));
+  const T g = sqrt(C(1, 2) * C(1, 2) - C(1, 1) * C(2, 2));
+  Eigen::Matrix<T, 4, 9> db_dC = Eigen::Matrix<T, 4, 9>::Zero();
+  db_dC(0, 0) = T(1) / f * T(-0.5);
+  db_dC(0, 6) = (C(0, 2) * T(1) / f + T(1)) / C(2, 2);
+  db_dC(0, 8) = T(-1) / (C(2, 2) * C(2, 2)) * (C(0, 2) + f) -
+                (C(0, 0) * T(1) / f * T(0.5)) / C(2, 2);
+  db_dC(1, 4) = T(1) / g * T(-0.5);
+  db_dC(1, 7) = (C(1, 2) * T(1) / g + T(1)) / C(2, 2);
+  db_dC(1, 8) = T(-1) / (C(2, 2) * C(2, 2)) * (C(1, 2) + g) -
+                (C(1, 1) * T(1) / g * T(0.5)) / C(2, 2);
+  db_dC(2, 0) = T(1) / f * T(0.5);
+  db_dC(2, 6) = -(C(0, 2) * T(1) / f - T(1)) / C(2, 2);
+  db_dC(2, 8) = T(-1) / (C(2, 2) * C(2, 2)) * (C(0, 2) - f) +
+                (C(0, 0) * T(1) / f * T(0.5)) / C(2, 2);
+  db_dC(3, 4) = T(1) / g * T(0.5);
+  db_dC(3, 7) = -(C(1, 2) * T(1) / g - T(1)) / C(2, 2);
+  db_dC(3, 8) = T(-1) / (C(2, 2) * C(2, 2)) * (C(1, 2) - g) +
+                (C(1, 1) * T(1) / g * T(0.5)) / C(2, 2);
+  return db_dC;
+}
+
+/**
+ * Returns true if the dual conic is an ellipse, without inverting it:
+ * the top-left block of adj(C) has determinant det(C) * C22, so the
+ * normalized point conic is an ellipse when det(C) * C22 > 0 and
+ * adj(C)22 != 0, see DualConic::isEllipse
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC bool isEllipse(const Matrix3T<T>& C) {
+  const T minor = C(0, 0) * C(1, 1) - C(0, 1) * C(0, 1);
+  const T det = C(0, 0) * (C(1, 1) * C(2, 2) - C(1, 2) * C(1, 2)) -
+                C(0, 1) * (C(0, 1) * C(2, 2) - C(1, 2) * C(0, 2)) +
+                C(0, 2) * (C(0, 1) * C(1, 2) - C(1, 1) * C(0, 2));
+  return det * C(2, 2) > T(0) && minor != T(0);
+}
+
+/**
+ * Returns the STANDARD BoundingBoxFactor error, the simple bounds of the
+ * quadric (Rq, tq, radii) seen from a camera (Rx, tx) minus the measured
+ * bounds. Assumes the projection succeeds, see QuadricCamera::tryProject.
+ */
+template <typename T>
+EIGEN_DEVICE_FUNC Vector4T<T> boundingBoxError(
+    const Matrix3T<T>& Rx, const Vector3T<T>& tx, const Matrix3T<T>& Rq,
+    const Vector3T<T>& tq, const Vector3T<T>& radii, const Matrix3T<T>& K,
+    const Vector4T<T>& measured) {
+  const Matrix3T<T> C = projectQuadric<T>(projectionMatrix<T>(K, Rx, tx),
+                                          quadricMatrix<T>(Rq, tq, radii));
+  return conicBounds<T>(C) - measured;
+}
+
+}  // namespace kernels
+}  // namespace gtsam_quadrics
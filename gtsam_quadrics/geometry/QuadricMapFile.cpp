@@ -0,0 +1,175 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricMapFile.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief a compact binary format for quadric maps and detection streams
+ */
+
+#include <gtsam_quadrics/geometry/QuadricMapFile.h>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+namespace {
+
+/// writes the rotation as a quaternion (w, x, y, z) and the translation
+void fromPose(const gtsam::Pose3& pose, double* rotation,
+              double* translation) {
+  const gtsam::Quaternion q = pose.rotation().toQuaternion();
+  rotation[0] = q.w();
+  rotation[1] = q.x();
+  rotation[2] = q.y();
+  rotation[3] = q.z();
+  const gtsam::Point3& t = pose.translation();
+  for (int i = 0; i < 3; i++) {
+    translation[i] = t(i);
+  }
+}
+
+/// reads the pose of a quaternion (w, x, y, z) and translation
+gtsam::Pose3 toPose3(const double* rotation, const double* translation) {
+  return gtsam::Pose3(gtsam::Rot3::Quaternion(rotation[0], rotation[1],
+                                              rotation[2], rotation[3]),
+                      gtsam::Point3(translation[0], translation[1],
+                                    translation[2]));
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+QuadricMapFile::Landmark QuadricMapFile::toRecord(
+    const gtsam::Key& key, const ConstrainedDualQuadric& quadric) {
+  Landmark record;
+  record.key = key;
+  fromPose(quadric.pose(), record.rotation, record.translation);
+  for (int i = 0; i < 3; i++) {
+    record.radii[i] = quadric.radii()(i);
+  }
+  return record;
+}
+
+/* ************************************************************************* */
+QuadricMapFile::Pose QuadricMapFile::toRecord(const gtsam::Key& key,
+                                              const gtsam::Pose3& pose) {
+  Pose record;
+  record.key = key;
+  fromPose(pose, record.rotation, record.translation);
+  return record;
+}
+
+/* ************************************************************************* */
+QuadricMapFile::Detection QuadricMapFile::toRecord(
+    const BoundingBoxFactor& factor, uint32_t cameraId) {
+  Detection record;
+  record.poseKey = factor.poseKey();
+  record.quadricKey = factor.objectKey();
+  record.cameraId = cameraId;
+  record.reserved = 0;
+  const gtsam::Vector4 box = factor.measurement().vector();
+  for (int i = 0; i < 4; i++) {
+    record.box[i] = box(i);
+  }
+  return record;
+}
+
+/* ************************************************************************* */
+ConstrainedDualQuadric QuadricMapFile::toQuadric(const Landmark& record) {
+  return ConstrainedDualQuadric(
+      toPose3(record.rotation, record.translation),
+      gtsam::Vector3(record.radii[0], record.radii[1], record.radii[2]));
+}
+
+/* ************************************************************************* */
+gtsam::Pose3 QuadricMapFile::toPose(const Pose& record) {
+  return toPose3(record.rotation, record.translation);
+}
+
+/* ************************************************************************* */
+AlignedBox2 QuadricMapFile::toBox(const Detection& record) {
+  return AlignedBox2(record.box[0], record.box[1], record.box[2],
+                     record.box[3]);
+}
+
+/* ************************************************************************* */
+BoundingBoxFactor QuadricMapFile::toFactor(
+    const Detection& record,
+    const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+    const gtsam::SharedNoiseModel& model,
+    const BoundingBoxFactor::MeasurementModel& errorType) {
+  return BoundingBoxFactor(toBox(record), calibration, record.poseKey,
+                           record.quadricKey, model, errorType);
+}
+
+/* ************************************************************************* */
+void QuadricMapFile::saveLandmarks(const std::string& filename,
+                                   const gtsam::Values& values) {
+  Writer<Landmark> writer(filename);
+  for (const auto& keyValue : values.filter<ConstrainedDualQuadric>()) {
+    writer.write(toRecord(keyValue.key, keyValue.value));
+  }
+  writer.flush();
+}
+
+/* ************************************************************************* */
+gtsam::Values QuadricMapFile::loadLandmarks(const std::string& filename) {
+  gtsam::Values values;
+  for (const Landmark& record : read<Landmark>(filename)) {
+    values.insert(record.key, toQuadric(record));
+  }
+  return values;
+}
+
+/* ************************************************************************* */
+void QuadricMapFile::savePoses(const std::string& filename,
+                               const gtsam::Values& values) {
+  Writer<Pose> writer(filename);
+  for (const auto& keyValue : values.filter<gtsam::Pose3>()) {
+    writer.write(toRecord(keyValue.key, keyValue.value));
+  }
+  writer.flush();
+}
+
+/* ************************************************************************* */
+gtsam::Values QuadricMapFile::loadPoses(const std::string& filename) {
+  gtsam::Values values;
+  for (const Pose& record : read<Pose>(filename)) {
+    values.insert(record.key, toPose(record));
+  }
+  return values;
+}
+
+/* ************************************************************************* */
+void QuadricMapFile::saveDetections(const std::string& filename,
+                                    const gtsam::NonlinearFactorGraph& graph,
+                                    uint32_t cameraId, bool append) {
+  Writer<Detection> writer(filename, append);
+  for (const auto& factor : graph) {
+    const BoundingBoxFactor* bbf =
+        dynamic_cast<const BoundingBoxFactor*>(factor.get());
+    if (bbf) {
+      writer.write(toRecord(*bbf, cameraId));
+    }
+  }
+  writer.flush();
+}
+
+/* ************************************************************************* */
+std::vector<QuadricMapFile::Detection> QuadricMapFile::loadDetections(
+    const std::string& filename) {
+  return read<Detection>(filename);
+}
+
+}  // namespace gtsam_quadrics
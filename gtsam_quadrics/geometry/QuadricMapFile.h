@@ -0,0 +1,333 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricMapFile.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief a compact binary format for quadric maps and detection streams
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class QuadricMapFile
+ * Reads and writes landmarks, poses and detections as flat arrays of fixed
+ * size records behind a 32 byte header, in host byte order. The number of
+ * records is implied by the file size, so a file can be appended to while
+ * it is being recorded and replayed or memory mapped without parsing, e.g.
+ * numpy.memmap(filename, dtype, offset=32). A trailing partial record left
+ * by an interrupted writer is ignored when reading.
+ * Rotations are stored as unit quaternions (w, x, y, z).
+ * For full objects and factor graphs use the boost serialization of each
+ * class instead, see gtsam/base/serialization.h.
+ */
+class QuadricMapFile {
+ public:
+  /// the identifier of each record type
+  enum RecordType { LANDMARK = 1, POSE = 2, DETECTION = 3 };
+
+  /// the version written to new files
+  enum { VERSION = 1 };
+
+  /// the header at the start of every file
+  struct Header {
+    char magic[8];        ///< "GTSQMAP\0"
+    uint32_t version;     ///< the format version
+    uint32_t recordType;  ///< one of RecordType
+    uint32_t recordSize;  ///< sizeof the record, in bytes
+    uint32_t byteOrder;   ///< 0x01020304 in the byte order of the writer
+    uint64_t reserved;    ///< zero
+  };
+
+  /// a quadric landmark
+  struct Landmark {
+    enum { TYPE = LANDMARK };
+    uint64_t key;
+    double rotation[4];     ///< quaternion (w, x, y, z)
+    double translation[3];  ///< position in the world frame
+    double radii[3];        ///< radii along each local axis
+  };
+
+  /// a camera pose, world_T_camera
+  struct Pose {
+    enum { TYPE = POSE };
+    uint64_t key;
+    double rotation[4];     ///< quaternion (w, x, y, z)
+    double translation[3];  ///< position in the world frame
+  };
+
+  /// a bounding box of a landmark seen from a pose
+  struct Detection {
+    enum { TYPE = DETECTION };
+    uint64_t poseKey;
+    uint64_t quadricKey;
+    uint32_t cameraId;  ///< the camera of a multi camera rig
+    uint32_t reserved;  ///< zero
+    double box[4];      ///< (xmin, ymin, xmax, ymax)
+  };
+
+  /**
+   * @class View
+   * A read only view of the records in a buffer holding a whole file,
+   * e.g. from mmap. The buffer must outlive the view.
+   */
+  template <class Record>
+  class View {
+   public:
+    /**
+     * @param data the start of the file, aligned to 8 bytes
+     * @param size the size of the file, in bytes
+     * @throws std::runtime_error if the header does not match Record
+     */
+    View(const void* data, size_t size) : records_(0), size_(0) {
+      if (size < sizeof(Header)) {
+        throw std::runtime_error("QuadricMapFile is missing its header");
+      }
+      Header header;
+      std::memcpy(&header, data, sizeof(Header));
+      checkHeader<Record>(header);
+      records_ = reinterpret_cast<const Record*>(
+          static_cast<const char*>(data) + sizeof(Header));
+      size_ = (size - sizeof(Header)) / sizeof(Record);
+    }
+
+    /** Returns the number of complete records */
+    size_t size() const { return size_; }
+
+    /** Returns record i */
+    const Record& operator[](size_t i) const { return records_[i]; }
+
+    const Record* begin() const { return records_; }
+    const Record* end() const { return records_ + size_; }
+
+   private:
+    const Record* records_;
+    size_t size_;
+  };
+
+  /**
+   * @class Writer
+   * Streams records to a file, writing the header when the file is new
+   */
+  template <class Record>
+  class Writer {
+   public:
+    /**
+     * @param filename the file to write
+     * @param append if true, records are added to the end of an existing
+     * file of the same record type
+     * @throws std::runtime_error if the file cannot be opened or an existing
+     * file has a different header or ends in a partial record
+     */
+    explicit Writer(const std::string& filename, bool append = false) {
+      size_t existing = 0;
+      if (append) {
+        std::ifstream in(filename, std::ios::binary | std::ios::ate);
+        if (in) {
+          existing = size_t(in.tellg());
+        }
+        if (existing > 0) {
+          Header header;
+          in.seekg(0);
+          if (!in.read(reinterpret_cast<char*>(&header), sizeof(Header))) {
+            throw std::runtime_error("QuadricMapFile is missing its header");
+          }
+          checkHeader<Record>(header);
+          if ((existing - sizeof(Header)) % sizeof(Record) != 0) {
+            throw std::runtime_error(
+                "QuadricMapFile ends in a partial record, cannot append");
+          }
+        }
+      }
+      file_.open(filename, std::ios::binary | (existing > 0
+                                                   ? std::ios::app
+                                                   : std::ios::trunc));
+      if (!file_) {
+        throw std::runtime_error("QuadricMapFile cannot open " + filename);
+      }
+      if (existing == 0) {
+        const Header header = makeHeader<Record>();
+        file_.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+      }
+    }
+
+    /** Appends a record */
+    void write(const Record& record) {
+      file_.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+    }
+
+    /** Appends many records */
+    void write(const std::vector<Record>& records) {
+      file_.write(reinterpret_cast<const char*>(records.data()),
+                  records.size() * sizeof(Record));
+    }
+
+    /**
+     * Flushes the written records to the file
+     * @throws std::runtime_error if a write failed
+     */
+    void flush() {
+      file_.flush();
+      if (!file_) {
+        throw std::runtime_error("QuadricMapFile write failed");
+      }
+    }
+
+   private:
+    std::ofstream file_;
+  };
+
+  /// @name Record conversions
+  /// @{
+
+  /** Returns the record of a quadric */
+  static Landmark toRecord(const gtsam::Key& key,
+                           const ConstrainedDualQuadric& quadric);
+
+  /** Returns the record of a pose */
+  static Pose toRecord(const gtsam::Key& key, const gtsam::Pose3& pose);
+
+  /** Returns the record of the measurement of a factor */
+  static Detection toRecord(const BoundingBoxFactor& factor,
+                            uint32_t cameraId = 0);
+
+  /** Returns the quadric of a record */
+  static ConstrainedDualQuadric toQuadric(const Landmark& record);
+
+  /** Returns the pose of a record */
+  static gtsam::Pose3 toPose(const Pose& record);
+
+  /** Returns the box of a record */
+  static AlignedBox2 toBox(const Detection& record);
+
+  /** Returns a factor measuring the box of a record */
+  static BoundingBoxFactor toFactor(
+      const Detection& record,
+      const boost::shared_ptr<gtsam::Cal3_S2>& calibration,
+      const gtsam::SharedNoiseModel& model,
+      const BoundingBoxFactor::MeasurementModel& errorType =
+          BoundingBoxFactor::STANDARD);
+
+  /// @}
+  /// @name Files
+  /// @{
+
+  /**
+   * Reads every complete record of a file
+   * @throws std::runtime_error if the file cannot be read or its header
+   * does not match Record
+   */
+  template <class Record>
+  static std::vector<Record> read(const std::string& filename) {
+    std::ifstream in(filename, std::ios::binary | std::ios::ate);
+    if (!in) {
+      throw std::runtime_error("QuadricMapFile cannot open " + filename);
+    }
+    // read into 8 byte aligned storage so the records can be viewed in place
+    const size_t size = size_t(in.tellg());
+    std::vector<uint64_t> buffer((size + 7) / 8);
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(buffer.data()), size);
+    View<Record> view(buffer.data(), size);
+    return std::vector<Record>(view.begin(), view.end());
+  }
+
+  /** Writes every ConstrainedDualQuadric in the values */
+  static void saveLandmarks(const std::string& filename,
+                            const gtsam::Values& values);
+
+  /** Reads the landmarks of a file into values */
+  static gtsam::Values loadLandmarks(const std::string& filename);
+
+  /** Writes every Pose3 in the values */
+  static void savePoses(const std::string& filename,
+                        const gtsam::Values& values);
+
+  /** Reads the poses of a file into values */
+  static gtsam::Values loadPoses(const std::string& filename);
+
+  /**
+   * Writes the measurement of every BoundingBoxFactor in the graph
+   * @param append if true, adds to the end of an existing detection file
+   */
+  static void saveDetections(const std::string& filename,
+                             const gtsam::NonlinearFactorGraph& graph,
+                             uint32_t cameraId = 0, bool append = false);
+
+  /** Reads the detections of a file */
+  static std::vector<Detection> loadDetections(const std::string& filename);
+
+  /// @}
+
+ private:
+  /** Returns the header of a new file of Record */
+  template <class Record>
+  static Header makeHeader() {
+    Header header;
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    header.recordType = Record::TYPE;
+    header.recordSize = sizeof(Record);
+    header.byteOrder = BYTE_ORDER_MARK;
+    return header;
+  }
+
+  /** Throws std::runtime_error if the header is not of a file of Record */
+  template <class Record>
+  static void checkHeader(const Header& header) {
+    if (std::memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0) {
+      throw std::runtime_error("Not a QuadricMapFile");
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+      throw std::runtime_error("QuadricMapFile has a different byte order");
+    }
+    if (header.version != uint32_t(VERSION)) {
+      throw std::runtime_error("QuadricMapFile has an unsupported version");
+    }
+    if (header.recordType != uint32_t(Record::TYPE) ||
+        header.recordSize != sizeof(Record)) {
+      throw std::runtime_error("QuadricMapFile has a different record type");
+    }
+  }
+
+  static constexpr const char* MAGIC = "GTSQMAP";
+  static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+};
+
+static_assert(sizeof(QuadricMapFile::Header) == 32,
+              "QuadricMapFile::Header must be 32 bytes");
+static_assert(sizeof(QuadricMapFile::Landmark) == 88,
+              "QuadricMapFile::Landmark must be 88 bytes");
+static_assert(sizeof(QuadricMapFile::Pose) == 64,
+              "QuadricMapFile::Pose must be 64 bytes");
+static_assert(sizeof(QuadricMapFile::Detection) == 56,
+              "QuadricMapFile::Detection must be 56 bytes");
+
+}  // namespace gtsam_quadrics
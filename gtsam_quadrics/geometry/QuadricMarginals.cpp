@@ -0,0 +1,89 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricMarginals.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief cached marginal covariances of quadric landmarks from ISAM2
+ */
+
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/QuadricMarginals.h>
+
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+gtsam::Matrix QuadricMarginals::covariance(const gtsam::ISAM2& isam,
+                                           const gtsam::Key& key) {
+  if (cached(isam, key)) {
+    return cache_.at(key).covariance;
+  }
+
+  const gtsam::Values& theta = isam.getLinearizationPoint();
+  if (!theta.exists<ConstrainedDualQuadric>(key)) {
+    throw std::invalid_argument(
+        "QuadricMarginals key is not a ConstrainedDualQuadric in ISAM2");
+  }
+  Entry& entry = cache_[key];
+  entry.covariance = isam.marginalCovariance(key);
+  entry.cliques.clear();
+  for (gtsam::ISAM2::sharedClique node = clique(isam, key); node;
+       node = node->parent()) {
+    entry.cliques.push_back(node);
+  }
+  nrComputed_++;
+  return entry.covariance;
+}
+
+/* ************************************************************************* */
+std::vector<gtsam::Matrix> QuadricMarginals::covariances(
+    const gtsam::ISAM2& isam, const gtsam::KeyVector& keys) {
+  std::vector<gtsam::Matrix> covariances;
+  covariances.reserve(keys.size());
+  for (const gtsam::Key& key : keys) {
+    covariances.push_back(covariance(isam, key));
+  }
+  return covariances;
+}
+
+/* ************************************************************************* */
+bool QuadricMarginals::cached(const gtsam::ISAM2& isam,
+                              const gtsam::Key& key) const {
+  auto it = cache_.find(key);
+  if (it == cache_.end()) {
+    return false;
+  }
+  // the cliques are compared by identity, ISAM2 replaces the cliques it
+  // re-eliminates and a new root above the old one is a change as well
+  gtsam::ISAM2::sharedClique node = clique(isam, key);
+  for (const auto& cached : it->second.cliques) {
+    if (!node || cached.lock() != node) {
+      return false;
+    }
+    node = node->parent();
+  }
+  return !node;
+}
+
+/* ************************************************************************* */
+gtsam::ISAM2::sharedClique QuadricMarginals::clique(const gtsam::ISAM2& isam,
+                                                    const gtsam::Key& key) {
+  auto it = isam.nodes().find(key);
+  return it == isam.nodes().end() ? gtsam::ISAM2::sharedClique()
+                                  : it->second;
+}
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,110 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricMarginals.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief cached marginal covariances of quadric landmarks from ISAM2
+ */
+
+#pragma once
+
+#include <gtsam/base/Matrix.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/nonlinear/ISAM2.h>
+
+#include <boost/weak_ptr.hpp>
+#include <map>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class QuadricMarginals
+ * Marginal covariances of the requested landmarks only, read from the
+ * Bayes tree ISAM2 already maintains instead of eliminating the whole graph
+ * as gtsam::Marginals does. Each covariance is computed from the clique of
+ * the landmark and the separator marginals above it, which the Bayes tree
+ * caches and shares between landmarks.
+ *
+ * Covariances are also cached here, together with the cliques they were
+ * computed from. ISAM2 replaces a clique when it re-eliminates it, and the
+ * covariance of a landmark changes whenever its clique or any clique above
+ * it changes, e.g. when a pose it was seen from is constrained further, so
+ * a cached covariance is recomputed once any clique between the landmark
+ * and the root changes. Every update of a connected graph replaces the
+ * root, so every covariance is recomputed after every update: the cache
+ * only saves repeated queries between two updates.
+ * The covariances are in the tangent space of the ISAM2 linearization
+ * point, see ConstrainedDualQuadric::retract.
+ */
+class QuadricMarginals {
+ protected:
+  /// a cached covariance and the cliques it depends on
+  struct Entry {
+    gtsam::Matrix covariance;
+    std::vector<boost::weak_ptr<gtsam::ISAM2::Clique> > cliques;
+  };
+
+  std::map<gtsam::Key, Entry> cache_;   ///< covariance of each landmark
+  size_t nrComputed_;                   ///< covariances computed so far
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Default constructor, with an empty cache */
+  QuadricMarginals() : nrComputed_(0) {}
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the number of cached covariances */
+  size_t size() const { return cache_.size(); }
+
+  /** Returns the number of covariances computed, as opposed to cached */
+  size_t nrComputed() const { return nrComputed_; }
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /**
+   * Returns the 9x9 marginal covariance of a landmark, from the cache if
+   * its cliques are unchanged
+   * @throws std::invalid_argument if the key is not a quadric in isam
+   */
+  gtsam::Matrix covariance(const gtsam::ISAM2& isam, const gtsam::Key& key);
+
+  /** Returns the marginal covariance of each landmark, see covariance */
+  std::vector<gtsam::Matrix> covariances(const gtsam::ISAM2& isam,
+                                         const gtsam::KeyVector& keys);
+
+  /** Returns true if the cached covariance of a landmark is still valid */
+  bool cached(const gtsam::ISAM2& isam, const gtsam::Key& key) const;
+
+  /** Forgets the covariance of a landmark, e.g. after it is removed */
+  void erase(const gtsam::Key& key) { cache_.erase(key); }
+
+  /** Forgets every cached covariance */
+  void clear() { cache_.clear(); }
+
+  /// @}
+
+ protected:
+  /** Returns the clique a variable is a frontal of, or null */
+  static gtsam::ISAM2::sharedClique clique(const gtsam::ISAM2& isam,
+                                           const gtsam::Key& key);
+};
+
+}  // namespace gtsam_quadrics
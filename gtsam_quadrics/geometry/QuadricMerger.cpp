@@ -0,0 +1,209 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricMerger.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief merges duplicate quadric landmarks found with a QuadricIndex
+ */
+
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/QuadricMerger.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+namespace {
+
+/// returns the root of a key, halving the path on the way
+gtsam::Key findRoot(std::map<gtsam::Key, gtsam::Key>& parents,
+                    gtsam::Key key) {
+  while (parents[key] != key) {
+    parents[key] = parents[parents[key]];
+    key = parents[key];
+  }
+  return key;
+}
+
+/// true if the factor involves a key more than once
+bool repeatsKeys(const gtsam::NonlinearFactor& factor) {
+  gtsam::KeyVector keys = factor.keys();
+  std::sort(keys.begin(), keys.end());
+  return std::adjacent_find(keys.begin(), keys.end()) != keys.end();
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+std::vector<gtsam::KeyVector> QuadricMerger::group(
+    const std::vector<KeyPair>& pairs) {
+  std::map<gtsam::Key, gtsam::Key> parents;
+  for (const KeyPair& pair : pairs) {
+    parents.insert(std::make_pair(pair.first, pair.first));
+    parents.insert(std::make_pair(pair.second, pair.second));
+  }
+  for (const KeyPair& pair : pairs) {
+    gtsam::Key a = findRoot(parents, pair.first);
+    gtsam::Key b = findRoot(parents, pair.second);
+    if (a != b) {
+      parents[std::max(a, b)] = std::min(a, b);
+    }
+  }
+
+  // the root is the smallest key of its group, and keys are visited in
+  // order, so each group is created by its root and filled in order
+  std::vector<gtsam::KeyVector> groups;
+  std::map<gtsam::Key, size_t> groupOfRoot;
+  for (const auto& keyParent : parents) {
+    const gtsam::Key root = findRoot(parents, keyParent.first);
+    auto inserted = groupOfRoot.insert(std::make_pair(root, groups.size()));
+    if (inserted.second) {
+      groups.push_back(gtsam::KeyVector());
+    }
+    groups[inserted.first->second].push_back(keyParent.first);
+  }
+  return groups;
+}
+
+/* ************************************************************************* */
+QuadricMerger::KeyMap QuadricMerger::merge(
+    const std::vector<gtsam::KeyVector>& groups,
+    gtsam::NonlinearFactorGraph& graph, gtsam::Values& values,
+    size_t nrThreads) {
+  std::map<gtsam::Key, size_t> nrFactors;
+  for (const gtsam::KeyVector& keys : groups) {
+    for (const gtsam::Key& key : keys) {
+      if (!values.exists<ConstrainedDualQuadric>(key)) {
+        throw std::invalid_argument(
+            "QuadricMerger key is not a ConstrainedDualQuadric in values");
+      }
+      nrFactors[key] = 0;
+    }
+  }
+  for (const gtsam::NonlinearFactor::shared_ptr& factor : graph) {
+    if (!factor) continue;
+    for (const gtsam::Key& key : factor->keys()) {
+      auto it = nrFactors.find(key);
+      if (it != nrFactors.end()) {
+        it->second++;
+      }
+    }
+  }
+
+  KeyMap merged;
+  for (const gtsam::KeyVector& keys : groups) {
+    if (keys.size() < 2) continue;
+    gtsam::Key target = keys.front();
+    for (const gtsam::Key& key : keys) {
+      if (nrFactors[key] > nrFactors[target] ||
+          (nrFactors[key] == nrFactors[target] && key < target)) {
+        target = key;
+      }
+    }
+    for (const gtsam::Key& key : keys) {
+      if (key != target) {
+        merged[key] = target;
+      }
+    }
+
+    // average the group in the tangent space of the kept estimate
+    const ConstrainedDualQuadric& kept =
+        values.at<ConstrainedDualQuadric>(target);
+    gtsam::Vector9 delta = gtsam::Vector9::Zero();
+    double totalWeight = 0.0;
+    for (const gtsam::Key& key : keys) {
+      const double weight = double(std::max<size_t>(nrFactors[key], 1));
+      delta += weight * kept.localCoordinates(
+                            values.at<ConstrainedDualQuadric>(key));
+      totalWeight += weight;
+    }
+    const ConstrainedDualQuadric fused = kept.retract(delta / totalWeight);
+    values.update(target, fused);
+  }
+  if (merged.empty()) {
+    return merged;
+  }
+
+  // cloning the factors dominates, so the threads rekey interleaved slots
+  // of the graph and the graph is only modified once they have joined
+  const size_t n = graph.size();
+  nrThreads = std::max<size_t>(std::min(nrThreads, n), 1);
+  std::vector<gtsam::NonlinearFactor::shared_ptr> rekeyed(n);
+  std::vector<char> changed(n, 0);
+  auto rekey = [&](size_t thread) {
+    for (size_t i = thread; i < n; i += nrThreads) {
+      const gtsam::NonlinearFactor::shared_ptr& factor = graph[i];
+      if (!factor) continue;
+      for (const gtsam::Key& key : factor->keys()) {
+        if (merged.count(key)) {
+          changed[i] = 1;
+          break;
+        }
+      }
+      if (changed[i]) {
+        rekeyed[i] = factor->rekey(merged);
+        if (repeatsKeys(*rekeyed[i])) {
+          rekeyed[i].reset();
+        }
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (size_t thread = 1; thread < nrThreads; thread++) {
+    threads.push_back(std::thread(rekey, thread));
+  }
+  rekey(0);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    if (!changed[i]) continue;
+    if (rekeyed[i]) {
+      graph.replace(i, rekeyed[i]);
+    } else {
+      graph.remove(i);
+    }
+  }
+  for (const auto& keyTarget : merged) {
+    values.erase(keyTarget.first);
+  }
+  return merged;
+}
+
+/* ************************************************************************* */
+QuadricMerger::KeyMap QuadricMerger::mergeDuplicates(
+    QuadricIndex& index, gtsam::NonlinearFactorGraph& graph,
+    gtsam::Values& values, const double& minIou, size_t nrThreads) {
+  // landmarks only in the index, e.g. frozen ones, are left alone
+  std::vector<KeyPair> pairs;
+  for (const KeyPair& pair : index.overlapping(minIou, nrThreads)) {
+    if (values.exists<ConstrainedDualQuadric>(pair.first) &&
+        values.exists<ConstrainedDualQuadric>(pair.second)) {
+      pairs.push_back(pair);
+    }
+  }
+  KeyMap merged = merge(group(pairs), graph, values, nrThreads);
+  for (const auto& keyTarget : merged) {
+    index.remove(keyTarget.first);
+    index.update(keyTarget.second,
+                 values.at<ConstrainedDualQuadric>(keyTarget.second));
+  }
+  return merged;
+}
+
+}  // namespace gtsam_quadrics
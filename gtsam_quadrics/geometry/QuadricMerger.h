@@ -0,0 +1,95 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricMerger.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief merges duplicate quadric landmarks found with a QuadricIndex
+ */
+
+#pragma once
+
+#include <gtsam/inference/Key.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam_quadrics/geometry/QuadricIndex.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class QuadricMerger
+ * Fuses landmarks that describe the same object, e.g. when an object is
+ * initialized again after association failed. Overlapping landmarks are
+ * grouped transitively, and each group is merged into the landmark with
+ * the most factors: the factors of the others are rekeyed to it, and their
+ * estimates are fused into its estimate and erased. Estimates are averaged
+ * in the tangent space of the kept landmark, weighted by the number of
+ * factors on each as a proxy for their information. The kept estimate is
+ * constrained by every box of the group from then on, so the next
+ * optimization refines the fused estimate.
+ *
+ * Factors are replaced in place, so the indices of the other factors stay
+ * valid. Factors that would constrain a landmark against itself after
+ * rekeying, e.g. a between factor of two merged landmarks, are removed and
+ * leave an empty slot as NonlinearFactorGraph::remove does. Every factor
+ * touching a merged landmark has to implement clone, see
+ * gtsam::NonlinearFactor::rekey.
+ */
+class QuadricMerger {
+ public:
+  /// a pair of landmark keys
+  typedef std::pair<gtsam::Key, gtsam::Key> KeyPair;
+
+  /// the landmark each merged key was merged into
+  typedef std::map<gtsam::Key, gtsam::Key> KeyMap;
+
+  /// @name Class methods
+  /// @{
+
+  /**
+   * Returns the connected groups of the pairs, each sorted by key, with
+   * groups in order of their smallest key
+   */
+  static std::vector<gtsam::KeyVector> group(
+      const std::vector<KeyPair>& pairs);
+
+  /**
+   * Merges each group of landmarks into its landmark with the most factors,
+   * ties going to the smallest key, see the class description
+   * @param nrThreads the factors are rekeyed by this many threads
+   * @return the landmark each removed key was merged into
+   * @throws std::invalid_argument if a key is not a quadric in values
+   */
+  static KeyMap merge(const std::vector<gtsam::KeyVector>& groups,
+                      gtsam::NonlinearFactorGraph& graph,
+                      gtsam::Values& values, size_t nrThreads = 1);
+
+  /**
+   * Merges the landmarks of values whose indexed bounds overlap by at least
+   * minIou, removes the merged landmarks from the index and moves the kept
+   * landmarks to their fused estimates
+   * @return the landmark each removed key was merged into
+   */
+  static KeyMap mergeDuplicates(QuadricIndex& index,
+                                gtsam::NonlinearFactorGraph& graph,
+                                gtsam::Values& values,
+                                const double& minIou = 0.5,
+                                size_t nrThreads = 1);
+
+  /// @}
+};
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,314 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricPipeline.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief front-end and ISAM2 back-end of quadric SLAM on separate threads
+ */
+
+#include <gtsam/inference/Symbol.h>
+#include <gtsam_quadrics/geometry/BoxAssociation.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricInitializer.h>
+#include <gtsam_quadrics/geometry/QuadricPipeline.h>
+
+#include <boost/make_shared.hpp>
+#include <chrono>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/// how long the back-end sleeps when there is nothing to apply
+static const std::chrono::microseconds idleSleep(100);
+
+/* ************************************************************************* */
+QuadricPipeline::QuadricPipeline(const QuadricPipelineParams& params)
+    : params_(params),
+      seenVersion_(0),
+      nrFrames_(0),
+      nrLandmarks_(0),
+      submitted_(0),
+      isam_(params.isam),
+      version_(0),
+      queue_(params.queueCapacity),
+      snapshot_(boost::make_shared<const Snapshot>()),
+      applied_(0),
+      running_(false),
+      failed_(false) {
+  if (params_.minViews < 3) {
+    throw std::invalid_argument(
+        "QuadricPipeline requires at least 3 views to initialize a landmark");
+  }
+}
+
+/* ************************************************************************* */
+QuadricPipeline::~QuadricPipeline() {
+  try {
+    this->stop();
+  } catch (...) {
+  }
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<const QuadricPipeline::Snapshot> QuadricPipeline::snapshot()
+    const {
+  return boost::atomic_load(&snapshot_);
+}
+
+/* ************************************************************************* */
+void QuadricPipeline::start() {
+  this->rethrow();
+  if (thread_.joinable()) {
+    throw std::logic_error("QuadricPipeline is already running");
+  }
+  running_ = true;
+  thread_ = std::thread(&QuadricPipeline::run, this);
+}
+
+/* ************************************************************************* */
+void QuadricPipeline::addFrame(const Frame& frame) {
+  this->rethrow();
+  if (!running_) {
+    throw std::logic_error("QuadricPipeline requires start() before frames");
+  }
+  const FrameFactorBuilder::Camera& camera = builder_.camera(frame.cameraId);
+  this->refresh();
+
+  if (!pending_) {
+    pending_ = boost::make_shared<Update>();
+  }
+  Update& update = *pending_;
+  update.frames++;
+  update.factors.push_back(frame.factors);
+  update.values.insert(frame.values);
+  update.values.insert(frame.poseKey, frame.pose);
+
+  // associate the boxes with the known landmarks projected in one batch
+  AlignedBox2Vector matched, unmatched;
+  gtsam::KeyVector matchedKeys;
+  if (quadrics_.empty()) {
+    unmatched = frame.boxes;
+  } else {
+    QuadricCamera::projectBatch(quadrics_.data(), quadrics_.size(),
+                                frame.pose, camera.calibration, projections_);
+    BoxAssociation association =
+        BoxAssociation::associate(projections_, frame.boxes, params_.minIoU);
+    for (size_t i = 0; i < frame.boxes.size(); i++) {
+      if (association.isMatched(i)) {
+        matched.push_back(frame.boxes[i]);
+        matchedKeys.push_back(keys_[association.landmark(i)]);
+      } else {
+        unmatched.push_back(frame.boxes[i]);
+      }
+    }
+  }
+  builder_.add(update.factors, frame.poseKey, frame.cameraId, matched,
+               matchedKeys);
+
+  this->track(frame, unmatched, update);
+  nrFrames_++;
+  this->tryQueue();
+}
+
+/* ************************************************************************* */
+void QuadricPipeline::flush() {
+  this->rethrow();
+  if (!thread_.joinable()) {
+    throw std::logic_error("QuadricPipeline requires start() before flush()");
+  }
+  while (!this->tryQueue()) {
+    this->rethrow();
+    std::this_thread::yield();
+  }
+  while (applied_.load(std::memory_order_acquire) < submitted_) {
+    this->rethrow();
+    std::this_thread::sleep_for(idleSleep);
+  }
+  this->rethrow();
+}
+
+/* ************************************************************************* */
+void QuadricPipeline::stop() {
+  if (!thread_.joinable()) {
+    this->rethrow();
+    return;
+  }
+  while (!this->tryQueue() && !failed_) {
+    std::this_thread::yield();
+  }
+  running_ = false;
+  thread_.join();
+  this->rethrow();
+}
+
+/* ************************************************************************* */
+void QuadricPipeline::refresh() {
+  boost::shared_ptr<const Snapshot> latest = this->snapshot();
+  if (latest->version == seenVersion_) {
+    return;
+  }
+  seenVersion_ = latest->version;
+
+  // landmarks initialized since the snapshot keep their initial estimate
+  for (const gtsam::Key& key : latest->landmarks) {
+    quadrics_[index_.at(key)] =
+        latest->estimate.at<ConstrainedDualQuadric>(key);
+  }
+}
+
+/* ************************************************************************* */
+void QuadricPipeline::track(const Frame& frame,
+                            const AlignedBox2Vector& boxes, Update& update) {
+  const size_t frameIndex = nrFrames_;
+
+  // match each box with the latest box of a track of the same camera
+  std::vector<size_t> candidates;
+  for (size_t t = 0; t < tracks_.size(); t++) {
+    if (tracks_[t].cameraId == frame.cameraId) {
+      candidates.push_back(t);
+    }
+  }
+  gtsam::Matrix predicted(candidates.size(), 4);
+  for (size_t j = 0; j < candidates.size(); j++) {
+    predicted.row(j) = tracks_[candidates[j]].boxes.back().vector().transpose();
+  }
+  gtsam::Matrix measured(boxes.size(), 4);
+  for (size_t i = 0; i < boxes.size(); i++) {
+    measured.row(i) = boxes[i].vector().transpose();
+  }
+  BoxAssociation association =
+      BoxAssociation::associate(predicted, measured, params_.minIoU);
+
+  for (size_t i = 0; i < boxes.size(); i++) {
+    if (!association.isMatched(i)) {
+      tracks_.push_back(Track{frame.cameraId, gtsam::KeyVector(), {},
+                              AlignedBox2Vector(), frameIndex});
+    }
+    Track& track = association.isMatched(i)
+                       ? tracks_[candidates[association.landmark(i)]]
+                       : tracks_.back();
+    track.poseKeys.push_back(frame.poseKey);
+    track.poses.push_back(frame.pose);
+    track.boxes.push_back(boxes[i]);
+    track.lastFrame = frameIndex;
+  }
+
+  // initialize the tracks extended by this frame, drop the stale ones
+  const FrameFactorBuilder::Camera& camera = builder_.camera(frame.cameraId);
+  size_t kept = 0;
+  for (size_t t = 0; t < tracks_.size(); t++) {
+    Track& track = tracks_[t];
+    if (frameIndex - track.lastFrame > params_.maxTrackAge) {
+      continue;
+    }
+
+    ConstrainedDualQuadric quadric;
+    if (track.lastFrame == frameIndex &&
+        track.boxes.size() >= params_.minViews &&
+        QuadricInitializer::tryInitialize(track.poses, track.boxes,
+                                          camera.calibration, quadric) ==
+            QuadricInitializer::SUCCESS) {
+      const gtsam::Key key = gtsam::Symbol(params_.landmarkChar, nrLandmarks_++);
+      update.values.insert(key, quadric);
+      update.landmarks.push_back(key);
+      for (size_t k = 0; k < track.boxes.size(); k++) {
+        update.factors.push_back(builder_.factor(
+            track.boxes[k], track.poseKeys[k], key, track.cameraId));
+      }
+      index_[key] = keys_.size();
+      keys_.push_back(key);
+      quadrics_.push_back(quadric);
+      continue;
+    }
+
+    if (kept != t) {
+      tracks_[kept] = track;
+    }
+    kept++;
+  }
+  tracks_.resize(kept);
+}
+
+/* ************************************************************************* */
+bool QuadricPipeline::tryQueue() {
+  if (pending_ && queue_.tryPush(pending_)) {
+    submitted_ += pending_->frames;
+    pending_.reset();
+  }
+  return !pending_;
+}
+
+/* ************************************************************************* */
+void QuadricPipeline::rethrow() const {
+  if (failed_.load(std::memory_order_acquire)) {
+    std::rethrow_exception(error_);
+  }
+}
+
+/* ************************************************************************* */
+void QuadricPipeline::run() {
+  while (!failed_) {
+    // anything pushed before stop() is visible once running_ is false
+    const bool stopping = !running_;
+
+    // everything queued is applied in one ISAM2 update
+    boost::shared_ptr<Update> merged, update;
+    while (queue_.tryPop(update)) {
+      if (!merged) {
+        merged = update;
+        continue;
+      }
+      merged->frames += update->frames;
+      merged->factors.push_back(update->factors);
+      merged->values.insert(update->values);
+      merged->landmarks.insert(merged->landmarks.end(),
+                               update->landmarks.begin(),
+                               update->landmarks.end());
+    }
+
+    if (merged) {
+      try {
+        this->apply(*merged);
+      } catch (...) {
+        error_ = std::current_exception();
+        running_ = false;
+        failed_.store(true, std::memory_order_release);
+      }
+      applied_.fetch_add(merged->frames, std::memory_order_release);
+    } else if (stopping) {
+      break;
+    } else {
+      std::this_thread::sleep_for(idleSleep);
+    }
+  }
+}
+
+/* ************************************************************************* */
+void QuadricPipeline::apply(const Update& update) {
+  isam_.update(update.factors, update.values);
+  landmarks_.insert(landmarks_.end(), update.landmarks.begin(),
+                    update.landmarks.end());
+
+  // readers keep the snapshot they hold, the next one replaces it
+  boost::shared_ptr<Snapshot> snapshot = boost::make_shared<Snapshot>();
+  snapshot->version = ++version_;
+  snapshot->frames = applied_.load(std::memory_order_relaxed) + update.frames;
+  snapshot->estimate = isam_.calculateEstimate();
+  snapshot->landmarks = landmarks_;
+  boost::atomic_store(&snapshot_,
+                      boost::shared_ptr<const Snapshot>(snapshot));
+}
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,246 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricPipeline.h
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief front-end and ISAM2 back-end of quadric SLAM on separate threads
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam_quadrics/base/SpscQueue.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/BatchProjection.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/FrameFactorBuilder.h>
+
+#include <atomic>
+#include <exception>
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class QuadricPipelineParams
+ * Parameters of a QuadricPipeline
+ */
+struct QuadricPipelineParams {
+  /// parameters of the back-end solver
+  gtsam::ISAM2Params isam;
+
+  /// the smallest IoU of a box with a landmark or track it is matched to
+  double minIoU = 0.3;
+
+  /// boxes of a track before its landmark is initialized, at least 3
+  size_t minViews = 3;
+
+  /// frames a track is kept without a new box
+  size_t maxTrackAge = 10;
+
+  /// updates queued for the back-end, further frames are merged
+  size_t queueCapacity = 64;
+
+  /// the symbol of new landmark keys, gtsam::Symbol(landmarkChar, index)
+  unsigned char landmarkChar = 'q';
+
+  QuadricPipelineParams() {}
+};
+
+/**
+ * @class QuadricPipeline
+ * Runs quadric SLAM as two stages so the frame rate is not capped by the
+ * optimizer. The front-end runs in addFrame on the caller's thread: it
+ * projects the landmarks into the frame in one batch, associates the
+ * boxes, builds their factors with a FrameFactorBuilder, and tracks the
+ * unmatched boxes over frames until a new landmark can be initialized from
+ * them. The back-end thread applies the resulting updates to gtsam::ISAM2.
+ * The stages share nothing but a lock-free SpscQueue of updates and the
+ * latest Snapshot of the estimate, published by swapping an immutable
+ * snapshot so that readers never block the optimizer and always see a
+ * complete estimate. When the back-end falls behind, the queue fills and
+ * the front-end merges the following frames into one update, so ISAM2
+ * runs fewer, larger updates instead of frames being dropped.
+ *
+ * The front-end projects the landmarks as of the latest snapshot, plus the
+ * landmarks it initialized since. addFrame must be called from one thread
+ * only, snapshot() from any thread.
+ */
+class QuadricPipeline {
+ public:
+  /// the input of one camera frame
+  struct Frame {
+    gtsam::Key poseKey;               ///< the key of the camera pose
+    gtsam::Pose3 pose;                ///< the initial estimate of the pose
+    uint32_t cameraId = 0;            ///< the camera, see builder()
+    AlignedBox2Vector boxes;          ///< the detections of the frame
+    gtsam::NonlinearFactorGraph factors;  ///< e.g. odometry and priors
+    gtsam::Values values;             ///< new variables other than the pose
+  };
+
+  /// an estimate published by the back-end, never modified once published
+  struct Snapshot {
+    size_t version = 0;        ///< incremented by each published estimate
+    size_t frames = 0;         ///< frames included in the estimate
+    gtsam::Values estimate;    ///< every variable
+    gtsam::KeyVector landmarks;  ///< the landmark keys, in creation order
+  };
+
+  /// what the front-end of one or more frames adds to the back-end
+  struct Update {
+    size_t frames = 0;
+    gtsam::NonlinearFactorGraph factors;
+    gtsam::Values values;
+    gtsam::KeyVector landmarks;  ///< the keys of new landmarks
+  };
+
+ protected:
+  /// boxes of one camera not yet explained by a landmark
+  struct Track {
+    uint32_t cameraId;
+    gtsam::KeyVector poseKeys;
+    std::vector<gtsam::Pose3> poses;
+    AlignedBox2Vector boxes;
+    size_t lastFrame;  ///< the frame of the latest box
+  };
+
+  QuadricPipelineParams params_;
+
+  // front-end state, used by the thread calling addFrame
+  FrameFactorBuilder builder_;
+  gtsam::KeyVector keys_;  ///< landmarks known to the front-end
+  std::vector<ConstrainedDualQuadric> quadrics_;  ///< estimate of keys_
+  std::map<gtsam::Key, size_t> index_;            ///< index in keys_
+  size_t seenVersion_;      ///< the snapshot version of quadrics_
+  std::vector<Track> tracks_;
+  BatchProjection projections_;  ///< reused between frames
+  boost::shared_ptr<Update> pending_;  ///< frames not yet queued
+  size_t nrFrames_;
+  size_t nrLandmarks_;
+  size_t submitted_;  ///< frames queued for the back-end
+
+  // back-end state, used by the back-end thread while running
+  gtsam::ISAM2 isam_;
+  gtsam::KeyVector landmarks_;
+  size_t version_;
+
+  // shared between the stages
+  SpscQueue<boost::shared_ptr<Update> > queue_;
+  boost::shared_ptr<const Snapshot> snapshot_;  ///< read with atomic_load
+  std::atomic<size_t> applied_;  ///< frames applied by the back-end
+  std::atomic<bool> running_;
+  std::atomic<bool> failed_;
+  std::exception_ptr error_;  ///< set before failed_
+  std::thread thread_;
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Constructor from parameters, call start() after adding cameras */
+  explicit QuadricPipeline(
+      const QuadricPipelineParams& params = QuadricPipelineParams());
+
+  /** Stops the back-end, discarding errors */
+  ~QuadricPipeline();
+
+  QuadricPipeline(const QuadricPipeline&) = delete;
+  QuadricPipeline& operator=(const QuadricPipeline&) = delete;
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the parameters */
+  const QuadricPipelineParams& params() const { return params_; }
+
+  /** Returns the factor builder, register the cameras here before start() */
+  FrameFactorBuilder& builder() { return builder_; }
+
+  /** Returns the number of frames added */
+  size_t nrFrames() const { return nrFrames_; }
+
+  /** Returns the number of landmarks initialized by the front-end */
+  size_t nrLandmarks() const { return nrLandmarks_; }
+
+  /** Returns the number of unmatched box tracks */
+  size_t nrTracks() const { return tracks_.size(); }
+
+  /** Returns true while the back-end thread runs */
+  bool running() const { return running_.load(); }
+
+  /**
+   * Returns the latest published estimate without waiting for the
+   * back-end, safe from any thread. The snapshot stays valid while held.
+   */
+  boost::shared_ptr<const Snapshot> snapshot() const;
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /** Starts the back-end thread */
+  void start();
+
+  /**
+   * Processes one frame in the front-end and queues its update
+   * @throws std::out_of_range if the camera is not registered
+   * @throws std::logic_error if the pipeline is not running
+   * @throws the first exception of the back-end, after which the pipeline
+   * has stopped
+   */
+  void addFrame(const Frame& frame);
+
+  /**
+   * Waits until the back-end has applied every added frame and published
+   * its estimate
+   * @throws the first exception of the back-end
+   */
+  void flush();
+
+  /** Applies every added frame, then stops the back-end thread */
+  void stop();
+
+  /// @}
+
+ protected:
+  /** Refreshes the front-end landmarks from the latest snapshot */
+  void refresh();
+
+  /**
+   * Adds unmatched boxes to the tracks of their camera, and initializes the
+   * landmarks of tracks with enough boxes into the update
+   */
+  void track(const Frame& frame, const AlignedBox2Vector& boxes,
+             Update& update);
+
+  /** Queues the pending update if there is room */
+  bool tryQueue();
+
+  /** Rethrows the back-end exception, if any */
+  void rethrow() const;
+
+  /** The back-end thread */
+  void run();
+
+  /** Applies one merged update to ISAM2 and publishes the estimate */
+  void apply(const Update& update);
+};
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,273 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricStore.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief compact structure of arrays storage for many quadric landmarks
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Key.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam_quadrics/geometry/AlignedBox3.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/QuadricKernels.h>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class QuadricStoreT
+ * Landmarks that are not being optimized, stored as one contiguous array
+ * per field: a unit quaternion, translation and radii, 10 scalars per
+ * landmark against the 15 aligned doubles and heap allocated value of a
+ * ConstrainedDualQuadric in gtsam::Values. Keep only the active window
+ * in Values, see values() and insert().
+ * The float instantiation halves the memory again, and its translations
+ * have a precision of about 1e-7 of their distance from the origin, so
+ * express very large maps relative to a local origin.
+ * Landmarks are addressed by index for batched passes and by key, indices
+ * are not stable across remove().
+ */
+template <typename Scalar>
+class QuadricStoreT {
+ public:
+  typedef kernels::Matrix3T<Scalar> Matrix3;
+  typedef kernels::Vector3T<Scalar> Vector3;
+
+  /// bounds of many landmarks, one column per side of AlignedBox3::vector
+  typedef Eigen::Matrix<Scalar, Eigen::Dynamic, 6> BatchBounds;
+
+ protected:
+  std::vector<gtsam::Key> keys_;            ///< key of each landmark
+  std::vector<Scalar> qw_, qx_, qy_, qz_;   ///< unit quaternion (w, x, y, z)
+  std::vector<Scalar> tx_, ty_, tz_;        ///< translation
+  std::vector<Scalar> rx_, ry_, rz_;        ///< radii
+  std::unordered_map<gtsam::Key, size_t> indices_;  ///< index of each key
+
+ public:
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the number of landmarks */
+  size_t size() const { return keys_.size(); }
+
+  /** Returns true if the store holds no landmarks */
+  bool empty() const { return keys_.empty(); }
+
+  /** Checks if a landmark is stored */
+  bool exists(const gtsam::Key& key) const { return indices_.count(key) > 0; }
+
+  /** Returns the key of landmark i */
+  gtsam::Key key(size_t i) const { return keys_[i]; }
+
+  /** Returns the key of every landmark, in index order */
+  const std::vector<gtsam::Key>& keys() const { return keys_; }
+
+  /** Returns the index of a landmark, throws std::out_of_range if missing */
+  size_t index(const gtsam::Key& key) const {
+    auto it = indices_.find(key);
+    if (it == indices_.end()) {
+      throw std::out_of_range("QuadricStore key is not stored");
+    }
+    return it->second;
+  }
+
+  /** Returns the rotation matrix of landmark i */
+  Matrix3 rotation(size_t i) const {
+    return kernels::quaternionMatrix<Scalar>(qw_[i], qx_[i], qy_[i], qz_[i]);
+  }
+
+  /** Returns the translation of landmark i */
+  Vector3 translation(size_t i) const {
+    return Vector3(tx_[i], ty_[i], tz_[i]);
+  }
+
+  /** Returns the radii of landmark i */
+  Vector3 radii(size_t i) const { return Vector3(rx_[i], ry_[i], rz_[i]); }
+
+  /** Returns landmark i as a quadric */
+  ConstrainedDualQuadric quadric(size_t i) const {
+    gtsam::Pose3 pose(gtsam::Rot3::Quaternion(qw_[i], qx_[i], qy_[i], qz_[i]),
+                      gtsam::Point3(tx_[i], ty_[i], tz_[i]));
+    return ConstrainedDualQuadric(pose, gtsam::Vector3(rx_[i], ry_[i], rz_[i]));
+  }
+
+  /** Returns a landmark as a quadric, throws std::out_of_range if missing */
+  ConstrainedDualQuadric at(const gtsam::Key& key) const {
+    return quadric(index(key));
+  }
+
+  /**
+   * Returns the axis aligned bounds of landmark i, equal to
+   * ConstrainedDualQuadric::bounds without building the quadric matrix
+   */
+  AlignedBox3 bounds(size_t i) const {
+    const Vector3 t = translation(i);
+    const Vector3 h = kernels::halfExtents<Scalar>(rotation(i), radii(i));
+    return AlignedBox3(t(0) - h(0), t(0) + h(0), t(1) - h(1), t(1) + h(1),
+                       t(2) - h(2), t(2) + h(2));
+  }
+
+  /**
+   * Computes the bounds of every landmark in one pass, row i holding
+   * landmark i as (xmin, xmax, ymin, ymax, zmin, zmax). The loop body is
+   * halfExtents of quaternionMatrix written out on scalars, and only reads
+   * and writes contiguous arrays, so it vectorizes across landmarks.
+   */
+  void bounds(BatchBounds& bounds) const {
+    const size_t n = size();
+    bounds.resize(n, 6);
+    Scalar* out = bounds.data();
+    for (size_t i = 0; i < n; i++) {
+      const Scalar w = qw_[i], x = qx_[i], y = qy_[i], z = qz_[i];
+      const Scalar xx = x * x, yy = y * y, zz = z * z;
+      const Scalar xy = x * y, xz = x * z, yz = y * z;
+      const Scalar wx = w * x, wy = w * y, wz = w * z;
+      const Scalar r00 = Scalar(1) - Scalar(2) * (yy + zz);
+      const Scalar r01 = Scalar(2) * (xy - wz), r02 = Scalar(2) * (xz + wy);
+      const Scalar r10 = Scalar(2) * (xy + wz), r12 = Scalar(2) * (yz - wx);
+      const Scalar r11 = Scalar(1) - Scalar(2) * (xx + zz);
+      const Scalar r20 = Scalar(2) * (xz - wy), r21 = Scalar(2) * (yz + wx);
+      const Scalar r22 = Scalar(1) - Scalar(2) * (xx + yy);
+      const Scalar sx = rx_[i] * rx_[i], sy = ry_[i] * ry_[i],
+                   sz = rz_[i] * rz_[i];
+      const Scalar hx = std::sqrt(r00 * r00 * sx + r01 * r01 * sy +
+                                  r02 * r02 * sz);
+      const Scalar hy = std::sqrt(r10 * r10 * sx + r11 * r11 * sy +
+                                  r12 * r12 * sz);
+      const Scalar hz = std::sqrt(r20 * r20 * sx + r21 * r21 * sy +
+                                  r22 * r22 * sz);
+      out[i] = tx_[i] - hx;
+      out[n + i] = tx_[i] + hx;
+      out[2 * n + i] = ty_[i] - hy;
+      out[3 * n + i] = ty_[i] + hy;
+      out[4 * n + i] = tz_[i] - hz;
+      out[5 * n + i] = tz_[i] + hz;
+    }
+  }
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /** Reserves memory for n landmarks */
+  void reserve(size_t n) {
+    keys_.reserve(n);
+    for (std::vector<Scalar>* v : arrays()) {
+      v->reserve(n);
+    }
+    indices_.reserve(n);
+  }
+
+  /**
+   * Inserts a landmark, or replaces it if the key is already stored
+   * @return the index of the landmark
+   */
+  size_t insert(const gtsam::Key& key, const ConstrainedDualQuadric& quadric) {
+    auto inserted = indices_.insert(std::make_pair(key, keys_.size()));
+    const size_t i = inserted.first->second;
+    if (inserted.second) {
+      keys_.push_back(key);
+      for (std::vector<Scalar>* v : arrays()) {
+        v->push_back(Scalar(0));
+      }
+    }
+    const gtsam::Pose3 pose = quadric.pose();
+    const gtsam::Quaternion q = pose.rotation().toQuaternion();
+    const gtsam::Point3& t = pose.translation();
+    const gtsam::Vector3 r = quadric.radii();
+    qw_[i] = Scalar(q.w());
+    qx_[i] = Scalar(q.x());
+    qy_[i] = Scalar(q.y());
+    qz_[i] = Scalar(q.z());
+    tx_[i] = Scalar(t(0));
+    ty_[i] = Scalar(t(1));
+    tz_[i] = Scalar(t(2));
+    rx_[i] = Scalar(r(0));
+    ry_[i] = Scalar(r(1));
+    rz_[i] = Scalar(r(2));
+    return i;
+  }
+
+  /** Inserts or replaces every ConstrainedDualQuadric in the values */
+  void insert(const gtsam::Values& values) {
+    for (const auto& keyValue : values.filter<ConstrainedDualQuadric>()) {
+      insert(keyValue.key, keyValue.value);
+    }
+  }
+
+  /**
+   * Removes a landmark by moving the last landmark into its index
+   * @return false if the landmark was not stored
+   */
+  bool remove(const gtsam::Key& key) {
+    auto it = indices_.find(key);
+    if (it == indices_.end()) {
+      return false;
+    }
+    const size_t i = it->second, last = keys_.size() - 1;
+    indices_.erase(it);
+    if (i != last) {
+      keys_[i] = keys_[last];
+      indices_[keys_[i]] = i;
+    }
+    keys_.pop_back();
+    for (std::vector<Scalar>* v : arrays()) {
+      (*v)[i] = (*v)[last];
+      v->pop_back();
+    }
+    return true;
+  }
+
+  /** Removes every landmark */
+  void clear() {
+    keys_.clear();
+    for (std::vector<Scalar>* v : arrays()) {
+      v->clear();
+    }
+    indices_.clear();
+  }
+
+  /**
+   * Returns the given landmarks as values, e.g. to activate them for
+   * optimization. Throws std::out_of_range if a key is missing.
+   */
+  gtsam::Values values(const gtsam::KeyVector& keys) const {
+    gtsam::Values values;
+    for (const gtsam::Key& key : keys) {
+      values.insert(key, at(key));
+    }
+    return values;
+  }
+
+  /// @}
+
+ protected:
+  /** Returns every per landmark array of scalars */
+  std::array<std::vector<Scalar>*, 10> arrays() {
+    return {{&qw_, &qx_, &qy_, &qz_, &tx_, &ty_, &tz_, &rx_, &ry_, &rz_}};
+  }
+};
+
+typedef QuadricStoreT<double> QuadricStore;
+typedef QuadricStoreT<float> QuadricStoref;
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,310 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricWindow.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief a sliding window over quadric graphs with landmark summarization
+ */
+
+#include <gtsam/inference/Ordering.h>
+#include <gtsam/linear/GaussianBayesTree.h>
+#include <gtsam/linear/GaussianFactorGraph.h>
+#include <gtsam/linear/NoiseModel.h>
+#include <gtsam/nonlinear/LinearContainerFactor.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricWindow.h>
+#include <gtsam_quadrics/geometry/RigBoundingBoxFactor.h>
+
+#include <Eigen/QR>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+namespace {
+
+/// returns the number of boxes measured by a factor, one for every single
+/// detection factor of a camera or of a camera rig
+size_t nrBoxes(const gtsam::NonlinearFactor& factor) {
+  return dynamic_cast<const BoundingBoxFactor*>(&factor) ||
+                 dynamic_cast<const RigBoundingBoxFactor*>(&factor)
+             ? 1
+             : 0;
+}
+
+}  // namespace
+
+/* ************************************************************************* */
+size_t QuadricWindow::observations(const gtsam::Key& key) const {
+  auto it = observations_.find(key);
+  return it == observations_.end() ? 0 : it->second;
+}
+
+/* ************************************************************************* */
+gtsam::NonlinearFactor::shared_ptr QuadricWindow::prior(
+    const gtsam::Key& key) const {
+  auto it = priors_.find(key);
+  return it == priors_.end() ? gtsam::NonlinearFactor::shared_ptr()
+                             : it->second;
+}
+
+/* ************************************************************************* */
+QuadricWindow::KeyTimestampMap QuadricWindow::update(
+    const gtsam::NonlinearFactorGraph& newFactors,
+    const gtsam::Values& newValues, double time) {
+  // check every variable is known before changing the window
+  for (const auto& factor : newFactors) {
+    for (const gtsam::Key& key : factor->keys()) {
+      if (!values_.exists(key) && !newValues.exists(key) &&
+          !frozen_.exists(key)) {
+        throw std::invalid_argument(
+            "QuadricWindow factor uses a variable that is not in the "
+            "window, discarded landmarks have to be initialized again");
+      }
+    }
+  }
+
+  KeyTimestampMap updated;
+  for (const gtsam::Key& key : newValues.keys()) {
+    values_.insert(key, newValues.at(key));
+    frozen_.remove(key);
+    updated[key] = time;
+  }
+  for (const auto& keyValue : newValues.filter<ConstrainedDualQuadric>()) {
+    landmarks_.insert(keyValue.key);
+  }
+
+  for (const auto& factor : newFactors) {
+    for (const gtsam::Key& key : factor->keys()) {
+      if (!values_.exists(key)) {
+        values_.insert(key, frozen_.at(key));
+        landmarks_.insert(key);
+        frozen_.remove(key);
+      }
+      updated[key] = time;
+    }
+    const size_t boxes = nrBoxes(*factor);
+    if (boxes > 0) {
+      for (const gtsam::Key& key : factor->keys()) {
+        if (landmarks_.count(key)) {
+          observations_[key] += boxes;
+        }
+      }
+    }
+    factors_.push_back(factor);
+  }
+
+  for (const auto& stamp : updated) {
+    double& last = timestamps_[stamp.first];
+    last = std::max(last, stamp.second);
+  }
+  rebuildGraph();
+  return updated;
+}
+
+/* ************************************************************************* */
+void QuadricWindow::setEstimate(const gtsam::Values& estimate) {
+  gtsam::Values values;
+  for (const gtsam::Key& key : values_.keys()) {
+    values.insert(key, estimate.exists(key) ? estimate.at(key)
+                                            : values_.at(key));
+  }
+  values_ = values;
+}
+
+/* ************************************************************************* */
+gtsam::KeyVector QuadricWindow::marginalize(double time) {
+  const double cutoff = time - params_.lag;
+  gtsam::KeySet old;
+  for (const auto& stamp : timestamps_) {
+    if (stamp.second < cutoff) {
+      old.insert(stamp.first);
+    }
+  }
+
+  // landmarks still used with an active variable leave later
+  bool postponed = true;
+  while (postponed) {
+    postponed = false;
+    for (const auto& factor : factors_) {
+      bool active = false;
+      for (const gtsam::Key& key : factor->keys()) {
+        active |= !old.count(key);
+      }
+      for (const gtsam::Key& key : factor->keys()) {
+        if (active && landmarks_.count(key) && old.erase(key)) {
+          postponed = true;
+        }
+      }
+    }
+  }
+  if (old.empty()) {
+    return gtsam::KeyVector();
+  }
+
+  // factors of one landmark and otherwise leaving variables are folded into
+  // the landmark prior, other factors of leaving variables are marginalized
+  std::map<gtsam::Key, gtsam::NonlinearFactorGraph> folded;
+  gtsam::NonlinearFactorGraph kept, marginal;
+  gtsam::KeySet eliminated;
+  bool remaining = false;
+  for (const auto& factor : factors_) {
+    size_t nrOld = 0, nrLandmarks = 0;
+    gtsam::Key landmark = 0;
+    for (const gtsam::Key& key : factor->keys()) {
+      nrOld += old.count(key);
+      if (landmarks_.count(key)) {
+        nrLandmarks++;
+        landmark = key;
+      }
+    }
+    if (nrOld == 0) {
+      kept.push_back(factor);
+    } else if (nrLandmarks == 1 &&
+               nrOld + (old.count(landmark) ? 0 : 1) == factor->size()) {
+      folded[landmark].push_back(factor);
+    } else {
+      marginal.push_back(factor);
+      for (const gtsam::Key& key : factor->keys()) {
+        if (old.count(key)) {
+          eliminated.insert(key);
+        } else {
+          remaining = true;
+        }
+      }
+    }
+  }
+
+  for (const auto& landmarkFactors : folded) {
+    const gtsam::Key& key = landmarkFactors.first;
+    gtsam::NonlinearFactorGraph factors = landmarkFactors.second;
+    if (priors_.count(key)) {
+      factors.push_back(priors_.at(key));
+    }
+    gtsam::NonlinearFactor::shared_ptr summary =
+        summarize(key, factors, values_);
+    if (summary) {
+      priors_[key] = summary;
+    }
+  }
+
+  // the marginal of the remaining variables is kept as linear factors
+  if (remaining) {
+    gtsam::GaussianFactorGraph::shared_ptr linear =
+        marginal.linearize(values_);
+    gtsam::Ordering ordering(eliminated.begin(), eliminated.end());
+    gtsam::GaussianFactorGraph::shared_ptr marginals =
+        linear->eliminatePartialMultifrontal(ordering).second;
+    for (const auto& factor : *marginals) {
+      if (factor) {
+        kept.push_back(
+            boost::make_shared<gtsam::LinearContainerFactor>(factor, values_));
+      }
+    }
+  }
+
+  for (const gtsam::Key& key : old) {
+    if (landmarks_.count(key)) {
+      if (observations(key) >= params_.minObservations) {
+        frozen_.insert(key, values_.at<ConstrainedDualQuadric>(key));
+      } else {
+        priors_.erase(key);
+        observations_.erase(key);
+      }
+      landmarks_.erase(key);
+    }
+    values_.erase(key);
+    timestamps_.erase(key);
+  }
+  factors_ = kept;
+  rebuildGraph();
+  return gtsam::KeyVector(old.begin(), old.end());
+}
+
+/* ************************************************************************* */
+gtsam::NonlinearFactor::shared_ptr QuadricWindow::summarize(
+    const gtsam::Key& key, const gtsam::NonlinearFactorGraph& factors,
+    const gtsam::Values& values) {
+  // stack the whitened jacobians of the landmark, A * delta = b
+  std::vector<gtsam::Matrix> As;
+  std::vector<gtsam::Vector> bs;
+  size_t rows = 0;
+  for (const auto& factor : factors) {
+    if (std::find(factor->begin(), factor->end(), key) == factor->end()) {
+      throw std::invalid_argument(
+          "QuadricWindow::summarize factor does not use the landmark");
+    }
+    gtsam::GaussianFactor::shared_ptr gaussian = factor->linearize(values);
+    if (!gaussian) {
+      continue;
+    }
+    size_t column = 0;
+    for (auto it = gaussian->begin(); *it != key; ++it) {
+      column += gaussian->getDim(it);
+    }
+    std::pair<gtsam::Matrix, gtsam::Vector> Ab = gaussian->jacobian();
+    As.push_back(Ab.first.middleCols(column, 9));
+    bs.push_back(Ab.second);
+    rows += Ab.second.size();
+  }
+  if (rows == 0) {
+    return gtsam::NonlinearFactor::shared_ptr();
+  }
+
+  gtsam::Matrix A(rows, 9);
+  gtsam::Vector b(rows);
+  for (size_t i = 0, row = 0; i < As.size(); row += bs[i].size(), i++) {
+    A.middleRows(row, bs[i].size()) = As[i];
+    b.segment(row, bs[i].size()) = bs[i];
+  }
+
+  // the mean is the gauss newton step, the square root information is the
+  // triangular factor of A and is singular until the landmark is observed
+  // from enough views
+  const gtsam::Vector9 delta = A.completeOrthogonalDecomposition().solve(b);
+  Eigen::HouseholderQR<gtsam::Matrix> qr(A);
+  gtsam::Matrix R = gtsam::Matrix::Zero(9, 9);
+  for (size_t i = 0; i < std::min<size_t>(rows, 9); i++) {
+    R.row(i).tail(9 - i) = qr.matrixQR().row(i).tail(9 - i);
+  }
+
+  const ConstrainedDualQuadric& quadric =
+      values.at<ConstrainedDualQuadric>(key);
+  return boost::make_shared<gtsam::PriorFactor<ConstrainedDualQuadric>>(
+      key, quadric.retract(delta),
+      gtsam::noiseModel::Gaussian::SqrtInformation(R, false));
+}
+
+/* ************************************************************************* */
+void QuadricWindow::print(const std::string& s) const {
+  cout << s << "QuadricWindow: " << values_.size() << " variables, "
+       << graph_.size() << " factors, " << priors_.size() << " priors, "
+       << frozen_.size() << " frozen landmarks" << endl;
+}
+
+/* ************************************************************************* */
+void QuadricWindow::rebuildGraph() {
+  graph_ = factors_;
+  for (const auto& prior : priors_) {
+    if (landmarks_.count(prior.first)) {
+      graph_.push_back(prior.second);
+    }
+  }
+}
+
+}  // namespace gtsam_quadrics
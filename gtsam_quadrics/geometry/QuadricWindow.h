@@ -0,0 +1,177 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file QuadricWindow.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief a sliding window over quadric graphs with landmark summarization
+ */
+
+#pragma once
+
+#include <gtsam/inference/Key.h>
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam/nonlinear/Values.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/QuadricStore.h>
+
+#include <map>
+#include <string>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class QuadricWindowParams
+ * Parameters of a QuadricWindow
+ */
+struct QuadricWindowParams {
+  /// seconds a variable stays in the window after it was last used
+  double lag = 5.0;
+
+  /// landmarks that leave the window with fewer boxes are discarded
+  size_t minObservations = 3;
+
+  QuadricWindowParams() {}
+
+  QuadricWindowParams(double lag, size_t minObservations)
+      : lag(lag), minObservations(minObservations) {}
+};
+
+/**
+ * @class QuadricWindow
+ * Keeps the factors and values of a quadric graph within a time window,
+ * so the cost of optimizing after each frame stops growing with the length
+ * of the sequence.
+ *
+ * Every variable has the time it was last used, landmarks are refreshed
+ * each time they are observed. When a pose leaves the window, its
+ * bounding box factors are folded into one summarized prior per landmark,
+ * see summarize(), and its other factors are marginalized onto the
+ * remaining variables as linear factors. Folding the boxes freezes the
+ * pose instead of marginalizing it, which keeps the landmarks independent
+ * of each other and the graph sparse.
+ * When a landmark leaves the window it is frozen: its estimate moves to
+ * frozen() and its prior is kept, and both are restored if the landmark
+ * is observed again. Landmarks seen fewer than minObservations times are
+ * discarded instead and have to be initialized again.
+ *
+ * The same timestamps drive gtsam's fixed-lag smoothers, which
+ * marginalize the variables themselves: pass the map returned by update()
+ * to gtsam::IncrementalFixedLagSmoother::update, so that landmarks stay
+ * until they are no longer observed.
+ */
+class QuadricWindow {
+ public:
+  /// the time of each variable, as gtsam::FixedLagSmoother::KeyTimestampMap
+  typedef std::map<gtsam::Key, double> KeyTimestampMap;
+
+ protected:
+  QuadricWindowParams params_;
+  gtsam::NonlinearFactorGraph factors_;  ///< active factors without priors
+  gtsam::NonlinearFactorGraph graph_;    ///< active factors and priors
+  gtsam::Values values_;                 ///< active variables
+  gtsam::KeySet landmarks_;              ///< active landmark keys
+  KeyTimestampMap timestamps_;  ///< time each active variable was last used
+  std::map<gtsam::Key, size_t> observations_;  ///< boxes of each landmark
+  std::map<gtsam::Key, gtsam::NonlinearFactor::shared_ptr>
+      priors_;            ///< summarized prior of each landmark
+  QuadricStore frozen_;   ///< landmarks that have left the window
+
+ public:
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Default constructor */
+  QuadricWindow() {}
+
+  /** Constructor from parameters */
+  explicit QuadricWindow(const QuadricWindowParams& params)
+      : params_(params) {}
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the parameters */
+  const QuadricWindowParams& params() const { return params_; }
+
+  /** Returns the active factors, including the summarized priors */
+  const gtsam::NonlinearFactorGraph& graph() const { return graph_; }
+
+  /** Returns the estimate of the active variables */
+  const gtsam::Values& values() const { return values_; }
+
+  /** Returns the time each active variable was last used */
+  const KeyTimestampMap& timestamps() const { return timestamps_; }
+
+  /** Returns the landmarks that have left the window */
+  const QuadricStore& frozen() const { return frozen_; }
+
+  /** Returns the number of boxes observing a landmark, from a camera or rig */
+  size_t observations(const gtsam::Key& key) const;
+
+  /** Returns the summarized prior of a landmark, or null if it has none */
+  gtsam::NonlinearFactor::shared_ptr prior(const gtsam::Key& key) const;
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /**
+   * Adds new factors and variables used at the given time. Frozen
+   * landmarks used by the new factors are moved back into the window.
+   * @return the time of each new or refreshed variable
+   * @throws std::invalid_argument if a factor uses an unknown variable
+   */
+  KeyTimestampMap update(const gtsam::NonlinearFactorGraph& newFactors,
+                         const gtsam::Values& newValues, double time);
+
+  /** Replaces the estimate of the active variables, e.g. after optimizing */
+  void setEstimate(const gtsam::Values& estimate);
+
+  /**
+   * Removes every variable last used before time - lag, summarizing or
+   * marginalizing its factors. Call it after setEstimate, the factors are
+   * linearized at the current estimate.
+   * @return the keys that have left the window
+   */
+  gtsam::KeyVector marginalize(double time);
+
+  /**
+   * Summarizes the factors of one landmark as a prior on it, with every
+   * other variable held at its value. The factors are linearized at the
+   * values and replaced by the Gaussian with the same information and
+   * mean, so one 9 dimensional prior replaces many bounding box factors.
+   * @return a gtsam::PriorFactor<ConstrainedDualQuadric>, or null if no
+   * factor is active
+   * @throws std::invalid_argument if a factor does not use the landmark
+   */
+  static gtsam::NonlinearFactor::shared_ptr summarize(
+      const gtsam::Key& key, const gtsam::NonlinearFactorGraph& factors,
+      const gtsam::Values& values);
+
+  /// @}
+  /// @name Testable group traits
+  /// @{
+
+  /** Prints the window size with optional string */
+  void print(const std::string& s = "") const;
+
+  /// @}
+
+ protected:
+  /** Rebuilds graph_ from the active factors and priors */
+  void rebuildGraph();
+};
+
+}  // namespace gtsam_quadrics
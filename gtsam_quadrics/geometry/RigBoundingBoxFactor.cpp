@@ -0,0 +1,182 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file RigBoundingBoxFactor.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief factor between the body Pose3 of a camera rig and a quadric
+ */
+
+#include <gtsam/base/serialization.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam_quadrics/geometry/QuadricContext.h>
+#include <gtsam_quadrics/geometry/RigBoundingBoxFactor.h>
+
+#include <iostream>
+#include <stdexcept>
+
+BOOST_CLASS_EXPORT(gtsam_quadrics::RigBoundingBoxFactor)
+
+using namespace std;
+
+namespace gtsam_quadrics {
+
+/* ************************************************************************* */
+RigBoundingBoxFactor::RigBoundingBoxFactor(
+    const AlignedBox2& measured, const boost::shared_ptr<CameraRig>& rig,
+    const size_t& camera, const gtsam::Key& bodyKey,
+    const gtsam::Key& quadricKey, const gtsam::SharedNoiseModel& model,
+    const MeasurementModel& errorType)
+    : Base(model, bodyKey, quadricKey),
+      measured_(measured),
+      camera_(camera),
+      rig_(rig),
+      measurementModel_(errorType) {
+  if (!rig_) {
+    throw std::invalid_argument("RigBoundingBoxFactor requires a camera rig");
+  }
+  if (camera_ >= rig_->size()) {
+    throw std::invalid_argument(
+        "RigBoundingBoxFactor camera is not a camera of the rig");
+  }
+  if (bodyKey == quadricKey) {
+    throw std::invalid_argument(
+        "RigBoundingBoxFactor quadric key equals the body key");
+  }
+  if (!model || model->dim() != 4) {
+    throw std::invalid_argument(
+        "RigBoundingBoxFactor requires a 4-dimensional noise model");
+  }
+}
+
+/* ************************************************************************* */
+gtsam::NonlinearFactorGraph RigBoundingBoxFactor::create(
+    const AlignedBox2Vector& measured, const std::vector<size_t>& cameras,
+    const boost::shared_ptr<CameraRig>& rig, const gtsam::Key& bodyKey,
+    const gtsam::KeyVector& quadricKeys, const gtsam::SharedNoiseModel& model,
+    const MeasurementModel& errorType) {
+  if (measured.size() != cameras.size() ||
+      measured.size() != quadricKeys.size()) {
+    throw std::invalid_argument(
+        "RigBoundingBoxFactor requires one camera and quadric key per "
+        "measurement");
+  }
+
+  gtsam::NonlinearFactorGraph graph;
+  graph.reserve(measured.size());
+  for (size_t i = 0; i < measured.size(); i++) {
+    graph.emplace_shared<RigBoundingBoxFactor>(measured[i], rig, cameras[i],
+                                               bodyKey, quadricKeys[i], model,
+                                               errorType);
+  }
+  return graph;
+}
+
+/* ************************************************************************* */
+gtsam::Vector RigBoundingBoxFactor::evaluateError(
+    const gtsam::Pose3& bodyPose, const ConstrainedDualQuadric& quadric,
+    boost::optional<gtsam::Matrix&> H1,
+    boost::optional<gtsam::Matrix&> H2) const {
+  const CameraRig& rig = *rig_;
+  const CameraView view(rig.cameraPose(bodyPose, camera_),
+                        *rig.calibration(camera_));
+  if (!H1 && !H2) {
+    return BoundingBoxFactor::evaluateView(
+        QuadricContext(quadric, false), view, measured_,
+        *rig.imageBoundary(camera_), measurementModel_);
+  }
+
+  Eigen::Matrix<double, 4, 6> db_dx;
+  Eigen::Matrix<double, 4, 9> db_dq;
+  const gtsam::Vector4 error = BoundingBoxFactor::evaluateView(
+      QuadricContext(quadric, true), view, measured_,
+      *rig.imageBoundary(camera_), measurementModel_, db_dx, db_dq);
+
+  // chain the camera pose jacobian to the body pose
+  if (H1) {
+    *H1 = db_dx * rig.adjoint(camera_);
+  }
+  if (H2) {
+    *H2 = db_dq;
+  }
+  return error;
+}
+
+/* ************************************************************************* */
+boost::shared_ptr<gtsam::GaussianFactor> RigBoundingBoxFactor::linearize(
+    const gtsam::Values& values) const {
+  const gtsam::noiseModel::Gaussian* gaussian =
+      dynamic_cast<const gtsam::noiseModel::Gaussian*>(noiseModel().get());
+  if (!gaussian || gaussian->isConstrained()) {
+    return Base::linearize(values);
+  }
+  if (!this->active(values)) {
+    return boost::shared_ptr<gtsam::JacobianFactor>();
+  }
+
+  const gtsam::Pose3& bodyPose = values.at<gtsam::Pose3>(this->bodyKey());
+  const ConstrainedDualQuadric& quadric =
+      values.at<ConstrainedDualQuadric>(this->objectKey());
+  const CameraRig& rig = *rig_;
+  const CameraView view(rig.cameraPose(bodyPose, camera_),
+                        *rig.calibration(camera_));
+
+  // evaluate directly into fixed-size blocks [body, quadric, b]
+  Eigen::Matrix<double, 4, 6> db_dx;
+  Eigen::Matrix<double, 4, 9> db_dq;
+  gtsam::Vector4 error = BoundingBoxFactor::evaluateView(
+      QuadricContext(quadric, true), view, measured_,
+      *rig.imageBoundary(camera_), measurementModel_, db_dx, db_dq);
+
+  static const size_t dimensions[] = {6, 9};
+  gtsam::VerticalBlockMatrix Ab(dimensions, dimensions + 2, 4, true);
+  Ab(0) = db_dx * rig.adjoint(camera_);
+  Ab(1) = db_dq;
+  Ab(2) = -error;
+  gaussian->WhitenInPlace(Ab.full());
+
+  return boost::make_shared<gtsam::JacobianFactor>(this->keys(), Ab);
+}
+
+/* ************************************************************************* */
+void RigBoundingBoxFactor::print(const std::string& s,
+                                 const gtsam::KeyFormatter& keyFormatter) const {
+  cout << s << "RigBoundingBoxFactor(" << keyFormatter(key1()) << ","
+       << keyFormatter(key2()) << ")" << endl;
+  cout << "    Camera: " << camera_ << endl;
+  measured_.print("    Measured: ");
+  cout << "    NoiseModel: ";
+  noiseModel()->print();
+  cout << endl;
+}
+
+/* ************************************************************************* */
+bool RigBoundingBoxFactor::equals(const RigBoundingBoxFactor& other,
+                                  double tol) const {
+  bool equal = measured_.equals(other.measured_, tol) &&
+               camera_ == other.camera_ &&
+               measurementModel_ == other.measurementModel_ &&
+               noiseModel()->equals(*other.noiseModel(), tol) &&
+               key1() == other.key1() && key2() == other.key2() &&
+               rig_->equals(*other.rig_, tol);
+  return equal;
+}
+
+/* ************************************************************************* */
+bool RigBoundingBoxFactor::equals(const gtsam::NonlinearFactor& other,
+                                  double tol) const {
+  const RigBoundingBoxFactor* e =
+      dynamic_cast<const RigBoundingBoxFactor*>(&other);
+  return e != nullptr && this->equals(*e, tol);
+}
+
+}  // namespace gtsam_quadrics
@@ -0,0 +1,219 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file RigBoundingBoxFactor.h
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief factor between the body Pose3 of a camera rig and a quadric
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/nonlinear/NonlinearFactor.h>
+#include <gtsam/nonlinear/NonlinearFactorGraph.h>
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/CameraRig.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+
+#include <boost/make_shared.hpp>
+#include <boost/serialization/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace gtsam_quadrics {
+
+/**
+ * @class RigBoundingBoxFactor
+ * AlignedBox2 factor between the body pose of a CameraRig and a quadric
+ * detected by one camera of the rig. Equivalent to a BoundingBoxFactor on
+ * the camera pose bodyPose * extrinsic, without a pose variable per camera.
+ * Each detection is a separate factor that linearizes to its own 4x15
+ * JacobianFactor, and computes the pose and projection matrix of its camera
+ * itself, so factors share no mutable state and linearize in parallel.
+ * See create() for building all detections of a timestamp.
+ */
+class RigBoundingBoxFactor
+    : public gtsam::NoiseModelFactor2<gtsam::Pose3, ConstrainedDualQuadric> {
+ public:
+  typedef BoundingBoxFactor::MeasurementModel MeasurementModel;
+
+ protected:
+  AlignedBox2 measured_;                  ///< measured bounding box
+  size_t camera_;                         ///< camera of the rig
+  boost::shared_ptr<CameraRig> rig_;      ///< cameras of the body
+  MeasurementModel measurementModel_;     ///< error function
+  typedef NoiseModelFactor2<gtsam::Pose3, ConstrainedDualQuadric> Base;
+
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /// @name Constructors and named constructors
+  /// @{
+
+  /** Default constructor */
+  RigBoundingBoxFactor()
+      : camera_(0),
+        rig_(new CameraRig()),
+        measurementModel_(BoundingBoxFactor::STANDARD){};
+
+  /**
+   * Constructor from a detection by one camera of the rig
+   * @param measured the measured box
+   * @param rig the cameras of the body
+   * @param camera the index of the camera in the rig
+   * @param bodyKey the body pose key of the timestamp
+   * @param quadricKey the landmark key
+   * @param model the 4-dimensional noise model of the box
+   * @param errorType the error function to use
+   * @throws std::invalid_argument if the rig is null, the camera is not a
+   * camera of the rig, the keys are equal or the model is not 4-dimensional
+   */
+  RigBoundingBoxFactor(
+      const AlignedBox2& measured,
+      const boost::shared_ptr<CameraRig>& rig, const size_t& camera,
+      const gtsam::Key& bodyKey, const gtsam::Key& quadricKey,
+      const gtsam::SharedNoiseModel& model,
+      const MeasurementModel& errorType = BoundingBoxFactor::STANDARD);
+
+  /** Constructor with error type "STANDARD"/"TRUNCATED" */
+  RigBoundingBoxFactor(const AlignedBox2& measured,
+                       const boost::shared_ptr<CameraRig>& rig,
+                       const size_t& camera, const gtsam::Key& bodyKey,
+                       const gtsam::Key& quadricKey,
+                       const gtsam::SharedNoiseModel& model,
+                       const std::string& errorString)
+      : RigBoundingBoxFactor(measured, rig, camera, bodyKey, quadricKey,
+                             model) {
+    if (errorString == "STANDARD") {
+      measurementModel_ = BoundingBoxFactor::STANDARD;
+    } else if (errorString == "TRUNCATED") {
+      measurementModel_ = BoundingBoxFactor::TRUNCATED;
+    } else {
+      throw std::logic_error("The error type \"" + errorString +
+                             "\" is not a valid option for initializing a "
+                             "RigBoundingBoxFactor");
+    }
+  }
+
+  /**
+   * Builds one factor per detection of the rig at one timestamp
+   * @param measured the measured boxes
+   * @param cameras the camera of each box
+   * @param quadricKeys the landmark of each box
+   * @throws std::invalid_argument unless there is one camera and one
+   * landmark per box
+   */
+  static gtsam::NonlinearFactorGraph create(
+      const AlignedBox2Vector& measured, const std::vector<size_t>& cameras,
+      const boost::shared_ptr<CameraRig>& rig, const gtsam::Key& bodyKey,
+      const gtsam::KeyVector& quadricKeys,
+      const gtsam::SharedNoiseModel& model,
+      const MeasurementModel& errorType = BoundingBoxFactor::STANDARD);
+
+  /// @}
+  /// @name Class accessors
+  /// @{
+
+  /** Returns the body pose key */
+  gtsam::Key bodyKey() const { return key1(); }
+
+  /** Returns the object/landmark key */
+  gtsam::Key objectKey() const { return key2(); }
+
+  /** Returns the measured bounding box */
+  AlignedBox2 measurement() const { return measured_; }
+
+  /** Returns the camera of the rig */
+  size_t camera() const { return camera_; }
+
+  /** Returns the cameras of the body */
+  const boost::shared_ptr<CameraRig>& rig() const { return rig_; }
+
+  /** Returns the error function */
+  MeasurementModel measurementModel() const { return measurementModel_; }
+
+  /// @}
+  /// @name Class methods
+  /// @{
+
+  /**
+   * Evaluates the error as a BoundingBoxFactor on the camera pose
+   * @param H1 the derivative of the error wrt the body pose (4x6)
+   * @param H2 the derivative of the error wrt the quadric (4x9)
+   */
+  gtsam::Vector evaluateError(
+      const gtsam::Pose3& bodyPose, const ConstrainedDualQuadric& quadric,
+      boost::optional<gtsam::Matrix&> H1 = boost::none,
+      boost::optional<gtsam::Matrix&> H2 = boost::none) const override;
+
+  /**
+   * Linearizes into a JacobianFactor with fixed-size blocks [body, quadric].
+   * Gaussian noise models are whitened in place, robust and constrained
+   * noise models fall back to NoiseModelFactor.
+   */
+  boost::shared_ptr<gtsam::GaussianFactor> linearize(
+      const gtsam::Values& values) const override;
+
+  /** Returns a deep copy of the factor */
+  gtsam::NonlinearFactor::shared_ptr clone() const override {
+    return boost::static_pointer_cast<gtsam::NonlinearFactor>(
+        gtsam::NonlinearFactor::shared_ptr(new RigBoundingBoxFactor(*this)));
+  }
+
+  /// @}
+  /// @name Testable group traits
+  /// @{
+
+  /** Prints the factor with optional string */
+  void print(const std::string& s = "",
+             const gtsam::KeyFormatter& keyFormatter =
+                 gtsam::DefaultKeyFormatter) const override;
+
+  /** Returns true if equal keys, measurement, camera, noisemodel and rig */
+  bool equals(const RigBoundingBoxFactor& other, double tol = 1e-9) const;
+
+  /** Returns true if equal to another nonlinear factor */
+  bool equals(const gtsam::NonlinearFactor& other,
+              double tol = 1e-9) const override;
+
+  /// @}
+
+ private:
+  /// @name Advanced Interface
+  /// @{
+
+  /** Serialization function */
+  friend class boost::serialization::access;
+  template <class ARCHIVE>
+  void serialize(ARCHIVE& ar, const unsigned int /*version*/) {
+    ar& boost::serialization::make_nvp(
+        "NoiseModelFactor2", boost::serialization::base_object<Base>(*this));
+    ar& BOOST_SERIALIZATION_NVP(measured_);
+    ar& BOOST_SERIALIZATION_NVP(camera_);
+    ar& BOOST_SERIALIZATION_NVP(rig_);
+    ar& BOOST_SERIALIZATION_NVP(measurementModel_);
+  }
+
+  /// @}
+};
+
+}  // namespace gtsam_quadrics
+
+/** \cond PRIVATE */
+// Add to testable group
+template <>
+struct gtsam::traits<gtsam_quadrics::RigBoundingBoxFactor>
+    : public gtsam::Testable<gtsam_quadrics::RigBoundingBoxFactor> {};
+/** \endcond */
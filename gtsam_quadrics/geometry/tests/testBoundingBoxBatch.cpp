@@ -0,0 +1,186 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testBoundingBoxBatch.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for BoundingBoxBatch
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/BoundingBoxBatch.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/slam/PriorFactor.h>
+
+#include <random>
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0, 520.0, 0.5, 320.0, 240.0));
+static const SharedNoiseModel model = noiseModel::Diagonal::Sigmas(Vector4(2.0,3.0,2.0,3.0));
+static const AlignedBox2 box(250,180,420,330);
+
+/// one quadric in front of two cameras and one behind them
+static Values values() {
+  Values values;
+  values.insert(Symbol('x', 0), Pose3(Rot3::Rodrigues(0.1,-0.2,0.05), Point3(0.2,-0.1,-5.0)));
+  values.insert(Symbol('x', 1), Pose3(Rot3::Rodrigues(-0.1,0.3,0.0), Point3(-1.0,0.2,-4.0)));
+  values.insert(Symbol('q', 0), ConstrainedDualQuadric(Rot3::Rodrigues(0.3,-0.2,0.5), Point3(0.2,0.1,0.3), Vector3(0.4,0.6,0.5)));
+  values.insert(Symbol('q', 1), ConstrainedDualQuadric(Rot3(), Point3(0.0,0.0,-10.0), Vector3(0.3,0.3,0.3)));
+  return values;
+}
+
+/// bounding box factors of every kind, and another factor
+static NonlinearFactorGraph graph() {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<BoundingBoxFactor>(box, K, Symbol('x', 0), Symbol('q', 0), model);
+  graph.emplace_shared<BoundingBoxFactor>(box, K, Symbol('x', 1), Symbol('q', 0), model);
+  graph.emplace_shared<BoundingBoxFactor>(box, K, Symbol('x', 0), Symbol('q', 1), model);
+  boost::shared_ptr<BoundingBoxFactor> gated = boost::make_shared<BoundingBoxFactor>(box, K, Symbol('x', 1), Symbol('q', 1), model);
+  gated->setGated(true);
+  graph.push_back(gated);
+  graph.emplace_shared<BoundingBoxFactor>(box, K, Symbol('x', 1), Symbol('q', 0), model, "TRUNCATED");
+  graph.emplace_shared<BoundingBoxFactor>(box, K, Symbol('x', 0), Symbol('q', 0),
+      noiseModel::Robust::Create(noiseModel::mEstimator::Huber::Create(1.0), model));
+  graph.emplace_shared<PriorFactor<Pose3> >(Symbol('x', 0), Pose3(), noiseModel::Isotropic::Sigma(6, 1.0));
+  return graph;
+}
+
+TEST(BoundingBoxBatch, MatchesGraph) {
+  NonlinearFactorGraph factors = graph();
+  Values v = values();
+  BoundingBoxBatch batch(factors, BoundingBoxBatch::HOST);
+
+  // STANDARD factors with gaussian noise are batched
+  LONGS_EQUAL(4, batch.size());
+  LONGS_EQUAL(3, batch.graphIndex(3));
+  EXPECT_DOUBLES_EQUAL(factors.error(v), batch.error(v), 1e-6);
+
+  GaussianFactorGraph::shared_ptr expected = factors.linearize(v);
+  GaussianFactorGraph::shared_ptr actual = batch.linearize(v);
+  LONGS_EQUAL(expected->size(), actual->size());
+  for (size_t g = 0; g < expected->size(); g++) {
+    EXPECT(bool(expected->at(g)) == bool(actual->at(g)));
+    if (expected->at(g) && actual->at(g)) {
+      EXPECT(assert_equal(*expected->at(g), *actual->at(g), 1e-6));
+    }
+  }
+
+  // the quadric behind the cameras keeps a constant error
+  EXPECT(batch.status(0) == ProjectionStatus::SUCCESS);
+  EXPECT(batch.status(2) == ProjectionStatus::BEHIND_CAMERA);
+  EXPECT(assert_equal(Vector(Vector4::Constant(1000.0)), Vector(batch.errors().row(2).transpose())));
+
+  // hidden factors, gated or not, keep the constant error on the quadric alone
+  for (size_t g = 2; g < 4; g++) {
+    CHECK(actual->at(g));
+    EXPECT(actual->at(g)->keys() == KeyVector{Symbol('q', 1)});
+    EXPECT(assert_equal(Matrix(Matrix::Zero(4, 9)), actual->at(g)->jacobian().first));
+  }
+}
+
+TEST(BoundingBoxBatch, MatchesFactorsOnRandomGraphs) {
+  std::mt19937 generator(17);
+  std::uniform_real_distribution<double> unit(-1.0, 1.0);
+  for (int trial = 0; trial < 5; trial++) {
+    // cameras near the origin looking along z, quadrics in front and behind
+    Values v;
+    for (size_t i = 0; i < 10; i++) {
+      v.insert(Symbol('x', i), Pose3(Rot3::Rodrigues(0.2*unit(generator),0.2*unit(generator),0.2*unit(generator)),
+                                     Point3(unit(generator),unit(generator),unit(generator))));
+    }
+    for (size_t j = 0; j < 20; j++) {
+      v.insert(Symbol('q', j), ConstrainedDualQuadric(Rot3::Rodrigues(unit(generator),unit(generator),unit(generator)),
+                                                      Point3(2.0*unit(generator),2.0*unit(generator),2.5+6.0*unit(generator)),
+                                                      Vector3(0.6+0.4*unit(generator),0.6+0.4*unit(generator),0.6+0.4*unit(generator))));
+    }
+    NonlinearFactorGraph factors;
+    for (size_t f = 0; f < 80; f++) {
+      AlignedBox2 measured(250+50*unit(generator), 180+50*unit(generator), 420+50*unit(generator), 330+50*unit(generator));
+      factors.emplace_shared<BoundingBoxFactor>(measured, K, Symbol('x', f%10), Symbol('q', (f*7)%20), model);
+    }
+
+    BoundingBoxBatch batch(factors, BoundingBoxBatch::HOST);
+    LONGS_EQUAL(factors.size(), batch.size());
+    GaussianFactorGraph::shared_ptr expected = factors.linearize(v);
+    GaussianFactorGraph::shared_ptr actual = batch.linearize(v);
+    size_t hidden = 0;
+    for (size_t f = 0; f < factors.size(); f++) {
+      const BoundingBoxFactor& factor = static_cast<const BoundingBoxFactor&>(*factors[f]);
+      Vector error = factor.evaluateError(v.at<Pose3>(factor.poseKey()), v.at<ConstrainedDualQuadric>(factor.objectKey()));
+      EXPECT(assert_equal(error, Vector(batch.errors().row(f).transpose()), 1e-6));
+      EXPECT(assert_equal(*expected->at(f), *actual->at(f), 1e-6));
+      hidden += batch.status(f) != ProjectionStatus::SUCCESS;
+    }
+
+    // both visible and hidden quadrics are compared
+    EXPECT(hidden > 0 && hidden < factors.size());
+  }
+}
+
+TEST(BoundingBoxBatch, MatchesEvaluateBatch) {
+  NonlinearFactorGraph factors = graph();
+  Values v = values();
+  BoundingBoxBatch batch(factors, "HOST");
+  batch.evaluate(v);
+
+  BoundingBoxFactor::BatchPoses poses(2, 12);
+  BoundingBoxFactor::BatchQuadrics quadrics(2, 9);
+  BoundingBoxFactor::BatchBoxes measured(2, 4), errors(2, 4);
+  BoundingBoxFactor::BatchJacobians jacobians(2, 60);
+  for (size_t i = 0; i < 2; i++) {
+    Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor> >(poses.row(i).data()) = v.at<Pose3>(Symbol('x', i)).matrix().topRows<3>();
+    quadrics.row(i) = ConstrainedDualQuadric::LocalCoordinates(v.at<ConstrainedDualQuadric>(Symbol('q', 0))).transpose();
+    measured.row(i) = box.vector().transpose();
+  }
+  BoundingBoxFactor::evaluateBatch(poses, quadrics, measured, K, ImageBoundary(), BoundingBoxFactor::STANDARD, errors, jacobians);
+  EXPECT(assert_equal(Matrix(errors), Matrix(batch.errors().topRows(2)), 1e-6));
+  EXPECT(assert_equal(Matrix(jacobians), Matrix(batch.jacobians().topRows(2)), 1e-6));
+
+  // jacobians can be skipped
+  batch.evaluate(v, false);
+  LONGS_EQUAL(0, batch.jacobians().rows());
+  EXPECT(assert_equal(Matrix(errors), Matrix(batch.errors().topRows(2)), 1e-6));
+}
+
+TEST(BoundingBoxBatch, Backends) {
+  NonlinearFactorGraph factors = graph();
+  CHECK_EXCEPTION(BoundingBoxBatch batch(factors, "GPU"), std::logic_error);
+  if (!BoundingBoxBatch::cudaEnabled()) {
+    EXPECT(BoundingBoxBatch::defaultBackend() == BoundingBoxBatch::HOST);
+    CHECK_EXCEPTION(BoundingBoxBatch batch(factors, BoundingBoxBatch::CUDA), std::invalid_argument);
+    return;
+  }
+
+  // the device evaluates the same kernel as the host
+  Values v = values();
+  BoundingBoxBatch host(factors, BoundingBoxBatch::HOST);
+  BoundingBoxBatch device(factors, BoundingBoxBatch::CUDA);
+  host.evaluate(v);
+  device.evaluate(v);
+  EXPECT(assert_equal(Matrix(host.errors()), Matrix(device.errors()), 1e-9));
+  EXPECT(assert_equal(Matrix(host.jacobians()), Matrix(device.jacobians()), 1e-6));
+  EXPECT_DOUBLES_EQUAL(host.error(v), device.error(v), 1e-6);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
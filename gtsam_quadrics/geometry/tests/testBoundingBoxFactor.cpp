@@ -18,13 +18,20 @@
 #include <CppUnitLite/TestHarness.h>
 
 #include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
 
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/base/Vector.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Rot3.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/linear/VectorValues.h>
 #include <gtsam/nonlinear/NonlinearFactorGraph.h>
 
+#include <Eigen/StdVector>
+#include <thread>
+#include <vector>
+
 using namespace std;
 using namespace gtsam_quadrics;
 
@@ -80,6 +87,242 @@ TEST(BoundingBoxFactor, Equals) {
   EXPECT(!bbf1.equals(bbf3));
 }
 
+TEST(BoundingBoxFactor, ProjectionFailure) {
+  BoundingBoxFactor bbf(measured, calibration, poseKey, quadricKey, model);
+  Pose3 behindPose(Rot3(), Point3(0,0,3));
+  Matrix H1, H2;
+  Vector error = bbf.evaluateError(behindPose, quadric, H1, H2);
+  EXPECT(assert_equal(Vector4(1000.0, 1000.0, 1000.0, 1000.0), Vector4(error)));
+  EXPECT(assert_equal(Matrix(Matrix::Zero(4,6)), H1));
+  EXPECT(assert_equal(Matrix(Matrix::Zero(4,9)), H2));
+
+  BoundingBoxFactor truncated(measured, calibration, poseKey, quadricKey, model, "TRUNCATED");
+  Pose3 insidePose(Rot3(), Point3(0,0,-0.5));
+  error = truncated.evaluateError(insidePose, quadric, H1, H2);
+  EXPECT(assert_equal(Vector4(1000.0, 1000.0, 1000.0, 1000.0), Vector4(error)));
+}
+
+TEST(BoundingBoxFactor, Linearize) {
+  Values values;
+  values.insert(poseKey, Pose3(Rot3::Rodrigues(0.1, -0.1, 0.05), Point3(0.2,0.1,-3)));
+  values.insert(quadricKey, ConstrainedDualQuadric(Rot3::Rodrigues(0.2,0.1,0.3), Point3(0.1,0,0.2), Vector3(0.3,0.5,0.7)));
+  boost::shared_ptr<noiseModel::Gaussian> gaussian = noiseModel::Gaussian::Covariance(
+      (Matrix44() << 4,1,0,0, 1,3,0,0, 0,0,2,0.5, 0,0,0.5,5).finished());
+
+  for (const SharedNoiseModel& m : {SharedNoiseModel(model), SharedNoiseModel(gaussian)}) {
+    for (string errorType : {"STANDARD", "TRUNCATED"}) {
+      BoundingBoxFactor bbf(measured, calibration, poseKey, quadricKey, m, errorType);
+      boost::shared_ptr<JacobianFactor> expected =
+          boost::dynamic_pointer_cast<JacobianFactor>(bbf.NoiseModelFactor::linearize(values));
+      boost::shared_ptr<JacobianFactor> actual =
+          boost::dynamic_pointer_cast<JacobianFactor>(bbf.linearize(values));
+      EXPECT(expected->keys() == actual->keys());
+      EXPECT(assert_equal(expected->jacobian().first, actual->jacobian().first, 1e-9));
+      EXPECT(assert_equal(expected->jacobian().second, actual->jacobian().second, 1e-9));
+    }
+  }
+}
+
+TEST(BoundingBoxFactor, EvaluateH1H2) {
+  BoundingBoxFactor bbf(measured, calibration, poseKey, quadricKey, model, "TRUNCATED");
+  ConstrainedDualQuadric q(Rot3::Rodrigues(0.2,0.1,0.3), Point3(0.1,0,0.2), Vector3(0.3,0.5,0.7));
+  pair<Matrix, Matrix> H1H2 = bbf.evaluateH1H2(cameraPose, q);
+  EXPECT(assert_equal(bbf.evaluateH1(cameraPose, q), H1H2.first));
+  EXPECT(assert_equal(bbf.evaluateH2(cameraPose, q), H1H2.second));
+}
+
+TEST(BoundingBoxFactor, ImageBoundary) {
+  boost::shared_ptr<ImageBoundary> hd(new ImageBoundary(1920.0, 1080.0));
+  BoundingBoxFactor standard(measured, calibration, poseKey, quadricKey, model, "TRUNCATED");
+  BoundingBoxFactor large(measured, calibration, hd, poseKey, quadricKey, model, "TRUNCATED");
+  EXPECT(assert_equal(ImageBoundary(), *standard.imageBoundary()));
+  EXPECT(large.imageBoundary() == hd);
+  EXPECT(!standard.equals(large));
+
+  // a quadric beyond the right border of a 640x480 image is fully visible in 1920x1080
+  Pose3 pose(Rot3(), Point3(-2.5,0,-3));
+  Vector4 expected = QuadricCamera::project(quadric, pose, calibration).bounds().vector() - measured.vector();
+  EXPECT(assert_equal(expected, Vector4(large.evaluateError(pose, quadric))));
+  EXPECT(!expected.isApprox(standard.evaluateError(pose, quadric)));
+}
+
+TEST(BoundingBoxFactor, EvaluateBatch) {
+  Matrix tangents(3, 6);
+  tangents << 0.1, -0.2, 0.05, 0.3, -0.1, -3.0,
+              0.0, 0.3, 0.0, -0.5, 0.2, -2.5,
+              0.0, 0.0, 0.0, 0.0, 0.0, 3.0;
+  BoundingBoxFactor::BatchPoses poses(3, 12);
+  Eigen::Matrix<double, 3, 16, Eigen::RowMajor> matrices;
+  for (int i = 0; i < 3; i++) {
+    Matrix4 T = Pose3::Retract(Vector6(tangents.row(i).transpose())).matrix();
+    Eigen::Map<Eigen::Matrix<double, 3, 4, Eigen::RowMajor> >(poses.row(i).data()) = T.topRows<3>();
+    Eigen::Map<Eigen::Matrix<double, 4, 4, Eigen::RowMajor> >(matrices.row(i).data()) = T;
+  }
+  BoundingBoxFactor::BatchQuadrics quadrics(3, 9);
+  quadrics << 0.2, 0.1, 0.3, 0.1, 0.0, 0.2, 0.3, 0.5, 0.7,
+              -0.1, 0.4, 0.0, 0.3, 0.1, -0.2, 0.6, 0.4, 0.5,
+              0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0;
+  BoundingBoxFactor::BatchBoxes boxes(3, 4);
+  boxes << measured.vector().transpose(), 300.0, 200.0, 500.0, 400.0,
+           measured.vector().transpose();
+
+  // the last quadric is behind the camera
+  for (BoundingBoxFactor::MeasurementModel errorType :
+       {BoundingBoxFactor::STANDARD, BoundingBoxFactor::TRUNCATED}) {
+    BoundingBoxFactor::BatchBoxes errors(3, 4);
+    BoundingBoxFactor::BatchJacobians jacobians(3, 60);
+    BoundingBoxFactor::evaluateBatch(poses, quadrics, boxes, calibration,
+                                     ImageBoundary(), errorType, errors,
+                                     jacobians);
+
+    for (int i = 0; i < 3; i++) {
+      Pose3 pose = Pose3::Retract(Vector6(tangents.row(i).transpose()));
+      ConstrainedDualQuadric q =
+          ConstrainedDualQuadric::Retract(Vector9(quadrics.row(i).transpose()));
+      BoundingBoxFactor factor(AlignedBox2(Vector4(boxes.row(i).transpose())),
+                               calibration, poseKey, quadricKey, model,
+                               errorType);
+      pair<Matrix, Matrix> H1H2 = factor.evaluateH1H2(pose, q);
+      Eigen::Matrix<double, 4, 15, Eigen::RowMajor> H(jacobians.row(i).data());
+      EXPECT(assert_equal(factor.evaluateError(pose, q),
+                          Vector(errors.row(i).transpose())));
+      EXPECT(assert_equal(H1H2.first, Matrix(H.leftCols<6>())));
+      EXPECT(assert_equal(H1H2.second, Matrix(H.rightCols<9>())));
+    }
+    EXPECT(assert_equal(Vector4::Constant(1000.0),
+                        Vector4(errors.row(2).transpose())));
+
+    // errors only
+    BoundingBoxFactor::BatchBoxes errorsOnly(3, 4);
+    BoundingBoxFactor::BatchJacobians none(0, 60);
+    BoundingBoxFactor::evaluateBatch(poses, quadrics, boxes, calibration,
+                                     ImageBoundary(), errorType, errorsOnly,
+                                     none);
+    EXPECT(assert_equal(Matrix(errors), Matrix(errorsOnly)));
+
+    // full 4x4 pose matrices are read in place with an outer stride
+    BoundingBoxFactor::BatchBoxes strided(3, 4);
+    Eigen::Map<const BoundingBoxFactor::BatchPoses, 0, Eigen::OuterStride<> >
+        squares(matrices.data(), 3, 12, Eigen::OuterStride<>(16));
+    BoundingBoxFactor::evaluateBatch(squares, quadrics, boxes, calibration,
+                                     ImageBoundary(), errorType, strided,
+                                     none);
+    EXPECT(errors == strided);
+  }
+}
+
+TEST(BoundingBoxFactor, Gated) {
+  BoundingBoxFactor factor(measured, calibration, poseKey, quadricKey, model);
+  BoundingBoxFactor gated(measured, calibration, poseKey, quadricKey, model);
+  gated.setGated(true);
+  EXPECT(gated.gated());
+  EXPECT(!factor.equals(gated));
+
+  // in view both factors evaluate and linearize alike
+  Values values;
+  values.insert(poseKey, cameraPose);
+  values.insert(quadricKey, quadric);
+  EXPECT(gated.inView(cameraPose, quadric));
+  EXPECT_DOUBLES_EQUAL(factor.error(values), gated.error(values), 1e-9);
+  EXPECT(assert_equal(*factor.linearize(values), *gated.linearize(values), 1e-9));
+
+  // behind the camera the gated factor skips the projection, but keeps the
+  // constant error so leaving the view never lowers the cost
+  Pose3 behind(Rot3(), Point3(0,0,3));
+  values.update(poseKey, behind);
+  EXPECT(factor.inView(behind, quadric));
+  EXPECT(!gated.inView(behind, quadric));
+  EXPECT(gated.error(values) > 0.0);
+  EXPECT_DOUBLES_EQUAL(factor.error(values), gated.error(values), 1e-9);
+  EXPECT(assert_equal(*factor.linearize(values), *gated.linearize(values), 1e-9));
+
+  // the constant is carried by the quadric alone, with the same error
+  GaussianFactor::shared_ptr hidden = gated.linearize(values);
+  EXPECT(hidden->keys() == KeyVector{quadricKey});
+  EXPECT(assert_equal(Matrix(Matrix::Zero(4,9)), hidden->jacobian().first));
+  VectorValues zero;
+  zero.insert(quadricKey, Vector::Zero(9));
+  EXPECT_DOUBLES_EQUAL(gated.error(values), hidden->error(zero), 1e-9);
+  Matrix H1, H2;
+  Vector error = gated.evaluateError(behind, quadric, H1, H2);
+  EXPECT(assert_equal(Vector(Vector4::Constant(BoundingBoxFactor::HIDDEN_ERROR)), error));
+  EXPECT(assert_equal(Matrix(Matrix::Zero(4,6)), H1));
+  EXPECT(assert_equal(Matrix(Matrix::Zero(4,9)), H2));
+
+  // a truncated factor skips the quadric once it leaves the image
+  BoundingBoxFactor truncated(measured, calibration, poseKey, quadricKey, model, "TRUNCATED");
+  BoundingBoxFactor ungated(measured, calibration, poseKey, quadricKey, model, "TRUNCATED");
+  truncated.setGated(true);
+  EXPECT(truncated.inView(Pose3(Rot3(), Point3(0,0,-3)), quadric));
+  Pose3 aside(Rot3(), Point3(10,0,-3));
+  values.update(poseKey, aside);
+  EXPECT(!truncated.inView(aside, quadric));
+  EXPECT_DOUBLES_EQUAL(ungated.error(values), truncated.error(values), 1e-9);
+  EXPECT(assert_equal(*ungated.linearize(values), *truncated.linearize(values), 1e-9));
+}
+
+TEST(BoundingBoxFactor, ConcurrentLinearize) {
+  // factors sharing one calibration, image and noise model, as in a graph
+  boost::shared_ptr<ImageBoundary> image(new ImageBoundary());
+  SharedNoiseModel noise = noiseModel::Isotropic::Sigma(4, 2.0);
+  vector<BoundingBoxFactor, Eigen::aligned_allocator<BoundingBoxFactor> >
+      factors;
+  Values values;
+  for (int i = 0; i < 20; i++) {
+    values.insert(Symbol('x', i),
+                  Pose3(Rot3::Rodrigues(0.02 * i, -0.01 * i, 0.0),
+                        Point3(0.1 * i - 1.0, 0.05 * i, -6.0)));
+  }
+  for (int j = 0; j < 50; j++) {
+    values.insert(Symbol('q', j),
+                  ConstrainedDualQuadric(
+                      Rot3::Rodrigues(0.1 * j, 0.0, -0.05 * j),
+                      Point3(0.6 * (j % 10) - 2.7, 0.8 * (j / 10) - 1.6, 0.0),
+                      Vector3(0.3, 0.2, 0.4)));
+  }
+  for (int i = 0; i < 20; i++) {
+    for (int j = 0; j < 50; j++) {
+      factors.push_back(BoundingBoxFactor(
+          AlignedBox2(200.0 + j, 150.0, 260.0 + i, 220.0), calibration, image,
+          Symbol('x', i), Symbol('q', j), noise,
+          (i + j) % 2 ? BoundingBoxFactor::STANDARD
+                      : BoundingBoxFactor::TRUNCATED));
+    }
+  }
+
+  vector<boost::shared_ptr<JacobianFactor> > expected;
+  for (const BoundingBoxFactor& factor : factors) {
+    expected.push_back(
+        boost::dynamic_pointer_cast<JacobianFactor>(factor.linearize(values)));
+  }
+
+  // every thread linearizes every factor, results must match exactly
+  const int nrThreads = 8;
+  vector<int> mismatches(nrThreads, 0);
+  vector<std::thread> threads;
+  for (int t = 0; t < nrThreads; t++) {
+    threads.push_back(std::thread([&, t]() {
+      for (int round = 0; round < 3; round++) {
+        for (size_t k = 0; k < factors.size(); k++) {
+          size_t f = (k + t * factors.size() / nrThreads) % factors.size();
+          boost::shared_ptr<JacobianFactor> linear =
+              boost::dynamic_pointer_cast<JacobianFactor>(
+                  factors[f].linearize(values));
+          if (!linear || !linear->equals(*expected[f], 0.0)) {
+            mismatches[t]++;
+          }
+        }
+      }
+    }));
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < nrThreads; t++) {
+    EXPECT_LONGS_EQUAL(0, mismatches[t]);
+  }
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
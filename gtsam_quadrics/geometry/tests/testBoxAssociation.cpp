@@ -0,0 +1,187 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testBoxAssociation.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for BoxAssociation
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/BoxAssociation.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot3.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+/// total IoU of an association
+static double totalIoU(const BoxAssociation& association) {
+  double total = 0.0;
+  for (size_t i = 0; i < association.size(); i++) {
+    total += association.iou(i);
+  }
+  return total;
+}
+
+TEST(BoxAssociation, IouMatrix) {
+  AlignedBox2Vector predicted;
+  predicted.push_back(AlignedBox2(10.0, 10.0, 50.0, 40.0));
+  predicted.push_back(AlignedBox2(30.0, 20.0, 90.0, 80.0));
+  predicted.push_back(AlignedBox2(200.0, 200.0, 220.0, 260.0));
+  AlignedBox2Vector measured;
+  measured.push_back(AlignedBox2(12.0, 8.0, 48.0, 45.0));
+  measured.push_back(AlignedBox2(35.0, 25.0, 70.0, 60.0));
+  measured.push_back(AlignedBox2(0.0, 0.0, 300.0, 300.0));
+  measured.push_back(AlignedBox2(400.0, 400.0, 410.0, 410.0));
+
+  Matrix P(predicted.size(), 4), M(measured.size(), 4);
+  for (size_t j = 0; j < predicted.size(); j++) {
+    P.row(j) = predicted[j].vector().transpose();
+  }
+  for (size_t i = 0; i < measured.size(); i++) {
+    M.row(i) = measured[i].vector().transpose();
+  }
+
+  // matches AlignedBox2::iou, including contained boxes
+  Matrix iou = BoxAssociation::iouMatrix(P, M);
+  EXPECT_LONGS_EQUAL(4, iou.rows());
+  EXPECT_LONGS_EQUAL(3, iou.cols());
+  for (size_t i = 0; i < measured.size(); i++) {
+    for (size_t j = 0; j < predicted.size(); j++) {
+      EXPECT_DOUBLES_EQUAL(measured[i].iou(predicted[j]), iou(i, j), 1e-12);
+    }
+  }
+  EXPECT(assert_equal(Matrix(Matrix::Zero(1, 3)), Matrix(iou.row(3))));
+
+  CHECK_EXCEPTION(BoxAssociation::iouMatrix(Matrix::Zero(2, 3), M),
+                  std::invalid_argument);
+  EXPECT(BoxAssociation::iouMatrix(Matrix(), M).cols() == 0);
+}
+
+TEST(BoxAssociation, HungarianAndGreedy) {
+  // greedy takes the best pair first and leaves measurement 1 unmatched
+  Matrix iou = (Matrix(2, 2) << 0.6, 0.5, 0.55, 0.0).finished();
+
+  BoxAssociation greedy = BoxAssociation::solve(iou, 0.3,
+                                                BoxAssociation::GREEDY);
+  EXPECT_LONGS_EQUAL(0, greedy.landmark(0));
+  EXPECT_LONGS_EQUAL(-1, greedy.landmark(1));
+  EXPECT_LONGS_EQUAL(1, greedy.nrMatches());
+
+  BoxAssociation optimal = BoxAssociation::solve(iou, 0.3);
+  EXPECT_LONGS_EQUAL(1, optimal.landmark(0));
+  EXPECT_LONGS_EQUAL(0, optimal.landmark(1));
+  EXPECT_DOUBLES_EQUAL(1.05, totalIoU(optimal), 1e-12);
+
+  // pairs below the threshold are never matched
+  BoxAssociation strict = BoxAssociation::solve(iou, 0.58);
+  EXPECT_LONGS_EQUAL(0, strict.landmark(0));
+  EXPECT(!strict.isMatched(1));
+  EXPECT_DOUBLES_EQUAL(0.0, strict.iou(1), 1e-12);
+
+  CHECK_EXCEPTION(BoxAssociation::associate(Matrix(), Matrix(), 0.3, "BEST"),
+                  std::logic_error);
+  EXPECT_LONGS_EQUAL(0, BoxAssociation::solve(Matrix()).size());
+}
+
+TEST(BoxAssociation, HungarianIsOptimal) {
+  // compare against every assignment of small rectangular problems
+  for (int trial = 0; trial < 20; trial++) {
+    int M = 2 + trial % 3, N = 2 + (trial / 3) % 3;
+    Matrix iou(M, N);
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++) {
+        double x = std::sin(12.9898 * (trial * 31 + i * 7 + j) + 4.1);
+        iou(i, j) = std::max(0.0, std::fabs(x) - 0.2);
+      }
+    }
+    double minIoU = 0.25;
+
+    int n = std::max(M, N);
+    vector<int> columns(n);
+    for (int j = 0; j < n; j++) columns[j] = j;
+    double best = 0.0;
+    do {
+      double total = 0.0;
+      for (int i = 0; i < M; i++) {
+        int j = columns[i];
+        if (j < N && iou(i, j) >= minIoU) total += iou(i, j);
+      }
+      best = std::max(best, total);
+    } while (std::next_permutation(columns.begin(), columns.end()));
+
+    BoxAssociation optimal = BoxAssociation::solve(iou, minIoU);
+    BoxAssociation greedy =
+        BoxAssociation::solve(iou, minIoU, BoxAssociation::GREEDY);
+    EXPECT_DOUBLES_EQUAL(best, totalIoU(optimal), 1e-9);
+    EXPECT(totalIoU(greedy) <= best + 1e-9);
+
+    // every landmark is matched at most once
+    vector<int> matched;
+    for (size_t i = 0; i < optimal.size(); i++) {
+      if (optimal.isMatched(i)) matched.push_back(optimal.landmark(i));
+    }
+    std::sort(matched.begin(), matched.end());
+    EXPECT(std::adjacent_find(matched.begin(), matched.end()) ==
+           matched.end());
+  }
+}
+
+TEST(BoxAssociation, BatchProjection) {
+  boost::shared_ptr<Cal3_S2> calibration(
+      new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+  Pose3 pose(Rot3(), Point3(0.0, 0.0, -5.0));
+  vector<ConstrainedDualQuadric> quadrics;
+  quadrics.push_back(ConstrainedDualQuadric(Rot3(), Point3(-1.0, 0.0, 0.0),
+                                            Vector3(0.3, 0.4, 0.5)));
+  quadrics.push_back(ConstrainedDualQuadric(Rot3(), Point3(1.0, 0.5, 0.0),
+                                            Vector3(0.4, 0.3, 0.2)));
+  quadrics.push_back(ConstrainedDualQuadric(Rot3(), Point3(0.0, 0.0, -8.0),
+                                            Vector3(0.4, 0.3, 0.2)));
+  BatchProjection projections =
+      QuadricCamera::projectBatch(quadrics, pose, calibration);
+  EXPECT(projections.status[2] != ProjectionStatus::SUCCESS);
+
+  // detections of the visible quadrics in reverse order, slightly offset
+  AlignedBox2Vector measured;
+  measured.push_back(AlignedBox2(projections.bounds(1).vector() +
+                                 Vector4(2.0, -1.0, 3.0, 1.0)));
+  measured.push_back(AlignedBox2(projections.bounds(0).vector() +
+                                 Vector4(-2.0, 1.0, -1.0, 2.0)));
+
+  // failed projections are gated
+  Matrix iou = BoxAssociation::iouMatrix(projections, measured);
+  EXPECT(assert_equal(Matrix(Matrix::Zero(2, 1)), Matrix(iou.col(2))));
+
+  BoxAssociation association =
+      BoxAssociation::associate(projections, measured);
+  EXPECT_LONGS_EQUAL(2, association.nrMatches());
+  EXPECT_LONGS_EQUAL(1, association.landmark(0));
+  EXPECT_LONGS_EQUAL(0, association.landmark(1));
+  EXPECT_DOUBLES_EQUAL(measured[0].iou(projections.bounds(1)),
+                       association.iou(0), 1e-12);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -24,6 +24,7 @@
 
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/base/Vector.h>
+#include <gtsam/base/numericalDerivative.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Rot3.h>
 #include <gtsam/nonlinear/Values.h>
@@ -67,6 +68,12 @@ TEST(ConstrainedDualQuadric, Constrain) {
   Matrix44 actual2 = ConstrainedDualQuadric::constrain(constrainedQuadric).matrix();
   EXPECT(assert_equal(defaultQuadric, actual1));
   EXPECT(assert_equal(constrainedQuadric, actual2));
+
+  // a rotated quadric, scaled by a negative factor
+  ConstrainedDualQuadric rotated(Rot3::Rodrigues(0.3,-0.4,1.2), Point3(1.0,-2.0,3.0), Vector3(0.4,0.6,0.9));
+  ConstrainedDualQuadric actual3 = ConstrainedDualQuadric::constrain(-2.5 * rotated.matrix());
+  EXPECT(assert_equal(rotated.matrix(), actual3.matrix(), 1e-9));
+  EXPECT_DOUBLES_EQUAL(1.0, actual3.pose().rotation().matrix().determinant(), 1e-9);
 }
 
 TEST(ConstrainedDualQuadric, Accessors) {
@@ -92,6 +99,20 @@ TEST(ConstrainedDualQuadric, Matrix) {
   EXPECT(assert_equal(expected, q.matrix()));
 };
 
+TEST(ConstrainedDualQuadric, MatrixJacobian) {
+  ConstrainedDualQuadric q(Rot3::Rodrigues(0.3,-0.2,0.5), Point3(1.,-2.,3.), Vector3(0.4,0.7,1.3));
+
+  std::function<Vector(const ConstrainedDualQuadric&)> f = [](const ConstrainedDualQuadric& x) -> Vector {
+    Matrix44 Q = x.matrix();
+    return Eigen::Map<const Vector>(Q.data(), 16);
+  };
+  Matrix expected = numericalDerivative11<Vector, ConstrainedDualQuadric>(f, q, 1e-6);
+
+  Eigen::Matrix<double, 16, 9> actual;
+  q.matrix(actual);
+  EXPECT(assert_equal(expected, Matrix(actual), 1e-6));
+};
+
 TEST(ConstrainedDualQuadric, NormalizedMatrix) {
   ConstrainedDualQuadric q1 = ConstrainedDualQuadric::Retract((Vector9()<<1.,2.,3.,4.,5.,6.,7.,8.,9.).finished());
 
@@ -108,6 +129,22 @@ TEST(ConstrainedDualQuadric, Bounds) {
   EXPECT(assert_equal(expected, actual));
 }
 
+TEST(ConstrainedDualQuadric, RotatedBounds) {
+  ConstrainedDualQuadric Q(Rot3::Rodrigues(0.3,-0.7,1.2), Point3(0.5,-1.0,2.0), Vector3(0.3,1.4,0.8));
+
+  // the extreme planes x = c are tangent to the quadric, so c solves
+  // Q(0,0) - 2cQ(0,3) + c^2Q(3,3) = 0
+  Matrix44 dE = Q.matrix();
+  Vector6 expected;
+  for (int i = 0; i < 3; i++) {
+    double root = std::sqrt(dE(i,3)*dE(i,3) - dE(i,i)*dE(3,3));
+    expected(2*i) = (dE(i,3) - root) / dE(3,3);
+    expected(2*i+1) = (dE(i,3) + root) / dE(3,3);
+  }
+
+  EXPECT(assert_equal(AlignedBox3(expected), Q.bounds(), 1e-9));
+}
+
 TEST(ConstrainedDualQuadric, IsBehind) {
   ConstrainedDualQuadric Q(Rot3(), Point3(0.,0.,20.), Vector3(1.,2.,3.));
   Pose3 qInfront(Rot3(), Point3(0.,0.,3.));
@@ -0,0 +1,152 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testDistortedCamera.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for DistortedCamera
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/DistortedCamera.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/geometry/Cal3DS2.h>
+#include <gtsam/geometry/Cal3Fisheye.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <cmath>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const Cal3DS2 radtan(525.0,525.0,0.0,320.0,240.0,-0.28,0.07,0.001,-0.0005);
+static const Cal3Fisheye fisheye(380.0,380.0,0.0,320.0,240.0,0.02,-0.01,0.003,-0.001);
+
+/// returns the bounds of an ellipse outline in the ideal image, optionally distorted
+template <class CALIBRATION>
+static AlignedBox2 outline(const Point2& center, const Vector2& radii, double angle, const CALIBRATION& calibration, bool distorted) {
+  const Cal3_S2 K = *QuadricCamera::pinhole(calibration);
+  double xmin = 1e9, ymin = 1e9, xmax = -1e9, ymax = -1e9;
+  for (int i = 0; i < 3600; i++) {
+    double t = 2.0 * M_PI * i / 3600.0;
+    Point2 p = center + Point2(radii(0) * cos(t) * cos(angle) - radii(1) * sin(t) * sin(angle), radii(0) * cos(t) * sin(angle) + radii(1) * sin(t) * cos(angle));
+    if (distorted) p = calibration.uncalibrate(K.calibrate(p));
+    xmin = min(xmin, p.x()); ymin = min(ymin, p.y()); xmax = max(xmax, p.x()); ymax = max(ymax, p.y());
+  }
+  return AlignedBox2(xmin, ymin, xmax, ymax);
+}
+
+/// checks each side of the undistorted box is within the bound of undistortError
+template <class CALIBRATION>
+static bool withinBound(const Point2& center, const Vector2& radii, double angle, const CALIBRATION& calibration) {
+  AlignedBox2 detected = outline(center, radii, angle, calibration, true);
+  Vector4 error = QuadricCamera::undistort(detected, calibration).vector() - outline(center, radii, angle, calibration, false).vector();
+  return (error.cwiseAbs().array() <= QuadricCamera::undistortError(detected, calibration).array()).all();
+}
+
+TEST(DistortedCamera, Undistort) {
+  // objects across the image, the box of the ideal conic is recovered from the detected box
+  for (double x : {100.0, 320.0, 520.0}) {
+    for (double y : {80.0, 240.0, 400.0}) {
+      Point2 center(x, y);
+      Vector2 radii(50.0, 30.0);
+      AlignedBox2 ideal = outline(center, radii, 0.4, radtan, false);
+      EXPECT(assert_equal(ideal, QuadricCamera::undistort(outline(center, radii, 0.4, radtan, true), radtan), 2.0));
+      EXPECT(assert_equal(outline(center, radii, 0.4, radtan, true), QuadricCamera::distort(ideal, radtan), 2.0));
+      EXPECT(withinBound(center, radii, 0.4, radtan));
+
+      ideal = outline(center, radii, -0.2, fisheye, false);
+      EXPECT(assert_equal(ideal, QuadricCamera::undistort(outline(center, radii, -0.2, fisheye, true), fisheye), 3.0));
+      EXPECT(withinBound(center, radii, -0.2, fisheye));
+    }
+  }
+
+  // the approximation is exact at the principal point
+  AlignedBox2 centered = outline(Point2(320.0, 240.0), Vector2(50.0, 30.0), 0.0, radtan, true);
+  EXPECT(assert_equal(outline(Point2(320.0, 240.0), Vector2(50.0, 30.0), 0.0, radtan, false), QuadricCamera::undistort(centered, radtan), 0.05));
+
+  // a pinhole camera has no distortion
+  Cal3_S2 K(525.0,525.0,0.0,320.0,240.0);
+  AlignedBox2 box(10.0,20.0,100.0,120.0);
+  EXPECT(assert_equal(box, QuadricCamera::undistort(box, K)));
+  EXPECT(assert_equal(box, QuadricCamera::distort(box, K)));
+  EXPECT(assert_equal(K, *QuadricCamera::pinhole(radtan)));
+}
+
+TEST(DistortedCamera, LargeOffCentre) {
+  // a box spanning half of the image near its corner, where the sides undistort to curves
+  Point2 center(170.0, 130.0);
+  Vector2 radii(140.0, 90.0);
+  AlignedBox2 detected = outline(center, radii, 0.3, radtan, true);
+  EXPECT(detected.width() > 240.0 && detected.height() > 170.0);
+  EXPECT(withinBound(center, radii, 0.3, radtan));
+  EXPECT(assert_equal(outline(center, radii, 0.3, radtan, false), QuadricCamera::undistort(detected, radtan), 3.0));
+  EXPECT(withinBound(Point2(480.0, 360.0), Vector2(120.0, 90.0), -0.4, radtan));
+  EXPECT(withinBound(Point2(500.0, 120.0), Vector2(130.0, 80.0), 0.5, fisheye));
+
+  // the bound grows with the box, the sides far from the principal point curve most
+  Vector4 bound = QuadricCamera::undistortError(detected, radtan);
+  Vector4 smallBound = QuadricCamera::undistortError(outline(center, Vector2(20.0, 15.0), 0.3, radtan, true), radtan);
+  EXPECT((bound.head<2>().array() > 5.0 * smallBound.head<2>().array()).all());
+  EXPECT(bound(0) > bound(2) && bound(1) > bound(3));
+  EXPECT(assert_equal(Vector(Vector4::Zero()), Vector(QuadricCamera::undistortError(detected, Cal3_S2()))));
+
+  // barrel distortion compresses the border, so the sigmas of the outer sides grow
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 2.0);
+  DistortedCamera<Cal3DS2> camera(radtan, 640.0, 480.0);
+  Vector4 scale = QuadricCamera::undistortJacobian(detected, radtan);
+  EXPECT(scale(0) > 1.2 && scale(1) > 1.1);
+  EXPECT(assert_equal(Vector(Vector4::Ones()), Vector(scale.tail<2>()), 0.05));
+  BoundingBoxFactor factor = camera.factor(detected, Symbol('x',0), Symbol('q',1), model);
+  noiseModel::Diagonal::shared_ptr diagonal = boost::dynamic_pointer_cast<noiseModel::Diagonal>(factor.noiseModel());
+  CHECK(diagonal);
+  EXPECT(assert_equal(Vector(2.0 * scale), diagonal->sigmas(), 1e-9));
+
+  // robust and full covariance models are scaled in the ideal image
+  SharedNoiseModel robust = noiseModel::Robust::Create(noiseModel::mEstimator::Huber::Create(1.0), model);
+  noiseModel::Robust::shared_ptr scaled = boost::dynamic_pointer_cast<noiseModel::Robust>(camera.undistort(detected, robust));
+  CHECK(scaled);
+  EXPECT(assert_equal(Vector(2.0 * scale), boost::dynamic_pointer_cast<noiseModel::Diagonal>(scaled->noise())->sigmas(), 1e-9));
+  Matrix4 covariance = Matrix4::Identity() + Matrix4::Constant(0.5);
+  SharedNoiseModel gaussian = noiseModel::Gaussian::Covariance(covariance);
+  Matrix4 expected = scale.asDiagonal() * covariance * scale.asDiagonal();
+  EXPECT(assert_equal(Matrix(expected), boost::dynamic_pointer_cast<noiseModel::Gaussian>(camera.undistort(detected, gaussian))->covariance(), 1e-9));
+}
+
+TEST(DistortedCamera, Factor) {
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 2.0);
+  DistortedCamera<Cal3DS2> camera(radtan, 640.0, 480.0);
+  AlignedBox2 box(10.0,20.0,100.0,120.0);
+  BoundingBoxFactor factor = camera.factor(box, Symbol('x',0), Symbol('q',1), model, BoundingBoxFactor::TRUNCATED);
+  BoundingBoxFactor expected(camera.undistort(box), camera.pinhole(), camera.imageBoundary(), Symbol('x',0), Symbol('q',1), camera.undistort(box, model), BoundingBoxFactor::TRUNCATED);
+  EXPECT(assert_equal(expected, factor));
+  EXPECT(factor.imageBoundary() == camera.imageBoundary());
+
+  // barrel distortion pulls the border in, the ideal image area extends beyond it
+  AlignedBox2 area = camera.imageBoundary()->bounds();
+  EXPECT(area.xmin() < 0.0 && area.ymin() < 0.0 && area.xmax() > 640.0 && area.ymax() > 480.0);
+
+  DistortedCamera<Cal3_S2> pinhole(Cal3_S2(525.0,525.0,0.0,320.0,240.0), 640.0, 480.0);
+  EXPECT(assert_equal(box, pinhole.factor(box, Symbol('x',0), Symbol('q',1), model).measurement()));
+  EXPECT(pinhole.undistort(box, model) == model);
+  EXPECT(assert_equal(AlignedBox2(0.0,0.0,640.0,480.0), pinhole.imageBoundary()->bounds()));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
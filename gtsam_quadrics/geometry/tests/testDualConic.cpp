@@ -23,13 +23,18 @@
 #include <CppUnitLite/TestHarness.h>
 
 #include <gtsam_quadrics/geometry/DualConic.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
 
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/base/Vector.h>
+#include <gtsam/base/numericalDerivative.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Rot3.h>
 
+#include <cmath>
+
 using namespace std;
+using namespace gtsam;
 using namespace gtsam_quadrics;
 
 static const Matrix33 expectedDefault((Matrix33() << 1.0, 0.0, 0.0, 
@@ -91,6 +96,152 @@ TEST(DualConic, Equals) {
   EXPECT(!conic1.equals(conic2));
 }
 
+TEST(DualConic, SmartBoundsJacobian) {
+  boost::shared_ptr<Cal3_S2> calibration(
+      new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+
+  // truncated by the left border, by the top-left corner,
+  // and by the right border with the remaining bounds on tangent points
+  vector<DualConic> conics;
+  conics.push_back(DualConic(Pose2(Rot2::fromAngle(0.3), Point2(10.0, 240.0)),
+                             Vector2(50.0, 30.0)));
+  conics.push_back(DualConic(Pose2(Rot2::fromAngle(-0.2), Point2(20.0, 15.0)),
+                             Vector2(80.0, 60.0)));
+  conics.push_back(DualConic(Pose2(Rot2::fromAngle(1.1), Point2(600.0, 300.0)),
+                             Vector2(90.0, 40.0)));
+
+  for (const DualConic& dualConic : conics) {
+    Eigen::Matrix<double, 4, 9> H;
+    dualConic.smartBounds(calibration, H);
+
+    auto boundsFunction = [&calibration](const Matrix33& dC) -> Vector4 {
+      return DualConic(dC).smartBounds(calibration).vector();
+    };
+    Eigen::Matrix<double, 4, 9> expectedH =
+        numericalDerivative11<Vector4, Matrix33>(boundsFunction,
+                                                 dualConic.matrix(), 1e-5);
+    EXPECT(assert_equal(expectedH, Matrix(H), 1e-3));
+  }
+}
+
+TEST(DualConic, TrySmartBounds) {
+  boost::shared_ptr<Cal3_S2> calibration(
+      new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+
+  // partially visible conics match smartBounds
+  DualConic partiallyVisible(Pose2(Rot2::fromAngle(0.3), Point2(10.0, 240.0)),
+                             Vector2(50.0, 30.0));
+  AlignedBox2 bounds;
+  EXPECT(partiallyVisible.trySmartBounds(calibration, bounds) ==
+         ProjectionStatus::SUCCESS);
+  EXPECT(assert_equal(partiallyVisible.smartBounds(calibration), bounds));
+
+  // conics outside the image report failure without throwing
+  DualConic notVisible(Pose2(Rot2(), Point2(-200.0, -200.0)),
+                       Vector2(50.0, 30.0));
+  EXPECT(notVisible.trySmartBounds(calibration, bounds) ==
+         ProjectionStatus::NOT_VISIBLE);
+  CHECK_EXCEPTION(notVisible.smartBounds(calibration), std::runtime_error);
+}
+
+TEST(DualConic, SmartBoundsImageBoundary) {
+  ImageBoundary hd(1920.0, 1080.0);
+  boost::shared_ptr<Cal3_S2> calibration(
+      new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+
+  // the calibration overload keeps the 640x480 default
+  DualConic partiallyVisible(Pose2(Rot2::fromAngle(0.3), Point2(10.0, 240.0)),
+                             Vector2(50.0, 30.0));
+  EXPECT(assert_equal(partiallyVisible.smartBounds(ImageBoundary()),
+                      partiallyVisible.smartBounds(calibration)));
+
+  // visible in a larger image only
+  DualConic centered(Pose2(Rot2::fromAngle(0.2), Point2(900.0, 500.0)),
+                     Vector2(100.0, 60.0));
+  EXPECT(assert_equal(centered.bounds(), centered.smartBounds(hd)));
+
+  // truncated by the right border and bottom-right corner of the larger image
+  DualConic truncated(Pose2(Rot2::fromAngle(-0.4), Point2(1900.0, 1070.0)),
+                      Vector2(80.0, 50.0));
+  Eigen::Matrix<double, 4, 9> H;
+  AlignedBox2 bounds = truncated.smartBounds(hd, H);
+  EXPECT_DOUBLES_EQUAL(1920.0, bounds.xmax(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(1080.0, bounds.ymax(), 1e-9);
+
+  auto boundsFunction = [&hd](const Matrix33& dC) -> Vector4 {
+    return DualConic(dC).smartBounds(hd).vector();
+  };
+  Eigen::Matrix<double, 4, 9> expectedH =
+      numericalDerivative11<Vector4, Matrix33>(boundsFunction,
+                                               truncated.matrix(), 1e-5);
+  // entries grow with the image size, compare relative to the largest
+  double tol = 1e-4 * expectedH.cwiseAbs().maxCoeff();
+  EXPECT(assert_equal(expectedH, Matrix(H), tol));
+}
+
+/// bounds of the conic inside the image from densely sampled points
+static AlignedBox2 sampledBounds(const Pose2& pose, const Vector2& radii,
+                                 const AlignedBox2& image) {
+  DualConic dualConic(pose, radii);
+  Vector4 b(image.xmax(), image.ymax(), image.xmin(), image.ymin());
+  auto add = [&b](const Point2& p) {
+    b = Vector4(min(b[0], p.x()), min(b[1], p.y()), max(b[2], p.x()),
+                max(b[3], p.y()));
+  };
+  for (int i = 0; i < 100000; i++) {
+    double theta = 2.0 * M_PI * i / 100000.0;
+    Vector3 p = pose.matrix() * Vector3(radii[0] * cos(theta),
+                                        radii[1] * sin(theta), 1.0);
+    if (image.contains(Point2(p.head<2>()))) add(Point2(p.head<2>()));
+  }
+  for (const Point2& corner : ImageBoundary(image).corners()) {
+    if (dualConic.contains(corner)) add(corner);
+  }
+  return AlignedBox2(b);
+}
+
+TEST(DualConic, SmartBoundsMatchesSampling) {
+  ImageBoundary image;
+  vector<pair<Pose2, Vector2> > conics;
+  conics.push_back(make_pair(Pose2(Rot2::fromAngle(0.2), Point2(320, 240)),
+                             Vector2(100.0, 60.0)));
+  conics.push_back(make_pair(Pose2(Rot2::fromAngle(0.3), Point2(10, 240)),
+                             Vector2(50.0, 30.0)));
+  conics.push_back(make_pair(Pose2(Rot2::fromAngle(-0.2), Point2(20, 15)),
+                             Vector2(80.0, 60.0)));
+  conics.push_back(make_pair(Pose2(Rot2::fromAngle(1.1), Point2(600, 300)),
+                             Vector2(90.0, 40.0)));
+  conics.push_back(make_pair(Pose2(Rot2::fromAngle(0.7), Point2(630, 470)),
+                             Vector2(120.0, 30.0)));
+  conics.push_back(make_pair(Pose2(Rot2::fromAngle(-0.4), Point2(300, 500)),
+                             Vector2(200.0, 45.0)));
+  conics.push_back(make_pair(Pose2(Rot2::fromAngle(0.1), Point2(320, 240)),
+                             Vector2(900.0, 700.0)));
+
+  for (const auto& conic : conics) {
+    AlignedBox2 bounds;
+    EXPECT(DualConic(conic.first, conic.second)
+               .trySmartBounds(image, bounds) == ProjectionStatus::SUCCESS);
+    EXPECT(assert_equal(sampledBounds(conic.first, conic.second,
+                                      image.bounds()),
+                        bounds, 0.05));
+  }
+
+  // conics missing a border stop at their extrema, not at that border
+  DualConic left(Pose2(Rot2::fromAngle(0.3), Point2(10.0, 240.0)),
+                 Vector2(50.0, 30.0));
+  AlignedBox2 simple = left.bounds();
+  AlignedBox2 smart = left.smartBounds(image);
+  EXPECT_DOUBLES_EQUAL(0.0, smart.xmin(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(simple.xmax(), smart.xmax(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(simple.ymax(), smart.ymax(), 1e-9);
+
+  // a conic covering the image is truncated to its corners
+  DualConic covering(Pose2(Rot2::fromAngle(0.1), Point2(320, 240)),
+                     Vector2(900.0, 700.0));
+  EXPECT(assert_equal(image.bounds(), covering.smartBounds(image), 1e-9));
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
@@ -0,0 +1,99 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testFrameFactorBuilder.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for FrameFactorBuilder
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/FrameFactorBuilder.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+
+TEST(FrameFactorBuilder, Cameras) {
+  FrameFactorBuilder builder;
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 2.0);
+  boost::shared_ptr<Cal3_S2> copy(new Cal3_S2(*K));
+  boost::shared_ptr<ImageBoundary> hd(new ImageBoundary(1920.0, 1080.0));
+
+  // equal calibrations and noise models are shared between cameras
+  LONGS_EQUAL(0, builder.addCamera(K, model));
+  LONGS_EQUAL(1, builder.addCamera(copy, noiseModel::Isotropic::Sigma(4, 2.0), "TRUNCATED"));
+  LONGS_EQUAL(2, builder.addCamera(K, hd, noiseModel::Isotropic::Sigma(4, 3.0)));
+  LONGS_EQUAL(3, builder.nrCameras());
+  LONGS_EQUAL(2, builder.nrNoiseModels());
+  EXPECT(builder.camera(1).calibration == K);
+  EXPECT(builder.camera(1).model == model);
+  EXPECT(builder.camera(1).imageBoundary == builder.camera(0).imageBoundary);
+  EXPECT(builder.camera(2).imageBoundary == hd);
+  EXPECT(builder.camera(1).measurementModel == BoundingBoxFactor::TRUNCATED);
+  CHECK_EXCEPTION(builder.camera(3), std::out_of_range);
+  CHECK_EXCEPTION(builder.addCamera(K, model, "SMART"), std::logic_error);
+}
+
+TEST(FrameFactorBuilder, Build) {
+  FrameFactorBuilder builder(4);
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 2.0);
+  builder.addCamera(K, model, BoundingBoxFactor::TRUNCATED);
+  builder.setGated(true);
+
+  Matrix boxes(3, 4);
+  boxes << 10.0, 20.0, 100.0, 120.0,
+           15.0, 25.0, 90.0, 110.0,
+           200.0, 150.0, 400.0, 300.0;
+  KeyVector keys = {Symbol('q',0), Symbol('q',1), Symbol('q',2)};
+  {
+    NonlinearFactorGraph graph = builder.build(Symbol('x',0), 0, boxes, keys);
+    AlignedBox2Vector more = {AlignedBox2(1.0,2.0,3.0,4.0), AlignedBox2(5.0,6.0,7.0,8.0)};
+    builder.add(graph, Symbol('x',1), 0, more, KeyVector({Symbol('q',0), Symbol('q',3)}));
+    LONGS_EQUAL(5, graph.size());
+    LONGS_EQUAL(5, builder.pool()->allocated());
+    LONGS_EQUAL(8, builder.pool()->capacity());
+
+    // the factors equal factors built one at a time
+    BoundingBoxFactor expected(AlignedBox2(15.0,25.0,90.0,110.0), K, Symbol('x',0), Symbol('q',1), model, "TRUNCATED");
+    expected.setGated(true);
+    boost::shared_ptr<BoundingBoxFactor> factor = boost::dynamic_pointer_cast<BoundingBoxFactor>(graph[1]);
+    CHECK(factor);
+    EXPECT(assert_equal(expected, *factor));
+    EXPECT(factor->imageBoundary() == builder.camera(0).imageBoundary);
+    EXPECT(assert_equal(AlignedBox2(5.0,6.0,7.0,8.0), boost::dynamic_pointer_cast<BoundingBoxFactor>(graph[4])->measurement()));
+
+    CHECK_EXCEPTION(builder.build(Symbol('x',0), 0, boxes, KeyVector()), std::invalid_argument);
+    CHECK_EXCEPTION(builder.build(Symbol('x',0), 1, boxes, keys), std::out_of_range);
+  }
+
+  // destroyed factors return to the pool and are reused
+  LONGS_EQUAL(0, builder.pool()->allocated());
+  NonlinearFactorGraph graph = builder.build(Symbol('x',2), 0, boxes, keys);
+  LONGS_EQUAL(3, builder.pool()->allocated());
+  LONGS_EQUAL(8, builder.pool()->capacity());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,62 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testImageBoundary.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for ImageBoundary
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+
+#include <gtsam/base/TestableAssertions.h>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+TEST(ImageBoundary, Constructors) {
+  ImageBoundary defaultImage;
+  EXPECT(assert_equal(AlignedBox2(0.0, 0.0, 640.0, 480.0),
+                      defaultImage.bounds()));
+
+  ImageBoundary hd(1920.0, 1080.0);
+  EXPECT(assert_equal(AlignedBox2(0.0, 0.0, 1920.0, 1080.0), hd.bounds()));
+  EXPECT_DOUBLES_EQUAL(1920.0, hd.width(), 1e-9);
+  EXPECT_DOUBLES_EQUAL(1080.0, hd.height(), 1e-9);
+  EXPECT(assert_equal(hd, ImageBoundary(AlignedBox2(0.0, 0.0, 1920.0, 1080.0))));
+  EXPECT(!hd.equals(defaultImage));
+}
+
+TEST(ImageBoundary, Geometry) {
+  AlignedBox2 area(10.0, 20.0, 110.0, 220.0);
+  ImageBoundary image(area);
+
+  LONGS_EQUAL(4, image.corners().size());
+  EXPECT(assert_equal(Point2(10.0, 20.0), image.corners()[0]));
+  EXPECT(assert_equal(Point2(10.0, 220.0), image.corners()[1]));
+  EXPECT(assert_equal(Point2(110.0, 20.0), image.corners()[2]));
+  EXPECT(assert_equal(Point2(110.0, 220.0), image.corners()[3]));
+
+  LONGS_EQUAL(4, image.lines().size());
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT(assert_equal(area.lines()[i], image.lines()[i]));
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,213 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testMultiViewBoundingBoxFactor.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for MultiViewBoundingBoxFactor
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/MultiViewBoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricContext.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot3.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/JacobianFactor.h>
+
+#include <Eigen/StdVector>
+#include <boost/make_shared.hpp>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static boost::shared_ptr<Cal3_S2> calibration(
+    new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+static boost::shared_ptr<ImageBoundary> image(new ImageBoundary());
+static Key quadricKey(Symbol('q', 1));
+static SharedNoiseModel model = noiseModel::Diagonal::Sigmas(
+    Vector4(0.2, 0.3, 0.2, 0.4));
+static SharedNoiseModel robust = noiseModel::Robust::Create(
+    noiseModel::mEstimator::Huber::Create(1.0), model);
+static ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.1, 0.2, -0.1),
+                                      Point3(0.1, 0.2, 0.3),
+                                      Vector3(0.4, 0.6, 0.8));
+
+/// three detections of the same quadric, the last partially offscreen
+static Values values() {
+  Values values;
+  values.insert(quadricKey, quadric);
+  values.insert(Symbol('x', 1), Pose3(Rot3(), Point3(0.0, 0.0, -3.0)));
+  values.insert(Symbol('x', 2),
+                Pose3(Rot3::Rodrigues(0.05, -0.1, 0.02), Point3(0.5, 0, -4)));
+  values.insert(Symbol('x', 3),
+                Pose3(Rot3::Rodrigues(0.0, 0.3, 0.0), Point3(-1.5, 0, -3)));
+  return values;
+}
+
+static AlignedBox2 box(size_t i) {
+  return AlignedBox2(150.0 + 10 * i, 120.0, 420.0, 380.0 - 15 * i);
+}
+
+TEST(QuadricContextCache, Context) {
+  QuadricContextCache cache;
+  const QuadricContext& context = cache.context(quadric);
+  EXPECT(&context == &cache.context(quadric));
+
+  QuadricContext expected(quadric, true);
+  EXPECT(assert_equal(Matrix(expected.Q()), Matrix(context.Q())));
+  EXPECT(assert_equal(Matrix(expected.Qinv()), Matrix(context.Qinv())));
+  EXPECT(assert_equal(Matrix(expected.dQ_dq()), Matrix(context.dQ_dq())));
+
+  // a changed quadric is computed again
+  ConstrainedDualQuadric moved(quadric.pose(), Vector3(0.4, 0.6, 0.9));
+  const QuadricContext& other = cache.context(moved);
+  EXPECT(assert_equal(moved, other.quadric()));
+  EXPECT(assert_equal(Matrix(QuadricContext(moved, true).dQ_dq()), Matrix(other.dQ_dq())));
+
+  // caches sharing a slot of the thread recompute rather than mix contexts
+  vector<boost::shared_ptr<QuadricContextCache> > caches;
+  for (size_t i = 0; i < 2 * QuadricContextCache::SLOTS; i++) {
+    caches.push_back(boost::make_shared<QuadricContextCache>());
+  }
+  for (size_t i = 0; i < caches.size(); i++) {
+    ConstrainedDualQuadric q(quadric.pose(), Vector3(0.4, 0.6, 0.5 + 0.001 * i));
+    EXPECT(assert_equal(q, caches[i]->context(q).quadric()));
+  }
+}
+
+TEST(MultiViewBoundingBoxFactor, Create) {
+  AlignedBox2Vector measured{box(0), box(1)};
+  KeyVector poseKeys{Symbol('x', 1), Symbol('x', 2)};
+  NonlinearFactorGraph graph = MultiViewBoundingBoxFactor::create(
+      measured, calibration, image, poseKeys, quadricKey, model);
+  LONGS_EQUAL(2, graph.size());
+
+  boost::shared_ptr<MultiViewBoundingBoxFactor> first =
+      boost::dynamic_pointer_cast<MultiViewBoundingBoxFactor>(graph[0]);
+  boost::shared_ptr<MultiViewBoundingBoxFactor> second =
+      boost::dynamic_pointer_cast<MultiViewBoundingBoxFactor>(graph[1]);
+  CHECK(first && second);
+  EXPECT(first->keys() == KeyVector({Symbol('x', 1), quadricKey}));
+  EXPECT(second->keys() == KeyVector({Symbol('x', 2), quadricKey}));
+  EXPECT(assert_equal(box(1), second->measurement()));
+  EXPECT(first->cache() == second->cache());
+
+  // a clone shares the cache of its landmark
+  boost::shared_ptr<MultiViewBoundingBoxFactor> copy =
+      boost::dynamic_pointer_cast<MultiViewBoundingBoxFactor>(first->clone());
+  CHECK(copy);
+  EXPECT(assert_equal(*first, *copy));
+  EXPECT(copy->cache() == first->cache());
+  EXPECT(!first->equals(*second));
+
+  CHECK_EXCEPTION(MultiViewBoundingBoxFactor::create(measured, calibration, image,
+                      KeyVector{Symbol('x', 1)}, quadricKey, model),
+                  std::invalid_argument);
+  CHECK_EXCEPTION(MultiViewBoundingBoxFactor::create(measured, calibration, image,
+                      KeyVector{Symbol('x', 1), Symbol('x', 1)}, quadricKey, model),
+                  std::invalid_argument);
+  CHECK_EXCEPTION(MultiViewBoundingBoxFactor(box(0), calibration, image,
+                      Symbol('x', 1), quadricKey, model,
+                      boost::shared_ptr<QuadricContextCache>()),
+                  std::invalid_argument);
+}
+
+TEST(MultiViewBoundingBoxFactor, MatchesBoundingBoxFactors) {
+  Values x = values();
+  for (auto errorType : {BoundingBoxFactor::STANDARD,
+                         BoundingBoxFactor::TRUNCATED}) {
+    boost::shared_ptr<QuadricContextCache> cache(new QuadricContextCache());
+    NonlinearFactorGraph views, singles;
+    for (size_t i = 0; i < 3; i++) {
+      SharedNoiseModel m = (i == 2) ? robust : model;
+      views.emplace_shared<MultiViewBoundingBoxFactor>(
+          box(i), calibration, image, Symbol('x', i + 1), quadricKey, m,
+          cache, errorType);
+      singles.emplace_shared<BoundingBoxFactor>(
+          box(i), calibration, image, Symbol('x', i + 1), quadricKey, m,
+          errorType);
+    }
+    EXPECT_DOUBLES_EQUAL(singles.error(x), views.error(x), 1e-9);
+
+    // one 4x15 block per detection, over its own pose and the quadric
+    GaussianFactorGraph::shared_ptr expected = singles.linearize(x);
+    GaussianFactorGraph::shared_ptr actual = views.linearize(x);
+    LONGS_EQUAL(3, actual->size());
+    for (size_t i = 0; i < 3; i++) {
+      JacobianFactor::shared_ptr jacobian =
+          boost::dynamic_pointer_cast<JacobianFactor>(actual->at(i));
+      CHECK(jacobian);
+      LONGS_EQUAL(4, jacobian->rows());
+      LONGS_EQUAL(16, jacobian->cols());
+      EXPECT(assert_equal(*expected->at(i), *actual->at(i), 1e-9));
+    }
+  }
+}
+
+TEST(MultiViewBoundingBoxFactor, ConcurrentLinearize) {
+  // many detections of two landmarks, each sharing the cache of its landmark
+  boost::shared_ptr<QuadricContextCache> caches[] = {
+      boost::make_shared<QuadricContextCache>(),
+      boost::make_shared<QuadricContextCache>()};
+  Values x = values();
+  x.insert(Symbol('q', 2), ConstrainedDualQuadric(quadric.pose(), Vector3(0.3, 0.5, 0.6)));
+  vector<MultiViewBoundingBoxFactor, Eigen::aligned_allocator<MultiViewBoundingBoxFactor> > factors;
+  for (size_t k = 0; k < 300; k++) {
+    size_t pose = k % 3, landmark = k % 2;
+    factors.push_back(MultiViewBoundingBoxFactor(box(pose), calibration, image, Symbol('x', pose + 1),
+        landmark ? Symbol('q', 2) : quadricKey, model, caches[landmark],
+        k % 5 ? BoundingBoxFactor::STANDARD : BoundingBoxFactor::TRUNCATED));
+  }
+
+  vector<boost::shared_ptr<JacobianFactor> > expected;
+  for (const MultiViewBoundingBoxFactor& factor : factors) {
+    expected.push_back(boost::dynamic_pointer_cast<JacobianFactor>(factor.linearize(x)));
+  }
+
+  // every thread linearizes every factor, results must match exactly
+  const int nrThreads = 8;
+  vector<int> mismatches(nrThreads, 0);
+  vector<std::thread> threads;
+  for (int t = 0; t < nrThreads; t++) {
+    threads.push_back(std::thread([&, t]() {
+      for (int round = 0; round < 3; round++) {
+        for (size_t k = 0; k < factors.size(); k++) {
+          size_t f = (k + t * factors.size() / nrThreads) % factors.size();
+          boost::shared_ptr<JacobianFactor> linear = boost::dynamic_pointer_cast<JacobianFactor>(factors[f].linearize(x));
+          if (!linear || !linear->equals(*expected[f], 0.0)) {
+            mismatches[t]++;
+          }
+        }
+      }
+    }));
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < nrThreads; t++) {
+    EXPECT_LONGS_EQUAL(0, mismatches[t]);
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,74 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricAngleFactor.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricAngleFactor
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/QuadricAngleFactor.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/base/Vector.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot3.h>
+#include <gtsam/inference/Symbol.h>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static Key quadricKey(Symbol('q', 1));
+static Rot3 measured(Rot3::Rodrigues(0.1, -0.2, 0.3));
+static SharedNoiseModel model = noiseModel::Isotropic::Sigma(3, 0.1);
+
+TEST(QuadricAngleFactor, Error) {
+  QuadricAngleFactor qaf(quadricKey, measured, model);
+  ConstrainedDualQuadric aligned(measured, Point3(1.0, 2.0, 3.0),
+                                 Vector3(0.5, 0.6, 0.7));
+  EXPECT(assert_equal(Vector3(0.0, 0.0, 0.0),
+                      Vector3(qaf.evaluateError(aligned)), 1e-9));
+}
+
+TEST(QuadricAngleFactor, Jacobian) {
+  QuadricAngleFactor qaf(quadricKey, measured, model);
+  ConstrainedDualQuadric quadric(Rot3::Rodrigues(-0.4, 0.5, 0.2),
+                                 Point3(1.0, 2.0, 3.0), Vector3(0.5, 0.6, 0.7));
+
+  Matrix H;
+  qaf.evaluateError(quadric, H);
+
+  auto errorFunction = [&qaf](const ConstrainedDualQuadric& q) -> Vector {
+    return qaf.evaluateError(q);
+  };
+  Matrix expectedH = numericalDerivative11<Vector, ConstrainedDualQuadric>(
+      errorFunction, quadric, 1e-6);
+  EXPECT(assert_equal(expectedH, H, 1e-6));
+}
+
+TEST(QuadricAngleFactor, Equals) {
+  QuadricAngleFactor qaf1(quadricKey, measured, model);
+  QuadricAngleFactor qaf2(Symbol('q', 1), measured, model);
+  QuadricAngleFactor qaf3(Symbol('q', 2), measured, model);
+  EXPECT(qaf1.equals(qaf2));
+  EXPECT(!qaf1.equals(qaf3));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -21,9 +21,13 @@
 
 #include <gtsam/base/TestableAssertions.h>
 #include <gtsam/base/Vector.h>
+#include <gtsam/base/numericalDerivative.h>
 #include <gtsam/geometry/Pose3.h>
 #include <gtsam/geometry/Rot3.h>
 
+#include <stdexcept>
+#include <vector>
+
 using namespace std;
 using namespace gtsam_quadrics;
 
@@ -40,6 +44,129 @@ TEST(QuadricCamera, ProjectQuadric) {
   EXPECT(assert_equal(conic1, C));
 }
 
+TEST(QuadricCamera, ProjectJacobians) {
+  Pose3 cameraPose(Rot3::Rodrigues(0.1,-0.2,0.05), Point3(0.3,-0.1,-5));
+  boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,520.0,0.5,320.0,240.0));
+  ConstrainedDualQuadric Q(Rot3::Rodrigues(0.4,0.1,-0.3), Point3(0.2,0.1,0.3), Vector3(0.5,0.8,1.1));
+
+  std::function<Vector(const Pose3&, const ConstrainedDualQuadric&)> f = 
+    [&K](const Pose3& x, const ConstrainedDualQuadric& q) -> Vector {
+      Matrix33 C = QuadricCamera::project(q, x, K).matrix();
+      return Eigen::Map<const Vector>(C.data(), 9);
+    };
+  Matrix expected_dC_dx = numericalDerivative21<Vector, Pose3, ConstrainedDualQuadric>(f, cameraPose, Q, 1e-6);
+  Matrix expected_dC_dq = numericalDerivative22<Vector, Pose3, ConstrainedDualQuadric>(f, cameraPose, Q, 1e-6);
+
+  Eigen::Matrix<double, 9, 9> dC_dq;
+  Eigen::Matrix<double, 9, 6> dC_dx;
+  QuadricCamera::project(Q, cameraPose, K, dC_dq, dC_dx);
+  EXPECT(assert_equal(expected_dC_dx, Matrix(dC_dx), 1e-2));
+  EXPECT(assert_equal(expected_dC_dq, Matrix(dC_dq), 1e-2));
+}
+
+TEST(QuadricCamera, TryProject) {
+  boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+  ConstrainedDualQuadric Q;
+  DualConic C;
+
+  Pose3 visiblePose(Rot3(), Point3(0,0,-5));
+  EXPECT(QuadricCamera::tryProject(Q, visiblePose, K, C) == ProjectionStatus::SUCCESS);
+  EXPECT(assert_equal(conic1, C));
+
+  Pose3 behindPose(Rot3(), Point3(0,0,5));
+  EXPECT(QuadricCamera::tryProject(Q, behindPose, K, C) == ProjectionStatus::BEHIND_CAMERA);
+
+  Pose3 insidePose(Rot3(), Point3(0,0,-0.5));
+  EXPECT(QuadricCamera::tryProject(Q, insidePose, K, C) == ProjectionStatus::CAMERA_INSIDE);
+
+  // the quadric crosses the camera plane and projects to a hyperbola
+  Pose3 besidePose(Rot3(), Point3(2,0,-0.1));
+  EXPECT(QuadricCamera::tryProject(Q, besidePose, K, C) == ProjectionStatus::NON_ELLIPSE);
+}
+
+TEST(QuadricCamera, CheckVisible) {
+  boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+  ImageBoundary image(640.0, 480.0);
+  ConstrainedDualQuadric Q;
+
+  EXPECT(QuadricCamera::checkVisible(Q, Pose3(Rot3(), Point3(0,0,-5)), K) == QuadricCamera::VISIBLE);
+  EXPECT(QuadricCamera::checkVisible(Q, Pose3(Rot3(), Point3(0,0,5)), K) == QuadricCamera::HIDDEN);
+  EXPECT(QuadricCamera::checkVisible(Q, Pose3(Rot3(), Point3(2,0,-0.1)), K) == QuadricCamera::UNDECIDED);
+
+  // against the image the bounds of the corners are inside, crossing or outside
+  EXPECT(QuadricCamera::checkVisible(Q, Pose3(Rot3(), Point3(0,0,-5)), K, &image) == QuadricCamera::VISIBLE);
+  EXPECT(QuadricCamera::checkVisible(Q, Pose3(Rot3(), Point3(0,0,-3)), K, &image) == QuadricCamera::UNDECIDED);
+  EXPECT(QuadricCamera::checkVisible(Q, Pose3(Rot3(), Point3(10,0,-3)), K, &image) == QuadricCamera::HIDDEN);
+}
+
+TEST(QuadricCamera, ProjectUncertain) {
+  Pose3 cameraPose(Rot3::Rodrigues(0.1,-0.2,0.05), Point3(0.3,-0.1,-5));
+  boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+  ConstrainedDualQuadric Q(Rot3::Rodrigues(0.1,0.2,0.3), Point3(0.2,-0.1,0.3), Vector3(0.3,0.4,0.5));
+  Matrix covariance = Vector9(1e-4,2e-4,1e-4,1e-3,1e-3,2e-3,1e-4,1e-4,1e-4).asDiagonal();
+  Matrix poseCovariance = Matrix::Identity(6,6) * 1e-4;
+
+  // the covariance of the bounds is propagated through their jacobians
+  std::function<Vector(const Pose3&, const ConstrainedDualQuadric&)> f =
+    [&K](const Pose3& x, const ConstrainedDualQuadric& q) -> Vector {
+      return QuadricCamera::project(q, x, K).bounds().vector();
+    };
+  Matrix db_dx = numericalDerivative21<Vector, Pose3, ConstrainedDualQuadric>(f, cameraPose, Q, 1e-6);
+  Matrix db_dq = numericalDerivative22<Vector, Pose3, ConstrainedDualQuadric>(f, cameraPose, Q, 1e-6);
+  AlignedBox2 bounds;
+  Matrix boundsCovariance;
+  CHECK(QuadricCamera::tryProjectUncertain(Q, covariance, cameraPose, K, bounds, boundsCovariance) == ProjectionStatus::SUCCESS);
+  EXPECT(assert_equal(QuadricCamera::project(Q, cameraPose, K).bounds(), bounds));
+  EXPECT(assert_equal(Matrix(db_dq * covariance * db_dq.transpose()), boundsCovariance, 1e-3));
+  CHECK(QuadricCamera::tryProjectUncertain(Q, covariance, cameraPose, K, bounds, boundsCovariance, poseCovariance) == ProjectionStatus::SUCCESS);
+  EXPECT(assert_equal(Matrix(db_dq * covariance * db_dq.transpose() + db_dx * poseCovariance * db_dx.transpose()), boundsCovariance, 1e-3));
+  CHECK_EXCEPTION(QuadricCamera::tryProjectUncertain(Q, poseCovariance, cameraPose, K, bounds, boundsCovariance), std::invalid_argument);
+  EXPECT(QuadricCamera::tryProjectUncertain(Q, covariance, Pose3(Rot3(), Point3(0,0,5)), K, bounds, boundsCovariance) == ProjectionStatus::BEHIND_CAMERA);
+
+  // each side grows outwards by its standard deviations
+  Matrix44 sides = Vector4(1.0, 4.0, 9.0, 16.0).asDiagonal();
+  EXPECT(assert_equal(AlignedBox2(8.0,16.0,36.0,48.0), QuadricCamera::inflate(AlignedBox2(10.0,20.0,30.0,40.0), sides, 2.0)));
+
+  std::vector<ConstrainedDualQuadric> quadrics = {Q, ConstrainedDualQuadric(Rot3(), Point3(0,0,-6), Vector3(0.3,0.4,0.5))};
+  AlignedBox2Vector inflated;
+  std::vector<ProjectionStatus> status = QuadricCamera::projectUncertainBatch(quadrics, {covariance, covariance}, cameraPose, K, 3.0, inflated);
+  LONGS_EQUAL(2, inflated.size());
+  EXPECT(status[0] == ProjectionStatus::SUCCESS);
+  EXPECT(status[1] == ProjectionStatus::BEHIND_CAMERA);
+  QuadricCamera::tryProjectUncertain(Q, covariance, cameraPose, K, bounds, boundsCovariance);
+  EXPECT(assert_equal(QuadricCamera::inflate(bounds, boundsCovariance, 3.0), inflated[0]));
+}
+
+TEST(QuadricCamera, ProjectBatch) {
+  boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,520.0,0.5,320.0,240.0));
+  Pose3 pose(Rot3::Rodrigues(0.1,-0.2,0.05), Point3(0.3,-0.1,-5.0));
+
+  // visible, behind, containing and hyperbolic quadrics
+  std::vector<ConstrainedDualQuadric> quadrics;
+  for (int i = 0; i < 20; i++) {
+    quadrics.push_back(ConstrainedDualQuadric(Rot3::Rodrigues(0.1*i,-0.05*i,0.2),
+      Point3(0.3*(i%5)-0.6, 0.2*(i%3)-0.2, 0.5*(i%4)), Vector3(0.3+0.05*i,0.5,0.4)));
+  }
+  quadrics.push_back(ConstrainedDualQuadric(Rot3(), Point3(0.3,-0.1,-10.0), Vector3(1,1,1)));
+  quadrics.push_back(ConstrainedDualQuadric(Rot3(), Point3(0.3,-0.1,-4.9), Vector3(1,1,1)));
+  quadrics.push_back(ConstrainedDualQuadric(Rot3(), Point3(2.0,-0.1,-4.5), Vector3(1,1,1)));
+
+  BatchProjection projections = QuadricCamera::projectBatch(quadrics, pose, K);
+  LONGS_EQUAL(quadrics.size(), projections.size());
+  for (size_t i = 0; i < quadrics.size(); i++) {
+    DualConic expected;
+    ProjectionStatus status = QuadricCamera::tryProject(quadrics[i], pose, K, expected);
+    EXPECT(status == projections.status[i]);
+    if (status == ProjectionStatus::SUCCESS) {
+      EXPECT(assert_equal(expected.matrix(), projections.conic(i).matrix(), 1e-6));
+      EXPECT(assert_equal(expected.bounds(), projections.bounds(i), 1e-6));
+    }
+  }
+  EXPECT(projections.status[20] == ProjectionStatus::BEHIND_CAMERA);
+  EXPECT(projections.status[21] == ProjectionStatus::CAMERA_INSIDE);
+  EXPECT(projections.status[22] == ProjectionStatus::NON_ELLIPSE);
+}
+
 /* ************************************************************************* */
 int main() {
   TestResult tr;
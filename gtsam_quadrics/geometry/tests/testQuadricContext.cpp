@@ -0,0 +1,84 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricContext.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricContext
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricContext.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/base/Vector.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot3.h>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.4, 0.1, -0.3),
+                                            Point3(0.2, 0.1, 0.3),
+                                            Vector3(0.5, 0.8, 1.1));
+
+TEST(QuadricContext, Matrices) {
+  QuadricContext context(quadric);
+  Eigen::Matrix<double, 16, 9> expected_dQ_dq;
+  Matrix44 expectedQ = quadric.matrix(expected_dQ_dq);
+
+  EXPECT(assert_equal(expectedQ, context.Q()));
+  EXPECT(assert_equal(Matrix44(expectedQ.inverse()), context.Qinv(), 1e-9));
+  EXPECT(assert_equal(expected_dQ_dq, context.dQ_dq()));
+
+  QuadricContext jacobianContext(quadric, true);
+  EXPECT(assert_equal(expected_dQ_dq, jacobianContext.dQ_dq()));
+}
+
+TEST(QuadricContext, Contains) {
+  QuadricContext context(quadric);
+  Pose3 inside(Rot3(), Point3(0.25, 0.1, 0.3));
+  Pose3 outside(Rot3(), Point3(0.2, 0.1, -5.0));
+  EXPECT(context.contains(inside) == quadric.contains(inside));
+  EXPECT(context.contains(outside) == quadric.contains(outside));
+  EXPECT(context.isBehind(outside) == quadric.isBehind(outside));
+}
+
+TEST(QuadricContext, Project) {
+  boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0, 520.0, 0.5, 320.0, 240.0));
+  Pose3 pose(Rot3::Rodrigues(0.1, -0.2, 0.05), Point3(0.3, -0.1, -5.0));
+
+  Eigen::Matrix<double, 9, 9> expected_dC_dq, dC_dq;
+  Eigen::Matrix<double, 9, 6> expected_dC_dx, dC_dx;
+  DualConic expected =
+      QuadricCamera::project(quadric, pose, K, expected_dC_dq, expected_dC_dx);
+
+  QuadricContext context(quadric, true);
+  DualConic actual = QuadricCamera::project(context, pose, K, dC_dq, dC_dx);
+  EXPECT(assert_equal(expected, actual));
+  EXPECT(assert_equal(expected_dC_dq, dC_dq));
+  EXPECT(assert_equal(expected_dC_dx, dC_dx));
+
+  DualConic tried;
+  EXPECT(QuadricCamera::tryProject(context, pose, K, tried) ==
+         ProjectionStatus::SUCCESS);
+  EXPECT(assert_equal(expected, tried));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
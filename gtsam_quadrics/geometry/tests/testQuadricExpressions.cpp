@@ -0,0 +1,103 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricExpressions.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for the quadric expressions
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricExpressions.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/JacobianFactor.h>
+#include <gtsam/nonlinear/ExpressionFactor.h>
+#include <gtsam/nonlinear/expressionTesting.h>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> calibration(new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+static const boost::shared_ptr<ImageBoundary> image(new ImageBoundary());
+static const SharedNoiseModel model = noiseModel::Diagonal::Sigmas(Vector4(0.2,0.3,0.2,0.3));
+static const Key poseKey(Symbol('x', 1));
+static const Key quadricKey(Symbol('q', 1));
+static const Pose3 cameraPose(Rot3::Rodrigues(0.05,-0.1,0.02), Point3(0.1,-0.2,-3.0));
+
+/// a quadric inside the image, and one crossing its right border
+static const ConstrainedDualQuadric inside(Rot3::Rodrigues(0.3,-0.2,0.5), Point3(0.2,0.1,0.3), Vector3(0.4,0.6,0.5));
+static const ConstrainedDualQuadric border(Rot3::Rodrigues(-0.2,0.4,0.1), Point3(1.6,0.0,0.2), Vector3(0.5,0.6,0.7));
+
+static Values values(const ConstrainedDualQuadric& quadric) {
+  Values values;
+  values.insert(poseKey, cameraPose);
+  values.insert(quadricKey, quadric);
+  return values;
+}
+
+TEST(QuadricExpressions, Values) {
+  Pose3_ pose(poseKey);
+  ConstrainedDualQuadric_ quadric(quadricKey);
+  Values v = values(inside);
+
+  EXPECT(assert_equal(inside.matrix(), quadricMatrix(quadric).value(v)));
+  DualConic dualConic = QuadricCamera::project(inside, cameraPose, calibration);
+  Matrix33 C = project(quadric, pose, calibration).value(v);
+  EXPECT(assert_equal(dualConic.matrix(), C));
+  EXPECT(assert_equal(dualConic.bounds().vector(), bounds(Matrix33_(C)).value(v)));
+  EXPECT(assert_equal(dualConic.smartBounds(*image).vector(), smartBounds(Matrix33_(C), image).value(v)));
+}
+
+TEST(QuadricExpressions, Jacobians) {
+  Pose3_ pose(poseKey);
+  ConstrainedDualQuadric_ quadric(quadricKey);
+
+  EXPECT_CORRECT_EXPRESSION_JACOBIANS(quadricMatrix(quadric), values(inside), 1e-6, 1e-5);
+  EXPECT_CORRECT_EXPRESSION_JACOBIANS(project(quadric, pose, calibration), values(inside), 1e-6, 1e-5);
+  EXPECT_CORRECT_EXPRESSION_JACOBIANS(bounds(project(quadric, pose, calibration)), values(inside), 1e-6, 1e-5);
+  EXPECT_CORRECT_EXPRESSION_JACOBIANS(smartBounds(project(quadric, pose, calibration), image), values(border), 1e-6, 1e-5);
+}
+
+TEST(QuadricExpressions, MatchesBoundingBoxFactor) {
+  AlignedBox2 measured(250.0, 180.0, 420.0, 330.0);
+  BoundingBoxFactor::MeasurementModel models[] = {BoundingBoxFactor::STANDARD, BoundingBoxFactor::TRUNCATED};
+  for (const BoundingBoxFactor::MeasurementModel& measurementModel : models) {
+    for (const ConstrainedDualQuadric& quadric : {inside, border}) {
+      BoundingBoxFactor bbf(measured, calibration, image, poseKey, quadricKey, model, measurementModel);
+      ExpressionFactor<Vector4> factor(model, measured.vector(),
+          predictedBounds(Pose3_(poseKey), ConstrainedDualQuadric_(quadricKey), calibration, image, measurementModel));
+
+      Values v = values(quadric);
+      EXPECT_DOUBLES_EQUAL(bbf.error(v), factor.error(v), 1e-9);
+      JacobianFactor expected = *boost::dynamic_pointer_cast<JacobianFactor>(bbf.linearize(v));
+      JacobianFactor actual = *boost::dynamic_pointer_cast<JacobianFactor>(factor.linearize(v));
+
+      // the expression factor orders its keys, so compare blocks by key
+      EXPECT(assert_equal(Vector(expected.getb()), Vector(actual.getb()), 1e-9));
+      for (const Key& key : {poseKey, quadricKey}) {
+        EXPECT(assert_equal(Matrix(expected.getA(expected.find(key))), Matrix(actual.getA(actual.find(key))), 1e-9));
+      }
+    }
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,283 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricIndex.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricIndex
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricIndex.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot3.h>
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+/// a lattice of small quadrics, keyed by their position in the lattice
+static Values lattice() {
+  Values values;
+  Key key = 0;
+  for (int x = -6; x < 6; x++) {
+    for (int y = -6; y < 6; y++) {
+      for (int z = -3; z < 3; z++) {
+        Rot3 R = Rot3::Rodrigues(0.1 * x, -0.05 * y, 0.2 * z);
+        Point3 t(1.3 * x, 1.1 * y, 1.7 * z);
+        Vector3 radii(0.2 + 0.05 * (key % 4), 0.3, 0.25 + 0.1 * (key % 3));
+        values.insert(key++, ConstrainedDualQuadric(R, t, radii));
+      }
+    }
+  }
+  return values;
+}
+
+static QuadricIndex indexValues(const Values& values, double cellSize) {
+  QuadricIndex index(cellSize);
+  for (const Key& key : values.keys()) {
+    index.update(key, values.at<ConstrainedDualQuadric>(key));
+  }
+  return index;
+}
+
+static KeyVector sorted(KeyVector keys) {
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+TEST(QuadricIndex, UpdateAndRemove) {
+  QuadricIndex index(0.5);
+  ConstrainedDualQuadric quadric(Rot3(), Point3(0.1, 0.2, 0.3),
+                                 Vector3(0.4, 0.6, 1.2));
+  index.update(7, quadric);
+  EXPECT(index.exists(7));
+  EXPECT_LONGS_EQUAL(1, index.size());
+  EXPECT(assert_equal(quadric.bounds(), index.bounds(7)));
+  EXPECT_LONGS_EQUAL(3 * 3 * 6, index.nrCells());
+
+  // moving keeps a single entry
+  index.update(7, AlignedBox3(5.1, 5.2, 5.1, 5.2, 5.1, 5.2));
+  EXPECT_LONGS_EQUAL(1, index.size());
+  EXPECT_LONGS_EQUAL(1, index.nrCells());
+  EXPECT(index.intersecting(quadric.bounds()).empty());
+
+  EXPECT(index.remove(7));
+  EXPECT(!index.remove(7));
+  EXPECT_LONGS_EQUAL(0, index.size());
+  EXPECT_LONGS_EQUAL(0, index.nrCells());
+  CHECK_EXCEPTION(index.bounds(7), std::out_of_range);
+  CHECK_EXCEPTION(QuadricIndex(0.0), std::invalid_argument);
+}
+
+TEST(QuadricIndex, LargeQuadrics) {
+  // a diverged landmark would cover ~1e12 cells of 0.1m
+  QuadricIndex index(0.1, 64);
+  ConstrainedDualQuadric huge(Rot3(), Point3(5.0, 0.0, 0.0),
+                              Vector3(1e3, 1e3, 1e3));
+  ConstrainedDualQuadric small(Rot3(), Point3(0.05, 0.05, 0.05),
+                               Vector3(0.04, 0.04, 0.04));
+  index.update(1, huge);
+  index.update(2, small);
+  EXPECT_LONGS_EQUAL(2, index.size());
+  EXPECT_LONGS_EQUAL(1, index.nrLarge());
+  EXPECT_LONGS_EQUAL(1, index.nrCells());
+
+  // large landmarks are still found by every query, once
+  EXPECT(sorted(index.intersecting(AlignedBox3(-0.05, 0.05, -0.05, 0.05,
+                                               -0.05, 0.05))) ==
+         KeyVector({1, 2}));
+  EXPECT(index.intersecting(AlignedBox3(2e3, 2e3 + 1, 0, 1, 0, 1)).empty());
+  EXPECT(sorted(index.near(Point3(300.0, 0.0, 0.0), 1.0)) == KeyVector({1}));
+  boost::shared_ptr<Cal3_S2> calibration(
+      new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+  KeyVector visible = index.visible(Pose3(Rot3(), Point3(0.0, 0.0, -5.0)),
+                                    calibration, ImageBoundary(), 10.0);
+  EXPECT(sorted(visible) == KeyVector({1, 2}));
+  index.update(3, AlignedBox3(-900.0, 900.0, -900.0, 900.0, -900.0, 900.0));
+  EXPECT(index.overlapping(0.5) ==
+         (vector<pair<Key, Key> >{make_pair(Key(1), Key(3))}));
+
+  // shrinking moves a landmark into the grid and back out
+  index.update(1, small);
+  EXPECT_LONGS_EQUAL(1, index.nrLarge());
+  EXPECT_LONGS_EQUAL(1, index.nrCells());
+  index.update(1, huge);
+  EXPECT_LONGS_EQUAL(2, index.nrLarge());
+  EXPECT(index.remove(1));
+  EXPECT(index.remove(3));
+  EXPECT_LONGS_EQUAL(0, index.nrLarge());
+  EXPECT(index.intersecting(huge.bounds()) == KeyVector({2}));
+
+  // degenerate bounds are never returned
+  double nan = std::numeric_limits<double>::quiet_NaN();
+  index.update(4, AlignedBox3(nan, nan, 0.0, 1.0, 0.0, 1.0));
+  EXPECT_LONGS_EQUAL(1, index.nrLarge());
+  EXPECT(index.intersecting(huge.bounds()) == KeyVector({2}));
+  CHECK_EXCEPTION(QuadricIndex(1.0, 0), std::invalid_argument);
+}
+
+TEST(QuadricIndex, MatchesLinearScan) {
+  Values values = lattice();
+  vector<AlignedBox3> queries;
+  queries.push_back(AlignedBox3(-1.0, 1.0, -1.0, 1.0, -1.0, 1.0));
+  queries.push_back(AlignedBox3(-20.0, 20.0, -20.0, 20.0, -20.0, 20.0));
+  queries.push_back(AlignedBox3(2.3, 2.4, -3.0, 4.0, -0.1, 0.1));
+  queries.push_back(AlignedBox3(50.0, 51.0, 0.0, 1.0, 0.0, 1.0));
+  Point3 point(0.7, -1.9, 0.4);
+  double radius = 2.5;
+
+  // dense and sparse traversal of the grid
+  for (double cellSize : {0.3, 1.0, 100.0}) {
+    QuadricIndex index = indexValues(values, cellSize);
+    EXPECT_LONGS_EQUAL(values.size(), index.size());
+
+    for (const AlignedBox3& query : queries) {
+      KeyVector expected;
+      for (const Key& key : values.keys()) {
+        AlignedBox3 b = values.at<ConstrainedDualQuadric>(key).bounds();
+        if (b.xmin() <= query.xmax() && b.xmax() >= query.xmin() &&
+            b.ymin() <= query.ymax() && b.ymax() >= query.ymin() &&
+            b.zmin() <= query.zmax() && b.zmax() >= query.zmin()) {
+          expected.push_back(key);
+        }
+      }
+      EXPECT(sorted(index.intersecting(query)) == expected);
+    }
+
+    KeyVector expected;
+    for (const Key& key : values.keys()) {
+      AlignedBox3 b = values.at<ConstrainedDualQuadric>(key).bounds();
+      Vector3 closest = Vector3(point)
+                            .cwiseMax(Vector3(b.xmin(), b.ymin(), b.zmin()))
+                            .cwiseMin(Vector3(b.xmax(), b.ymax(), b.zmax()));
+      if ((closest - point).norm() <= radius) {
+        expected.push_back(key);
+      }
+    }
+    EXPECT(!expected.empty());
+    EXPECT(sorted(index.near(point, radius)) == expected);
+  }
+}
+
+TEST(QuadricIndex, Overlapping) {
+  // every fifth landmark is duplicated with a small offset
+  Values values = lattice();
+  const size_t n = values.size();
+  for (Key key = 0; key < n; key += 5) {
+    ConstrainedDualQuadric q = values.at<ConstrainedDualQuadric>(key);
+    Pose3 pose = q.pose().compose(Pose3(Rot3(), Point3(0.02, -0.03, 0.01)));
+    values.insert(key + n, ConstrainedDualQuadric(pose, q.radii()));
+  }
+  QuadricIndex index = indexValues(values, 0.7);
+
+  std::vector<std::pair<Key, Key> > expected;
+  KeyVector keys = values.keys();
+  for (size_t i = 0; i < keys.size(); i++) {
+    for (size_t j = 0; j < keys.size(); j++) {
+      AlignedBox3 a = values.at<ConstrainedDualQuadric>(keys[i]).bounds();
+      AlignedBox3 b = values.at<ConstrainedDualQuadric>(keys[j]).bounds();
+      if (keys[i] < keys[j] && a.iou(b) >= 0.5) {
+        expected.push_back(std::make_pair(keys[i], keys[j]));
+      }
+    }
+  }
+  std::sort(expected.begin(), expected.end());
+
+  EXPECT_LONGS_EQUAL((n + 4) / 5, expected.size());
+  EXPECT(expected == index.overlapping(0.5));
+  EXPECT(expected == index.overlapping(0.5, 4));
+}
+
+TEST(QuadricIndex, UpdateValues) {
+  Values values = lattice();
+  QuadricIndex index = indexValues(values, 1.0);
+
+  // shift every estimate, as after an optimization step
+  Values updated;
+  for (const Key& key : values.keys()) {
+    ConstrainedDualQuadric q = values.at<ConstrainedDualQuadric>(key);
+    Pose3 pose = q.pose().compose(Pose3(Rot3(), Point3(0.3, -0.7, 0.2)));
+    updated.insert(key, ConstrainedDualQuadric(pose, q.radii()));
+  }
+  index.update(updated);
+
+  for (const Key& key : values.keys()) {
+    EXPECT(assert_equal(updated.at<ConstrainedDualQuadric>(key).bounds(),
+                        index.bounds(key)));
+  }
+  QuadricIndex expected = indexValues(updated, 1.0);
+  EXPECT_LONGS_EQUAL(expected.nrCells(), index.nrCells());
+}
+
+TEST(QuadricIndex, Visible) {
+  Values values = lattice();
+  boost::shared_ptr<Cal3_S2> calibration(
+      new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+  ImageBoundary image;
+  double maxDepth = 8.0;
+
+  vector<Pose3> poses;
+  poses.push_back(Pose3(Rot3(), Point3(0.0, 0.0, -6.0)));
+  poses.push_back(
+      Pose3(Rot3::Rodrigues(0.3, -1.2, 0.1), Point3(2.0, 1.0, 0.5)));
+  poses.push_back(
+      Pose3(Rot3::Rodrigues(2.0, 0.4, -0.3), Point3(-3.0, 4.0, 1.0)));
+
+  for (double cellSize : {0.5, 2.0}) {
+    QuadricIndex index = indexValues(values, cellSize);
+    for (const Pose3& pose : poses) {
+      KeyVector visible = sorted(index.visible(pose, calibration, image,
+                                               maxDepth));
+      EXPECT(std::adjacent_find(visible.begin(), visible.end()) ==
+             visible.end());
+
+      size_t nrVisible = 0;
+      for (const Key& key : values.keys()) {
+        const ConstrainedDualQuadric& q =
+            values.at<ConstrainedDualQuadric>(key);
+        double depth = pose.transformTo(q.centroid()).z();
+        bool found = std::binary_search(visible.begin(), visible.end(), key);
+
+        // everything projecting inside the image within range is kept
+        DualConic conic;
+        if (depth < maxDepth - 2.0 &&
+            QuadricCamera::tryProject(q, pose, calibration, conic) ==
+                ProjectionStatus::SUCCESS &&
+            image.bounds().contains(conic.bounds())) {
+          EXPECT(found);
+          nrVisible++;
+        }
+
+        // everything behind the camera or beyond range is culled
+        if (depth < -2.0 || depth > maxDepth + 2.0) {
+          EXPECT(!found);
+        }
+      }
+      EXPECT(nrVisible > 0);
+      EXPECT(visible.size() < values.size());
+    }
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,136 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricInitializer.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricInitializer
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricInitializer.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot3.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+
+/// cameras on an arc looking at the target from the given distance
+static std::vector<Pose3> arc(const Point3& target, size_t n, double distance) {
+  std::vector<Pose3> poses;
+  for (size_t i = 0; i < n; i++) {
+    double angle = 0.3 * i;
+    Point3 eye = target + Point3(distance*sin(angle), 0.5, -distance*cos(angle));
+    poses.push_back(PinholeCamera<Cal3_S2>::Lookat(eye, target, Point3(0,-1,0), *K).pose());
+  }
+  return poses;
+}
+
+/// the simple bounds of the quadric in each view
+static AlignedBox2Vector boxes(const ConstrainedDualQuadric& quadric, const std::vector<Pose3>& poses) {
+  AlignedBox2Vector boxes;
+  for (const Pose3& pose : poses) {
+    boxes.push_back(QuadricCamera::project(quadric, pose, K).bounds());
+  }
+  return boxes;
+}
+
+TEST(QuadricInitializer, ExactBoxes) {
+  // far from the origin, the solve is conditioned about the cameras
+  ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.3,-0.2,0.5), Point3(50.0,-20.0,30.0), Vector3(0.4,0.6,0.9));
+  std::vector<Pose3> poses = arc(quadric.pose().translation(), 5, 6.0);
+
+  ConstrainedDualQuadric actual;
+  QuadricInitializer::Status status = QuadricInitializer::tryInitialize(poses, boxes(quadric, poses), K, actual);
+  EXPECT(status == QuadricInitializer::SUCCESS);
+  EXPECT(assert_equal(quadric.normalizedMatrix(), actual.normalizedMatrix(), 1e-5));
+  EXPECT(assert_equal(quadric.matrix(), QuadricInitializer::initialize(poses, boxes(quadric, poses), K).matrix(), 1e-5));
+}
+
+TEST(QuadricInitializer, NoisyBoxes) {
+  ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.1,0.4,-0.2), Point3(1.0,0.5,2.0), Vector3(0.3,0.5,0.4));
+  std::vector<Pose3> poses = arc(quadric.pose().translation(), 8, 4.0);
+  AlignedBox2Vector noisy = boxes(quadric, poses);
+  for (size_t i = 0; i < noisy.size(); i++) {
+    double offset = (i % 2 ? 1.0 : -1.0);
+    noisy[i] = AlignedBox2(noisy[i].vector() + Vector4(offset, -offset, -offset, offset));
+  }
+
+  ConstrainedDualQuadric actual;
+  EXPECT(QuadricInitializer::tryInitialize(poses, noisy, K, actual) == QuadricInitializer::SUCCESS);
+  EXPECT(assert_equal(quadric.pose().translation(), actual.pose().translation(), 0.05));
+  EXPECT(assert_equal(quadric.bounds().vector(), actual.bounds().vector(), 0.1));
+}
+
+TEST(QuadricInitializer, Batch) {
+  ConstrainedDualQuadric q0(Rot3(), Point3(0.0,0.0,0.0), Vector3(0.3,0.4,0.5));
+  ConstrainedDualQuadric q1(Rot3::Rodrigues(0.0,0.3,0.0), Point3(0.6,-0.2,0.4), Vector3(0.2,0.2,0.3));
+  std::vector<Pose3> poses = arc(Point3(0.3,-0.1,0.2), 6, 5.0);
+
+  std::vector<QuadricInitializer::Track> tracks(3);
+  AlignedBox2Vector boxes0 = boxes(q0, poses), boxes1 = boxes(q1, poses);
+  for (size_t i = 0; i < poses.size(); i++) {
+    tracks[0].poses.push_back(i);
+    tracks[0].boxes.push_back(boxes0[i]);
+    if (i % 2 == 0) {
+      tracks[1].poses.push_back(i);
+      tracks[1].boxes.push_back(boxes1[i]);
+    }
+  }
+  // two views constrain 8 of the 9 degrees of freedom
+  tracks[2].poses = {0, 1};
+  tracks[2].boxes = {boxes0[0], boxes0[1]};
+
+  std::vector<ConstrainedDualQuadric> quadrics;
+  std::vector<QuadricInitializer::Status> status = QuadricInitializer::initializeBatch(poses, tracks, K, quadrics);
+  LONGS_EQUAL(3, quadrics.size());
+  EXPECT(status[0] == QuadricInitializer::SUCCESS);
+  EXPECT(status[1] == QuadricInitializer::SUCCESS);
+  EXPECT(status[2] == QuadricInitializer::TOO_FEW_PLANES);
+  EXPECT(assert_equal(q0.normalizedMatrix(), quadrics[0].normalizedMatrix(), 1e-6));
+  EXPECT(assert_equal(q1.normalizedMatrix(), quadrics[1].normalizedMatrix(), 1e-6));
+
+  CHECK_EXCEPTION(QuadricInitializer::initialize({poses[0], poses[1]}, tracks[2].boxes, K), std::runtime_error);
+  CHECK_EXCEPTION(QuadricInitializer::initialize(poses, tracks[2].boxes, K), std::invalid_argument);
+}
+
+TEST(QuadricInitializer, Solve) {
+  // the planes tangent to a sphere of radius 2 at the origin
+  std::vector<Vector4> planes;
+  for (int i = 0; i < 12; i++) {
+    double z = 1.0 - (i + 0.5) / 6.0, angle = 2.4*i;
+    Vector3 normal(sqrt(1.0-z*z)*cos(angle), sqrt(1.0-z*z)*sin(angle), z);
+    planes.push_back((Vector4() << normal, -2.0).finished());
+  }
+  Matrix4 expected = ConstrainedDualQuadric(Pose3(), Vector3(2,2,2)).matrix();
+  Matrix4 actual = QuadricInitializer::solve(planes);
+  actual *= expected(3,3) / actual(3,3);
+  EXPECT(assert_equal(expected, actual, 1e-9));
+  CHECK_EXCEPTION(QuadricInitializer::solve(std::vector<Vector4>(8, Vector4::Zero())), std::invalid_argument);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
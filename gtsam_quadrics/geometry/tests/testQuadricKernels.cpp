@@ -0,0 +1,147 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricKernels.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for the scalar templated quadric kernels
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricKernels.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/geometry/Rot3.h>
+
+#include <unsupported/Eigen/AutoDiff>
+
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const Pose3 cameraPose(Rot3::Rodrigues(0.1,-0.2,0.05), Point3(0.3,-0.1,-5.0));
+static const ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.4,0.1,-0.3), Point3(0.2,0.1,0.3), Vector3(0.5,0.8,1.1));
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,520.0,0.5,320.0,240.0));
+
+TEST(QuadricKernels, DoubleMatchesClasses) {
+  Matrix3 Rx = cameraPose.rotation().matrix(), Rq = quadric.pose().rotation().matrix();
+  Matrix3 calibration = kernels::calibrationMatrix(K->fx(), K->fy(), K->skew(), K->px(), K->py());
+  EXPECT(assert_equal(K->K(), calibration));
+
+  Matrix4 Q = kernels::quadricMatrix<double>(Rq, quadric.pose().translation(), quadric.radii());
+  EXPECT(assert_equal(quadric.matrix(), Q, 1e-9));
+
+  Matrix34 P = kernels::projectionMatrix<double>(calibration, Rx, cameraPose.translation());
+  EXPECT(assert_equal(QuadricCamera::transformToImage(cameraPose, K), P, 1e-9));
+
+  DualConic conic = QuadricCamera::project(quadric, cameraPose, K);
+  Matrix3 C = kernels::projectQuadric<double>(P, Q);
+  EXPECT(assert_equal(conic.matrix(), C, 1e-6));
+  EXPECT(assert_equal(conic.bounds().vector(), kernels::conicBounds<double>(C), 1e-9));
+  EXPECT(kernels::isEllipse<double>(C));
+
+  // a hyperbola, the camera is beside a quadric that is in front of it
+  ConstrainedDualQuadric beside(Rot3(), Point3(2.0,-0.1,-4.5), Vector3(1,1,1));
+  DualConic hyperbola = QuadricCamera::project(beside, cameraPose, K);
+  EXPECT(!hyperbola.isEllipse());
+  EXPECT(!kernels::isEllipse<double>(hyperbola.matrix()));
+}
+
+TEST(QuadricKernels, FloatMatchesDouble) {
+  typedef kernels::Matrix3T<float> Matrix3f;
+  typedef kernels::Vector3T<float> Vector3f;
+  Matrix3f Rx = cameraPose.rotation().matrix().cast<float>();
+  Matrix3f Rq = quadric.pose().rotation().matrix().cast<float>();
+  Vector3f tx = cameraPose.translation().cast<float>();
+  Vector3f tq = quadric.pose().translation().cast<float>();
+  Vector3f radii = quadric.radii().cast<float>();
+  Eigen::Vector4f measured(300.0f, 200.0f, 350.0f, 260.0f);
+
+  Eigen::Vector4f error = kernels::boundingBoxError<float>(Rx, tx, Rq, tq, radii, K->K().cast<float>(), measured);
+  Vector4 expected = QuadricCamera::project(quadric, cameraPose, K).bounds().vector() - measured.cast<double>();
+  EXPECT(assert_equal(expected, Vector4(error.cast<double>()), 1e-2));
+
+  // the float batch agrees with the double batch to float precision
+  std::vector<ConstrainedDualQuadric> quadrics;
+  for (int i = 0; i < 20; i++) {
+    quadrics.push_back(ConstrainedDualQuadric(Rot3::Rodrigues(0.1*i,-0.05*i,0.2),
+      Point3(0.3*(i%5)-0.6, 0.2*(i%3)-0.2, 0.5*(i%4)), Vector3(0.3+0.05*i,0.5,0.4)));
+  }
+  quadrics.push_back(ConstrainedDualQuadric(Rot3(), Point3(0.3,-0.1,-10.0), Vector3(1,1,1)));
+  quadrics.push_back(ConstrainedDualQuadric(Rot3(), Point3(0.3,-0.1,-4.9), Vector3(1,1,1)));
+  quadrics.push_back(ConstrainedDualQuadric(Rot3(), Point3(2.0,-0.1,-4.5), Vector3(1,1,1)));
+
+  BatchProjection projections = QuadricCamera::projectBatch(quadrics, cameraPose, K);
+  BatchProjectionf projectionsf;
+  QuadricCamera::projectBatch(quadrics.data(), quadrics.size(), cameraPose, K, projectionsf);
+  LONGS_EQUAL(projections.size(), projectionsf.size());
+  for (size_t i = 0; i < projections.size(); i++) {
+    EXPECT(projections.status[i] == projectionsf.status[i]);
+    if (projections.status[i] == ProjectionStatus::SUCCESS) {
+      EXPECT(assert_equal(projections.bounds(i), projectionsf.bounds(i), 5e-2));
+    }
+  }
+}
+
+TEST(QuadricKernels, AutoDiffMatchesAnalytic) {
+  // one derivative per element of the pose and quadric tangent vectors
+  typedef Eigen::AutoDiffScalar<Eigen::Matrix<double, 15, 1> > Jet;
+  typedef kernels::Matrix3T<Jet> Matrix3j;
+  typedef kernels::Vector3T<Jet> Vector3j;
+  typedef kernels::Vector4T<Jet> Vector4j;
+  Vector3j wx, vx, wq, vq, dr;
+  for (int i = 0; i < 3; i++) {
+    wx(i) = Jet(0.0, 15, i);
+    vx(i) = Jet(0.0, 15, 3 + i);
+    wq(i) = Jet(0.0, 15, 6 + i);
+    vq(i) = Jet(0.0, 15, 9 + i);
+    dr(i) = Jet(0.0, 15, 12 + i);
+  }
+
+  Matrix3j Rx, Rq;
+  Vector3j tx, tq;
+  kernels::retractFirstOrder<Jet>(cameraPose.rotation().matrix().cast<Jet>(),
+                                  cameraPose.translation().cast<Jet>(), wx, vx, Rx, tx);
+  kernels::retractFirstOrder<Jet>(quadric.pose().rotation().matrix().cast<Jet>(),
+                                  quadric.pose().translation().cast<Jet>(), wq, vq, Rq, tq);
+  Vector3j radii = quadric.radii().cast<Jet>() + dr;
+
+  AlignedBox2 measured(300.0, 200.0, 350.0, 260.0);
+  Vector4j error = kernels::boundingBoxError<Jet>(Rx, tx, Rq, tq, radii, K->K().cast<Jet>(),
+                                                  measured.vector().cast<Jet>());
+  Vector4 value;
+  Eigen::Matrix<double, 4, 15> jacobian;
+  for (int i = 0; i < 4; i++) {
+    value(i) = error(i).value();
+    jacobian.row(i) = error(i).derivatives().transpose();
+  }
+
+  BoundingBoxFactor factor(measured, K, Symbol('x', 0), Symbol('q', 0),
+                           noiseModel::Isotropic::Sigma(4, 1.0));
+  Matrix H1, H2;
+  Vector expected = factor.evaluateError(cameraPose, quadric, H1, H2);
+  EXPECT(assert_equal(expected, Vector(value), 1e-9));
+  EXPECT(assert_equal(H1, Matrix(jacobian.leftCols<6>()), 1e-6));
+  EXPECT(assert_equal(H2, Matrix(jacobian.rightCols<9>()), 1e-6));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,102 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricMapFile.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricMapFile
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/QuadricMapFile.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+
+TEST(QuadricMapFile, Landmarks) {
+  Values values;
+  values.insert(Symbol('q', 1), ConstrainedDualQuadric(Rot3::Rodrigues(0.1,-0.2,0.3), Point3(0.5,-1.0,2.0), Vector3(0.3,0.4,0.5)));
+  values.insert(Symbol('q', 7), ConstrainedDualQuadric(Rot3(), Point3(3.0,1.0,-2.0), Vector3(1.0,1.0,2.0)));
+  values.insert(Symbol('x', 0), Pose3(Rot3::Rodrigues(0.0,0.5,0.0), Point3(1.0,2.0,3.0)));
+
+  const string filename = "testQuadricMapFile_landmarks.bin";
+  QuadricMapFile::saveLandmarks(filename, values);
+  Values landmarks = QuadricMapFile::loadLandmarks(filename);
+  LONGS_EQUAL(2, landmarks.size());
+  EXPECT(assert_equal(values.at<ConstrainedDualQuadric>(Symbol('q', 1)), landmarks.at<ConstrainedDualQuadric>(Symbol('q', 1))));
+  EXPECT(assert_equal(values.at<ConstrainedDualQuadric>(Symbol('q', 7)), landmarks.at<ConstrainedDualQuadric>(Symbol('q', 7))));
+
+  // the poses are stored separately, and a file of one record type cannot be read as another
+  QuadricMapFile::savePoses(filename, values);
+  Values poses = QuadricMapFile::loadPoses(filename);
+  LONGS_EQUAL(1, poses.size());
+  EXPECT(assert_equal(values.at<Pose3>(Symbol('x', 0)), poses.at<Pose3>(Symbol('x', 0))));
+  CHECK_EXCEPTION(QuadricMapFile::loadLandmarks(filename), std::runtime_error);
+  std::remove(filename.c_str());
+  CHECK_EXCEPTION(QuadricMapFile::loadLandmarks(filename), std::runtime_error);
+}
+
+TEST(QuadricMapFile, DetectionStream) {
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 2.0);
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<BoundingBoxFactor>(AlignedBox2(10.0,20.0,100.0,120.0), K, Symbol('x',0), Symbol('q',1), model);
+  graph.emplace_shared<BoundingBoxFactor>(AlignedBox2(15.0,25.0,90.0,110.0), K, Symbol('x',0), Symbol('q',2), model);
+
+  // record two frames, the second from another camera
+  const string filename = "testQuadricMapFile_detections.bin";
+  QuadricMapFile::saveDetections(filename, graph);
+  BoundingBoxFactor factor(AlignedBox2(12.0,22.0,95.0,115.0), K, Symbol('x',1), Symbol('q',1), model);
+  {
+    QuadricMapFile::Writer<QuadricMapFile::Detection> writer(filename, true);
+    writer.write(QuadricMapFile::toRecord(factor, 1));
+  }
+
+  std::vector<QuadricMapFile::Detection> detections = QuadricMapFile::loadDetections(filename);
+  LONGS_EQUAL(3, detections.size());
+  EXPECT(Symbol('q',2) == detections[1].quadricKey);
+  LONGS_EQUAL(0, detections[1].cameraId);
+  LONGS_EQUAL(1, detections[2].cameraId);
+  EXPECT(assert_equal(AlignedBox2(15.0,25.0,90.0,110.0), QuadricMapFile::toBox(detections[1])));
+  EXPECT(assert_equal(factor, QuadricMapFile::toFactor(detections[2], K, model)));
+
+  // a view over the file in memory ignores a partial trailing record
+  std::vector<char> bytes(sizeof(QuadricMapFile::Header) + 2 * sizeof(QuadricMapFile::Detection) + 10);
+  FILE* file = std::fopen(filename.c_str(), "rb");
+  CHECK(std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size());
+  std::fclose(file);
+  std::vector<uint64_t> aligned((bytes.size() + 7) / 8);
+  std::memcpy(aligned.data(), bytes.data(), bytes.size());
+  QuadricMapFile::View<QuadricMapFile::Detection> view(aligned.data(), bytes.size());
+  LONGS_EQUAL(2, view.size());
+  EXPECT(Symbol('q',1) == view[0].quadricKey);
+  CHECK_EXCEPTION(QuadricMapFile::View<QuadricMapFile::Landmark>(aligned.data(), bytes.size()), std::runtime_error);
+  CHECK_EXCEPTION(QuadricMapFile::View<QuadricMapFile::Detection>(aligned.data(), 16), std::runtime_error);
+  std::remove(filename.c_str());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
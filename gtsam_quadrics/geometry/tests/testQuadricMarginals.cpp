@@ -0,0 +1,142 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricMarginals.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricMarginals
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricMarginals.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/nonlinear/Marginals.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+static const SharedNoiseModel boxNoise = noiseModel::Isotropic::Sigma(4, 2.0);
+
+/// adds a pose with a prior and the boxes of the quadrics it sees
+static void addPose(size_t i, const Pose3& pose, const std::vector<ConstrainedDualQuadric>& quadrics,
+                    NonlinearFactorGraph& graph, Values& values) {
+  values.insert(Symbol('x', i), pose);
+  graph.emplace_shared<PriorFactor<Pose3>>(Symbol('x', i), pose, noiseModel::Isotropic::Sigma(6, 0.01));
+  for (size_t j = 0; j < quadrics.size(); j++) {
+    AlignedBox2 box = QuadricCamera::project(quadrics[j], pose, K).bounds();
+    graph.emplace_shared<BoundingBoxFactor>(box, K, Symbol('x', i), Symbol('q', j), boxNoise);
+  }
+}
+
+TEST(QuadricMarginals, Covariance) {
+  std::vector<ConstrainedDualQuadric> quadrics = {
+    ConstrainedDualQuadric(Rot3::Rodrigues(0.1,0.2,0.0), Point3(0.0,0.0,0.0), Vector3(0.3,0.4,0.5)),
+    ConstrainedDualQuadric(Rot3(), Point3(1.0,0.5,0.5), Vector3(0.2,0.3,0.2))};
+  NonlinearFactorGraph graph;
+  Values values;
+  for (size_t j = 0; j < quadrics.size(); j++) {
+    values.insert(Symbol('q', j), quadrics[j]);
+    graph.emplace_shared<PriorFactor<ConstrainedDualQuadric>>(Symbol('q', j), quadrics[j], noiseModel::Isotropic::Sigma(9, 1.0));
+  }
+  for (size_t i = 0; i < 4; i++) {
+    addPose(i, Pose3(Rot3::Rodrigues(0.0,0.1*i,0.0), Point3(0.5*i-1.0,0.1*i,-5.0)), quadrics, graph, values);
+  }
+  ISAM2 isam;
+  isam.update(graph, values);
+
+  QuadricMarginals marginals;
+  Marginals expected(graph, isam.getLinearizationPoint());
+  EXPECT(assert_equal(expected.marginalCovariance(Symbol('q', 0)), marginals.covariance(isam, Symbol('q', 0)), 1e-6));
+  EXPECT(assert_equal(expected.marginalCovariance(Symbol('q', 1)), marginals.covariance(isam, Symbol('q', 1)), 1e-6));
+  LONGS_EQUAL(2, marginals.nrComputed());
+  LONGS_EQUAL(2, marginals.size());
+  CHECK_EXCEPTION(marginals.covariance(isam, Symbol('x', 0)), std::invalid_argument);
+
+  // repeated queries between updates are cached
+  EXPECT(marginals.cached(isam, Symbol('q', 0)));
+  EXPECT(marginals.cached(isam, Symbol('q', 1)));
+  std::vector<Matrix> covariances = marginals.covariances(isam, {Symbol('q', 0), Symbol('q', 1)});
+  EXPECT(assert_equal(expected.marginalCovariance(Symbol('q', 1)), covariances[1], 1e-6));
+  LONGS_EQUAL(2, marginals.nrComputed());
+
+  // an update of the connected graph replaces the root, so every landmark is recomputed
+  NonlinearFactorGraph newFactors;
+  Values newValues;
+  addPose(4, Pose3(Rot3(), Point3(1.0,0.0,-4.0)), {quadrics[0]}, newFactors, newValues);
+  isam.update(newFactors, newValues);
+  graph.push_back(newFactors);
+  EXPECT(!marginals.cached(isam, Symbol('q', 0)));
+  EXPECT(!marginals.cached(isam, Symbol('q', 1)));
+
+  Marginals updated(graph, isam.getLinearizationPoint());
+  EXPECT(assert_equal(updated.marginalCovariance(Symbol('q', 0)), marginals.covariance(isam, Symbol('q', 0)), 1e-6));
+  EXPECT(assert_equal(updated.marginalCovariance(Symbol('q', 1)), marginals.covariance(isam, Symbol('q', 1)), 1e-6));
+  LONGS_EQUAL(4, marginals.nrComputed());
+  marginals.clear();
+  LONGS_EQUAL(0, marginals.size());
+}
+
+TEST(QuadricMarginals, AncestorChanges) {
+  // a landmark seen from the first pose of a chain, eliminated below the poses
+  ConstrainedDualQuadric quadric(Rot3(), Point3(0.0,0.0,0.0), Vector3(0.3,0.4,0.5));
+  Pose3 pose0(Rot3(), Point3(0.0,0.0,-5.0));
+  Pose3 pose1(Rot3(), Point3(1.0,0.0,-5.0));
+  NonlinearFactorGraph graph;
+  Values values;
+  values.insert(Symbol('q', 0), quadric);
+  values.insert(Symbol('x', 0), pose0);
+  values.insert(Symbol('x', 1), pose1);
+  graph.emplace_shared<PriorFactor<ConstrainedDualQuadric>>(Symbol('q', 0), quadric, noiseModel::Isotropic::Sigma(9, 1.0));
+  graph.emplace_shared<PriorFactor<Pose3>>(Symbol('x', 0), pose0, noiseModel::Isotropic::Sigma(6, 1.0));
+  graph.emplace_shared<BetweenFactor<Pose3>>(Symbol('x', 0), Symbol('x', 1), pose0.between(pose1), noiseModel::Isotropic::Sigma(6, 0.01));
+  AlignedBox2 box = QuadricCamera::project(quadric, pose0, K).bounds();
+  graph.emplace_shared<BoundingBoxFactor>(box, K, Symbol('x', 0), Symbol('q', 0), boxNoise);
+  FastMap<Key, int> constrained;
+  constrained[Symbol('x', 0)] = 1;
+  constrained[Symbol('x', 1)] = 1;
+  ISAM2 isam;
+  isam.update(graph, values, FactorIndices(), constrained);
+
+  QuadricMarginals marginals;
+  Matrix before = marginals.covariance(isam, Symbol('q', 0));
+
+  // constraining the chain re-eliminates the cliques of the poses only
+  NonlinearFactorGraph prior;
+  prior.emplace_shared<PriorFactor<Pose3>>(Symbol('x', 1), pose1, noiseModel::Isotropic::Sigma(6, 0.01));
+  isam.update(prior);
+  graph.push_back(prior);
+
+  // the landmark is now better known, and the cache recomputes it
+  Matrix expected = Marginals(graph, isam.getLinearizationPoint()).marginalCovariance(Symbol('q', 0));
+  EXPECT((before - expected).norm() > 1e-3);
+  EXPECT(!marginals.cached(isam, Symbol('q', 0)));
+  EXPECT(assert_equal(expected, marginals.covariance(isam, Symbol('q', 0)), 1e-6));
+  LONGS_EQUAL(2, marginals.nrComputed());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
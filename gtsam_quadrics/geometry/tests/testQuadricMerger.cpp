@@ -0,0 +1,164 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricMerger.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricMerger
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricIndex.h>
+#include <gtsam_quadrics/geometry/QuadricMerger.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/nonlinear/PriorFactor.h>
+#include <gtsam/slam/BetweenFactor.h>
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+static const SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 2.0);
+static const ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.3,-0.2,0.5), Point3(0.5,-0.2,0.3), Vector3(0.4,0.6,0.9));
+
+/// the quadric moved by a small offset
+static ConstrainedDualQuadric moved(double offset) {
+  return ConstrainedDualQuadric(quadric.pose().compose(Pose3(Rot3(), Point3(offset, 0.0, -offset))), quadric.radii());
+}
+
+static BoundingBoxFactor box(Key poseKey, Key quadricKey) {
+  return BoundingBoxFactor(AlignedBox2(200,150,400,300), K, poseKey, quadricKey, model);
+}
+
+TEST(QuadricMerger, Group) {
+  std::vector<QuadricMerger::KeyPair> pairs;
+  pairs.push_back(std::make_pair(7, 9));
+  pairs.push_back(std::make_pair(2, 5));
+  pairs.push_back(std::make_pair(5, 9));
+  pairs.push_back(std::make_pair(3, 4));
+
+  std::vector<KeyVector> groups = QuadricMerger::group(pairs);
+  LONGS_EQUAL(2, groups.size());
+  EXPECT(KeyVector({2, 5, 7, 9}) == groups[0]);
+  EXPECT(KeyVector({3, 4}) == groups[1]);
+  EXPECT(QuadricMerger::group(std::vector<QuadricMerger::KeyPair>()).empty());
+}
+
+TEST(QuadricMerger, Merge) {
+  Key x0 = Symbol('x', 0), x1 = Symbol('x', 1), x2 = Symbol('x', 2);
+  Key q0 = Symbol('q', 0), q1 = Symbol('q', 1), q2 = Symbol('q', 2);
+  Values values;
+  values.insert(x0, Pose3());
+  values.insert(x1, Pose3());
+  values.insert(x2, Pose3());
+  values.insert(q0, quadric);
+  values.insert(q1, moved(0.01));
+  values.insert(q2, ConstrainedDualQuadric(moved(0.05).pose(), 1.1 * quadric.radii()));
+  Values original = values;
+
+  // q1 has the most boxes, and a factor between q0 and q2 would constrain
+  // the merged landmark against itself, rekeying does not check its type
+  NonlinearFactorGraph graph;
+  graph.add(box(x0, q0));
+  graph.add(box(x0, q1));
+  graph.add(box(x1, q1));
+  graph.add(box(x2, q1));
+  graph.add(box(x2, q2));
+  graph.add(BetweenFactor<Pose3>(q0, q2, Pose3(), noiseModel::Isotropic::Sigma(6, 1.0)));
+  graph.add(PriorFactor<Pose3>(x0, Pose3(), noiseModel::Isotropic::Sigma(6, 1.0)));
+
+  std::vector<KeyVector> groups(1, KeyVector({q0, q1, q2}));
+  QuadricMerger::KeyMap merged = QuadricMerger::merge(groups, graph, values);
+  LONGS_EQUAL(2, merged.size());
+  EXPECT(merged.at(q0) == q1);
+  EXPECT(merged.at(q2) == q1);
+
+  LONGS_EQUAL(7, graph.size());
+  EXPECT(graph[0]->keys() == KeyVector({x0, q1}));
+  EXPECT(graph[1]->keys() == KeyVector({x0, q1}));
+  EXPECT(graph[4]->keys() == KeyVector({x2, q1}));
+  EXPECT(!graph[5]);
+  EXPECT(graph[6]->keys() == KeyVector({x0}));
+
+  // the rekeyed factor measures the same box against the kept landmark
+  BoundingBoxFactor rekeyed = *boost::dynamic_pointer_cast<BoundingBoxFactor>(graph[4]);
+  EXPECT(assert_equal(box(x2, q1), rekeyed));
+
+  EXPECT(!values.exists(q0));
+  EXPECT(!values.exists(q2));
+  EXPECT(values.exists(x2));
+
+  // the estimates are averaged about q1, weighted by their 2, 3 and 2 factors
+  const ConstrainedDualQuadric& target = original.at<ConstrainedDualQuadric>(q1);
+  Vector9 delta = (2.0 * target.localCoordinates(original.at<ConstrainedDualQuadric>(q0)) +
+                   2.0 * target.localCoordinates(original.at<ConstrainedDualQuadric>(q2))) / 7.0;
+  const ConstrainedDualQuadric& fused = values.at<ConstrainedDualQuadric>(q1);
+  EXPECT(assert_equal(target.retract(delta), fused, 1e-9));
+  EXPECT(!target.equals(fused, 1e-4));
+  EXPECT(fused.radii().x() > quadric.radii().x() && fused.radii().x() < 1.1 * quadric.radii().x());
+
+  // every key of a group has to be a landmark
+  std::vector<KeyVector> poses(1, KeyVector({x0, q1}));
+  CHECK_EXCEPTION(QuadricMerger::merge(poses, graph, values), std::invalid_argument);
+}
+
+TEST(QuadricMerger, MergeDuplicates) {
+  Values values;
+  NonlinearFactorGraph graph;
+  QuadricIndex index(0.5);
+  for (size_t i = 0; i < 4; i++) {
+    // landmarks 1 and 3 duplicate 0 and 2, which are observed twice
+    ConstrainedDualQuadric q = i % 2 == 0 ? moved(5.0 * i) : moved(5.0 * (i - 1) + 0.02);
+    values.insert(Symbol('q', i), q);
+    index.update(Symbol('q', i), q);
+    for (size_t j = 0; j < 2 - i % 2; j++) {
+      graph.add(box(Symbol('x', j), Symbol('q', i)));
+    }
+  }
+
+  // a landmark in the index only is frozen, and left alone
+  index.update(Symbol('q', 4), moved(0.01));
+
+  QuadricMerger::KeyMap merged = QuadricMerger::mergeDuplicates(index, graph, values, 0.5, 2);
+  LONGS_EQUAL(2, merged.size());
+  EXPECT(merged.at(Symbol('q', 1)) == Symbol('q', 0));
+  EXPECT(merged.at(Symbol('q', 3)) == Symbol('q', 2));
+  LONGS_EQUAL(2, values.size());
+  LONGS_EQUAL(3, index.size());
+  EXPECT(!index.exists(Symbol('q', 1)));
+  EXPECT(index.exists(Symbol('q', 4)));
+  for (const auto& factor : graph) {
+    EXPECT(values.exists(factor->keys()[1]));
+  }
+
+  // the kept landmarks move a third of the way to their duplicates
+  ConstrainedDualQuadric fused = moved(0.0).retract(moved(0.0).localCoordinates(moved(0.02)) / 3.0);
+  EXPECT(assert_equal(fused, values.at<ConstrainedDualQuadric>(Symbol('q', 0)), 1e-9));
+  EXPECT(!moved(0.0).equals(fused, 1e-4));
+  EXPECT(assert_equal(fused.bounds(), index.bounds(Symbol('q', 0)), 1e-9));
+
+  // merging again finds nothing
+  EXPECT(QuadricMerger::mergeDuplicates(index, graph, values, 0.5, 2).empty());
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,128 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricPipeline.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricPipeline
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricPipeline.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/slam/PriorFactor.h>
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+static const SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 2.0);
+static const SharedNoiseModel poseModel = noiseModel::Isotropic::Sigma(6, 1e-4);
+static const ConstrainedDualQuadric leftQuadric(Rot3::Rodrigues(0.3,-0.2,0.5), Point3(-0.7,0.0,0.0), Vector3(0.3,0.4,0.5));
+static const ConstrainedDualQuadric rightQuadric(Rot3::Rodrigues(-0.1,0.2,0.1), Point3(0.7,0.1,0.2), Vector3(0.4,0.3,0.3));
+
+/// frame i from a camera on an arc, seeing the exact boxes of both quadrics
+static QuadricPipeline::Frame frame(size_t i) {
+  double angle = 0.15 * i;
+  Point3 eye(6.0*sin(angle), 0.5, -6.0*cos(angle));
+  QuadricPipeline::Frame frame;
+  frame.poseKey = Symbol('x', i);
+  frame.pose = PinholeCamera<Cal3_S2>::Lookat(eye, Point3(0,0,0), Point3(0,-1,0), *K).pose();
+  frame.boxes.push_back(QuadricCamera::project(leftQuadric, frame.pose, K).bounds());
+  frame.boxes.push_back(QuadricCamera::project(rightQuadric, frame.pose, K).bounds());
+  frame.factors.emplace_shared<PriorFactor<Pose3> >(frame.poseKey, frame.pose, poseModel);
+  return frame;
+}
+
+TEST(QuadricPipeline, Landmarks) {
+  QuadricPipeline pipeline;
+  pipeline.builder().addCamera(K, model);
+  CHECK_EXCEPTION(pipeline.addFrame(frame(0)), std::logic_error);
+  pipeline.start();
+
+  boost::shared_ptr<const QuadricPipeline::Snapshot> first = pipeline.snapshot();
+  for (size_t i = 0; i < 8; i++) {
+    pipeline.addFrame(frame(i));
+  }
+  pipeline.flush();
+
+  // the tracks of both boxes are initialized after 3 frames and then associated
+  LONGS_EQUAL(2, pipeline.nrLandmarks());
+  LONGS_EQUAL(0, pipeline.nrTracks());
+
+  boost::shared_ptr<const QuadricPipeline::Snapshot> latest = pipeline.snapshot();
+  LONGS_EQUAL(8, latest->frames);
+  EXPECT(latest->version >= 1);
+  EXPECT(latest->landmarks == KeyVector({Symbol('q', 0), Symbol('q', 1)}));
+  EXPECT(assert_equal(leftQuadric.normalizedMatrix(), latest->estimate.at<ConstrainedDualQuadric>(Symbol('q', 0)).normalizedMatrix(), 1e-4));
+  EXPECT(assert_equal(rightQuadric.normalizedMatrix(), latest->estimate.at<ConstrainedDualQuadric>(Symbol('q', 1)).normalizedMatrix(), 1e-4));
+  LONGS_EQUAL(10, latest->estimate.size());
+
+  // a held snapshot is never modified
+  LONGS_EQUAL(0, first->version);
+  EXPECT(first->estimate.empty());
+
+  pipeline.stop();
+  EXPECT(!pipeline.running());
+}
+
+TEST(QuadricPipeline, FullQueue) {
+  // frames added while the queue is full are merged into one update
+  QuadricPipelineParams params;
+  params.queueCapacity = 1;
+  QuadricPipeline pipeline(params);
+  pipeline.builder().addCamera(K, model);
+  pipeline.start();
+  for (size_t i = 0; i < 8; i++) {
+    pipeline.addFrame(frame(i));
+  }
+  pipeline.stop();
+
+  boost::shared_ptr<const QuadricPipeline::Snapshot> latest = pipeline.snapshot();
+  LONGS_EQUAL(8, latest->frames);
+  LONGS_EQUAL(2, latest->landmarks.size());
+  EXPECT(latest->version <= 8);
+}
+
+TEST(QuadricPipeline, Errors) {
+  QuadricPipelineParams params;
+  params.minViews = 2;
+  CHECK_EXCEPTION(QuadricPipeline pipeline(params), std::invalid_argument);
+
+  QuadricPipeline pipeline;
+  pipeline.start();
+  CHECK_EXCEPTION(pipeline.start(), std::logic_error);
+  CHECK_EXCEPTION(pipeline.addFrame(frame(0)), std::out_of_range);
+
+  // a back-end failure stops the pipeline and is rethrown to the front-end
+  pipeline.builder().addCamera(K, model);
+  QuadricPipeline::Frame unknown = frame(0);
+  unknown.factors.emplace_shared<PriorFactor<Pose3> >(Symbol('y', 0), Pose3(), poseModel);
+  pipeline.addFrame(unknown);
+  CHECK_EXCEPTION(pipeline.flush(), std::exception);
+  EXPECT(!pipeline.running());
+  CHECK_EXCEPTION(pipeline.addFrame(frame(1)), std::exception);
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,151 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricStore.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricStore
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricIndex.h>
+#include <gtsam_quadrics/geometry/QuadricStore.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+
+/// quadrics spread in front of a camera at z = -5
+static std::vector<ConstrainedDualQuadric> quadrics() {
+  std::vector<ConstrainedDualQuadric> quadrics;
+  for (int i = 0; i < 20; i++) {
+    quadrics.push_back(ConstrainedDualQuadric(Rot3::Rodrigues(0.1*i,-0.05*i,0.2),
+      Point3(0.3*(i%5)-0.6, 0.2*(i%3)-0.2, 0.5*(i%4)), Vector3(0.3+0.05*i,0.5,0.4)));
+  }
+  return quadrics;
+}
+
+TEST(QuadricStore, InsertRemove) {
+  std::vector<ConstrainedDualQuadric> expected = quadrics();
+  QuadricStore store;
+  for (size_t i = 0; i < expected.size(); i++) {
+    LONGS_EQUAL(i, store.insert(Symbol('q', i), expected[i]));
+  }
+  LONGS_EQUAL(expected.size(), store.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT(assert_equal(expected[i], store.quadric(i)));
+    EXPECT(assert_equal(expected[i].bounds(), store.bounds(i)));
+  }
+
+  // replacing keeps the index, removing moves the last landmark
+  LONGS_EQUAL(3, store.insert(Symbol('q', 3), expected[7]));
+  EXPECT(assert_equal(expected[7], store.at(Symbol('q', 3))));
+  EXPECT(store.remove(Symbol('q', 2)));
+  EXPECT(!store.remove(Symbol('q', 2)));
+  LONGS_EQUAL(expected.size() - 1, store.size());
+  LONGS_EQUAL(2, store.index(Symbol('q', expected.size() - 1)));
+  EXPECT(assert_equal(expected.back(), store.quadric(2)));
+  EXPECT(!store.exists(Symbol('q', 2)));
+  CHECK_EXCEPTION(store.at(Symbol('q', 2)), std::out_of_range);
+}
+
+TEST(QuadricStore, Values) {
+  std::vector<ConstrainedDualQuadric> expected = quadrics();
+  Values values;
+  for (size_t i = 0; i < expected.size(); i++) {
+    values.insert(Symbol('q', i), expected[i]);
+  }
+  values.insert(Symbol('x', 0), Pose3());
+
+  QuadricStoref store;
+  store.insert(values);
+  LONGS_EQUAL(expected.size(), store.size());
+
+  // only the active window is returned as values
+  Values active = store.values({Symbol('q', 4), Symbol('q', 9)});
+  LONGS_EQUAL(2, active.size());
+  EXPECT(assert_equal(expected[4], active.at<ConstrainedDualQuadric>(Symbol('q', 4)), 1e-5));
+  EXPECT(assert_equal(expected[9], active.at<ConstrainedDualQuadric>(Symbol('q', 9)), 1e-5));
+  CHECK_EXCEPTION(store.values({Symbol('x', 0)}), std::out_of_range);
+}
+
+TEST(QuadricStore, BatchBounds) {
+  std::vector<ConstrainedDualQuadric> expected = quadrics();
+  QuadricStore store;
+  QuadricStoref storef;
+  for (size_t i = 0; i < expected.size(); i++) {
+    store.insert(Symbol('q', i), expected[i]);
+    storef.insert(Symbol('q', i), expected[i]);
+  }
+
+  QuadricStore::BatchBounds bounds;
+  QuadricStoref::BatchBounds boundsf;
+  store.bounds(bounds);
+  storef.bounds(boundsf);
+  LONGS_EQUAL(expected.size(), bounds.rows());
+  LONGS_EQUAL(expected.size(), boundsf.rows());
+  for (size_t i = 0; i < expected.size(); i++) {
+    Vector6 row = bounds.row(i).transpose();
+    Vector6 rowf = boundsf.row(i).transpose().cast<double>();
+    EXPECT(assert_equal(expected[i].bounds().vector(), row, 1e-9));
+    EXPECT(assert_equal(expected[i].bounds().vector(), rowf, 1e-5));
+    EXPECT(assert_equal(store.bounds(i), AlignedBox3(row), 1e-9));
+  }
+}
+
+TEST(QuadricStore, ProjectAndIndex) {
+  std::vector<ConstrainedDualQuadric> expected = quadrics();
+  QuadricStore store;
+  QuadricStoref storef;
+  for (size_t i = 0; i < expected.size(); i++) {
+    store.insert(Symbol('q', i), expected[i]);
+    storef.insert(Symbol('q', i), expected[i]);
+  }
+
+  Pose3 pose(Rot3::Rodrigues(0.1,-0.2,0.05), Point3(0.3,-0.1,-5.0));
+  BatchProjection reference = QuadricCamera::projectBatch(expected, pose, K);
+  BatchProjection projections;
+  BatchProjectionf projectionsf;
+  QuadricCamera::projectBatch(store, pose, K, projections);
+  QuadricCamera::projectBatch(storef, pose, K, projectionsf);
+  LONGS_EQUAL(reference.size(), projections.size());
+  LONGS_EQUAL(reference.size(), projectionsf.size());
+  for (size_t i = 0; i < reference.size(); i++) {
+    EXPECT(reference.status[i] == projections.status[i]);
+    EXPECT(reference.status[i] == projectionsf.status[i]);
+    if (reference.status[i] == ProjectionStatus::SUCCESS) {
+      EXPECT(assert_equal(reference.bounds(i), projections.bounds(i), 1e-6));
+      EXPECT(assert_equal(reference.bounds(i), projectionsf.bounds(i), 5e-2));
+    }
+  }
+
+  QuadricIndex index(0.5);
+  index.update(storef);
+  LONGS_EQUAL(expected.size(), index.size());
+  EXPECT(assert_equal(expected[5].bounds(), index.bounds(Symbol('q', 5)), 1e-5));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,162 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testQuadricWindow.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for QuadricWindow
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricWindow.h>
+#include <gtsam_quadrics/geometry/RigBoundingBoxFactor.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/geometry/PinholeCamera.h>
+#include <gtsam/inference/Symbol.h>
+
+#include <stdexcept>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+static const SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 2.0);
+static const ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.3,-0.2,0.5), Point3(0.5,-0.2,0.3), Vector3(0.4,0.6,0.9));
+
+/// a camera on an arc looking at the quadric
+static Pose3 camera(size_t i) {
+  double angle = 0.3 * i;
+  Point3 eye = quadric.pose().translation() + Point3(6.0*sin(angle), 0.5, -6.0*cos(angle));
+  return PinholeCamera<Cal3_S2>::Lookat(eye, quadric.pose().translation(), Point3(0,-1,0), *K).pose();
+}
+
+/// the exact box of the quadric seen from camera i
+static BoundingBoxFactor observe(size_t i, Key quadricKey) {
+  return BoundingBoxFactor(QuadricCamera::project(quadric, camera(i), K).bounds(), K, Symbol('x', i), quadricKey, model);
+}
+
+TEST(QuadricWindow, Summarize) {
+  NonlinearFactorGraph graph;
+  Values values;
+  values.insert(Symbol('q', 0), quadric);
+  for (size_t i = 0; i < 5; i++) {
+    graph.add(observe(i, Symbol('q', 0)));
+    values.insert(Symbol('x', i), camera(i));
+  }
+
+  // the prior is centered on the exact quadric and has the same quadratic error about it
+  NonlinearFactor::shared_ptr prior = QuadricWindow::summarize(Symbol('q', 0), graph, values);
+  CHECK(prior);
+  LONGS_EQUAL(9, prior->dim());
+  DOUBLES_EQUAL(0.0, prior->error(values), 1e-9);
+  Vector9 delta;
+  delta << 0.002, -0.001, 0.003, 0.004, -0.002, 0.001, 0.002, 0.003, -0.001;
+  Values perturbed = values;
+  perturbed.update(Symbol('q', 0), quadric.retract(delta));
+  double expected = graph.error(perturbed);
+  EXPECT(expected > 1e-3);
+  DOUBLES_EQUAL(expected, prior->error(perturbed), 0.05 * expected);
+
+  NonlinearFactorGraph other;
+  other.add(observe(0, Symbol('q', 1)));
+  CHECK_EXCEPTION(QuadricWindow::summarize(Symbol('q', 0), other, values), std::invalid_argument);
+}
+
+TEST(QuadricWindow, SlidingWindow) {
+  QuadricWindow window(QuadricWindowParams(2.5, 3));
+  for (size_t i = 0; i <= 9; i++) {
+    NonlinearFactorGraph factors;
+    Values values;
+    values.insert(Symbol('x', i), camera(i));
+    if (i == 0) {
+      values.insert(Symbol('q', 1), quadric);
+      values.insert(Symbol('q', 2), quadric);
+      factors.add(observe(i, Symbol('q', 2)));
+    }
+    // q1 is observed until the sixth frame
+    if (i <= 5) {
+      factors.add(observe(i, Symbol('q', 1)));
+    }
+    QuadricWindow::KeyTimestampMap timestamps = window.update(factors, values, i);
+    DOUBLES_EQUAL(double(i), timestamps.at(Symbol('x', i)), 1e-9);
+    window.marginalize(i);
+
+    if (i == 3) {
+      // x0 has left, so has q2 which was observed once and is discarded
+      EXPECT(!window.values().exists(Symbol('x', 0)));
+      EXPECT(!window.values().exists(Symbol('q', 2)));
+      EXPECT(!window.frozen().exists(Symbol('q', 2)));
+      EXPECT(window.prior(Symbol('q', 1)));
+      LONGS_EQUAL(4, window.observations(Symbol('q', 1)));
+      LONGS_EQUAL(4, window.graph().size());
+    }
+  }
+
+  // q1 is frozen once it is no longer observed
+  EXPECT(window.frozen().exists(Symbol('q', 1)));
+  EXPECT(!window.values().exists(Symbol('q', 1)));
+  LONGS_EQUAL(0, window.graph().size());
+  LONGS_EQUAL(3, window.values().size());
+
+  // and restored with its prior when it is observed again
+  Values values;
+  values.insert(Symbol('x', 10), camera(10));
+  NonlinearFactorGraph factors;
+  factors.add(observe(10, Symbol('q', 1)));
+  window.update(factors, values, 10.0);
+  EXPECT(!window.frozen().exists(Symbol('q', 1)));
+  EXPECT(assert_equal(quadric, window.values().at<ConstrainedDualQuadric>(Symbol('q', 1)), 1e-9));
+  LONGS_EQUAL(2, window.graph().size());
+
+  // discarded landmarks have to be initialized again
+  NonlinearFactorGraph discarded;
+  discarded.add(observe(10, Symbol('q', 2)));
+  CHECK_EXCEPTION(window.update(discarded, Values(), 10.0), std::invalid_argument);
+}
+
+TEST(QuadricWindow, RigDetections) {
+  // a landmark only observed through a camera rig counts its detections
+  boost::shared_ptr<CameraRig> rig(new CameraRig());
+  rig->add(Pose3(), K);
+  QuadricWindow window(QuadricWindowParams(2.5, 3));
+  for (size_t i = 0; i <= 9; i++) {
+    NonlinearFactorGraph factors;
+    Values values;
+    values.insert(Symbol('x', i), camera(i));
+    if (i == 0) {
+      values.insert(Symbol('q', 1), quadric);
+    }
+    if (i <= 5) {
+      factors.emplace_shared<RigBoundingBoxFactor>(QuadricCamera::project(quadric, camera(i), K).bounds(), rig, 0,
+          Symbol('x', i), Symbol('q', 1), model);
+    }
+    window.update(factors, values, i);
+    window.marginalize(i);
+  }
+
+  // and is frozen with its prior rather than discarded
+  LONGS_EQUAL(6, window.observations(Symbol('q', 1)));
+  EXPECT(window.frozen().exists(Symbol('q', 1)));
+  EXPECT(!window.values().exists(Symbol('q', 1)));
+  EXPECT(window.prior(Symbol('q', 1)));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
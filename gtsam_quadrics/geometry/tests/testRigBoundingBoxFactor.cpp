@@ -0,0 +1,201 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testRigBoundingBoxFactor.cpp
+ * @date Oct 15, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for CameraRig and RigBoundingBoxFactor
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/CameraRig.h>
+#include <gtsam_quadrics/geometry/RigBoundingBoxFactor.h>
+
+#include <gtsam/base/TestableAssertions.h>
+#include <gtsam/base/numericalDerivative.h>
+#include <gtsam/inference/Symbol.h>
+#include <gtsam/linear/JacobianFactor.h>
+
+#include <Eigen/StdVector>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+static const boost::shared_ptr<Cal3_S2> wideK(new Cal3_S2(300.0, 300.0, 0.0, 320.0, 240.0));
+static const noiseModel::Diagonal::shared_ptr model = noiseModel::Diagonal::Sigmas(Vector4(2.0,3.0,2.0,3.0));
+static const Key body(Symbol('x', 0));
+static const Pose3 bodyPose(Rot3::Rodrigues(0.02,-0.05,0.1), Point3(0.1,0.2,-4.0));
+
+/// a forward camera and one turned slightly left, 20cm apart
+static boost::shared_ptr<CameraRig> rig() {
+  boost::shared_ptr<CameraRig> rig(new CameraRig());
+  rig->add(Pose3(Rot3(), Point3(0.1,0.0,0.0)), K);
+  rig->add(Pose3(Rot3::Ry(-0.2), Point3(-0.1,0.0,0.0)), wideK);
+  return rig;
+}
+
+static Values values() {
+  Values values;
+  values.insert(body, bodyPose);
+  values.insert(Symbol('q', 0), ConstrainedDualQuadric(Rot3::Rodrigues(0.3,-0.2,0.5), Point3(0.2,0.1,0.3), Vector3(0.4,0.6,0.5)));
+  values.insert(Symbol('q', 1), ConstrainedDualQuadric(Rot3::Rodrigues(-0.2,0.4,0.1), Point3(-0.9,0.3,0.5), Vector3(0.3,0.3,0.4)));
+  return values;
+}
+
+TEST(CameraRig, CameraPose) {
+  boost::shared_ptr<CameraRig> cameras = rig();
+  LONGS_EQUAL(2, cameras->size());
+
+  Matrix6 H;
+  Pose3 actual = cameras->cameraPose(bodyPose, 1, H);
+  EXPECT(assert_equal(bodyPose * cameras->extrinsic(1), actual));
+  Matrix numerical = numericalDerivative11<Pose3, Pose3>(
+      [&](const Pose3& x) { return cameras->cameraPose(x, 1); }, bodyPose, 1e-6);
+  EXPECT(assert_equal(numerical, Matrix(H), 1e-6));
+
+  CHECK_EXCEPTION(cameras->add(Pose3(), boost::shared_ptr<Cal3_S2>()), std::invalid_argument);
+}
+
+TEST(RigBoundingBoxFactor, Create) {
+  AlignedBox2Vector boxes{AlignedBox2(250,180,420,330), AlignedBox2(400,200,520,300), AlignedBox2(100,180,200,300)};
+  NonlinearFactorGraph graph = RigBoundingBoxFactor::create(boxes, {0, 1, 0}, rig(), body,
+      KeyVector{Symbol('q', 0), Symbol('q', 0), Symbol('q', 1)}, model);
+  LONGS_EQUAL(3, graph.size());
+
+  // one factor per detection of the timestamp
+  boost::shared_ptr<RigBoundingBoxFactor> first = boost::dynamic_pointer_cast<RigBoundingBoxFactor>(graph[0]);
+  boost::shared_ptr<RigBoundingBoxFactor> second = boost::dynamic_pointer_cast<RigBoundingBoxFactor>(graph[1]);
+  CHECK(first && second);
+  EXPECT(second->keys() == KeyVector({body, Symbol('q', 0)}));
+  LONGS_EQUAL(4, second->dim());
+  LONGS_EQUAL(1, second->camera());
+  EXPECT(assert_equal(boxes[1], second->measurement()));
+  EXPECT(first->rig() == second->rig());
+
+  boost::shared_ptr<RigBoundingBoxFactor> copy = boost::dynamic_pointer_cast<RigBoundingBoxFactor>(first->clone());
+  CHECK(copy);
+  EXPECT(assert_equal(*first, *copy));
+  EXPECT(!first->equals(*second));
+
+  boost::shared_ptr<CameraRig> cameras = rig();
+  CHECK_EXCEPTION(RigBoundingBoxFactor::create(boxes, {0, 1}, rig(), body, KeyVector(3, Symbol('q', 0)), model), std::invalid_argument);
+  CHECK_EXCEPTION(RigBoundingBoxFactor(boxes[0], boost::shared_ptr<CameraRig>(), 0, body, Symbol('q', 0), model), std::invalid_argument);
+  CHECK_EXCEPTION(RigBoundingBoxFactor(boxes[0], cameras, 2, body, Symbol('q', 0), model), std::invalid_argument);
+  CHECK_EXCEPTION(RigBoundingBoxFactor(boxes[0], cameras, 0, body, body, model), std::invalid_argument);
+  CHECK_EXCEPTION(RigBoundingBoxFactor(boxes[0], cameras, 0, body, Symbol('q', 0), noiseModel::Isotropic::Sigma(3, 1.0)), std::invalid_argument);
+  CHECK_EXCEPTION(RigBoundingBoxFactor(boxes[0], cameras, 0, body, Symbol('q', 0), model, "BAD"), std::logic_error);
+}
+
+TEST(RigBoundingBoxFactor, MatchesBoundingBoxFactors) {
+  boost::shared_ptr<CameraRig> cameras = rig();
+  Values v = values();
+
+  // the same detections as factors on the camera poses
+  Values cameraValues = v;
+  cameraValues.insert(Symbol('c', 0), cameras->cameraPose(bodyPose, 0));
+  cameraValues.insert(Symbol('c', 1), cameras->cameraPose(bodyPose, 1));
+
+  for (const string& errorType : {"STANDARD", "TRUNCATED"}) {
+    NonlinearFactorGraph rigGraph, graph;
+    const size_t cameraOf[] = {0, 1, 0};
+    const Key quadricOf[] = {Symbol('q', 0), Symbol('q', 0), Symbol('q', 1)};
+    const AlignedBox2 boxes[] = {AlignedBox2(250,180,420,330), AlignedBox2(400,200,520,300), AlignedBox2(100,180,200,300)};
+    for (size_t i = 0; i < 3; i++) {
+      rigGraph.emplace_shared<RigBoundingBoxFactor>(boxes[i], cameras, cameraOf[i], body, quadricOf[i], model, errorType);
+      graph.emplace_shared<BoundingBoxFactor>(boxes[i], cameras->calibration(cameraOf[i]), cameras->imageBoundary(cameraOf[i]),
+          Symbol('c', cameraOf[i]), quadricOf[i], model, errorType);
+    }
+    EXPECT_DOUBLES_EQUAL(graph.error(cameraValues), rigGraph.error(v), 1e-9);
+
+    // one 4x15 block per detection, over the body pose and its own quadric
+    GaussianFactorGraph::shared_ptr linear = rigGraph.linearize(v);
+    LONGS_EQUAL(3, linear->size());
+    for (size_t i = 0; i < 3; i++) {
+      BoundingBoxFactor bbf = *boost::dynamic_pointer_cast<BoundingBoxFactor>(graph[i]);
+      RigBoundingBoxFactor factor = *boost::dynamic_pointer_cast<RigBoundingBoxFactor>(rigGraph[i]);
+      EXPECT(assert_equal(Vector(bbf.unwhitenedError(cameraValues)), Vector(factor.unwhitenedError(v)), 1e-9));
+
+      JacobianFactor::shared_ptr jacobian = boost::dynamic_pointer_cast<JacobianFactor>(linear->at(i));
+      CHECK(jacobian);
+      LONGS_EQUAL(4, jacobian->rows());
+      LONGS_EQUAL(16, jacobian->cols());
+      EXPECT(jacobian->keys() == KeyVector({body, quadricOf[i]}));
+
+      // the body jacobian is the camera jacobian through the extrinsic
+      const ConstrainedDualQuadric& quadric = v.at<ConstrainedDualQuadric>(quadricOf[i]);
+      Matrix expectedBody = numericalDerivative11<Vector, Pose3>(
+          [&](const Pose3& x) { return factor.evaluateError(x, quadric); }, bodyPose, 1e-6);
+      Matrix expectedQuadric = bbf.evaluateH2(cameras->cameraPose(bodyPose, cameraOf[i]), quadric);
+      EXPECT(assert_equal(Matrix(model->R() * expectedBody), Matrix(jacobian->getA(jacobian->find(body))), 1e-4));
+      EXPECT(assert_equal(Matrix(model->R() * expectedQuadric), Matrix(jacobian->getA(jacobian->find(quadricOf[i]))), 1e-9));
+      EXPECT(assert_equal(Vector(-model->R() * factor.unwhitenedError(v)), Vector(jacobian->getb()), 1e-9));
+    }
+  }
+}
+
+TEST(RigBoundingBoxFactor, ConcurrentLinearize) {
+  // every detection of 20 timestamps, sharing one rig and noise model
+  boost::shared_ptr<CameraRig> cameras = rig();
+  vector<RigBoundingBoxFactor, Eigen::aligned_allocator<RigBoundingBoxFactor> > factors;
+  Values v = values();
+  for (int i = 1; i <= 20; i++) {
+    v.insert(Symbol('x', i), bodyPose * Pose3(Rot3::Rodrigues(0.0, 0.01 * i, 0.0), Point3(0.02 * i, 0.0, 0.0)));
+    for (int j = 0; j < 2; j++) {
+      for (size_t camera = 0; camera < 2; camera++) {
+        factors.push_back(RigBoundingBoxFactor(AlignedBox2(200.0 + i, 150.0, 300.0, 260.0 + j), cameras, camera,
+            Symbol('x', i), Symbol('q', j), model, (i + j) % 2 ? BoundingBoxFactor::STANDARD : BoundingBoxFactor::TRUNCATED));
+      }
+    }
+  }
+
+  vector<boost::shared_ptr<JacobianFactor> > expected;
+  for (const RigBoundingBoxFactor& factor : factors) {
+    expected.push_back(boost::dynamic_pointer_cast<JacobianFactor>(factor.linearize(v)));
+  }
+
+  // every thread linearizes every factor, results must match exactly
+  const int nrThreads = 8;
+  vector<int> mismatches(nrThreads, 0);
+  vector<std::thread> threads;
+  for (int t = 0; t < nrThreads; t++) {
+    threads.push_back(std::thread([&, t]() {
+      for (int round = 0; round < 3; round++) {
+        for (size_t k = 0; k < factors.size(); k++) {
+          size_t f = (k + t * factors.size() / nrThreads) % factors.size();
+          boost::shared_ptr<JacobianFactor> linear = boost::dynamic_pointer_cast<JacobianFactor>(factors[f].linearize(v));
+          if (!linear || !linear->equals(*expected[f], 0.0)) {
+            mismatches[t]++;
+          }
+        }
+      }
+    }));
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (int t = 0; t < nrThreads; t++) {
+    EXPECT_LONGS_EQUAL(0, mismatches[t]);
+  }
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,138 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file testSerialization.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief test cases for the boost serialization of geometry and factors
+ */
+
+#include <CppUnitLite/TestHarness.h>
+
+#include <gtsam_quadrics/geometry/AlignedBox2.h>
+#include <gtsam_quadrics/geometry/AlignedBox3.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
+#include <gtsam_quadrics/geometry/DualConic.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/MultiViewBoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/QuadricAngleFactor.h>
+#include <gtsam_quadrics/geometry/RigBoundingBoxFactor.h>
+
+#include <gtsam/base/serializationTestHelpers.h>
+#include <gtsam/geometry/Pose2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam/inference/Symbol.h>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+using namespace gtsam::serializationTestHelpers;
+
+// noise models are serialized through their base class pointer
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Gaussian, "gtsam_noiseModel_Gaussian");
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Diagonal, "gtsam_noiseModel_Diagonal");
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Isotropic, "gtsam_noiseModel_Isotropic");
+BOOST_CLASS_EXPORT_GUID(gtsam::noiseModel::Unit, "gtsam_noiseModel_Unit");
+GTSAM_VALUE_EXPORT(gtsam::Pose3);
+
+static const boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0,525.0,0.0,320.0,240.0));
+static const ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.1,-0.2,0.3), Point3(0.5,-1.0,2.0), Vector3(0.3,0.4,0.5));
+
+TEST(Serialization, Geometry) {
+  AlignedBox2 box2(1.0, 2.0, 30.0, 40.0);
+  EXPECT(equalsObj(box2));
+  EXPECT(equalsXML(box2));
+  EXPECT(equalsBinary(box2));
+
+  AlignedBox3 box3(-1.0, 1.0, -2.0, 2.0, -3.0, 3.0);
+  EXPECT(equalsObj(box3));
+  EXPECT(equalsXML(box3));
+  EXPECT(equalsBinary(box3));
+
+  EXPECT(equalsObj(quadric));
+  EXPECT(equalsXML(quadric));
+  EXPECT(equalsBinary(quadric));
+
+  DualConic conic(Pose2(1.0, 2.0, 0.3), Vector2(10.0, 20.0));
+  EXPECT(equalsObj(conic));
+  EXPECT(equalsXML(conic));
+  EXPECT(equalsBinary(conic));
+
+  // the cached corner lines are rebuilt on load
+  ImageBoundary boundary(AlignedBox2(0.0, 0.0, 320.0, 240.0));
+  ImageBoundary loaded;
+  deserializeBinary(serializeBinary(boundary), loaded);
+  EXPECT(assert_equal(boundary, loaded));
+  EXPECT(assert_equal(boundary.bounds(), loaded.bounds()));
+  EXPECT(boundary.corners() == loaded.corners());
+}
+
+TEST(Serialization, Factors) {
+  SharedNoiseModel model = noiseModel::Isotropic::Sigma(4, 2.0);
+  BoundingBoxFactor bbf(AlignedBox2(10.0, 20.0, 100.0, 120.0), K, Symbol('x', 1), Symbol('q', 2), model, BoundingBoxFactor::TRUNCATED);
+  EXPECT(equalsObj(bbf));
+  EXPECT(equalsXML(bbf));
+  EXPECT(equalsBinary(bbf));
+
+  QuadricAngleFactor qaf(Symbol('q', 2), Rot3::Rodrigues(0.0, 0.1, 0.2), noiseModel::Isotropic::Sigma(3, 0.1));
+  EXPECT(equalsObj(qaf));
+  EXPECT(equalsXML(qaf));
+  EXPECT(equalsBinary(qaf));
+
+  boost::shared_ptr<QuadricContextCache> cache(new QuadricContextCache());
+  MultiViewBoundingBoxFactor mvf(AlignedBox2(10.0, 20.0, 100.0, 120.0), K, boost::make_shared<ImageBoundary>(), Symbol('x', 1), Symbol('q', 2), model, cache);
+  EXPECT(equalsObj(mvf));
+  EXPECT(equalsXML(mvf));
+  EXPECT(equalsBinary(mvf));
+
+  // the detections of a landmark still share one cache when loaded
+  NonlinearFactorGraph mvfs = MultiViewBoundingBoxFactor::create(
+      AlignedBox2Vector{AlignedBox2(10.0, 20.0, 100.0, 120.0), AlignedBox2(15.0, 25.0, 90.0, 110.0)}, K,
+      boost::make_shared<ImageBoundary>(), KeyVector{Symbol('x', 1), Symbol('x', 2)}, Symbol('q', 2), model);
+  NonlinearFactorGraph loaded;
+  deserializeBinary(serializeBinary(mvfs), loaded);
+  LONGS_EQUAL(2, loaded.size());
+  boost::shared_ptr<MultiViewBoundingBoxFactor> first = boost::dynamic_pointer_cast<MultiViewBoundingBoxFactor>(loaded[0]);
+  boost::shared_ptr<MultiViewBoundingBoxFactor> second = boost::dynamic_pointer_cast<MultiViewBoundingBoxFactor>(loaded[1]);
+  CHECK(first && second);
+  EXPECT(first->cache() && first->cache() == second->cache());
+
+  boost::shared_ptr<CameraRig> rig(new CameraRig());
+  rig->add(Pose3(), K);
+  rig->add(Pose3(Rot3::Ry(0.5), Point3(0.1, 0.0, 0.0)), K, boost::make_shared<ImageBoundary>(320.0, 240.0));
+  RigBoundingBoxFactor rbf(AlignedBox2(10.0, 20.0, 100.0, 120.0), rig, 1,
+      Symbol('x', 1), Symbol('q', 2), model, BoundingBoxFactor::TRUNCATED);
+  EXPECT(equalsObj(rbf));
+  EXPECT(equalsXML(rbf));
+  EXPECT(equalsBinary(rbf));
+}
+
+TEST(Serialization, GraphAndValues) {
+  NonlinearFactorGraph graph;
+  graph.emplace_shared<BoundingBoxFactor>(AlignedBox2(10.0, 20.0, 100.0, 120.0), K, Symbol('x', 1), Symbol('q', 2), noiseModel::Isotropic::Sigma(4, 2.0));
+  graph.emplace_shared<QuadricAngleFactor>(Symbol('q', 2), Rot3(), noiseModel::Isotropic::Sigma(3, 0.1));
+  EXPECT(equalsObj(graph));
+  EXPECT(equalsBinary(graph));
+
+  Values values;
+  values.insert(Symbol('q', 2), quadric);
+  values.insert(Symbol('x', 1), Pose3());
+  EXPECT(equalsObj(values));
+  EXPECT(equalsBinary(values));
+}
+
+/* ************************************************************************* */
+int main() {
+  TestResult tr;
+  return TestRegistry::runAllTests(tr);
+}
+/* ************************************************************************* */
@@ -0,0 +1,129 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision, Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file timeQuadricCamera.cpp
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief time the quadric projection jacobians against the kronecker chain
+ */
+
+#include <gtsam_quadrics/base/Utilities.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace gtsam;
+using namespace gtsam_quadrics;
+
+/* ************************************************************************* */
+// the original dynamic-size kronecker chain, kept as a reference
+namespace kronecker {
+
+Matrix44 quadricMatrix(const ConstrainedDualQuadric& quadric,
+                       Eigen::Matrix<double, 16, 9>& dQ_dq) {
+  Matrix44 Z = quadric.pose().matrix();
+  Matrix44 Qc = (Vector4() << (quadric.radii()).array().pow(2), -1.0)
+                    .finished()
+                    .asDiagonal();
+  Eigen::Matrix<double, 16, 6> dZ_dx;
+  utils::matrix(quadric.pose(), dZ_dx);
+  Eigen::Matrix<double, 16, 9> dZ_dq = Matrix::Zero(16, 9);
+  dZ_dq.block(0, 0, 16, 6) = dZ_dx;
+  Eigen::Matrix<double, 16, 9> dQc_dq = Matrix::Zero(16, 9);
+  dQc_dq(0, 6) = 2.0 * quadric.radii()(0);
+  dQc_dq(5, 7) = 2.0 * quadric.radii()(1);
+  dQc_dq(10, 8) = 2.0 * quadric.radii()(2);
+  using utils::kron;
+  Matrix4 I44 = Matrix::Identity(4, 4);
+  Eigen::Matrix<double, 16, 16> T44 = utils::TVEC(4, 4);
+  dQ_dq = kron(I44, Z * Qc) * T44 * dZ_dq +
+          kron(Z, I44) * (kron(I44, Z) * dQc_dq + kron(Qc, I44) * dZ_dq);
+  return Z * Qc * Z.transpose();
+}
+
+Matrix33 project(const ConstrainedDualQuadric& quadric, const Pose3& pose,
+                 const boost::shared_ptr<Cal3_S2>& calibration,
+                 Eigen::Matrix<double, 9, 9>& dC_dq,
+                 Eigen::Matrix<double, 9, 6>& dC_dx) {
+  using utils::kron;
+  Matrix3 K = calibration->K();
+  Matrix4 Xi = pose.inverse().matrix();
+  Matrix34 I34 = Matrix::Identity(3, 4);
+  Matrix34 P = K * I34 * Xi;
+  Eigen::Matrix<double, 16, 9> dQ_dq;
+  Matrix4 Q = quadricMatrix(quadric, dQ_dq);
+  dC_dq = kron(P, P) * dQ_dq;
+  Matrix33 I33 = Matrix::Identity(3, 3);
+  Matrix44 I44 = Matrix::Identity(4, 4);
+  Eigen::Matrix<double, 9, 12> dC_dP =
+      kron(I33, P * Q) * utils::TVEC(3, 4) + kron(P * Q.transpose(), I33);
+  Eigen::Matrix<double, 12, 16> dP_dXi = kron(I44, K * I34);
+  Eigen::Matrix<double, 16, 16> dXi_dX = -kron(Xi.transpose(), Xi);
+  Eigen::Matrix<double, 16, 6> dX_dx;
+  utils::matrix(pose, dX_dx);
+  dC_dx = dC_dP * dP_dXi * dXi_dX * dX_dx;
+  return P * Q * P.transpose();
+}
+
+}  // namespace kronecker
+
+/* ************************************************************************* */
+#define TEST(TITLE, STATEMENT)                                    \
+  cout << endl << TITLE << endl;                                  \
+  timeLog = clock();                                              \
+  for (int i = 0; i < n; i++) STATEMENT;                          \
+  seconds = (double)(clock() - timeLog) / CLOCKS_PER_SEC;         \
+  cout << seconds << " seconds" << endl;                          \
+  cout << ((double)n / seconds) << " calls/second" << endl;
+
+int main() {
+  int n = 100000;
+  long timeLog;
+  double seconds;
+
+  boost::shared_ptr<Cal3_S2> K(new Cal3_S2(525.0, 525.0, 0.0, 320.0, 240.0));
+  Pose3 pose(Rot3::Rodrigues(0.1, -0.2, 0.05), Point3(0.3, -0.1, -5.0));
+  ConstrainedDualQuadric quadric(Rot3::Rodrigues(0.4, 0.1, -0.3),
+                                 Point3(0.2, 0.1, 0.3),
+                                 Vector3(0.5, 0.8, 1.1));
+  Eigen::Matrix<double, 16, 9> dQ_dq;
+  Eigen::Matrix<double, 9, 9> dC_dq;
+  Eigen::Matrix<double, 9, 6> dC_dx;
+
+  TEST("ConstrainedDualQuadric::matrix(H) kronecker",
+       kronecker::quadricMatrix(quadric, dQ_dq))
+  TEST("ConstrainedDualQuadric::matrix(H) closed form", quadric.matrix(dQ_dq))
+  TEST("QuadricCamera::project(H) kronecker",
+       kronecker::project(quadric, pose, K, dC_dq, dC_dx))
+  TEST("QuadricCamera::project(H) closed form",
+       QuadricCamera::project(quadric, pose, K, dC_dq, dC_dx))
+
+  // one map of landmarks into a keyframe, each call handles every landmark
+  std::vector<ConstrainedDualQuadric> map(10000, quadric);
+  BatchProjection projections;
+  DualConic dualConic;
+  n = 100;
+  TEST("QuadricCamera::tryProject + bounds per landmark",
+       for (const ConstrainedDualQuadric& q : map) {
+         if (QuadricCamera::tryProject(q, pose, K, dualConic) ==
+             ProjectionStatus::SUCCESS) {
+           dualConic.bounds();
+         }
+       })
+  TEST("QuadricCamera::projectBatch",
+       QuadricCamera::projectBatch(map.data(), map.size(), pose, K,
+                                   projections))
+
+  return 0;
+}
@@ -48,6 +48,15 @@ gtsam::Pose3 interpolate(const gtsam::Pose3& p1, const gtsam::Pose3& p2,
                          const double& percent);
 }  // namespace utils
 
+#include <gtsam_quadrics/base/Statistics.h>
+class Statistics {
+  static bool enabled();
+  static size_t count(const string& name);
+  static void reset();
+  static void print(const string& s);
+  static void print();
+};
+
 #include <gtsam_quadrics/geometry/ConstrainedDualQuadric.h>
 class ConstrainedDualQuadric {
   ConstrainedDualQuadric();
@@ -77,6 +86,9 @@ class ConstrainedDualQuadric {
   bool equals(const gtsam_quadrics::ConstrainedDualQuadric& other,
               double tol) const;
   bool equals(const gtsam_quadrics::ConstrainedDualQuadric& other) const;
+
+  // enabling serialization functionality
+  void serialize() const;
 };
 
 #include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
@@ -91,9 +103,19 @@ virtual class BoundingBoxFactor : gtsam::NonlinearFactor {
                     const size_t& quadricKey,
                     const gtsam::noiseModel::Base* model,
                     const string& errorString);
+  BoundingBoxFactor(const gtsam_quadrics::AlignedBox2& measured,
+                    const gtsam::Cal3_S2* calibration,
+                    const gtsam_quadrics::ImageBoundary* imageBoundary,
+                    const size_t& poseKey, const size_t& quadricKey,
+                    const gtsam::noiseModel::Base* model,
+                    const string& errorString);
   AlignedBox2 measurement() const;
   size_t poseKey() const;
   size_t objectKey() const;
+  bool gated() const;
+  void setGated(bool gated);
+  bool inView(const gtsam::Pose3& pose,
+              const gtsam_quadrics::ConstrainedDualQuadric& quadric) const;
   gtsam::Vector evaluateError(
       const gtsam::Pose3& pose,
       const gtsam_quadrics::ConstrainedDualQuadric& quadric) const;
@@ -105,6 +127,78 @@ virtual class BoundingBoxFactor : gtsam::NonlinearFactor {
       const gtsam_quadrics::ConstrainedDualQuadric& quadric) const;
   gtsam::Matrix evaluateH1(const gtsam::Values& x) const;
   gtsam::Matrix evaluateH2(const gtsam::Values& x) const;
+  pair<gtsam::Matrix, gtsam::Matrix> evaluateH1H2(
+      const gtsam::Pose3& pose,
+      const gtsam_quadrics::ConstrainedDualQuadric& quadric) const;
+  pair<gtsam::Matrix, gtsam::Matrix> evaluateH1H2(
+      const gtsam::Values& x) const;
+
+  // enabling serialization functionality
+  void serialize() const;
+};
+
+#include <gtsam_quadrics/geometry/QuadricContext.h>
+class QuadricContextCache {
+  QuadricContextCache();
+};
+
+#include <gtsam_quadrics/geometry/MultiViewBoundingBoxFactor.h>
+virtual class MultiViewBoundingBoxFactor : gtsam_quadrics::BoundingBoxFactor {
+  MultiViewBoundingBoxFactor();
+  MultiViewBoundingBoxFactor(
+      const gtsam_quadrics::AlignedBox2& measured,
+      const gtsam::Cal3_S2* calibration,
+      const gtsam_quadrics::ImageBoundary* imageBoundary, const size_t& poseKey,
+      const size_t& quadricKey, const gtsam::noiseModel::Base* model,
+      const gtsam_quadrics::QuadricContextCache* cache,
+      const string& errorString);
+
+  // enabling serialization functionality
+  void serialize() const;
+};
+
+#include <gtsam_quadrics/geometry/CameraRig.h>
+class CameraRig {
+  CameraRig();
+  size_t add(const gtsam::Pose3& extrinsic, const gtsam::Cal3_S2* calibration);
+  size_t add(const gtsam::Pose3& extrinsic, const gtsam::Cal3_S2* calibration,
+             const gtsam_quadrics::ImageBoundary* imageBoundary);
+  size_t size() const;
+  gtsam::Pose3 extrinsic(size_t i) const;
+  gtsam::Pose3 cameraPose(const gtsam::Pose3& bodyPose, size_t i) const;
+  void print(const string& s) const;
+  void print() const;
+  bool equals(const gtsam_quadrics::CameraRig& other, double tol) const;
+
+  // enabling serialization functionality
+  void serialize() const;
+};
+
+#include <gtsam_quadrics/geometry/RigBoundingBoxFactor.h>
+virtual class RigBoundingBoxFactor : gtsam::NonlinearFactor {
+  RigBoundingBoxFactor();
+  RigBoundingBoxFactor(const gtsam_quadrics::AlignedBox2& measured,
+                       const gtsam_quadrics::CameraRig* rig,
+                       const size_t& camera, const size_t& bodyKey,
+                       const size_t& quadricKey,
+                       const gtsam::noiseModel::Base* model);
+  RigBoundingBoxFactor(const gtsam_quadrics::AlignedBox2& measured,
+                       const gtsam_quadrics::CameraRig* rig,
+                       const size_t& camera, const size_t& bodyKey,
+                       const size_t& quadricKey,
+                       const gtsam::noiseModel::Base* model,
+                       const string& errorString);
+  size_t bodyKey() const;
+  size_t objectKey() const;
+  gtsam_quadrics::AlignedBox2 measurement() const;
+  size_t camera() const;
+  gtsam_quadrics::CameraRig* rig() const;
+  gtsam::Vector evaluateError(
+      const gtsam::Pose3& bodyPose,
+      const gtsam_quadrics::ConstrainedDualQuadric& quadric) const;
+
+  // enabling serialization functionality
+  void serialize() const;
 };
 
 #include <gtsam_quadrics/geometry/QuadricAngleFactor.h>
@@ -113,6 +207,9 @@ virtual class QuadricAngleFactor {
                      const gtsam::noiseModel::Base* model);
   Vector evaluateError(
       const gtsam_quadrics::ConstrainedDualQuadric& quadric) const;
+
+  // enabling serialization functionality
+  void serialize() const;
 };
 
 // TODO need to figure out how to get this to import...
@@ -158,6 +255,9 @@ class AlignedBox2 {
   void print() const;
   bool equals(const gtsam_quadrics::AlignedBox2& other, double tol) const;
   bool equals(const gtsam_quadrics::AlignedBox2& other) const;
+
+  // enabling serialization functionality
+  void serialize() const;
 };
 
 #include <gtsam_quadrics/geometry/AlignedBox3.h>
@@ -182,6 +282,68 @@ class AlignedBox3 {
   void print() const;
   bool equals(const gtsam_quadrics::AlignedBox3& other, double tol) const;
   bool equals(const gtsam_quadrics::AlignedBox3& other) const;
+
+  // enabling serialization functionality
+  void serialize() const;
+};
+
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+class ImageBoundary {
+  ImageBoundary();
+  ImageBoundary(const double& width, const double& height);
+  ImageBoundary(const gtsam_quadrics::AlignedBox2& bounds);
+  gtsam_quadrics::AlignedBox2 bounds() const;
+  double width() const;
+  double height() const;
+  void print(const string& s) const;
+  void print() const;
+  bool equals(const gtsam_quadrics::ImageBoundary& other, double tol) const;
+  bool equals(const gtsam_quadrics::ImageBoundary& other) const;
+
+  // enabling serialization functionality
+  void serialize() const;
+};
+
+#include <gtsam_quadrics/geometry/BoxAssociation.h>
+class BoxAssociation {
+  BoxAssociation();
+  static gtsam_quadrics::BoxAssociation associate(
+      const gtsam::Matrix& predicted, const gtsam::Matrix& measured,
+      const double& minIoU, const string& solver);
+  static gtsam::Matrix iouMatrix(const gtsam::Matrix& predicted,
+                                 const gtsam::Matrix& measured);
+  size_t size() const;
+  size_t nrMatches() const;
+  int landmark(size_t i) const;
+  double iou(size_t i) const;
+  bool isMatched(size_t i) const;
+};
+
+#include <gtsam_quadrics/geometry/QuadricIndex.h>
+class QuadricIndex {
+  QuadricIndex();
+  QuadricIndex(const double& cellSize);
+  QuadricIndex(const double& cellSize, size_t maxCells);
+  double cellSize() const;
+  size_t maxCells() const;
+  size_t size() const;
+  size_t nrCells() const;
+  size_t nrLarge() const;
+  bool exists(const size_t& key) const;
+  gtsam_quadrics::AlignedBox3 bounds(const size_t& key) const;
+  void update(const size_t& key,
+              const gtsam_quadrics::ConstrainedDualQuadric& quadric);
+  void update(const size_t& key, const gtsam_quadrics::AlignedBox3& bounds);
+  void update(const gtsam::Values& values);
+  bool remove(const size_t& key);
+  void clear();
+  gtsam::KeyVector intersecting(const gtsam_quadrics::AlignedBox3& box) const;
+  gtsam::KeyVector near(const gtsam::Point3& point,
+                        const double& radius) const;
+  gtsam::KeyVector visible(
+      const gtsam::Pose3& pose, const gtsam::Cal3_S2* calibration,
+      const gtsam_quadrics::ImageBoundary& imageBoundary,
+      const double& maxDepth) const;
 };
 
 #include <gtsam_quadrics/geometry/DualConic.h>
@@ -191,8 +353,92 @@ class DualConic {
   DualConic(const gtsam::Pose2& pose, const gtsam::Vector& radii);
   gtsam::Matrix matrix() const;
   gtsam::AlignedBox2 bounds() const;
+  gtsam_quadrics::AlignedBox2 smartBounds(
+      const gtsam_quadrics::ImageBoundary& imageBoundary) const;
   bool isDegenerate() const;
   bool isEllipse() const;
+
+  // enabling serialization functionality
+  void serialize() const;
+};
+
+#include <gtsam_quadrics/geometry/QuadricMapFile.h>
+class QuadricMapFile {
+  static void saveLandmarks(const string& filename,
+                            const gtsam::Values& values);
+  static gtsam::Values loadLandmarks(const string& filename);
+  static void savePoses(const string& filename, const gtsam::Values& values);
+  static gtsam::Values loadPoses(const string& filename);
+  static void saveDetections(const string& filename,
+                             const gtsam::NonlinearFactorGraph& graph,
+                             size_t cameraId, bool append);
+};
+
+#include <gtsam_quadrics/geometry/QuadricWindow.h>
+class QuadricWindowParams {
+  QuadricWindowParams();
+  QuadricWindowParams(double lag, size_t minObservations);
+  double lag;
+  size_t minObservations;
+};
+
+class QuadricWindow {
+  QuadricWindow();
+  QuadricWindow(const gtsam_quadrics::QuadricWindowParams& params);
+  gtsam_quadrics::QuadricWindowParams params() const;
+  gtsam::NonlinearFactorGraph graph() const;
+  gtsam::Values values() const;
+  size_t observations(const size_t& key) const;
+  gtsam::NonlinearFactor* prior(const size_t& key) const;
+  void update(const gtsam::NonlinearFactorGraph& newFactors,
+              const gtsam::Values& newValues, double time);
+  void setEstimate(const gtsam::Values& estimate);
+  gtsam::KeyVector marginalize(double time);
+  static gtsam::NonlinearFactor* summarize(
+      const size_t& key, const gtsam::NonlinearFactorGraph& factors,
+      const gtsam::Values& values);
+  void print(const string& s) const;
+  void print() const;
+};
+
+#include <gtsam_quadrics/geometry/FrameFactorBuilder.h>
+class FrameFactorBuilder {
+  FrameFactorBuilder();
+  FrameFactorBuilder(size_t blockSize);
+  size_t nrCameras() const;
+  size_t nrNoiseModels() const;
+  bool gated() const;
+  void setGated(bool gated);
+  size_t addCamera(const gtsam::Cal3_S2* calibration,
+                   const gtsam::noiseModel::Base* model);
+  size_t addCamera(const gtsam::Cal3_S2* calibration,
+                   const gtsam::noiseModel::Base* model,
+                   const string& errorString);
+  size_t addCamera(const gtsam::Cal3_S2* calibration,
+                   const gtsam_quadrics::ImageBoundary* imageBoundary,
+                   const gtsam::noiseModel::Base* model,
+                   const string& errorString);
+  void add(gtsam::NonlinearFactorGraph& graph, const size_t& poseKey,
+           size_t cameraId, const gtsam::Matrix& boxes,
+           const gtsam::KeyVector& quadricKeys) const;
+  gtsam::NonlinearFactorGraph build(const size_t& poseKey, size_t cameraId,
+                                    const gtsam::Matrix& boxes,
+                                    const gtsam::KeyVector& quadricKeys) const;
+  gtsam_quadrics::BoundingBoxFactor* factor(
+      const gtsam_quadrics::AlignedBox2& measured, const size_t& poseKey,
+      const size_t& quadricKey, size_t cameraId) const;
+};
+
+#include <gtsam_quadrics/geometry/BoundingBoxBatch.h>
+class BoundingBoxBatch {
+  BoundingBoxBatch(const gtsam::NonlinearFactorGraph& graph);
+  BoundingBoxBatch(const gtsam::NonlinearFactorGraph& graph,
+                   const string& backendString);
+  static bool cudaEnabled();
+  size_t size() const;
+  size_t graphIndex(size_t i) const;
+  double error(const gtsam::Values& values);
+  gtsam::GaussianFactorGraph* linearize(const gtsam::Values& values);
 };
 
 #include <gtsam_quadrics/geometry/QuadricCamera.h>
@@ -202,6 +448,49 @@ class QuadricCamera {
   static gtsam_quadrics::DualConic project(
       const gtsam_quadrics::ConstrainedDualQuadric& quadric,
       const gtsam::Pose3& pose, const gtsam::Cal3_S2* calibration);
+  static gtsam_quadrics::AlignedBox2 inflate(
+      const gtsam_quadrics::AlignedBox2& bounds,
+      const gtsam::Matrix& boundsCovariance, double sigmas);
+};
+
+#include <gtsam/nonlinear/ISAM2.h>
+#include <gtsam_quadrics/geometry/QuadricMarginals.h>
+class QuadricMarginals {
+  QuadricMarginals();
+  size_t size() const;
+  size_t nrComputed() const;
+  gtsam::Matrix covariance(const gtsam::ISAM2& isam, const size_t& key);
+  bool cached(const gtsam::ISAM2& isam, const size_t& key) const;
+  void erase(const size_t& key);
+  void clear();
+};
+
+#include <gtsam/geometry/Cal3DS2.h>
+#include <gtsam/geometry/Cal3Fisheye.h>
+#include <gtsam_quadrics/geometry/DistortedCamera.h>
+template <CALIBRATION = {gtsam::Cal3DS2, gtsam::Cal3Fisheye}>
+class DistortedCamera {
+  DistortedCamera(const CALIBRATION& calibration,
+                  const gtsam_quadrics::AlignedBox2& imageBounds);
+  DistortedCamera(const CALIBRATION& calibration, double width,
+                  double height);
+  CALIBRATION calibration() const;
+  gtsam::Cal3_S2* pinhole() const;
+  gtsam_quadrics::ImageBoundary* imageBoundary() const;
+  gtsam_quadrics::AlignedBox2 undistort(
+      const gtsam_quadrics::AlignedBox2& box) const;
+  gtsam::noiseModel::Base* undistort(
+      const gtsam_quadrics::AlignedBox2& box,
+      const gtsam::noiseModel::Base* model) const;
+  gtsam_quadrics::AlignedBox2 distort(
+      const gtsam_quadrics::AlignedBox2& box) const;
+  gtsam_quadrics::BoundingBoxFactor factor(
+      const gtsam_quadrics::AlignedBox2& measured, const size_t& poseKey,
+      const size_t& quadricKey, const gtsam::noiseModel::Base* model) const;
+  gtsam_quadrics::BoundingBoxFactor factor(
+      const gtsam_quadrics::AlignedBox2& measured, const size_t& poseKey,
+      const size_t& quadricKey, const gtsam::noiseModel::Base* model,
+      const string& errorString) const;
 };
 
 }  // namespace gtsam_quadrics
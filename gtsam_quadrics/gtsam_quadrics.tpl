@@ -8,11 +8,15 @@
 #include <pybind11/functional.h>
 #include <pybind11/iostream.h>
 
+#include "gtsam/base/serialization.h"
 #include "gtsam/base/utilities.h"
 
 // These are the included headers listed in `gtsam_quadrics.i`
 {includes}
 
+// Handwritten NumPy batch functions
+#include <gtsam_quadrics/python/BatchBindings.h>
+
 // Export classes for serialization
 #include <boost/serialization/export.hpp>
 {boost_class_export}
@@ -44,6 +48,8 @@ namespace py = pybind11;
 
 {wrapped_namespace}
 
+    gtsam_quadrics::python::defineBatchFunctions(m_);
+
 // Specializations for STL classes
 // TODO(fan): make this automatic
 // #include "python/gtsam/specializations/{module_name}.h"
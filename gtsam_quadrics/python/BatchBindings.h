@@ -0,0 +1,294 @@
+/* ----------------------------------------------------------------------------
+
+ * QuadricSLAM Copyright 2020, ARC Centre of Excellence for Robotic Vision,
+ Queensland University of Technology (QUT)
+ * Brisbane, QLD 4000
+ * All Rights Reserved
+ * Authors: Lachlan Nicholson, et al. (see THANKS for the full author list)
+ * See LICENSE for the license information
+
+ * -------------------------------------------------------------------------- */
+
+/**
+ * @file BatchBindings.h
+ * @date Oct 14, 2026
+ * @author Lachlan Nicholson
+ * @brief NumPy batch entry points for the python wrapper
+ */
+
+/**
+ * Handwritten pybind11 functions that gtwrap cannot generate from
+ * gtsam_quadrics.i: they take and return NumPy arrays directly, so a whole
+ * frame is evaluated in one call instead of one call per object.
+ * Row-major float64 inputs are mapped without copying, outputs are
+ * allocated as NumPy arrays and written in place, and the GIL is released
+ * while evaluating. Included from gtsam_quadrics.tpl only.
+ */
+
+#pragma once
+
+#include <gtsam/geometry/Cal3_S2.h>
+#include <gtsam/geometry/Pose3.h>
+#include <gtsam_quadrics/geometry/BoundingBoxFactor.h>
+#include <gtsam_quadrics/geometry/ImageBoundary.h>
+#include <gtsam_quadrics/geometry/QuadricCamera.h>
+#include <gtsam_quadrics/geometry/QuadricInitializer.h>
+
+#include <pybind11/eigen.h>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <boost/make_shared.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace gtsam_quadrics {
+namespace python {
+
+namespace py = pybind11;
+
+/** Parses the error type, as the string BoundingBoxFactor constructors */
+inline BoundingBoxFactor::MeasurementModel measurementModel(
+    const std::string& errorString) {
+  if (errorString == "STANDARD") {
+    return BoundingBoxFactor::STANDARD;
+  } else if (errorString == "TRUNCATED") {
+    return BoundingBoxFactor::TRUNCATED;
+  }
+  throw std::invalid_argument("The error type \"" + errorString +
+                              "\" is not a valid option");
+}
+
+/// pose matrices as NumPy arrays, converted to C order float64 if needed
+typedef py::array_t<double, py::array::c_style | py::array::forcecast>
+    PoseArray;
+typedef Eigen::Map<const BoundingBoxFactor::BatchPoses, 0,
+                   Eigen::OuterStride<> >
+    PosesMap;
+
+/**
+ * Maps Nx4x4 pose matrices, or their top Nx3x4 or Nx12 rows, as the
+ * BoundingBoxFactor::BatchPoses rows without copying
+ */
+inline PosesMap mapPoses(const PoseArray& poses) {
+  const bool square =
+      poses.ndim() == 3 && poses.shape(1) == 4 && poses.shape(2) == 4;
+  const bool top =
+      (poses.ndim() == 3 && poses.shape(1) == 3 && poses.shape(2) == 4) ||
+      (poses.ndim() == 2 && poses.shape(1) == 12);
+  if (!square && !top) {
+    throw std::invalid_argument(
+        "poses require Nx4x4, Nx3x4 or Nx12 pose matrices");
+  }
+  return PosesMap(poses.data(), poses.shape(0), 12,
+                  Eigen::OuterStride<>(square ? 16 : 12));
+}
+
+/** Returns the pose of one row of mapped pose matrices */
+inline gtsam::Pose3 pose(const PosesMap& poses, Eigen::Index i) {
+  const Eigen::Map<const Eigen::Matrix<double, 3, 4, Eigen::RowMajor> > T(
+      poses.row(i).data());
+  return gtsam::Pose3(gtsam::Rot3(gtsam::Matrix3(T.leftCols<3>())),
+                      gtsam::Point3(T.col(3)));
+}
+
+/** Adds the batch functions to the module */
+inline void defineBatchFunctions(py::module_& m) {
+  typedef Eigen::Ref<const BoundingBoxFactor::BatchQuadrics> QuadricsRef;
+  typedef Eigen::Ref<const BoundingBoxFactor::BatchBoxes> BoxesRef;
+  typedef Eigen::Ref<const Eigen::Matrix<double, Eigen::Dynamic, 81,
+                                         Eigen::RowMajor> >
+      CovariancesRef;
+
+  m.def(
+      "evaluateBoundingBoxBatch",
+      [](const PoseArray& poseMatrices, const QuadricsRef& quadrics,
+         const BoxesRef& measured, const gtsam::Cal3_S2& calibration,
+         const ImageBoundary& imageBoundary, const std::string& errorType,
+         bool computeJacobians) -> py::tuple {
+        const PosesMap poses = mapPoses(poseMatrices);
+        const py::ssize_t n = poses.rows();
+        if (quadrics.rows() != n || measured.rows() != n) {
+          throw std::invalid_argument(
+              "poses, quadrics and measured require one row per factor");
+        }
+        BoundingBoxFactor::MeasurementModel model = measurementModel(errorType);
+        boost::shared_ptr<gtsam::Cal3_S2> K =
+            boost::make_shared<gtsam::Cal3_S2>(calibration);
+
+        py::array_t<double> errors({n, py::ssize_t(4)});
+        py::array_t<double> jacobians(
+            std::vector<py::ssize_t>{computeJacobians ? n : 0, 4, 15});
+        Eigen::Map<BoundingBoxFactor::BatchBoxes> errorsMap(
+            errors.mutable_data(), n, 4);
+        Eigen::Map<BoundingBoxFactor::BatchJacobians> jacobiansMap(
+            jacobians.mutable_data(), computeJacobians ? n : 0, 60);
+        {
+          py::gil_scoped_release release;
+          BoundingBoxFactor::evaluateBatch(poses, quadrics, measured, K,
+                                           imageBoundary, model, errorsMap,
+                                           jacobiansMap);
+        }
+        return py::make_tuple(errors, jacobians);
+      },
+      py::arg("poses"), py::arg("quadrics"), py::arg("measured"),
+      py::arg("calibration"), py::arg("imageBoundary") = ImageBoundary(),
+      py::arg("errorType") = "STANDARD", py::arg("computeJacobians") = true,
+      "Evaluates BoundingBoxFactor errors for Nx4x4 pose matrices (or\n"
+      "their top Nx3x4 or Nx12 rows), Nx9 quadric tangent vectors (see\n"
+      "ConstrainedDualQuadric.Retract) and Nx4 measured boxes. Returns the\n"
+      "Nx4 errors and the Nx4x15 jacobians [H1 H2], with no rows if\n"
+      "computeJacobians is false.");
+
+  m.def(
+      "projectBoundsBatch",
+      [](const QuadricsRef& quadrics, const gtsam::Pose3& pose,
+         const gtsam::Cal3_S2& calibration) -> py::tuple {
+        const py::ssize_t n = quadrics.rows();
+        boost::shared_ptr<gtsam::Cal3_S2> K =
+            boost::make_shared<gtsam::Cal3_S2>(calibration);
+
+        py::array_t<double> bounds({n, py::ssize_t(4)});
+        py::array_t<int> status(n);
+        Eigen::Map<BoundingBoxFactor::BatchBoxes> boundsMap(
+            bounds.mutable_data(), n, 4);
+        int* statusData = status.mutable_data();
+        {
+          py::gil_scoped_release release;
+          std::vector<ConstrainedDualQuadric> batch;
+          batch.reserve(n);
+          for (py::ssize_t i = 0; i < n; i++) {
+            batch.push_back(ConstrainedDualQuadric::Retract(
+                gtsam::Vector9(quadrics.row(i).transpose())));
+          }
+          BatchProjection projections =
+              QuadricCamera::projectBatch(batch, pose, K);
+          for (py::ssize_t i = 0; i < n; i++) {
+            boundsMap.row(i) << projections.xmin[i], projections.ymin[i],
+                projections.xmax[i], projections.ymax[i];
+            statusData[i] = static_cast<int>(projections.status[i]);
+          }
+        }
+        return py::make_tuple(bounds, status);
+      },
+      py::arg("quadrics"), py::arg("pose"), py::arg("calibration"),
+      "Projects Nx9 quadric tangent vectors into one camera. Returns the\n"
+      "Nx4 simple bounds and N statuses, 0 where the projection succeeded,\n"
+      "see QuadricCamera.projectBatch.");
+
+  m.def(
+      "projectUncertainBoundsBatch",
+      [](const QuadricsRef& quadrics, const CovariancesRef& covariances,
+         const gtsam::Pose3& pose, const gtsam::Cal3_S2& calibration,
+         double sigmas) -> py::tuple {
+        const py::ssize_t n = quadrics.rows();
+        if (covariances.rows() != n) {
+          throw std::invalid_argument(
+              "quadrics and covariances require one row per quadric");
+        }
+        boost::shared_ptr<gtsam::Cal3_S2> K =
+            boost::make_shared<gtsam::Cal3_S2>(calibration);
+
+        py::array_t<double> bounds({n, py::ssize_t(4)});
+        py::array_t<int> status(n);
+        Eigen::Map<BoundingBoxFactor::BatchBoxes> boundsMap(
+            bounds.mutable_data(), n, 4);
+        int* statusData = status.mutable_data();
+        {
+          py::gil_scoped_release release;
+          std::vector<ConstrainedDualQuadric> batch;
+          std::vector<gtsam::Matrix> batchCovariances;
+          batch.reserve(n);
+          batchCovariances.reserve(n);
+          for (py::ssize_t i = 0; i < n; i++) {
+            batch.push_back(ConstrainedDualQuadric::Retract(
+                gtsam::Vector9(quadrics.row(i).transpose())));
+            batchCovariances.push_back(
+                Eigen::Map<const Eigen::Matrix<double, 9, 9, Eigen::RowMajor> >(
+                    covariances.row(i).data()));
+          }
+          AlignedBox2Vector batchBounds;
+          std::vector<ProjectionStatus> batchStatus =
+              QuadricCamera::projectUncertainBatch(
+                  batch, batchCovariances, pose, K, sigmas, batchBounds);
+          for (py::ssize_t i = 0; i < n; i++) {
+            boundsMap.row(i) = batchBounds[i].vector().transpose();
+            statusData[i] = static_cast<int>(batchStatus[i]);
+          }
+        }
+        return py::make_tuple(bounds, status);
+      },
+      py::arg("quadrics"), py::arg("covariances"), py::arg("pose"),
+      py::arg("calibration"), py::arg("sigmas") = 3.0,
+      "Projects Nx9 quadric tangent vectors with Nx81 row-major 9x9\n"
+      "covariances into one camera (covariances.reshape(N, 81)). Returns\n"
+      "the Nx4 simple bounds grown by sigmas standard deviations per side\n"
+      "and N statuses, see QuadricCamera.projectUncertainBatch.");
+
+  m.def(
+      "initializeQuadricsBatch",
+      [](const PoseArray& poseMatrices, const BoxesRef& boxes,
+         const Eigen::Ref<const Eigen::VectorXi>& poseIndices,
+         const Eigen::Ref<const Eigen::VectorXi>& landmarkIndices,
+         size_t nrLandmarks, const gtsam::Cal3_S2& calibration) -> py::tuple {
+        const PosesMap poses = mapPoses(poseMatrices);
+        const py::ssize_t m = boxes.rows();
+        if (poseIndices.size() != m || landmarkIndices.size() != m) {
+          throw std::invalid_argument(
+              "boxes, poseIndices and landmarkIndices require one row per "
+              "box");
+        }
+        if ((poseIndices.array() < 0).any() ||
+            (poseIndices.array() >= poses.rows()).any() ||
+            (landmarkIndices.array() < 0).any() ||
+            (landmarkIndices.array() >= int(nrLandmarks)).any()) {
+          throw std::invalid_argument("pose or landmark index out of range");
+        }
+        boost::shared_ptr<gtsam::Cal3_S2> K =
+            boost::make_shared<gtsam::Cal3_S2>(calibration);
+
+        py::array_t<double> quadrics({py::ssize_t(nrLandmarks),
+                                      py::ssize_t(9)});
+        py::array_t<int> status(nrLandmarks);
+        Eigen::Map<BoundingBoxFactor::BatchQuadrics> quadricsMap(
+            quadrics.mutable_data(), nrLandmarks, 9);
+        int* statusData = status.mutable_data();
+        {
+          py::gil_scoped_release release;
+          std::vector<gtsam::Pose3> batchPoses;
+          batchPoses.reserve(poses.rows());
+          for (py::ssize_t i = 0; i < poses.rows(); i++) {
+            batchPoses.push_back(pose(poses, i));
+          }
+          std::vector<QuadricInitializer::Track> tracks(nrLandmarks);
+          for (py::ssize_t i = 0; i < m; i++) {
+            QuadricInitializer::Track& track = tracks[landmarkIndices(i)];
+            track.poses.push_back(poseIndices(i));
+            track.boxes.push_back(
+                AlignedBox2(gtsam::Vector4(boxes.row(i).transpose())));
+          }
+          std::vector<ConstrainedDualQuadric> batch;
+          std::vector<QuadricInitializer::Status> batchStatus =
+              QuadricInitializer::initializeBatch(batchPoses, tracks, K,
+                                                  batch);
+          for (size_t j = 0; j < nrLandmarks; j++) {
+            quadricsMap.row(j) =
+                ConstrainedDualQuadric::LocalCoordinates(batch[j]).transpose();
+            statusData[j] = static_cast<int>(batchStatus[j]);
+          }
+        }
+        return py::make_tuple(quadrics, status);
+      },
+      py::arg("poses"), py::arg("boxes"), py::arg("poseIndices"),
+      py::arg("landmarkIndices"), py::arg("nrLandmarks"),
+      py::arg("calibration"),
+      "Initializes nrLandmarks quadrics from Nx4 boxes, each seen from\n"
+      "poses[poseIndices[i]] (Px4x4 pose matrices, or Px3x4 or Px12) of\n"
+      "landmark landmarkIndices[i]. Returns the Lx9 quadric tangent vectors\n"
+      "and L statuses, 0 where the initialization succeeded, see\n"
+      "QuadricInitializer.initializeBatch.");
+}
+
+}  // namespace python
+}  // namespace gtsam_quadrics